@@ -0,0 +1,9 @@
+"""Build hook for the optional native scanning kernel.
+
+Project metadata lives in `pyproject.toml`; this file only declares `usereq._scan`. The extension is `optional`, so installs on hosts without a C
+compiler still succeed and `usereq.line_lexer` keeps using its pure-Python kernels.
+"""
+
+from setuptools import Extension, setup
+
+setup(ext_modules=[Extension("usereq._scan", ["src/usereq/_scan.c"], optional=True)])
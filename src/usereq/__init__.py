@@ -2,7 +2,8 @@
 @file __init__.py
 @brief Initialization module for the `usereq` package.
 @details Exposes package metadata and lazily-resolved CLI entrypoints while avoiding eager
-import of `usereq.cli` during package initialization.
+import of `usereq.cli` and of the analysis submodules during package initialization, so the
+`req` console script pays only for the modules its command uses.
 @author GitHub Copilot
 @version 0.0.70
 """
@@ -10,14 +11,14 @@ import of `usereq.cli` during package initialization.
 from __future__ import annotations
 
 import importlib
-from . import compress  # usereq.compress submodule
-from . import compress_files  # usereq.compress_files submodule
-from . import find_constructs  # usereq.find_constructs submodule
-from . import generate_markdown  # usereq.generate_markdown submodule
-from . import source_analyzer  # usereq.source_analyzer submodule
-from . import token_counter  # usereq.token_counter submodule
 from typing import Any
 
+_LAZY_SUBMODULES = frozenset({
+    "cli", "compress", "compress_files", "find_constructs",
+    "generate_markdown", "source_analyzer", "token_counter",
+})
+"""! @brief Public submodules imported on first attribute access instead of at package import."""
+
 __version__ = "0.66.0"
 """! @brief Semantic version string of the package."""
 
@@ -41,16 +42,17 @@ def main(argv: list[str] | None = None) -> int:
 def __getattr__(name: str) -> Any:
     """!
     @brief Lazily resolve deferred public package attributes.
-    @details Resolves `cli` on first access to preserve backward-compatible attribute
-    access (`usereq.cli`) while keeping package initialization free from eager CLI import.
+    @details Resolves `cli` and the public analysis submodules on first access to preserve
+    backward-compatible attribute access (`usereq.cli`, `usereq.compress`, ...) while keeping
+    package initialization free from eager imports.
     @param name {str} Requested attribute name.
     @return {Any} Resolved attribute object.
     @throws {AttributeError} Raised when the attribute is not a supported deferred symbol.
-    @satisfies SRS-056
+    @satisfies SRS-056, SRS-402
     """
 
-    if name == "cli":
-        return importlib.import_module(f"{__name__}.cli")
+    if name in _LAZY_SUBMODULES:
+        return importlib.import_module(f"{__name__}.{name}")
     raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
 
 
@@ -0,0 +1,938 @@
+/*!
+ * @file _scan.c
+ * @brief Optional native kernels of `usereq.line_lexer`: the string/comment lexer and the brace-depth scanner.
+ * @details `Lexer` mirrors `line_lexer.LineLexer` (`advance`, `in_string`, `find_comment`) and `BraceScanner` mirrors the per-line loop of
+ * `line_lexer.iter_brace_marks()`. Both walk the string's canonical storage directly; for 1-byte strings (ASCII and Latin-1 sources) candidate positions are
+ * found by a table-driven byte skip, and single-needle searches (block comment and raw string terminators) use `PyUnicode_Find`. Token priority, escape
+ * handling, and state carried across lines follow the Python implementation exactly, so the two are interchangeable; the module is built only when a C
+ * compiler is available (see `setup.py`) and `line_lexer` falls back to Python otherwise.
+ * @author GitHub Copilot
+ * @version 0.0.70
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <structmember.h>
+
+/* Token roles. Non-negative roles of lexer open tokens are delimiter indexes. */
+#define ROLE_COMMENT (-1)
+#define ROLE_ESCAPE (-2)
+#define ROLE_CLOSE (-3)
+#define ROLE_LBRACE (-10)
+#define ROLE_RBRACE (-11)
+#define ROLE_LPAREN (-12)
+#define ROLE_RPAREN (-13)
+#define ROLE_SEMI (-14)
+#define ROLE_BLOCK (-15)
+#define ROLE_CHARLIT (-16)
+#define ROLE_STR (-17)
+
+#define STATE_CODE 0
+#define STATE_BLOCK 1
+#define STATE_RAW 2
+#define STATE_STR 3
+
+#define RAW_NONE 0
+#define RAW_CPP 1
+#define RAW_RUST 2
+
+/* Ordered literal tokens; at one position the first matching token wins, like a regex alternation. */
+typedef struct {
+    Py_ssize_t n;
+    PyObject **tokens;
+    Py_ssize_t *lens;
+    int *roles;
+    Py_ssize_t *indexes;
+    unsigned char first[128];
+    int first_nonascii;
+} TokenSet;
+
+static PyObject *MARK_BRACE;
+static PyObject *MARK_SEMI;
+
+static void
+tokenset_clear(TokenSet *set)
+{
+    for (Py_ssize_t k = 0; k < set->n; k++) {
+        Py_XDECREF(set->tokens[k]);
+    }
+    PyMem_Free(set->tokens);
+    PyMem_Free(set->lens);
+    PyMem_Free(set->roles);
+    PyMem_Free(set->indexes);
+    memset(set, 0, sizeof(*set));
+}
+
+static int
+tokenset_init(TokenSet *set, Py_ssize_t capacity)
+{
+    memset(set, 0, sizeof(*set));
+    Py_ssize_t size = capacity > 0 ? capacity : 1;
+    set->tokens = PyMem_Calloc(size, sizeof(PyObject *));
+    set->lens = PyMem_Calloc(size, sizeof(Py_ssize_t));
+    set->roles = PyMem_Calloc(size, sizeof(int));
+    set->indexes = PyMem_Calloc(size, sizeof(Py_ssize_t));
+    if (!set->tokens || !set->lens || !set->roles || !set->indexes) {
+        tokenset_clear(set);
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+/* Append a token; None and empty strings are skipped like `_token_regex()` does. */
+static int
+tokenset_add(TokenSet *set, PyObject *token, int role, Py_ssize_t index)
+{
+    if (token == NULL || token == Py_None) {
+        return 0;
+    }
+    if (!PyUnicode_Check(token)) {
+        PyErr_SetString(PyExc_TypeError, "tokens must be str or None");
+        return -1;
+    }
+    Py_ssize_t len = PyUnicode_GET_LENGTH(token);
+    if (len == 0) {
+        return 0;
+    }
+    Py_INCREF(token);
+    set->tokens[set->n] = token;
+    set->lens[set->n] = len;
+    set->roles[set->n] = role;
+    set->indexes[set->n] = index;
+    set->n++;
+    Py_UCS4 c = PyUnicode_READ_CHAR(token, 0);
+    if (c < 128) {
+        set->first[c] = 1;
+    }
+    else {
+        set->first_nonascii = 1;
+    }
+    return 0;
+}
+
+static inline int
+match_at(int kind, const void *data, Py_ssize_t len, Py_ssize_t p, PyObject *token, Py_ssize_t tlen)
+{
+    if (p + tlen > len) {
+        return 0;
+    }
+    int tkind = PyUnicode_KIND(token);
+    const void *tdata = PyUnicode_DATA(token);
+    for (Py_ssize_t k = 0; k < tlen; k++) {
+        if (PyUnicode_READ(kind, data, p + k) != PyUnicode_READ(tkind, tdata, k)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#define IS_CANDIDATE(table, nonascii, c) ((c) < 128 ? (table)[(c)] : (nonascii))
+
+/* Leftmost position in [i, limit) where a token matches within [0, len); -1 when none. */
+static Py_ssize_t
+find_token(int kind, const void *data, Py_ssize_t len, Py_ssize_t i, Py_ssize_t limit, const TokenSet *set, Py_ssize_t *which)
+{
+    if (limit > len) {
+        limit = len;
+    }
+    for (Py_ssize_t p = i; p < limit; p++) {
+        if (kind == PyUnicode_1BYTE_KIND) {
+            const Py_UCS1 *bytes = (const Py_UCS1 *)data;
+            while (p < limit && !IS_CANDIDATE(set->first, set->first_nonascii, bytes[p])) {
+                p++;
+            }
+            if (p >= limit) {
+                break;
+            }
+        }
+        else {
+            Py_UCS4 c = PyUnicode_READ(kind, data, p);
+            if (!IS_CANDIDATE(set->first, set->first_nonascii, c)) {
+                continue;
+            }
+        }
+        for (Py_ssize_t k = 0; k < set->n; k++) {
+            if (match_at(kind, data, len, p, set->tokens[k], set->lens[k])) {
+                *which = k;
+                return p;
+            }
+        }
+    }
+    return -1;
+}
+
+/* ------------------------------------------------------------------------------------------------------------------------------------------------------ */
+/* Lexer                                                                                                                                                  */
+/* ------------------------------------------------------------------------------------------------------------------------------------------------------ */
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *delimiters;
+    PyObject *single_comment;
+    int escape_multi;
+    TokenSet open;
+    TokenSet open_or_comment;
+    TokenSet *close;
+    Py_ssize_t n_delimiters;
+} LexerObject;
+
+static void
+Lexer_dealloc(LexerObject *self)
+{
+    tokenset_clear(&self->open);
+    tokenset_clear(&self->open_or_comment);
+    if (self->close != NULL) {
+        for (Py_ssize_t k = 0; k < self->n_delimiters; k++) {
+            tokenset_clear(&self->close[k]);
+        }
+        PyMem_Free(self->close);
+    }
+    Py_XDECREF(self->delimiters);
+    Py_XDECREF(self->single_comment);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int
+Lexer_init(LexerObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"string_delimiters", "single_comment", "escape_multi", NULL};
+    PyObject *delimiters;
+    PyObject *single_comment = Py_None;
+    int escape_multi = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!|Op", kwlist, &PyTuple_Type, &delimiters, &single_comment, &escape_multi)) {
+        return -1;
+    }
+    if (self->delimiters != NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Lexer is already initialized");
+        return -1;
+    }
+    if (single_comment != Py_None && (!PyUnicode_Check(single_comment) || PyUnicode_GET_LENGTH(single_comment) == 0)) {
+        single_comment = Py_None;
+    }
+    Py_ssize_t n = PyTuple_GET_SIZE(delimiters);
+    Py_INCREF(delimiters);
+    self->delimiters = delimiters;
+    Py_INCREF(single_comment);
+    self->single_comment = single_comment;
+    self->escape_multi = escape_multi;
+    self->n_delimiters = n;
+    self->close = PyMem_Calloc(n > 0 ? n : 1, sizeof(TokenSet));
+    if (self->close == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (tokenset_init(&self->open, n) < 0 || tokenset_init(&self->open_or_comment, n + 1) < 0) {
+        return -1;
+    }
+    if (tokenset_add(&self->open_or_comment, single_comment, ROLE_COMMENT, -1) < 0) {
+        return -1;
+    }
+    for (Py_ssize_t k = 0; k < n; k++) {
+        PyObject *delim = PyTuple_GET_ITEM(delimiters, k);
+        if (!PyUnicode_Check(delim)) {
+            PyErr_SetString(PyExc_TypeError, "string delimiters must be str");
+            return -1;
+        }
+        if (tokenset_add(&self->open, delim, (int)k, k) < 0 || tokenset_add(&self->open_or_comment, delim, (int)k, k) < 0) {
+            return -1;
+        }
+        if (tokenset_init(&self->close[k], 2) < 0) {
+            return -1;
+        }
+        int escaped = escape_multi || PyUnicode_GET_LENGTH(delim) == 1;
+        if (escaped) {
+            PyObject *backslash = PyUnicode_FromOrdinal('\\');
+            if (backslash == NULL) {
+                return -1;
+            }
+            int rc = tokenset_add(&self->close[k], backslash, ROLE_ESCAPE, k);
+            Py_DECREF(backslash);
+            if (rc < 0) {
+                return -1;
+            }
+        }
+        if (tokenset_add(&self->close[k], delim, ROLE_CLOSE, k) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Run the state machine. `*state` is -1 in code, a delimiter index in a string, or -2 for an unknown delimiter passed by the caller. */
+static int
+lexer_run(LexerObject *self, PyObject *line, Py_ssize_t start, Py_ssize_t stop, Py_ssize_t *state, PyObject *state_obj, int find_comment,
+          Py_ssize_t *comment)
+{
+    int kind = PyUnicode_KIND(line);
+    const void *data = PyUnicode_DATA(line);
+    Py_ssize_t len = PyUnicode_GET_LENGTH(line);
+    Py_ssize_t i = start;
+    Py_ssize_t which;
+    *comment = -1;
+    while (i < stop) {
+        if (*state == -1) {
+            const TokenSet *set = find_comment ? &self->open_or_comment : &self->open;
+            Py_ssize_t p = find_token(kind, data, len, i, stop, set, &which);
+            if (p < 0) {
+                break;
+            }
+            if (set->roles[which] == ROLE_COMMENT) {
+                *comment = p;
+                return 0;
+            }
+            *state = set->roles[which];
+            i = p + set->lens[which];
+            continue;
+        }
+        if (*state < 0) {
+            PyErr_SetObject(PyExc_KeyError, state_obj);
+            return -1;
+        }
+        const TokenSet *close = &self->close[*state];
+        Py_ssize_t p = find_token(kind, data, len, i, stop, close, &which);
+        if (p < 0) {
+            break;
+        }
+        if (close->roles[which] == ROLE_ESCAPE) {
+            i = p + (p + 1 < len ? 2 : 1);
+            continue;
+        }
+        *state = -1;
+        i = p + close->lens[which];
+    }
+    return 0;
+}
+
+static Py_ssize_t
+lexer_state_index(LexerObject *self, PyObject *state)
+{
+    if (state == Py_None) {
+        return -1;
+    }
+    for (Py_ssize_t k = 0; k < self->n_delimiters; k++) {
+        int eq = PyObject_RichCompareBool(PyTuple_GET_ITEM(self->delimiters, k), state, Py_EQ);
+        if (eq < 0) {
+            return -3;
+        }
+        if (eq) {
+            return k;
+        }
+    }
+    return -2;
+}
+
+static PyObject *
+lexer_state_object(LexerObject *self, Py_ssize_t state, PyObject *original)
+{
+    PyObject *result = state == -1 ? Py_None : state == -2 ? original : PyTuple_GET_ITEM(self->delimiters, state);
+    Py_INCREF(result);
+    return result;
+}
+
+static PyObject *
+Lexer_advance(LexerObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"line", "start", "stop", "state", "find_comment", NULL};
+    PyObject *line;
+    Py_ssize_t start;
+    Py_ssize_t stop;
+    PyObject *state_obj = Py_None;
+    int find_comment = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Unn|Op", kwlist, &line, &start, &stop, &state_obj, &find_comment)) {
+        return NULL;
+    }
+    Py_ssize_t state = lexer_state_index(self, state_obj);
+    Py_ssize_t comment;
+    if (state == -3 || lexer_run(self, line, start, stop, &state, state_obj, find_comment, &comment) < 0) {
+        return NULL;
+    }
+    if (comment >= 0) {
+        return Py_BuildValue("(On)", Py_None, comment);
+    }
+    PyObject *result_state = lexer_state_object(self, state, state_obj);
+    return Py_BuildValue("(NO)", result_state, Py_None);
+}
+
+static PyObject *
+Lexer_in_string(LexerObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"line", "pos", "state", NULL};
+    PyObject *line;
+    Py_ssize_t pos;
+    PyObject *state_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Un|O", kwlist, &line, &pos, &state_obj)) {
+        return NULL;
+    }
+    Py_ssize_t state = lexer_state_index(self, state_obj);
+    Py_ssize_t comment;
+    if (state == -3 || lexer_run(self, line, 0, pos, &state, state_obj, 0, &comment) < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(state != -1);
+}
+
+static PyObject *
+Lexer_find_comment(LexerObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"line", "state", NULL};
+    PyObject *line;
+    PyObject *state_obj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "U|O", kwlist, &line, &state_obj)) {
+        return NULL;
+    }
+    if (self->single_comment == Py_None) {
+        Py_RETURN_NONE;
+    }
+    Py_ssize_t state = lexer_state_index(self, state_obj);
+    Py_ssize_t comment;
+    if (state == -3 || lexer_run(self, line, 0, PyUnicode_GET_LENGTH(line), &state, state_obj, 1, &comment) < 0) {
+        return NULL;
+    }
+    if (comment < 0) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromSsize_t(comment);
+}
+
+static PyMethodDef Lexer_methods[] = {
+    {"advance", (PyCFunction)(void (*)(void))Lexer_advance, METH_VARARGS | METH_KEYWORDS,
+     "advance(line, start, stop, state=None, find_comment=False) -> (state, comment_index)"},
+    {"in_string", (PyCFunction)(void (*)(void))Lexer_in_string, METH_VARARGS | METH_KEYWORDS, "in_string(line, pos, state=None) -> bool"},
+    {"find_comment", (PyCFunction)(void (*)(void))Lexer_find_comment, METH_VARARGS | METH_KEYWORDS, "find_comment(line, state=None) -> int | None"},
+    {NULL, NULL, 0, NULL},
+};
+
+static PyMemberDef Lexer_members[] = {
+    {"delimiters", T_OBJECT, offsetof(LexerObject, delimiters), READONLY, "String delimiters, longest first."},
+    {"single_comment", T_OBJECT, offsetof(LexerObject, single_comment), READONLY, "Single-line comment marker, or None."},
+    {"escape_multi", T_BOOL, offsetof(LexerObject, escape_multi), READONLY, "Whether backslashes escape inside multi-character delimiters."},
+    {NULL, 0, 0, 0, NULL},
+};
+
+static PyTypeObject LexerType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "usereq._scan.Lexer",
+    .tp_basicsize = sizeof(LexerObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Lexer(string_delimiters, single_comment=None, escape_multi=True): native LineLexer; delimiters must be sorted longest first.",
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Lexer_init,
+    .tp_dealloc = (destructor)Lexer_dealloc,
+    .tp_methods = Lexer_methods,
+    .tp_members = Lexer_members,
+};
+
+/* ------------------------------------------------------------------------------------------------------------------------------------------------------ */
+/* BraceScanner                                                                                                                                           */
+/* ------------------------------------------------------------------------------------------------------------------------------------------------------ */
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *delimiters;
+    PyObject *block_end;
+    int char_literals;
+    int raw_mode;
+    TokenSet code;
+    TokenSet *close;
+    Py_ssize_t n_delimiters;
+    unsigned char candidates[128];
+    int candidates_nonascii;
+    int state;
+    Py_ssize_t str_index;
+    PyObject *raw_term;
+    Py_ssize_t depth;
+    Py_ssize_t parens;
+} BraceScannerObject;
+
+static void
+BraceScanner_dealloc(BraceScannerObject *self)
+{
+    tokenset_clear(&self->code);
+    if (self->close != NULL) {
+        for (Py_ssize_t k = 0; k < self->n_delimiters; k++) {
+            tokenset_clear(&self->close[k]);
+        }
+        PyMem_Free(self->close);
+    }
+    Py_XDECREF(self->delimiters);
+    Py_XDECREF(self->block_end);
+    Py_XDECREF(self->raw_term);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int
+str_equals(PyObject *token, const char *text)
+{
+    return token != NULL && token != Py_None && PyUnicode_Check(token) && PyUnicode_CompareWithASCIIString(token, text) == 0;
+}
+
+static int
+objects_equal(PyObject *a, PyObject *b)
+{
+    if (a == Py_None || b == Py_None) {
+        return 0;
+    }
+    return PyObject_RichCompareBool(a, b, Py_EQ);
+}
+
+/* Role of one code token, following the `elif` chain of `_iter_python_brace_marks()`. */
+static int
+brace_token_role(BraceScannerObject *self, PyObject *token, PyObject *single_comment, PyObject *multi_start, Py_ssize_t *index)
+{
+    int eq;
+    *index = -1;
+    if (str_equals(token, "{")) {
+        return ROLE_LBRACE;
+    }
+    if (str_equals(token, "}")) {
+        return ROLE_RBRACE;
+    }
+    if (str_equals(token, "(")) {
+        return ROLE_LPAREN;
+    }
+    if (str_equals(token, ")")) {
+        return ROLE_RPAREN;
+    }
+    if (str_equals(token, ";")) {
+        return ROLE_SEMI;
+    }
+    if ((eq = objects_equal(token, single_comment)) != 0) {
+        return eq < 0 ? -100 : ROLE_COMMENT;
+    }
+    if ((eq = objects_equal(token, multi_start)) != 0) {
+        return eq < 0 ? -100 : ROLE_BLOCK;
+    }
+    if (self->char_literals && str_equals(token, "'")) {
+        return ROLE_CHARLIT;
+    }
+    for (Py_ssize_t k = 0; k < self->n_delimiters; k++) {
+        eq = PyObject_RichCompareBool(PyTuple_GET_ITEM(self->delimiters, k), token, Py_EQ);
+        if (eq < 0) {
+            return -100;
+        }
+        if (eq) {
+            *index = k;
+            return ROLE_STR;
+        }
+    }
+    PyErr_SetObject(PyExc_KeyError, token);
+    return -100;
+}
+
+static int
+BraceScanner_init(BraceScannerObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"multi_comment_start", "single_comment", "string_delimiters", "multi_comment_end", "char_literals", "raw_mode", NULL};
+    PyObject *multi_start;
+    PyObject *single_comment;
+    PyObject *delimiters;
+    PyObject *block_end;
+    int char_literals = 0;
+    int raw_mode = RAW_NONE;
+    static const char *structural[] = {"{", "}", "(", ")", ";"};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO!O|pi", kwlist, &multi_start, &single_comment, &PyTuple_Type, &delimiters, &block_end,
+                                     &char_literals, &raw_mode)) {
+        return -1;
+    }
+    if (self->delimiters != NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "BraceScanner is already initialized");
+        return -1;
+    }
+    Py_ssize_t n = PyTuple_GET_SIZE(delimiters);
+    Py_INCREF(delimiters);
+    self->delimiters = delimiters;
+    Py_INCREF(block_end);
+    self->block_end = block_end;
+    self->char_literals = char_literals;
+    self->raw_mode = raw_mode;
+    self->n_delimiters = n;
+    self->state = STATE_CODE;
+    self->close = PyMem_Calloc(n > 0 ? n : 1, sizeof(TokenSet));
+    if (self->close == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (tokenset_init(&self->code, n + 7) < 0) {
+        return -1;
+    }
+    PyObject *ordered[2] = {multi_start, single_comment};
+    for (int k = 0; k < 2; k++) {
+        Py_ssize_t index;
+        if (ordered[k] == Py_None || (PyUnicode_Check(ordered[k]) && PyUnicode_GET_LENGTH(ordered[k]) == 0)) {
+            continue;
+        }
+        int role = brace_token_role(self, ordered[k], single_comment, multi_start, &index);
+        if (role == -100 || tokenset_add(&self->code, ordered[k], role, index) < 0) {
+            return -1;
+        }
+    }
+    for (Py_ssize_t k = 0; k < n; k++) {
+        PyObject *delim = PyTuple_GET_ITEM(delimiters, k);
+        Py_ssize_t index;
+        if (!PyUnicode_Check(delim)) {
+            PyErr_SetString(PyExc_TypeError, "string delimiters must be str");
+            return -1;
+        }
+        if (PyUnicode_GET_LENGTH(delim) > 0) {
+            int role = brace_token_role(self, delim, single_comment, multi_start, &index);
+            if (role == -100 || tokenset_add(&self->code, delim, role, index) < 0) {
+                return -1;
+            }
+        }
+        if (tokenset_init(&self->close[k], 2) < 0) {
+            return -1;
+        }
+        PyObject *backslash = PyUnicode_FromOrdinal('\\');
+        if (backslash == NULL) {
+            return -1;
+        }
+        int rc = tokenset_add(&self->close[k], backslash, ROLE_ESCAPE, k);
+        Py_DECREF(backslash);
+        if (rc < 0 || tokenset_add(&self->close[k], delim, ROLE_CLOSE, k) < 0) {
+            return -1;
+        }
+    }
+    for (int k = 0; k < 5; k++) {
+        PyObject *token = PyUnicode_FromString(structural[k]);
+        Py_ssize_t index;
+        if (token == NULL) {
+            return -1;
+        }
+        int role = brace_token_role(self, token, single_comment, multi_start, &index);
+        int rc = role == -100 ? -1 : tokenset_add(&self->code, token, role, index);
+        Py_DECREF(token);
+        if (rc < 0) {
+            return -1;
+        }
+    }
+    memcpy(self->candidates, self->code.first, sizeof(self->candidates));
+    self->candidates_nonascii = self->code.first_nonascii;
+    if (raw_mode == RAW_CPP) {
+        self->candidates['u'] = self->candidates['U'] = self->candidates['L'] = self->candidates['R'] = 1;
+    }
+    else if (raw_mode == RAW_RUST) {
+        self->candidates['b'] = self->candidates['r'] = 1;
+    }
+    return 0;
+}
+
+static inline int
+is_word_ascii(Py_UCS4 c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+/* Raw string opener at `p` (`_RAW_STRING_OPENERS`); returns the end column and sets the delimiter span, or -1. */
+static Py_ssize_t
+raw_opener_at(int raw_mode, int kind, const void *data, Py_ssize_t length, Py_ssize_t p, Py_ssize_t *delim_start, Py_ssize_t *delim_end)
+{
+    if (p > 0 && is_word_ascii(PyUnicode_READ(kind, data, p - 1))) {
+        return -1;
+    }
+#define AT(q) ((q) < length ? PyUnicode_READ(kind, data, (q)) : (Py_UCS4)0)
+    if (raw_mode == RAW_CPP) {
+        Py_UCS4 c0 = AT(p);
+        Py_ssize_t starts[3];
+        int count = 0;
+        if (c0 == 'u' && AT(p + 1) == '8') {
+            starts[count++] = p + 2;
+        }
+        if (c0 == 'u' || c0 == 'U' || c0 == 'L') {
+            starts[count++] = p + 1;
+        }
+        starts[count++] = p;
+        for (int k = 0; k < count; k++) {
+            Py_ssize_t q = starts[k];
+            if (AT(q) != 'R' || q + 1 >= length || AT(q + 1) != '"') {
+                continue;
+            }
+            Py_ssize_t r = q + 2;
+            while (r < length && r - (q + 2) < 16) {
+                Py_UCS4 c = PyUnicode_READ(kind, data, r);
+                if (c == '(' || c == ')' || c == '\\' || c == '"' || Py_UNICODE_ISSPACE(c)) {
+                    break;
+                }
+                r++;
+            }
+            if (r < length && PyUnicode_READ(kind, data, r) == '(') {
+                *delim_start = q + 2;
+                *delim_end = r;
+                return r + 1;
+            }
+        }
+        return -1;
+    }
+    if (raw_mode == RAW_RUST) {
+        Py_ssize_t q;
+        if (AT(p) == 'b' && AT(p + 1) == 'r') {
+            q = p + 2;
+        }
+        else if (AT(p) == 'r') {
+            q = p + 1;
+        }
+        else {
+            return -1;
+        }
+        Py_ssize_t r = q;
+        while (r < length && PyUnicode_READ(kind, data, r) == '#') {
+            r++;
+        }
+        if (r < length && PyUnicode_READ(kind, data, r) == '"') {
+            *delim_start = q;
+            *delim_end = r;
+            return r + 1;
+        }
+    }
+    return -1;
+#undef AT
+}
+
+/* One-character literal at `p` (`_CHAR_LITERAL`); returns the end column or -1. */
+static Py_ssize_t
+char_literal_end(int kind, const void *data, Py_ssize_t length, Py_ssize_t p)
+{
+    Py_ssize_t q = p + 1;
+    if (q >= length) {
+        return -1;
+    }
+    Py_UCS4 c = PyUnicode_READ(kind, data, q);
+    if (c == '\\') {
+        if (q + 1 >= length || PyUnicode_READ(kind, data, q + 1) == '\n') {
+            return -1;
+        }
+        Py_ssize_t r = q + 2;
+        while (r < length) {
+            Py_UCS4 d = PyUnicode_READ(kind, data, r);
+            if (d == '\'' || d == '\\') {
+                break;
+            }
+            r++;
+        }
+        return r < length && PyUnicode_READ(kind, data, r) == '\'' ? r + 1 : -1;
+    }
+    if (c == '\'') {
+        return -1;
+    }
+    return q + 1 < length && PyUnicode_READ(kind, data, q + 1) == '\'' ? q + 2 : -1;
+}
+
+static PyObject *
+raw_terminator(int raw_mode, PyObject *line, Py_ssize_t start, Py_ssize_t end)
+{
+    PyObject *delim = PyUnicode_Substring(line, start, end);
+    if (delim == NULL) {
+        return NULL;
+    }
+    PyObject *result = raw_mode == RAW_CPP ? PyUnicode_FromFormat(")%U\"", delim) : PyUnicode_FromFormat("\"%U", delim);
+    Py_DECREF(delim);
+    return result;
+}
+
+static PyObject *
+BraceScanner_feed(BraceScannerObject *self, PyObject *raw_line)
+{
+    if (!PyUnicode_Check(raw_line)) {
+        PyErr_SetString(PyExc_TypeError, "feed() expects a str line");
+        return NULL;
+    }
+    int kind = PyUnicode_KIND(raw_line);
+    const void *data = PyUnicode_DATA(raw_line);
+    Py_ssize_t length = PyUnicode_GET_LENGTH(raw_line);
+    while (length > 0) {
+        Py_UCS4 c = PyUnicode_READ(kind, data, length - 1);
+        if (c != '\n' && c != '\r') {
+            break;
+        }
+        length--;
+    }
+    PyObject *mark = Py_None;
+    Py_ssize_t i = 0;
+    Py_ssize_t which;
+    const TokenSet *code = &self->code;
+    while (i < length) {
+        if (self->state == STATE_CODE) {
+            Py_ssize_t p = i;
+            Py_ssize_t raw_end = -1;
+            Py_ssize_t delim_start = 0;
+            Py_ssize_t delim_end = 0;
+            which = -1;
+            for (; p < length; p++) {
+                Py_UCS4 c;
+                if (kind == PyUnicode_1BYTE_KIND) {
+                    const Py_UCS1 *bytes = (const Py_UCS1 *)data;
+                    while (p < length && !IS_CANDIDATE(self->candidates, self->candidates_nonascii, bytes[p])) {
+                        p++;
+                    }
+                    if (p >= length) {
+                        break;
+                    }
+                    c = bytes[p];
+                }
+                else {
+                    c = PyUnicode_READ(kind, data, p);
+                    if (!IS_CANDIDATE(self->candidates, self->candidates_nonascii, c)) {
+                        continue;
+                    }
+                }
+                if (self->raw_mode != RAW_NONE && c < 128 && ((self->raw_mode == RAW_CPP && (c == 'u' || c == 'U' || c == 'L' || c == 'R'))
+                                                             || (self->raw_mode == RAW_RUST && (c == 'b' || c == 'r')))) {
+                    raw_end = raw_opener_at(self->raw_mode, kind, data, length, p, &delim_start, &delim_end);
+                    if (raw_end >= 0) {
+                        break;
+                    }
+                }
+                for (Py_ssize_t k = 0; k < code->n; k++) {
+                    if (match_at(kind, data, length, p, code->tokens[k], code->lens[k])) {
+                        which = k;
+                        break;
+                    }
+                }
+                if (which >= 0) {
+                    break;
+                }
+            }
+            if (p >= length) {
+                break;
+            }
+            if (raw_end >= 0) {
+                PyObject *term = raw_terminator(self->raw_mode, raw_line, delim_start, delim_end);
+                if (term == NULL) {
+                    return NULL;
+                }
+                Py_XSETREF(self->raw_term, term);
+                self->state = STATE_RAW;
+                i = raw_end;
+                continue;
+            }
+            i = p + code->lens[which];
+            switch (code->roles[which]) {
+            case ROLE_LBRACE:
+                self->depth++;
+                if (mark == Py_None) {
+                    mark = MARK_BRACE;
+                }
+                break;
+            case ROLE_RBRACE:
+                self->depth--;
+                break;
+            case ROLE_LPAREN:
+                self->parens++;
+                break;
+            case ROLE_RPAREN:
+                self->parens = self->parens > 0 ? self->parens - 1 : 0;
+                break;
+            case ROLE_SEMI:
+                if (self->parens == 0 && mark == Py_None) {
+                    mark = MARK_SEMI;
+                }
+                break;
+            case ROLE_COMMENT:
+                i = length;
+                break;
+            case ROLE_BLOCK:
+                self->state = STATE_BLOCK;
+                break;
+            case ROLE_CHARLIT: {
+                Py_ssize_t end = char_literal_end(kind, data, length, p);
+                if (end >= 0) {
+                    i = end;
+                }
+                break;
+            }
+            default:
+                self->state = STATE_STR;
+                self->str_index = code->indexes[which];
+                break;
+            }
+            continue;
+        }
+        if (self->state != STATE_STR) {
+            PyObject *closer = self->state == STATE_BLOCK ? self->block_end : self->raw_term;
+            if (closer == NULL || closer == Py_None || PyUnicode_GET_LENGTH(closer) == 0) {
+                break;
+            }
+            Py_ssize_t found = PyUnicode_Find(raw_line, closer, i, length, 1);
+            if (found == -2) {
+                return NULL;
+            }
+            if (found < 0) {
+                break;
+            }
+            self->state = STATE_CODE;
+            i = found + PyUnicode_GET_LENGTH(closer);
+            continue;
+        }
+        const TokenSet *close = &self->close[self->str_index];
+        Py_ssize_t p = find_token(kind, data, length, i, length, close, &which);
+        if (p < 0) {
+            break;
+        }
+        if (close->roles[which] == ROLE_ESCAPE) {
+            i = p + 2;
+            continue;
+        }
+        self->state = STATE_CODE;
+        i = p + close->lens[which];
+    }
+    if (self->state == STATE_STR) {
+        PyObject *delim = PyTuple_GET_ITEM(self->delimiters, self->str_index);
+        int multiline = str_equals(delim, "`") || str_equals(delim, "\"\"\"");
+        int continued = length > 0 && PyUnicode_READ(kind, data, length - 1) == '\\';
+        if (!multiline && !continued) {
+            self->state = STATE_CODE;
+        }
+    }
+    return Py_BuildValue("(nO)", self->depth, mark);
+}
+
+static PyMethodDef BraceScanner_methods[] = {
+    {"feed", (PyCFunction)BraceScanner_feed, METH_O, "feed(line) -> (depth, mark): scan one line and return the depth at its end and its first structural token."},
+    {NULL, NULL, 0, NULL},
+};
+
+static PyTypeObject BraceScannerType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "usereq._scan.BraceScanner",
+    .tp_basicsize = sizeof(BraceScannerObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "BraceScanner(multi_comment_start, single_comment, string_delimiters, multi_comment_end, char_literals=False, raw_mode=0): native "
+              "per-line loop of iter_brace_marks(); delimiters must be sorted longest first.",
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)BraceScanner_init,
+    .tp_dealloc = (destructor)BraceScanner_dealloc,
+    .tp_methods = BraceScanner_methods,
+};
+
+static struct PyModuleDef scan_module = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "usereq._scan",
+    .m_doc = "Optional native kernels of usereq.line_lexer.",
+    .m_size = -1,
+};
+
+PyMODINIT_FUNC
+PyInit__scan(void)
+{
+    if (PyType_Ready(&LexerType) < 0 || PyType_Ready(&BraceScannerType) < 0) {
+        return NULL;
+    }
+    MARK_BRACE = PyUnicode_InternFromString("{");
+    MARK_SEMI = PyUnicode_InternFromString(";");
+    if (MARK_BRACE == NULL || MARK_SEMI == NULL) {
+        return NULL;
+    }
+    PyObject *module = PyModule_Create(&scan_module);
+    if (module == NULL) {
+        return NULL;
+    }
+    Py_INCREF(&LexerType);
+    Py_INCREF(&BraceScannerType);
+    if (PyModule_AddObject(module, "Lexer", (PyObject *)&LexerType) < 0
+        || PyModule_AddObject(module, "BraceScanner", (PyObject *)&BraceScannerType) < 0
+        || PyModule_AddIntConstant(module, "RAW_CPP", RAW_CPP) < 0 || PyModule_AddIntConstant(module, "RAW_RUST", RAW_RUST) < 0) {
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
+}
@@ -0,0 +1,607 @@
+"""!
+@file analysis_cache.py
+@brief Persistent on-disk cache for per-file analysis and compression results.
+@details Stores enriched `SourceElement` lists and compressed payloads under `.req/cache/` so warm `--references`, `--find`, and `--compress` runs over an unchanged
+tree only stat files. Entries are content-addressed by the git blob object id of the file bytes; a per-path stat index maps `(size, mtime_ns)` to the last computed
+digest, and a content hash is computed only when the stat signature changed. The whole cache namespace is keyed by a fingerprint of the package version and of the
+analyzer module sources (including the `build_language_specs()` pattern tables), so any pattern or version change invalidates every entry.
+Inside a git repository, payload objects live below the common git directory (`SHARED_CACHE_DIR_NAME`), so every worktree of the repository shares them, and
+files whose stat signature is unknown take their digest from the git index (`git ls-files --stage`) unless `git diff-files` reports them modified; a fresh
+worktree therefore hits the objects of its siblings without reading unchanged tracked files. Stat signatures, symbol indexes, and manifests stay per worktree
+under `.req/cache/`.
+The resident server (`--serve`) additionally keeps payloads and stat signatures in an in-process layer (`enable_memory()`).
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import hashlib
+import os
+import pickle
+import subprocess
+import tempfile
+import time
+from pathlib import Path
+from typing import Any, Callable
+
+from . import profiling
+from .source_analyzer import BRACE_LANGUAGES, STREAM_THRESHOLD_BYTES
+from .source_buffer import SourceBuffer, file_blob_digest, git_blob_digest
+
+CACHE_FORMAT_VERSION = "2"
+"""! @brief Serialization layout version mixed into every cache fingerprint."""
+
+CACHE_DIR_NAME = "cache"
+"""! @brief Cache directory name below the project `.req/` directory."""
+
+SHARED_CACHE_DIR_NAME = "usereq-cache"
+"""! @brief Directory below the common git directory holding payload objects shared by all worktrees."""
+
+RACY_WINDOW_NS = 2_000_000_000
+"""! @brief Stat signatures newer than this window at record time are re-hashed on the next lookup (git "racily clean" rule)."""
+
+INDEX_GRACE_NS = 100_000_000
+"""! @brief Margin by which a file's mtime and ctime must precede the git index read before its index blob id is trusted (covers coarse kernel timestamps)."""
+
+MEMORY_MAX_ENTRIES = 200_000
+"""! @brief Entry count at which the in-memory layer is cleared instead of growing further."""
+
+_MEMORY: dict | None = None
+"""! @brief In-process layer over every cache (payloads and stat signatures), enabled by the resident server; None disables it."""
+
+_INDEX_DIGESTS: dict[str, tuple] = {}
+"""! @brief Git index digests read by this process: worktree path -> `(index signature, read time ns, digests)`; inherited by forked workers."""
+
+_FINGERPRINT_MODULES = (
+    "source_analyzer.py",
+    "source_buffer.py",
+    "line_lexer.py",
+    "compress.py",
+    "doxygen_parser.py",
+    "find_constructs.py",
+    "symbol_index.py",
+)
+"""! @brief Package modules whose source participates in the cache fingerprint."""
+
+
+def compute_fingerprint() -> str:
+    """! @brief Compute the cache namespace fingerprint for the running package.
+    @return Hex digest over cache format version, package version, and analyzer module sources.
+    @details Hashing the module sources covers every `build_language_specs()` pattern, comment delimiter, and enrichment rule without compiling any regex.
+    """
+    from . import __version__
+
+    hasher = hashlib.sha1()
+    hasher.update(CACHE_FORMAT_VERSION.encode("ascii"))
+    hasher.update(b"\0")
+    hasher.update(str(__version__).encode("utf-8"))
+    package_dir = Path(__file__).resolve().parent
+    for module_name in _FINGERPRINT_MODULES:
+        hasher.update(b"\0")
+        try:
+            hasher.update((package_dir / module_name).read_bytes())
+        except OSError:
+            hasher.update(module_name.encode("utf-8"))
+    return hasher.hexdigest()
+
+
+def enable_memory() -> None:
+    """! @brief Keep loaded and stored payloads and stat signatures in process memory.
+    @return {None} Function return value.
+    @details Used by the resident server. Remembered payloads are returned as the same objects on later lookups, so callers must treat cached payloads as
+    read-only. Worker processes forked while the layer is enabled inherit its content.
+    """
+    global _MEMORY
+    _MEMORY = {}
+
+
+def disable_memory() -> None:
+    """! @brief Drop the in-process layer.
+    @return {None} Function return value.
+    """
+    global _MEMORY
+    _MEMORY = None
+
+
+def _remember(key: tuple, value: Any) -> None:
+    """! @brief Record one entry in the in-process layer when it is enabled.
+    @param key Entry key.
+    @param value Entry value.
+    @return {None} Function return value.
+    """
+    if _MEMORY is not None:
+        if len(_MEMORY) >= MEMORY_MAX_ENTRIES:
+            _MEMORY.clear()
+        _MEMORY[key] = value
+
+
+def _atomic_write_bytes(target: Path, data: bytes) -> None:
+    """! @brief Write bytes through a sibling temporary file and atomic rename.
+    @param target Destination file path.
+    @param data Payload to persist.
+    @return {None} Function return value.
+    @details Concurrent writers (worker processes) never expose partially written entries.
+    """
+    target.parent.mkdir(parents=True, exist_ok=True)
+    fd, tmp_name = tempfile.mkstemp(dir=str(target.parent), prefix=".tmp-")
+    try:
+        with os.fdopen(fd, "wb") as handle:
+            handle.write(data)
+        os.replace(tmp_name, target)
+    except BaseException:
+        try:
+            os.unlink(tmp_name)
+        except OSError:
+            pass
+        raise
+
+
+def _read_gitdir_file(dot_git: Path) -> Path | None:
+    """! @brief Resolve the private git directory a linked worktree's `.git` file points to.
+    @param dot_git `.git` file of a linked worktree.
+    @return Git directory of the worktree, or None when the file is unreadable or has no `gitdir:` line.
+    """
+    try:
+        text = dot_git.read_text(encoding="utf-8").strip()
+    except (OSError, UnicodeDecodeError):
+        return None
+    if not text.startswith("gitdir:"):
+        return None
+    git_dir = Path(text[len("gitdir:"):].strip())
+    if not git_dir.is_absolute():
+        git_dir = dot_git.parent / git_dir
+    return git_dir
+
+
+def find_git_common_dir(worktree: Path) -> Path | None:
+    """! @brief Locate the git directory shared by every worktree of the repository checked out at `worktree`.
+    @param worktree Worktree top-level directory.
+    @return Absolute common git directory, or None when `worktree` has no `.git` entry.
+    @details Reads a `.git` directory, or the `gitdir:` file of a linked worktree and its `commondir` pointer, without running git. Parent directories are not
+    searched, so scratch projects nested in another checkout keep a private cache.
+    """
+    dot_git = Path(os.path.abspath(worktree)) / ".git"
+    if dot_git.is_dir():
+        return dot_git
+    git_dir = _read_gitdir_file(dot_git)
+    if git_dir is None:
+        return None
+    try:
+        common = Path((git_dir / "commondir").read_text(encoding="utf-8").strip())
+    except (OSError, UnicodeDecodeError):
+        return Path(os.path.abspath(git_dir))
+    if not common.is_absolute():
+        common = git_dir / common
+    return Path(os.path.abspath(common))
+
+
+def _git_index_signature(worktree: Path) -> tuple | None:
+    """! @brief Return the stat signature of the git index file covering a directory.
+    @param worktree Directory inside a git worktree.
+    @return `(mtime_ns, size, inode)` of the index of the nearest enclosing worktree, or None when no index is found.
+    @details Searches parent directories like git does, because project roots configured below the repository top level still take digests from its index.
+    """
+    directory = Path(os.path.abspath(worktree))
+    for candidate in (directory, *directory.parents):
+        dot_git = candidate / ".git"
+        if dot_git.is_dir():
+            index = dot_git / "index"
+            break
+        if dot_git.is_file():
+            git_dir = _read_gitdir_file(dot_git)
+            if git_dir is None:
+                return None
+            index = git_dir / "index"
+            break
+    else:
+        return None
+    try:
+        st = index.stat()
+    except OSError:
+        return None
+    return (st.st_mtime_ns, st.st_size, st.st_ino)
+
+
+def _run_git(base: str, args: tuple, stdin: bytes | None = None) -> str | None:
+    """! @brief Run one git command in a directory and return its decoded stdout.
+    @param base Directory passed to `git -C`.
+    @param args Git arguments.
+    @param stdin Optional bytes fed to the command.
+    @return Standard output, or None when git cannot be started or exits with a non-zero status.
+    """
+    profiling.count("subprocesses.git")
+    try:
+        with subprocess.Popen(
+            ["git", "-C", base, *args],
+            stdin=subprocess.PIPE if stdin is not None else subprocess.DEVNULL,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.DEVNULL,
+        ) as process:
+            output = process.communicate(stdin)[0]
+    except OSError:
+        return None
+    if process.returncode != 0:
+        return None
+    return output.decode("utf-8", "surrogateescape")
+
+
+def read_git_index_digests(worktree: Path) -> dict[str, str]:
+    """! @brief Map unmodified tracked regular files below a directory to their git blob ids.
+    @param worktree Directory inside a git worktree.
+    @return Mapping of absolute path to blob id; empty when git fails or the repository does not use SHA-1 object ids.
+    @details Uses `git ls-files --stage --eol -z` for stage-0 regular-file entries and drops the paths reported by `git diff-files --name-only -z`, which
+    compares worktree files against the index stat data (re-checking content of racily clean entries). A blob id equals `git_blob_digest()` of the worktree
+    bytes only when checkout wrote the staged bytes unchanged, so entries whose index and worktree line endings differ (`core.autocrlf`, `eol` attributes)
+    and entries with a `filter`, `ident`, or `working-tree-encoding` attribute (e.g. LFS) are dropped as well. Symlinks and repositories with SHA-256
+    object format are skipped.
+    """
+    base = os.path.abspath(worktree)
+    staged = _run_git(base, ("ls-files", "--stage", "--eol", "-z"))
+    modified = _run_git(base, ("diff-files", "--name-only", "--relative", "-z")) if staged is not None else None
+    if staged is None or modified is None:
+        return {}
+    dirty = set(filter(None, modified.split("\0")))
+    candidates: dict[str, str] = {}
+    for record in staged.split("\0"):
+        meta, _, rest = record.partition("\t")
+        eol, _, rel_path = rest.partition("\t")
+        fields = meta.split()
+        if len(fields) != 3 or fields[2] != "0" or not fields[0].startswith("100") or len(fields[1]) != 40 or rel_path in dirty:
+            continue
+        eol_fields = eol.split()
+        if len(eol_fields) < 2 or eol_fields[0][2:] != eol_fields[1][2:]:
+            continue
+        candidates[rel_path] = fields[1]
+    if not candidates:
+        return {}
+    attributes = _run_git(
+        base, ("check-attr", "-z", "--stdin", "filter", "ident", "working-tree-encoding"), "\0".join(candidates).encode("utf-8", "surrogateescape") + b"\0"
+    )
+    if attributes is None:
+        return {}
+    values = attributes.split("\0")
+    for index in range(0, len(values) - 2, 3):
+        if values[index + 2] not in ("unspecified", "unset"):
+            candidates.pop(values[index], None)
+    return {os.path.normpath(os.path.join(base, rel_path)): digest for rel_path, digest in candidates.items()}
+
+
+def load_git_index_digests(worktree: Path) -> tuple[int, dict[str, str]]:
+    """! @brief Return the git index digests of a directory, reading the index at most once per index state and process.
+    @param worktree Directory inside a git worktree.
+    @return Tuple `(read_ns, digests)`: the time the index was read and the `read_git_index_digests()` mapping.
+    @details Results are memoized per worktree in `_INDEX_DIGESTS` and re-read only when the index file signature changes (e.g. after `git add` or a checkout in
+    a long-running process). Worker processes forked after the parent loaded the digests reuse them without running git.
+    """
+    key = os.path.abspath(worktree)
+    signature = _git_index_signature(Path(key))
+    entry = _INDEX_DIGESTS.get(key)
+    if entry is None or entry[0] != signature:
+        profiling.count("cache.index_reads")
+        read_ns = time.time_ns()
+        entry = (signature, read_ns, read_git_index_digests(Path(key)))
+        _INDEX_DIGESTS[key] = entry
+    return entry[1], entry[2]
+
+
+class AnalysisCache:
+    """! @brief Content-addressed analysis result store rooted at one directory.
+    @details Instances hold only paths and the fingerprint, so they are cheap to pickle into worker processes. Git index digests live in a per-process memo
+    (`load_git_index_digests()`) that `prepare_for_pool()` fills before a pool forks, so one run reads the index once however many chunks it schedules. Every
+    I/O failure degrades to a cache miss; the cache never changes command output or exit status.
+    """
+
+    def __init__(
+        self,
+        root: Path | str,
+        fingerprint: str | None = None,
+        objects_root: Path | str | None = None,
+        worktree: Path | str | None = None,
+    ):
+        """! @brief Bind the cache to a root directory.
+        @param root Cache root directory (normally `<project>/.req/cache`).
+        @param fingerprint Namespace fingerprint; computed with `compute_fingerprint()` when omitted.
+        @param objects_root Root of the payload object store (default: `root`).
+        @param worktree Git worktree directory whose index supplies digests of unchanged tracked files (default: none).
+        @return {None} Function return value.
+        """
+        self.root = Path(root)
+        self.fingerprint = fingerprint or compute_fingerprint()
+        self.objects_root = Path(objects_root) if objects_root is not None else self.root
+        self.worktree = Path(worktree) if worktree is not None else None
+        self._index_digests: dict[str, str] | None = None
+        self._index_read_ns = 0
+
+    def __getstate__(self) -> dict:
+        """! @brief Pickle the cache without its reference to the git index digests.
+        @return Instance state.
+        @details Unpickled copies look the digests up again in the memo of their own process, which forked workers inherit from the parent.
+        """
+        state = self.__dict__.copy()
+        state["_index_digests"] = None
+        return state
+
+    def prepare_for_pool(self) -> None:
+        """! @brief Load the git index digests before worker processes are forked.
+        @return {None} Function return value.
+        @details Called by `parallel.iter_ordered()` in the parent process; without it every worker would read the index on its first stat miss.
+        """
+        if self.worktree is not None:
+            load_git_index_digests(self.worktree)
+
+    @classmethod
+    def for_project(cls, project_base: Path, git_root: Path | None = None) -> "AnalysisCache":
+        """! @brief Build the cache of a project directory.
+        @param project_base Project root directory.
+        @param git_root Repository top-level directory (the configured `git-path`) probed when `project_base` itself has no `.git` entry.
+        @return AnalysisCache rooted at `<project_base>/.req/cache`; in a git repository its objects live in `<common git dir>/usereq-cache` and the git index
+        supplies digests.
+        @satisfies SRS-396
+        """
+        root = Path(project_base) / ".req" / CACHE_DIR_NAME
+        common_dir = find_git_common_dir(Path(project_base))
+        if common_dir is None and git_root is not None:
+            common_dir = find_git_common_dir(Path(git_root))
+        if common_dir is None:
+            return cls(root)
+        return cls(root, objects_root=common_dir / SHARED_CACHE_DIR_NAME, worktree=project_base)
+
+    @property
+    def namespace_dir(self) -> Path:
+        """! @brief Directory holding entries for the active fingerprint.
+        @return `<root>/<fingerprint[:16]>` path.
+        """
+        return self.root / self.fingerprint[:16]
+
+    @property
+    def objects_dir(self) -> Path:
+        """! @brief Directory holding payload objects for the active fingerprint.
+        @return `<objects_root>/<fingerprint[:16]>/objects` path.
+        """
+        return self.objects_root / self.fingerprint[:16] / "objects"
+
+    def _stat_entry_path(self, path: str) -> Path:
+        """! @brief Resolve the stat-index entry location of one source path.
+        @param path Source file path.
+        @return Entry file path keyed by the SHA-1 of the absolute source path.
+        """
+        key = hashlib.sha1(os.path.abspath(path).encode("utf-8", "surrogateescape")).hexdigest()
+        return self.namespace_dir / "paths" / key[:2] / key[2:]
+
+    def _object_path(self, digest: str, kind: str) -> Path:
+        """! @brief Resolve the payload location of one digest/kind pair.
+        @param digest Content digest.
+        @param kind Payload kind identifier (e.g. `analysis.python`).
+        @return Entry file path.
+        """
+        return self.objects_dir / digest[:2] / f"{digest[2:]}.{kind}"
+
+    def _ensure_root(self) -> None:
+        """! @brief Create the cache root with a catch-all `.gitignore`.
+        @return {None} Function return value.
+        @details Keeps cache entries out of project commits without touching the project `.gitignore`.
+        """
+        gitignore = self.root / ".gitignore"
+        if not gitignore.exists():
+            self.root.mkdir(parents=True, exist_ok=True)
+            gitignore.write_text("*\n", encoding="utf-8")
+
+    def index_digest(self, path: str, st: os.stat_result) -> str | None:
+        """! @brief Return the git index blob id of a file unmodified since it was staged.
+        @param path Source file path.
+        @param st Current stat result of `path`.
+        @return Blob id, or None when no worktree is bound, the file is untracked or modified, or it changed after the index was read.
+        @details The digests come from `load_git_index_digests()` on first use by this instance. Memoized mappings outlive the files they describe, so an entry is
+        trusted only while the file's mtime and ctime precede the read time by more than `INDEX_GRACE_NS`; ctime also covers files replaced by rename.
+        """
+        if self.worktree is None:
+            return None
+        if self._index_digests is None:
+            self._index_read_ns, self._index_digests = load_git_index_digests(self.worktree)
+        if max(st.st_mtime_ns, st.st_ctime_ns) + INDEX_GRACE_NS >= self._index_read_ns:
+            return None
+        return self._index_digests.get(os.path.abspath(path))
+
+    def resolve(
+        self, path: str, source: SourceBuffer | None = None, stream_threshold: int | None = None
+    ) -> tuple[str | None, SourceBuffer | None]:
+        """! @brief Resolve the content digest of a file, reading it only on stat change.
+        @param path Source file path.
+        @param source Optional already loaded buffer of `path`.
+        @param stream_threshold Optional size from which a file is hashed in blocks instead of being loaded into a SourceBuffer.
+        @return Tuple `(digest, buffer)`; `buffer` is the loaded SourceBuffer when the file had to be read (or was supplied), else None; `digest` is None when the
+        file cannot be read.
+        @details A stored `(size, mtime_ns)` signature is trusted when it matches; otherwise the git index blob id of an unmodified tracked file is used, and
+        only untracked or modified files are read into a SourceBuffer and hashed. Either digest refreshes the stat index. Signatures within `RACY_WINDOW_NS` of
+        the current time are not recorded, so same-tick rewrites are always re-hashed.
+        @satisfies SRS-376, SRS-396, SRS-398
+        """
+        try:
+            st = os.stat(path)
+        except OSError:
+            return None, source
+        memory_key = (self.namespace_dir, "stat", os.path.abspath(path))
+        if _MEMORY is not None:
+            remembered = _MEMORY.get(memory_key)
+            if remembered is not None and remembered[0] == st.st_size and remembered[1] == st.st_mtime_ns:
+                profiling.count("cache.stat_hits")
+                return remembered[2], source
+        entry_path = self._stat_entry_path(path)
+        try:
+            size_text, mtime_text, digest = entry_path.read_text(encoding="ascii").split()
+            if int(size_text) == st.st_size and int(mtime_text) == st.st_mtime_ns:
+                profiling.count("cache.stat_hits")
+                _remember(memory_key, (st.st_size, st.st_mtime_ns, digest))
+                return digest, source
+        except (OSError, ValueError):
+            pass
+        digest = self.index_digest(path, st) if source is None else None
+        if digest is not None:
+            profiling.count("cache.index_hits")
+        else:
+            profiling.count("cache.rehashes")
+            if source is None and stream_threshold is not None and st.st_size >= stream_threshold:
+                try:
+                    digest = file_blob_digest(path, st.st_size)
+                except OSError:
+                    return None, None
+            else:
+                if source is None:
+                    try:
+                        source = SourceBuffer.from_path(path)
+                    except OSError:
+                        return None, None
+                digest = source.digest
+        if time.time_ns() - st.st_mtime_ns > RACY_WINDOW_NS:
+            _remember(memory_key, (st.st_size, st.st_mtime_ns, digest))
+            try:
+                self._ensure_root()
+                _atomic_write_bytes(
+                    entry_path,
+                    f"{st.st_size} {st.st_mtime_ns} {digest}\n".encode("ascii"),
+                )
+            except OSError:
+                pass
+        return digest, source
+
+    def digest_for(self, path: str) -> str | None:
+        """! @brief Return the content digest of a file, hashing only on stat change.
+        @param path Source file path.
+        @return Git blob digest, or None when the file cannot be read.
+        """
+        return self.resolve(path)[0]
+
+    def load(self, digest: str, kind: str) -> Any | None:
+        """! @brief Load a cached payload.
+        @param digest Content digest.
+        @param kind Payload kind identifier.
+        @return Unpickled payload, or None on miss or unreadable entry.
+        """
+        memory_key = (self.objects_dir, digest, kind)
+        if _MEMORY is not None:
+            payload = _MEMORY.get(memory_key)
+            if payload is not None:
+                profiling.count("cache.hits")
+                return payload
+        try:
+            with open(self._object_path(digest, kind), "rb") as handle:
+                payload = pickle.load(handle)
+        except Exception:
+            profiling.count("cache.misses")
+            return None
+        profiling.count("cache.hits")
+        _remember(memory_key, payload)
+        return payload
+
+    def store(self, digest: str, kind: str, payload: Any) -> None:
+        """! @brief Persist a payload for a digest/kind pair.
+        @param digest Content digest.
+        @param kind Payload kind identifier.
+        @param payload Picklable payload.
+        @return {None} Function return value.
+        """
+        _remember((self.objects_dir, digest, kind), payload)
+        try:
+            self._ensure_root()
+            _atomic_write_bytes(
+                self._object_path(digest, kind),
+                pickle.dumps(payload, protocol=pickle.HIGHEST_PROTOCOL),
+            )
+        except Exception:
+            pass
+
+    def get_or_compute(
+        self,
+        path: str,
+        kind: str,
+        compute: Callable[[SourceBuffer | None], Any],
+        source: SourceBuffer | None = None,
+        stream_threshold: int | None = None,
+    ) -> Any:
+        """! @brief Return the cached payload of a file or compute and store it.
+        @param path Source file path.
+        @param kind Payload kind identifier.
+        @param compute Callable producing the payload from the file SourceBuffer on miss.
+        @param source Optional already loaded buffer of `path`.
+        @param stream_threshold Optional size from which the file is never loaded whole: it is hashed in blocks and `compute` receives None.
+        @return Cached or freshly computed payload.
+        @details The file is read at most once per call: the buffer loaded for hashing is handed to `compute`. Exceptions raised by `compute` propagate unchanged
+        and nothing is stored.
+        """
+        digest, source = self.resolve(path, source, stream_threshold)
+        if digest is not None:
+            payload = self.load(digest, kind)
+            if payload is not None:
+                return payload
+        if source is None and (stream_threshold is None or os.path.getsize(path) < stream_threshold):
+            source = SourceBuffer.from_path(path)
+        payload = compute(source)
+        if digest is not None:
+            self.store(digest, kind, payload)
+        return payload
+
+
+def analyze_file(
+    analyzer, fpath: str, lang: str, source: SourceBuffer | None = None, stream_threshold: int | None = None
+) -> tuple[list, int]:
+    """! @brief Run `analyze()` and `enrich()` on one file and count its lines.
+    @param analyzer SourceAnalyzer instance.
+    @param fpath Source file path.
+    @param lang Canonical language identifier.
+    @param source Optional already loaded buffer of `fpath`.
+    @param stream_threshold Optional size from which a brace-language file without `source` is analyzed by `analyze_stream()`.
+    @return Tuple `(enriched_elements, total_lines)`.
+    @details Shared payload producer for the `analysis.<lang>` cache kind used by markdown generation and construct extraction. The file is read once and the
+    buffer is shared by analysis, enrichment, and line counting. Streamed files produce the same elements without ever holding the file text.
+    @satisfies SRS-398
+    """
+    if (source is None and stream_threshold is not None and lang in BRACE_LANGUAGES
+            and os.path.getsize(fpath) >= stream_threshold):
+        with profiling.span("analyze"):
+            elements, total_lines = analyzer.analyze_stream(fpath, lang)
+        with profiling.span("enrich"):
+            analyzer.enrich(elements, lang, filepath=fpath, annotate_bodies=False)
+        profiling.count("analyze.streamed_files")
+    else:
+        if source is None:
+            source = SourceBuffer.from_path(fpath)
+        with profiling.span("analyze"):
+            elements = analyzer.analyze(fpath, lang, source=source)
+        with profiling.span("enrich"):
+            analyzer.enrich(elements, lang, filepath=fpath, source=source)
+        total_lines = source.line_count
+    if profiling.active() is not None:
+        profiling.count("analyze.files")
+        profiling.count("analyze.lines", total_lines)
+        for element in elements:
+            profiling.count(f"elements.{element.element_type.name}")
+    return elements, total_lines
+
+
+def load_analysis(
+    analyzer,
+    fpath: str,
+    lang: str,
+    cache: "AnalysisCache | None",
+    source: SourceBuffer | None = None,
+    stream_threshold: int | None = STREAM_THRESHOLD_BYTES,
+) -> tuple[list, int]:
+    """! @brief Return enriched elements and line count, through the cache when enabled.
+    @param analyzer SourceAnalyzer instance.
+    @param fpath Source file path.
+    @param lang Canonical language identifier.
+    @param cache Optional AnalysisCache.
+    @param source Optional already loaded buffer of `fpath`.
+    @param stream_threshold Size from which brace-language files are streamed instead of loaded (None disables streaming).
+    @return Tuple `(enriched_elements, total_lines)`.
+    """
+    if source is not None or lang not in BRACE_LANGUAGES:
+        stream_threshold = None
+    if cache is None:
+        return analyze_file(analyzer, fpath, lang, source, stream_threshold)
+    return cache.get_or_compute(
+        fpath,
+        f"analysis.{lang}",
+        lambda buffer: analyze_file(analyzer, fpath, lang, buffer, stream_threshold),
+        source,
+        stream_threshold,
+    )
@@ -0,0 +1,166 @@
+"""!
+@file batch.py
+@brief Multi-project batch mode: project scans of many repositories in one process.
+@details A batch resolves every project up front, then feeds the per-file work items of all projects, in project order, to one ordered worker pool. Each
+item carries the worker of its own project (output base, analysis cache, format), so workers move on to the next project while the parent is still writing
+the output file of the current one. `ProjectOutcomes` hands each project exactly its own slice of the shared result stream and accumulates its counters, and
+`format_report()` renders the per-project timing summary printed at the end of the batch.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import itertools
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Callable, Iterator, Optional, Sequence
+
+from .parallel import STATUS_FAIL, STATUS_OK, FileOutcome, iter_ordered
+
+BATCH_COMMANDS = ("references", "static-check")
+"""! @brief Project-scan commands accepted by `--batch`."""
+
+BATCH_OUTPUT_SUFFIXES = {
+    ("references", "markdown"): "references.md",
+    ("references", "jsonl"): "references.jsonl",
+    ("static-check", "markdown"): "static-check.txt",
+}
+"""! @brief Per-project output file name by `(command, format)`."""
+
+
+@dataclass
+class BatchProject:
+    """! @brief One project of a batch run and its accumulated results.
+    @details `error` holds the message of a project that could not be resolved or produced no output; such projects are reported and skipped without
+    stopping the batch.
+    """
+
+    base: Path
+    output: Path
+    files: list = field(default_factory=list)
+    worker: Optional[Callable[[str], FileOutcome]] = None
+    error: Optional[str] = None
+    code: int = 0
+    ok: int = 0
+    failed: int = 0
+    worker_seconds: float = 0.0
+    finished_seconds: float = 0.0
+
+
+def run_item(item: tuple) -> tuple:
+    """! @brief Pool entry point of one batch work item.
+    @param item Tuple `(path, worker)` pairing a file with the worker of its project.
+    @return Tuple `(outcome, seconds)`: the worker outcome and the worker wall time.
+    """
+    path, worker = item
+    start = time.perf_counter()
+    outcome = worker(path)
+    return outcome, time.perf_counter() - start
+
+
+def schedule(projects: Sequence[BatchProject], jobs: Optional[int]) -> Iterator[tuple]:
+    """! @brief Start the shared ordered pool over the files of every resolved project.
+    @param projects Batch projects in output order.
+    @param jobs Worker process count shared by all projects (`None` selects the CPU core count).
+    @return Iterator of `run_item()` results, ordered by project and then by file.
+    """
+    items = [(path, project.worker) for project in projects if project.error is None for path in project.files]
+    return iter_ordered(run_item, items, jobs)
+
+
+class ProjectOutcomes:
+    """! @brief Iterator over the outcomes of one project taken from the shared batch stream.
+    @details Yields exactly `len(project.files)` outcomes and records their status counts and worker time on the project. `drain()` consumes whatever
+    the project's consumer left unread (e.g. after an output error), so the next project starts at its own first file.
+    """
+
+    def __init__(self, project: BatchProject, shared: Iterator[tuple]):
+        """! @brief Bind a project to the shared result stream.
+        @param project Project whose files come next in `shared`.
+        @param shared Iterator returned by `schedule()`.
+        @return {None} Function return value.
+        """
+        self.project = project
+        self._results = itertools.islice(shared, len(project.files))
+
+    def __iter__(self) -> "ProjectOutcomes":
+        """! @brief Return the iterator itself.
+        @return This instance.
+        """
+        return self
+
+    def __next__(self) -> FileOutcome:
+        """! @brief Return the next outcome of the project.
+        @return Next `FileOutcome`.
+        @throws StopIteration After the last file of the project.
+        """
+        outcome, seconds = next(self._results)
+        self.project.worker_seconds += seconds
+        if outcome.status == STATUS_OK:
+            self.project.ok += 1
+        elif outcome.status == STATUS_FAIL:
+            self.project.failed += 1
+        return outcome
+
+    def drain(self) -> None:
+        """! @brief Consume the outcomes not read by the project's consumer.
+        @return {None} Function return value.
+        """
+        for _ in self:
+            pass
+
+
+def output_paths(bases: Sequence[Path], output_dir: Optional[Path], file_name: str) -> list:
+    """! @brief Choose the output file of every project.
+    @param bases Resolved project roots in batch order.
+    @param output_dir Shared output directory, or None to write below each project's `.req/cache/`.
+    @param file_name Output file name from `BATCH_OUTPUT_SUFFIXES`.
+    @return Output paths in batch order; in a shared directory names are `<project dir name>.<file_name>`, with the lowest free `-2`, `-3`, ... suffix
+    appended to a name already assigned, so a suffixed name never collides with another project's own name.
+    """
+    if output_dir is None:
+        return [base / ".req" / "cache" / file_name for base in bases]
+    assigned: set = set()
+    paths = []
+    for base in bases:
+        name = base.name or "project"
+        stem, suffix = name, 1
+        while stem in assigned:
+            suffix += 1
+            stem = f"{name}-{suffix}"
+        assigned.add(stem)
+        paths.append(output_dir / f"{stem}.{file_name}")
+    return paths
+
+
+def format_report(projects: Sequence[BatchProject], total_seconds: float) -> str:
+    """! @brief Render the per-project timing summary of a batch.
+    @param projects Batch projects in batch order.
+    @param total_seconds Wall time of the whole batch.
+    @return One line per project followed by one total line. Pooled projects report file count, ok/failed counts, and summed worker time; projects run
+    without a per-file worker (static checks) report their exit code and wall time. Every line ends with the time from batch start until the project's
+    output was complete and its destination or error.
+    """
+    width = max([len(str(project.base)) for project in projects] + [7])
+    lines = []
+    for project in projects:
+        head = f"batch: {str(project.base):<{width}}"
+        if project.error is not None and not project.files and project.worker_seconds == 0:
+            lines.append(f"{head}  ERROR  {project.error}")
+            continue
+        if project.worker is None:
+            line = f"{head}  exit={project.code}  time={project.worker_seconds * 1000:>9.0f} ms"
+        else:
+            line = (
+                f"{head}  {len(project.files):>6} files  {project.ok:>6} ok  {project.failed:>4} failed"
+                f"  worker={project.worker_seconds * 1000:>9.0f} ms"
+            )
+        line += f"  done_at={project.finished_seconds * 1000:>9.0f} ms"
+        line += f"  ERROR  {project.error}" if project.error is not None else f"  -> {project.output}"
+        lines.append(line)
+    summary = f"batch: {len(projects)} projects"
+    if any(project.worker is not None for project in projects):
+        summary += f", {sum(len(project.files) for project in projects)} files"
+    errors = sum(1 for project in projects if project.error is not None)
+    lines.append(f"{summary}, {errors} with errors in {total_seconds * 1000:.0f} ms")
+    return "\n".join(lines)
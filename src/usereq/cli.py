@@ -10,22 +10,17 @@ from __future__ import annotations
 
 import argparse
 from datetime import datetime, timezone
-from email.utils import parsedate_to_datetime
 import json
 import os
-import platform
 import re
 import shutil
 import sys
 import subprocess
 import textwrap
 import time
-import urllib.error
-import urllib.request
-import yaml
 from argparse import Namespace
 from pathlib import Path
-from typing import Any, Mapping, Optional, Sequence
+from typing import Any, Iterator, Mapping, Optional, Sequence
 
 REPO_ROOT = Path(__file__).resolve().parents[2]
 """! @brief The absolute path to the repository root."""
@@ -317,6 +312,16 @@ GITHUB_UPGRADE_SOURCE = (
 FORCE_ONLINE_RELEASE_CHECK = False
 """! @brief Startup-scoped override that bypasses release-check idle-state gating when enabled."""
 
+RELEASE_CHECK_WORKER_CODE = (
+    "import os, sys\n"
+    "root = sys.argv[1]\n"
+    "if root not in {os.path.realpath(entry) for entry in sys.path}:\n"
+    "    sys.path.insert(0, root)\n"
+    "from usereq.cli import run_release_check\n"
+    "run_release_check(force=True)\n"
+)
+"""! @brief Python source run by the detached background release-check process; `sys.argv[1]` is the directory holding the parent's `usereq` package."""
+
 
 class ReqError(Exception):
     """! @brief Dedicated exception for expected CLI errors.
@@ -395,7 +400,7 @@ def build_parser() -> argparse.ArgumentParser:
         "[--provider PROVIDER:ARTIFACT_ITEM[,ARTIFACT_ITEM...][:PROVIDER_OPTIONS]] "
         "[--preserve-models] [--add-guidelines | --upgrade-guidelines] "
         "[--files-tokens FILE ...] [--files-references FILE ...] [--files-compress FILE ...] [--files-find TAG PATTERN FILE ...] "
-        "[--references] [--compress] [--find TAG PATTERN] [--enable-line-numbers] [--tokens] "
+        "[--references] [--compress] [--find TAG PATTERN] [--enable-line-numbers] [--jobs N] [--no-cache] [--incremental] [--output FILE] [--static-check-batch] [--token-budget N] [--dedup] [--format {markdown,jsonl}] [--stream-threshold BYTES] [--batch PROJECT [PROJECT ...]] [--batch-output-dir DIR] [--profile] [--profile-format {table,json}] [--serve] [--serve-stop] [--no-server] [--watch] [--tokens] "
         "[--test-static-check {dummy,pylance,ruff,command} [FILES...]] "
         "[--git-check] [--docs-check] [--git-wt-name] [--git-wt-create WT_NAME] [--git-wt-delete WT_NAME] [--git-path] [--get-base-path] "
         f"({version})"
@@ -540,6 +545,122 @@ def build_parser() -> argparse.ArgumentParser:
         default=False,
         help="Enable line number prefixes (<n>:) in output for --files-compress, --compress, --files-find, and --find (disabled by default).",
     )
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        metavar="N",
+        default=None,
+        help="Worker process count for --files-references, --references, --files-compress, --compress, --files-find, and --find, and concurrent tool invocation count for --files-static-check and --static-check (default: CPU core count; 1 disables the worker pool).",
+    )
+    parser.add_argument(
+        "--no-cache",
+        action="store_true",
+        default=False,
+        dest="no_cache",
+        help="Disable the persistent .req/cache analysis cache, symbol index, and token counts for --references, --compress, --find, --tokens, --files-find, and --files-tokens (the --files-* commands use them only when the working directory contains .req/), and the static-check verdict cache of --static-check and --files-static-check.",
+    )
+    parser.add_argument(
+        "--incremental",
+        action="store_true",
+        default=False,
+        help="For --references, re-render only files changed since the previous --incremental run (git diff/status) and splice cached sections for the rest.",
+    )
+    parser.add_argument(
+        "--output",
+        metavar="FILE",
+        default=None,
+        help="Stream --files-references, --references, --files-compress, --compress, --files-find, and --find output to FILE instead of stdout.",
+    )
+    parser.add_argument(
+        "--static-check-batch",
+        action="store_true",
+        default=False,
+        dest="static_check_batch",
+        help="For --files-static-check and --static-check, run Pylance, Ruff, and multi-path Command tools (cppcheck, clang-tidy, shellcheck) once per file group; failing groups are rechecked per file.",
+    )
+    parser.add_argument(
+        "--token-budget",
+        type=int,
+        metavar="N",
+        default=None,
+        dest="token_budget",
+        help="For --references and --compress, emit at most N tokens: files dirty in git first, then files named in REQUIREMENTS.md, then the rest, each as full section, signatures only, or tree only, whichever still fits.",
+    )
+    parser.add_argument(
+        "--dedup",
+        action="store_true",
+        default=False,
+        help="For --files-compress and --compress, replace runs of compressed lines already emitted for an earlier file (license banners, include blocks, generated preambles) with a [same as PATH:START-END] back-reference.",
+    )
+    parser.add_argument(
+        "--format",
+        choices=("markdown", "jsonl"),
+        default="markdown",
+        dest="output_format",
+        help="Output format of --files-references, --references, --files-compress, --compress, --files-find, and --find: markdown sections (default) or JSON Lines with one record per file and per construct.",
+    )
+    parser.add_argument(
+        "--stream-threshold",
+        type=int,
+        metavar="BYTES",
+        default=None,
+        dest="stream_threshold",
+        help="For --files-references, --references, and --watch, analyze C, C++, and other brace-language files of at least BYTES bytes in bounded-memory streaming mode instead of loading them whole (default: 67108864; 0 streams every such file).",
+    )
+    parser.add_argument(
+        "--batch",
+        nargs="+",
+        type=Path,
+        metavar="PROJECT",
+        default=None,
+        help="Run --references or --static-check for every PROJECT directory in one process, each resolved from its own .req/config.json; --references schedules the files of all projects on one shared --jobs worker pool. Each project gets its own output file and a per-project timing summary is printed on stderr.",
+    )
+    parser.add_argument(
+        "--batch-output-dir",
+        metavar="DIR",
+        default=None,
+        dest="batch_output_dir",
+        help="For --batch, write the per-project output files to DIR as <project>.references.md (.jsonl with --format jsonl) or <project>.static-check.txt instead of each project's .req/cache/ directory.",
+    )
+    parser.add_argument(
+        "--profile",
+        action="store_true",
+        default=False,
+        help="Report per-phase timings, counters (bytes read, lines, elements per type, regex attempts, cache hits/misses, subprocesses), and the slowest files on stderr when the command finishes.",
+    )
+    parser.add_argument(
+        "--profile-format",
+        choices=("table", "json"),
+        default="table",
+        dest="profile_format",
+        help="Render the --profile report as an aligned table (default) or as JSON.",
+    )
+    parser.add_argument(
+        "--serve",
+        action="store_true",
+        default=False,
+        help="Run a resident server for the current directory that keeps modules, the tokenizer, the source file list, and analysis results loaded; later --references, --compress, --find, --tokens, and --files-* calls from this directory are forwarded to it. Exits after 30 minutes without requests.",
+    )
+    parser.add_argument(
+        "--serve-stop",
+        action="store_true",
+        default=False,
+        dest="serve_stop",
+        help="Stop the --serve server of the current directory.",
+    )
+    parser.add_argument(
+        "--no-server",
+        action="store_true",
+        default=False,
+        dest="no_server",
+        help="Run the command in this process even when a --serve server is running.",
+    )
+    parser.add_argument(
+        "--watch",
+        action="store_true",
+        default=False,
+        help="Watch the configured src-dir paths (inotify, polling fallback) and keep .req/cache/references.md (or --output FILE) and the --find symbol index current, re-rendering only changed files (here-only project scan; --here implied; --base forbidden).",
+    )
     parser.add_argument(
         "--tokens",
         action="store_true",
@@ -726,6 +847,8 @@ def run_upgrade() -> None:
         "--from",
         GITHUB_UPGRADE_SOURCE,
     ]
+    import platform
+
     detected_system = platform.system() or "Unknown"
     if detected_system != "Linux":
         print(
@@ -758,6 +881,8 @@ def run_uninstall() -> None:
         "uninstall",
         TOOL_PROGRAM_NAME,
     ]
+    import platform
+
     detected_system = platform.system() or "Unknown"
     if detected_system != "Linux":
         print(
@@ -1014,7 +1139,7 @@ def read_release_check_idle_state(file_path: Path) -> dict[str, int | str] | Non
         @throws OSError If file read fails.
         @throws json.JSONDecodeError If file content is not valid JSON.
         @throws ValueError If required keys are missing or value types are invalid.
-    @details Validates required keys `last_success_timestamp`, `last_success_human_readable_timestamp`, `idle_until_timestamp`, and `idle_until_human_readable_timestamp`; timestamps are normalized to integers.
+    @details Validates required keys `last_success_timestamp`, `last_success_human_readable_timestamp`, `idle_until_timestamp`, and `idle_until_human_readable_timestamp`; timestamps are normalized to integers. The optional `latest_version` key cached by the last successful check and the optional `notified_version` key recording the last version announced from that cache are kept when they are non-empty strings.
     """
     if not file_path.exists():
         return None
@@ -1059,7 +1184,7 @@ def read_release_check_idle_state(file_path: Path) -> dict[str, int | str] | Non
             "idle-state key 'idle_until_human_readable_timestamp' must be a non-empty string"
         )
 
-    return {
+    state: dict[str, int | str] = {
         "last_success_timestamp": int(last_success_timestamp),
         "last_success_human_readable_timestamp": (
             last_success_human_readable_timestamp.strip()
@@ -1069,6 +1194,11 @@ def read_release_check_idle_state(file_path: Path) -> dict[str, int | str] | Non
             idle_until_human_readable_timestamp.strip()
         ),
     }
+    for optional_key in ("latest_version", "notified_version"):
+        optional_value = payload.get(optional_key)
+        if isinstance(optional_value, str) and optional_value.strip():
+            state[optional_key] = optional_value.strip()
+    return state
 
 
 def should_execute_release_check(
@@ -1113,6 +1243,8 @@ def parse_retry_after_seconds(
     if re.fullmatch(r"[0-9]+", raw_value):
         return max(0, int(raw_value))
 
+    from email.utils import parsedate_to_datetime
+
     try:
         parsed_datetime = parsedate_to_datetime(raw_value)
     except (TypeError, ValueError):
@@ -1128,14 +1260,19 @@ def write_release_check_idle_state_payload(
     file_path: Path,
     last_success_timestamp: int,
     idle_until_timestamp: int,
+    latest_version: str | None = None,
+    notified_version: str | None = None,
 ) -> None:
     """!
     @brief Persist canonical release-check idle-state payload to disk.
         @param file_path Absolute idle-state JSON path.
         @param last_success_timestamp Unix timestamp of the last successful release-check.
         @param idle_until_timestamp Unix timestamp until startup release-check remains disabled.
+        @param latest_version Latest released version to cache for startup notices, or None.
+        @param notified_version Cached version already announced by a startup notice, or None.
         @throws OSError If file write fails.
-    @details Serializes both numeric and UTC human-readable timestamps for the success instant and the idle-until instant.
+    @details Serializes both numeric and UTC human-readable timestamps for the success instant and the idle-until instant. The file is replaced atomically so
+    a concurrent reader never sees a partial payload written by the background check.
     """
     payload = {
         "last_success_timestamp": last_success_timestamp,
@@ -1147,25 +1284,34 @@ def write_release_check_idle_state_payload(
             idle_until_timestamp
         ),
     }
+    if latest_version:
+        payload["latest_version"] = latest_version
+    if notified_version:
+        payload["notified_version"] = notified_version
     file_path.parent.mkdir(parents=True, exist_ok=True)
-    file_path.write_text(
+    temp_path = file_path.with_name(f"{file_path.name}.{os.getpid()}.tmp")
+    temp_path.write_text(
         f"{json.dumps(payload, indent=2, sort_keys=True)}\n",
         encoding="utf-8",
     )
+    os.replace(temp_path, file_path)
 
 
 def write_release_check_idle_state(
     file_path: Path,
     now_timestamp: int,
     idle_delay_seconds: int = RELEASE_CHECK_IDLE_DELAY_SECONDS,
+    latest_version: str | None = None,
 ) -> None:
     """!
     @brief Persist release-check idle-state after a successful remote check.
         @param file_path Absolute idle-state JSON path.
         @param now_timestamp Successful check timestamp in seconds.
         @param idle_delay_seconds Fixed idle-delay length in seconds.
+        @param latest_version Fetched latest released version, cached for later startup notices.
         @throws OSError If file write fails.
-    @details Computes `idle_until_timestamp = now_timestamp + idle_delay_seconds` and persists canonical idle-state keys.
+    @details Computes `idle_until_timestamp = now_timestamp + idle_delay_seconds` and persists canonical idle-state keys without `notified_version`, so the
+    next invocation announces the freshly cached version again.
     @satisfies SRS-349
     """
     idle_until_timestamp = now_timestamp + int(idle_delay_seconds)
@@ -1173,6 +1319,7 @@ def write_release_check_idle_state(
         file_path=file_path,
         last_success_timestamp=now_timestamp,
         idle_until_timestamp=idle_until_timestamp,
+        latest_version=latest_version,
     )
 
 
@@ -1189,22 +1336,32 @@ def write_failed_release_check_idle_state(
         @param idle_state Existing parsed idle-state payload or None.
         @param idle_delay_seconds Fixed failure idle-delay length in seconds.
         @throws OSError If file write fails.
-    @details Computes `idle_until_timestamp = now + idle_delay_seconds`, rewrites the canonical idle-state payload on every failure, and preserves the previous successful timestamp when available.
+    @details Computes `idle_until_timestamp = now + idle_delay_seconds`, rewrites the canonical idle-state payload on every failure, and preserves the previous successful timestamp, cached `latest_version`, and `notified_version` when available.
     @satisfies SRS-350, SRS-351
     """
     effective_idle_delay = max(0, int(idle_delay_seconds))
     idle_until_timestamp = now_timestamp + effective_idle_delay
 
     last_success_timestamp = now_timestamp
+    latest_version: str | None = None
+    notified_version: str | None = None
     if isinstance(idle_state, Mapping):
         current_last_success = idle_state.get("last_success_timestamp")
         if isinstance(current_last_success, (int, float)):
             last_success_timestamp = int(current_last_success)
+        cached_version = idle_state.get("latest_version")
+        if isinstance(cached_version, str):
+            latest_version = cached_version
+        announced_version = idle_state.get("notified_version")
+        if isinstance(announced_version, str):
+            notified_version = announced_version
 
     write_release_check_idle_state_payload(
         file_path=file_path,
         last_success_timestamp=last_success_timestamp,
         idle_until_timestamp=idle_until_timestamp,
+        latest_version=latest_version,
+        notified_version=notified_version,
     )
 
 
@@ -1238,16 +1395,125 @@ def persist_failed_release_check_idle_state(
         )
 
 
+def print_newer_version_notice(current_version: str, latest_version: str) -> None:
+    """!
+    @brief Print the bright-green update notice when a newer release exists.
+    @param current_version Installed package version.
+    @param latest_version Latest released version.
+    @return {None} Function return value.
+    @satisfies SRS-349
+    """
+    if is_newer_version(current_version, latest_version):
+        print(
+            (
+                f"{ANSI_BRIGHT_GREEN}New version available: "
+                f"installed {current_version}, latest {latest_version}."
+                f"{ANSI_RESET}"
+            ),
+            file=sys.stderr,
+        )
+
+
+def spawn_background_release_check() -> bool:
+    """!
+    @brief Start the online release-check in a detached process.
+    @return True when the process was started; False when it could not be spawned.
+    @details The child runs `run_release_check(force=True)` in its own session with all standard streams on the null device, so the invoking command never
+    waits for it and its diagnostics never interleave with command output. The directory holding the parent's `usereq` package is passed to the child,
+    which puts it in front of `sys.path` only when its default path lacks it (e.g. a source checkout); an installed package directory such as
+    site-packages is never moved ahead of the standard library.
+    @satisfies SRS-401
+    """
+    package_root = str(Path(__file__).resolve().parent.parent)
+    try:
+        subprocess.Popen(
+            [sys.executable, "-c", RELEASE_CHECK_WORKER_CODE, package_root],
+            stdin=subprocess.DEVNULL,
+            stdout=subprocess.DEVNULL,
+            stderr=subprocess.DEVNULL,
+            close_fds=True,
+            start_new_session=True,
+        )
+    except OSError:
+        return False
+    return True
+
+
 def maybe_notify_newer_version(
     timeout_seconds: float = RELEASE_CHECK_TIMEOUT_SECONDS,
+) -> None:
+    """!
+    @brief Print the cached update notice and refresh the release cache without blocking.
+        @param timeout_seconds Time to wait for the version check response when `FORCE_ONLINE_RELEASE_CHECK` is set.
+        @details With `FORCE_ONLINE_RELEASE_CHECK` (`--ver`/`--version`) runs `run_release_check(...)` synchronously. Otherwise reads the idle-state file,
+        prints the bright-green notice for the `latest_version` cached by an earlier check once per completed check (recording it as `notified_version`,
+        which the next successful check drops), and, when the idle window has expired, first renews the window for
+        `RELEASE_CHECK_IDLE_DELAY_SECONDS` (so concurrent invocations start a single check) and then starts `spawn_background_release_check()`; no network
+        request is made in this process.
+    @return {None} Function return value.
+    @satisfies SRS-345, SRS-348, SRS-401
+    """
+    if FORCE_ONLINE_RELEASE_CHECK:
+        run_release_check(timeout_seconds=timeout_seconds, force=True)
+        return
+
+    idle_state_path = get_release_check_idle_file_path()
+    now_timestamp = int(time.time())
+    idle_state: Mapping[str, Any] | None = None
+    try:
+        idle_state = read_release_check_idle_state(idle_state_path)
+    except (OSError, json.JSONDecodeError, ValueError) as exc:
+        print(
+            f"{ANSI_BRIGHT_RED}Release-check error: invalid idle-state ({exc}){ANSI_RESET}",
+            file=sys.stderr,
+        )
+    cached_version = idle_state.get("latest_version") if idle_state else None
+    if isinstance(cached_version, str) and cached_version != idle_state.get("notified_version"):
+        try:
+            current_version = load_package_version()
+            announce = is_newer_version(current_version, cached_version)
+        except (ReqError, ValueError):
+            announce = False
+        if announce:
+            print_newer_version_notice(current_version, cached_version)
+            idle_state = {**idle_state, "notified_version": cached_version}
+            try:
+                write_release_check_idle_state_payload(
+                    file_path=idle_state_path,
+                    last_success_timestamp=int(idle_state["last_success_timestamp"]),
+                    idle_until_timestamp=int(idle_state["idle_until_timestamp"]),
+                    latest_version=cached_version,
+                    notified_version=cached_version,
+                )
+            except OSError:
+                pass
+    if not should_execute_release_check(idle_state, now_timestamp):
+        return
+    try:
+        write_failed_release_check_idle_state(
+            file_path=idle_state_path,
+            now_timestamp=now_timestamp,
+            idle_state=idle_state,
+        )
+    except OSError:
+        return
+    spawn_background_release_check()
+
+
+def run_release_check(
+    timeout_seconds: float = RELEASE_CHECK_TIMEOUT_SECONDS,
+    force: bool = False,
 ) -> None:
     """!
     @brief Executes idle-gated online version check and prints bright colored status messages.
         @param timeout_seconds Time to wait for the version check response.
-        @details Reads idle-state from `$HOME/.cache/usereq/check_version_idle-time.json`, skips remote requests when idle window is active unless startup context enables `FORCE_ONLINE_RELEASE_CHECK`, resolves latest-release URL from hardcoded repository settings when due, compares versions, prints a bright-green update message only for newer versions, persists a 3600-second idle-delay after successful HTTP/JSON validation, prints bright-red diagnostics on every failure, rewrites idle-state JSON on every failure, uses an 86400-second idle-delay for `HTTPError`, `URLError`, and `TimeoutError`, and uses the default 3600-second idle-delay for other release-check failures.
+        @param force True to bypass idle-state gating (used by `--ver` and by the background worker, whose caller already renewed the idle window).
+        @details Reads idle-state from `$HOME/.cache/usereq/check_version_idle-time.json`, skips remote requests when idle window is active unless `force` or `FORCE_ONLINE_RELEASE_CHECK` is set, resolves latest-release URL from hardcoded repository settings when due, compares versions, prints a bright-green update message only for newer versions, persists a 3600-second idle-delay and the fetched `latest_version` after successful HTTP/JSON validation (dropping `notified_version`, so the cached notice is shown again once per completed check), prints bright-red diagnostics on every failure, rewrites idle-state JSON on every failure, uses an 86400-second idle-delay for `HTTPError`, `URLError`, and `TimeoutError`, and uses the default 3600-second idle-delay for other release-check failures.
     @return {None} Function return value.
-    @satisfies SRS-345, SRS-348, SRS-349, SRS-350, SRS-351
+    @satisfies SRS-345, SRS-348, SRS-349, SRS-350, SRS-351, SRS-401
     """
+    import urllib.error
+    import urllib.request
 
     current_version = load_package_version()
     idle_state_path = get_release_check_idle_file_path()
@@ -1266,7 +1532,7 @@ def maybe_notify_newer_version(
             now_timestamp=now_timestamp,
             idle_state=idle_state,
         )
-    if not FORCE_ONLINE_RELEASE_CHECK and not should_execute_release_check(
+    if not force and not FORCE_ONLINE_RELEASE_CHECK and not should_execute_release_check(
         idle_state,
         now_timestamp,
     ):
@@ -1316,17 +1582,13 @@ def maybe_notify_newer_version(
             return
 
         latest_version = normalize_release_tag(tag)
-        if is_newer_version(current_version, latest_version):
-            print(
-                (
-                    f"{ANSI_BRIGHT_GREEN}New version available: "
-                    f"installed {current_version}, latest {latest_version}."
-                    f"{ANSI_RESET}"
-                ),
-                file=sys.stderr,
-            )
+        print_newer_version_notice(current_version, latest_version)
         try:
-            write_release_check_idle_state(idle_state_path, now_timestamp)
+            write_release_check_idle_state(
+                idle_state_path,
+                now_timestamp,
+                latest_version=latest_version,
+            )
         except OSError as exc:
             print(
                 f"{ANSI_BRIGHT_RED}Release-check error: idle-state write failure ({exc}){ANSI_RESET}",
@@ -2262,6 +2524,8 @@ def extract_skill_description(frontmatter: str) -> str:
     @param[in] frontmatter str -- YAML front matter text (without the leading/trailing `---` delimiters).
     @return str -- Single-line text of the usage field; empty string if absent.
     """
+    import yaml
+
     try:
         data = yaml.safe_load(frontmatter)
     except yaml.YAMLError:
@@ -4359,15 +4623,104 @@ SUPPORTED_EXTENSIONS = frozenset(
 )
 """File extensions considered during source directory scanning."""
 
+_SOURCE_FILES_MEMO: Optional[dict] = None
+"""`(project_base, src_dirs)` -> `(signature, files)` memo of `_collect_source_files()` kept by `--serve`; None disables it."""
+
+
+def _source_tree_signature(src_dirs: list[str], project_base: Path) -> Optional[tuple]:
+    """!
+    @brief Fingerprint the inputs of `git ls-files` for the configured source directories.
+    @details Collects the stat signatures of `.git/index`, `.git/info/exclude`, the root `.gitignore`, and every directory and `.gitignore` below the source
+    directories, so staging, checkout, file creation, deletion, rename, and ignore-rule edits all change the signature.
+    @param src_dirs Configured source directories.
+    @param project_base Project root directory.
+    @return Signature tuple, or None when the project root holds no `.git` directory (worktrees and nested projects are not memoized).
+    @satisfies SRS-393
+    """
+    git_dir = project_base / ".git"
+    if not git_dir.is_dir():
+        return None
+    entries: list = []
+    for path in (git_dir / "index", git_dir / "info" / "exclude", project_base / ".gitignore"):
+        try:
+            st = os.stat(path)
+            entries.append((str(path), st.st_size, st.st_mtime_ns))
+        except OSError:
+            entries.append((str(path), -1, -1))
+    for src_dir in src_dirs:
+        root = project_base / make_relative_if_contains_project(src_dir, project_base)
+        for dirpath, dirnames, filenames in os.walk(root):
+            dirnames[:] = sorted(name for name in dirnames if name != ".git")
+            try:
+                entries.append((dirpath, os.stat(dirpath).st_mtime_ns))
+                if ".gitignore" in filenames:
+                    st = os.stat(os.path.join(dirpath, ".gitignore"))
+                    entries.append((dirpath, st.st_size, st.st_mtime_ns))
+            except OSError:
+                entries.append((dirpath, -1))
+    return tuple(entries)
+
 
 def _collect_source_files(src_dirs: list[str], project_base: Path) -> list[str]:
     """!
     @brief Collect source files from git-indexed project paths.
-        @details Uses `git ls-files --cached --others --exclude-standard` in project root, filters by src-dir prefixes, applies EXCLUDED_DIRS filtering, and keeps only SUPPORTED_EXTENSIONS files.
+        @details Uses `git ls-files --cached --others --exclude-standard` in project root restricted to src-dir pathspecs (`_list_source_entries()`), applies EXCLUDED_DIRS filtering, and keeps only SUPPORTED_EXTENSIONS files. Under `--serve`, the result is reused while `_source_tree_signature()` is unchanged.
     @param src_dirs Input parameter `src_dirs`.
     @param project_base Input parameter `project_base`.
     @return {list[str]} Function return value.
     """
+    if _SOURCE_FILES_MEMO is not None:
+        key = (str(project_base), tuple(src_dirs))
+        signature = _source_tree_signature(src_dirs, project_base)
+        remembered = _SOURCE_FILES_MEMO.get(key)
+        if signature is not None and remembered is not None and remembered[0] == signature:
+            return list(remembered[1])
+        files = _list_source_files(src_dirs, project_base)
+        if signature is not None:
+            _SOURCE_FILES_MEMO[key] = (signature, tuple(files))
+        return files
+    return _list_source_files(src_dirs, project_base)
+
+
+def _source_pathspecs(normalized_src_dirs: list[str]) -> Optional[list[str]]:
+    """!
+    @brief Translate normalized source directories into `git ls-files` pathspecs.
+    @param normalized_src_dirs Project-relative POSIX source directories.
+    @return Empty list when a directory selects the whole project, literal directory pathspecs otherwise (plus `EXCLUDED_DIRS` exclusions), or None when no
+      directory can match a path inside the project (absolute paths outside it, `..` escapes).
+    @details A literal directory pathspec matches the directory entry itself and every path below it, the same set the former per-line prefix test accepted.
+    """
+    if any(src_dir in {"", "."} for src_dir in normalized_src_dirs):
+        specs: list[str] = []
+    else:
+        specs = [
+            f":(literal){src_dir}"
+            for src_dir in dict.fromkeys(normalized_src_dirs)
+            if not src_dir.startswith("/") and src_dir != ".." and not src_dir.startswith("../")
+        ]
+        if not specs:
+            return None
+    specs.extend(f":(exclude,glob)**/{name}/**" for name in sorted(EXCLUDED_DIRS))
+    return specs
+
+
+def _list_source_entries(src_dirs: list[str], project_base: Path) -> list[tuple[str, bool]]:
+    """!
+    @brief Enumerate project-relative source paths selected by the configured source directories.
+    @param src_dirs Configured source directories.
+    @param project_base Project root directory.
+    @return {list[tuple[str, bool]]} `(relative POSIX path, is_symlink)` pairs in `git ls-files` order, possibly with duplicates (unmerged index stages).
+    @throws ReqError If `git ls-files` fails.
+    @details Runs one `git ls-files --cached --others --exclude-standard --stage -z` restricted by `_source_pathspecs()`, so git itself drops paths outside the
+      source directories. NUL-separated output needs no unquoting. Extensions are matched with one suffix lookup in `SUPPORTED_EXTENSIONS`. Tracked symlinks
+      are recognized by their `120000` index mode and untracked ones by `os.path.islink()`; git reports neither through symlinked directories.
+    @satisfies SRS-397
+    """
+    normalized_src_dirs = [
+        Path(make_relative_if_contains_project(src_dir, project_base)).as_posix().strip("/")
+        for src_dir in src_dirs
+    ]
+    pathspecs = _source_pathspecs(normalized_src_dirs)
     cmd = [
         "git",
         "-C",
@@ -4376,48 +4729,93 @@ def _collect_source_files(src_dirs: list[str], project_base: Path) -> list[str]:
         "--cached",
         "--others",
         "--exclude-standard",
+        "--stage",
+        "-z",
     ]
+    if pathspecs:
+        cmd += ["--", *pathspecs]
+    from . import profiling
+
+    profiling.count("subprocesses.git")
     try:
-        output = subprocess.check_output(
-            cmd,
-            stderr=subprocess.PIPE,
-            text=True,
-        )
+        with profiling.span("collect_files"):
+            output = subprocess.check_output(
+                cmd,
+                stderr=subprocess.PIPE,
+            ).decode("utf-8", "surrogateescape")
     except subprocess.CalledProcessError:
         raise ReqError(
             "Error: failed to collect source files with `git ls-files` in project root.",
             1,
         )
+    if pathspecs is None:
+        return []
 
-    normalized_src_dirs: list[str] = []
-    for src_dir in src_dirs:
-        normalized = make_relative_if_contains_project(src_dir, project_base)
-        normalized = Path(normalized).as_posix().strip("/")
-        normalized_src_dirs.append(normalized)
-
-    collected: set[str] = set()
-    for rel_path in output.splitlines():
-        rel_posix = Path(rel_path.strip()).as_posix()
-        if rel_posix.startswith("./"):
-            rel_posix = rel_posix[2:]
-        if not rel_posix:
-            continue
-        if not any(
-            src_dir in {"", "."}
-            or rel_posix == src_dir
-            or rel_posix.startswith(f"{src_dir}/")
-            for src_dir in normalized_src_dirs
-        ):
+    base = str(project_base)
+    entries: list[tuple[str, bool]] = []
+    for record in output.split("\0"):
+        meta, tab, rel_path = record.partition("\t")
+        if tab and meta[:6].isdigit() and meta.count(" ") == 2:
+            is_link = meta.startswith("120000")
+        else:
+            rel_path = record
+            is_link = None
+        if rel_path.startswith("./"):
+            rel_path = rel_path[2:]
+        if not rel_path:
             continue
-        rel_obj = Path(rel_posix)
-        if any(part in EXCLUDED_DIRS for part in rel_obj.parts[:-1]):
+        name_start = rel_path.rfind("/") + 1
+        dot = rel_path.rfind(".", name_start)
+        if dot <= name_start or rel_path[dot:].lower() not in SUPPORTED_EXTENSIONS:
             continue
-        if rel_obj.suffix.lower() not in SUPPORTED_EXTENSIONS:
+        if EXCLUDED_DIRS and not EXCLUDED_DIRS.isdisjoint(rel_path.split("/")[:-1]):
             continue
-        collected.add(str((project_base / rel_obj).resolve()))
+        if is_link is None:
+            is_link = os.path.islink(os.path.join(base, rel_path))
+        entries.append((rel_path, is_link))
+    return entries
+
+
+def _list_source_files(src_dirs: list[str], project_base: Path) -> list[str]:
+    """!
+    @brief Map `_list_source_entries()` results to absolute paths for `_collect_source_files()`.
+    @param src_dirs Configured source directories.
+    @param project_base Project root directory.
+    @return {list[str]} Sorted absolute source file paths with symlinks resolved.
+    @throws ReqError If `git ls-files` fails.
+    @details The project root is resolved once and joined with each relative path; only symlink entries are resolved individually, so the result equals
+      resolving every path.
+    @satisfies SRS-397
+    """
+    base = os.path.realpath(project_base)
+    collected: set[str] = set()
+    for rel_path, is_link in _list_source_entries(src_dirs, project_base):
+        joined = os.path.join(base, rel_path) if os.sep == "/" else os.path.join(base, *rel_path.split("/"))
+        collected.add(str(Path(joined).resolve()) if is_link else joined)
     return sorted(collected)
 
 
+def _project_relative_paths(files: list[str], project_base: Path) -> list[Optional[str]]:
+    """!
+    @brief Convert collected absolute paths back to project-relative POSIX paths.
+    @param files Absolute paths returned by `_collect_source_files()`.
+    @param project_base Project root directory.
+    @return {list[Optional[str]]} Relative path per file, or None for files outside the project root (resolved symlink targets).
+    @details Strips the resolved project root prefix with string operations instead of per-file `Path.resolve()` / `relative_to()` calls.
+    @satisfies SRS-397
+    """
+    base = os.path.realpath(project_base)
+    prefix = base.rstrip(os.sep) + os.sep
+    relative: list[Optional[str]] = []
+    for path in files:
+        if path.startswith(prefix):
+            rel_path = path[len(prefix):]
+            relative.append(rel_path if os.sep == "/" else rel_path.replace(os.sep, "/"))
+        else:
+            relative.append(None)
+    return relative
+
+
 def _build_ascii_tree(paths: list[str]) -> str:
     """!
     @brief Build a deterministic tree string from project-relative paths.
@@ -4473,7 +4871,10 @@ def _format_files_structure_markdown(files: list[str], project_base: Path) -> st
     @details Implements the _format_files_structure_markdown function behavior with deterministic control flow.
     """
     rel_paths = [
-        Path(path).resolve().relative_to(project_base).as_posix() for path in files
+        rel_path
+        if rel_path is not None
+        else Path(path).resolve().relative_to(project_base).as_posix()
+        for path, rel_path in zip(files, _project_relative_paths(files, project_base))
     ]
     tree = _build_ascii_tree(rel_paths)
     return f"# Files Structure\n```\n{tree}\n```"
@@ -4498,6 +4899,32 @@ def _is_standalone_command(args: Namespace) -> bool:
     )
 
 
+FAST_PATH_COMMANDS = {
+    "--files-tokens": "files_tokens",
+    "--files-references": "files_references",
+    "--files-compress": "files_compress",
+    "--files-find": "files_find",
+}
+"""! @brief Standalone options dispatched without building the argparse tree, mapped to their namespace attribute."""
+
+
+def _fast_path_args(argv_list: list[str]) -> Namespace | None:
+    """!
+    @brief Build the namespace of a plain standalone command without `build_parser()`.
+    @param argv_list CLI arguments.
+    @return Namespace equivalent to `parse_args(argv_list)` when `argv_list` is one `FAST_PATH_COMMANDS` option followed only by operands; None otherwise.
+    @details Any other option, any operand starting with `-`, or a missing operand returns None so the full parser handles (and reports) the command;
+    attributes absent from the namespace fall back to the `getattr(args, ..., default)` defaults used by `_dispatch()`.
+    @satisfies SRS-402
+    """
+    if not argv_list or argv_list[0] not in FAST_PATH_COMMANDS:
+        return None
+    operands = argv_list[1:]
+    if not operands or any(operand.startswith("-") for operand in operands):
+        return None
+    return Namespace(**{FAST_PATH_COMMANDS[argv_list[0]]: operands})
+
+
 def _is_project_scan_command(args: Namespace) -> bool:
     """!
     @brief Check if the parsed args contain a project-scan command.
@@ -4505,7 +4932,7 @@ def _is_project_scan_command(args: Namespace) -> bool:
     @return True when any project-scan flag is present.
     @details Project-scan commands: `--references`, `--compress`, `--tokens`, `--find`,
       `--static-check`, `--git-check`, `--docs-check`, `--git-wt-name`, `--git-wt-create`,
-      `--git-wt-delete`, `--git-path`, and `--get-base-path`.
+      `--git-wt-delete`, `--git-path`, `--get-base-path`, and `--watch`.
     """
     return bool(
         getattr(args, "references", False)
@@ -4520,6 +4947,7 @@ def _is_project_scan_command(args: Namespace) -> bool:
         or getattr(args, "git_wt_delete", None)
         or getattr(args, "git_path_cmd", False)
         or getattr(args, "get_base_path_cmd", False)
+        or getattr(args, "watch", False)
     )
 
 
@@ -4530,7 +4958,7 @@ def _is_here_only_project_scan_command(args: Namespace) -> bool:
     @return True when command requires implicit `--here` and rejects `--base`.
     @details Includes `--references`, `--compress`, `--tokens`, `--find`, `--static-check`,
       `--git-check`, `--docs-check`, `--git-wt-name`, `--git-wt-create`, `--git-wt-delete`,
-      `--git-path`, and `--get-base-path`.
+      `--git-path`, `--get-base-path`, and `--watch`.
     @satisfies SRS-311, SRS-313, SRS-318, SRS-320, SRS-326, SRS-333
     """
     return bool(
@@ -4546,6 +4974,7 @@ def _is_here_only_project_scan_command(args: Namespace) -> bool:
         or getattr(args, "git_wt_delete", None)
         or getattr(args, "git_path_cmd", False)
         or getattr(args, "get_base_path_cmd", False)
+        or getattr(args, "watch", False)
     )
 
 
@@ -4763,11 +5192,20 @@ def run_git_wt_create(args: Namespace) -> None:
         raise ReqError("Error: git worktree add timed out.", 3)
     wt_base_dir = wt_dest / base_dir
     try:
-        # SRS-323: copy .req if not present in new worktree.
+        # SRS-323: copy .req if not present in new worktree; the analysis cache is
+        # per-worktree state whose shared objects live in the common git dir (SRS-396).
         wt_req = wt_base_dir / ".req"
         src_req = base_path / ".req"
         if src_req.is_dir() and not wt_req.is_dir():
-            shutil.copytree(str(src_req), str(wt_req))
+            from .analysis_cache import CACHE_DIR_NAME
+
+            shutil.copytree(
+                str(src_req),
+                str(wt_req),
+                ignore=lambda directory, names: (
+                    [CACHE_DIR_NAME] if Path(directory) == src_req else []
+                ),
+            )
         # SRS-324, SRS-325: copy active provider directories.
         providers_specs = full_cfg.get("providers", [])
         active_providers: set[str] = set()
@@ -4911,11 +5349,12 @@ def run_get_base_path(args: Namespace) -> None:
     print(str(full_cfg.get("base-path", "")))
 
 
-def run_files_tokens(files: list[str]) -> None:
+def run_files_tokens(files: list[str], cache=None) -> None:
     """!
     @brief Execute --files-tokens: count tokens for arbitrary files.
     @details Implements the run_files_tokens function behavior with deterministic control flow.
     @param files Input parameter `files`.
+    @param cache Optional `AnalysisCache` reusing counts of unchanged files.
     @return {None} Function return value.
     """
     from .token_counter import count_files_metrics, format_pack_summary
@@ -4930,55 +5369,139 @@ def run_files_tokens(files: list[str]) -> None:
     if not valid_files:
         raise ReqError("Error: no valid files provided.", 1)
 
-    results = count_files_metrics(valid_files)
+    results = count_files_metrics(valid_files, cache=cache)
     print(format_pack_summary(results))
 
 
-def run_files_references(files: list[str]) -> None:
+def _write_stream(
+    chunks: Iterator[str], output: str | None = None, header: str | None = None
+) -> None:
+    """!
+    @brief Stream command output fragments to stdout or to a file as they are produced.
+    @param chunks Output fragments in final order.
+    @param output Destination file path, or None for stdout.
+    @param header Optional text emitted before the first fragment, followed by a blank line.
+    @return {None} Function return value.
+    @throws ReqError If the output file cannot be written.
+    @details The first fragment is pulled before anything is written, so a generator that fails without output (e.g. `ValueError` for no processed files)
+    writes nothing and leaves no empty output file. The output ends with a newline, matching `print()`.
+    @satisfies SRS-382
+    """
+    from . import profiling
+
+    iterator = iter(chunks)
+    first = next(iterator, None)
+    if first is None:
+        return
+    try:
+        handle = open(output, "w", encoding="utf-8") if output else sys.stdout
+    except OSError as e:
+        raise ReqError(f"Error: cannot write output file {output}: {e}", 1)
+    try:
+        with profiling.span("write_output"):
+            if header is not None:
+                handle.write(header)
+                handle.write("\n\n")
+            handle.write(first)
+        for chunk in iterator:
+            with profiling.span("write_output"):
+                handle.write(chunk)
+        with profiling.span("write_output"):
+            handle.write("\n")
+            handle.flush()
+    finally:
+        if output:
+            handle.close()
+
+
+def run_files_references(
+    files: list[str],
+    jobs: int | None = None,
+    output: str | None = None,
+    stream_threshold: int | None = None,
+    output_format: str = "markdown",
+) -> None:
     """!
     @brief Execute --files-references: generate markdown for arbitrary files.
     @details Implements the run_files_references function behavior with deterministic control flow.
     @param files Input parameter `files`.
+    @param jobs Worker process count (`None` selects the CPU core count).
+    @param output Optional output file path (default: stdout).
+    @param stream_threshold Size from which brace-language files are streamed (`None` selects `STREAM_THRESHOLD_BYTES`).
+    @param output_format `markdown` sections or `jsonl` records.
     @return {None} Function return value.
     """
-    from .generate_markdown import generate_markdown
+    from .generate_markdown import iter_markdown_sections
+    from .source_analyzer import STREAM_THRESHOLD_BYTES
 
-    md = generate_markdown(
-        files,
-        verbose=VERBOSE,
-        output_base=Path.cwd().resolve(),
+    _write_stream(
+        iter_markdown_sections(
+            files,
+            verbose=VERBOSE,
+            output_base=Path.cwd().resolve(),
+            jobs=jobs,
+            stream_threshold=STREAM_THRESHOLD_BYTES if stream_threshold is None else stream_threshold,
+            output_format=output_format,
+        ),
+        output,
     )
-    print(md)
 
 
-def run_files_compress(files: list[str], enable_line_numbers: bool = False) -> None:
+def run_files_compress(
+    files: list[str],
+    enable_line_numbers: bool = False,
+    jobs: int | None = None,
+    output: str | None = None,
+    dedup: bool = False,
+    output_format: str = "markdown",
+) -> None:
     """!
     @brief Execute --files-compress: compress arbitrary files.
         @param files List of source file paths to compress.
         @param enable_line_numbers If True, emits <n>: prefixes in compressed entries.
+        @param jobs Worker process count (`None` selects the CPU core count).
+        @param output Optional output file path (default: stdout).
+        @param dedup If True, replaces runs repeated from an earlier file with back-references.
+        @param output_format `markdown` blocks or `jsonl` records.
         @details Renders output header paths relative to current working directory.
     @return {None} Function return value.
     """
-    from .compress_files import compress_files
+    from .compress_files import iter_compressed_sections
 
-    output = compress_files(
-        files,
-        include_line_numbers=enable_line_numbers,
-        verbose=VERBOSE,
-        output_base=Path.cwd().resolve(),
+    _write_stream(
+        iter_compressed_sections(
+            files,
+            include_line_numbers=enable_line_numbers,
+            verbose=VERBOSE,
+            output_base=Path.cwd().resolve(),
+            jobs=jobs,
+            dedup=dedup,
+            output_format=output_format,
+        ),
+        output,
     )
-    print(output)
 
 
-def run_files_find(args_list: list[str], enable_line_numbers: bool = False) -> None:
+def run_files_find(
+    args_list: list[str],
+    enable_line_numbers: bool = False,
+    jobs: int | None = None,
+    output: str | None = None,
+    cache=None,
+    output_format: str = "markdown",
+) -> None:
     """!
     @brief Execute --files-find: find constructs in arbitrary files.
         @param args_list Combined list: [TAG, PATTERN, FILE1, FILE2, ...].
         @param enable_line_numbers If True, emits <n>: prefixes in output.
+        @param jobs Worker process count (`None` selects the CPU core count).
+        @param output Optional output file path (default: stdout).
+        @param cache Optional `AnalysisCache` whose symbol index answers the query.
+        @param output_format `markdown` blocks or `jsonl` records.
     @details Implements the run_files_find function behavior with deterministic control flow.
     @return {None} Function return value.
     """
-    from .find_constructs import find_constructs_in_files
+    from .find_constructs import iter_construct_sections
 
     if len(args_list) < 3:
         raise ReqError(
@@ -4989,54 +5512,270 @@ def run_files_find(args_list: list[str], enable_line_numbers: bool = False) -> N
     pattern = args_list[1]
     files = args_list[2:]
 
-    output = find_constructs_in_files(
-        files,
-        tag_filter,
-        pattern,
-        include_line_numbers=enable_line_numbers,
-        verbose=VERBOSE,
+    _write_stream(
+        iter_construct_sections(
+            files,
+            tag_filter,
+            pattern,
+            include_line_numbers=enable_line_numbers,
+            verbose=VERBOSE,
+            jobs=jobs,
+            cache=cache,
+            output_format=output_format,
+        ),
+        output,
     )
-    print(output)
+
+
+def _build_analysis_cache(args: Namespace, project_base: Path):
+    """!
+    @brief Build the persistent analysis cache for one project-scan command.
+    @param args Parsed CLI namespace.
+    @param project_base Resolved project root.
+    @return `AnalysisCache` rooted at `<project_base>/.req/cache`, or None when `--no-cache` is set.
+    @details The configured `git-path` locates the repository when the project root is a subdirectory of it, so the cache objects are shared by every
+      worktree of the repository (SRS-396).
+    @satisfies SRS-376, SRS-396
+    """
+    if getattr(args, "no_cache", False):
+        return None
+    from .analysis_cache import AnalysisCache
+
+    git_root: Optional[Path] = None
+    try:
+        git_path = load_full_config(project_base).get("git-path")
+    except (ReqError, OSError):
+        git_path = None
+    if isinstance(git_path, str) and git_path:
+        git_root = project_base / git_path
+    return AnalysisCache.for_project(project_base, git_root)
+
+
+def _build_static_check_cache(args: Namespace, project_base: Path):
+    """!
+    @brief Build the static-check verdict cache for one `--static-check` or `--files-static-check` command.
+    @param args Parsed CLI namespace.
+    @param project_base Resolved project root.
+    @return `StaticCheckResultCache` stored in `<project_base>/.req/cache`, or None when the project has no `.req/` directory or `--no-cache` is set.
+    @satisfies SRS-395
+    """
+    if not (project_base / ".req").is_dir():
+        return None
+    cache = _build_analysis_cache(args, project_base)
+    if cache is None:
+        return None
+    from .static_check import StaticCheckResultCache
+
+    return StaticCheckResultCache(cache, project_base)
+
+
+def _build_standalone_cache(args: Namespace):
+    """!
+    @brief Build the persistent analysis cache for one standalone `--files-*` command.
+    @param args Parsed CLI namespace.
+    @return `AnalysisCache` rooted at `<cwd>/.req/cache` when the working directory contains `.req/`, else None (also when `--no-cache` is set).
+    """
+    cwd = Path.cwd()
+    if not (cwd / ".req").is_dir():
+        return None
+    return _build_analysis_cache(args, cwd)
+
+
+def _token_budget(args: Namespace) -> int | None:
+    """!
+    @brief Validate the `--token-budget` option of one project-scan command.
+    @param args Parsed CLI namespace.
+    @return Positive token budget, or None when packing is disabled.
+    @throws ReqError If the budget is not positive or is combined with `--incremental`.
+    """
+    budget = getattr(args, "token_budget", None)
+    if budget is None:
+        return None
+    if budget <= 0:
+        raise ReqError("Error: --token-budget must be a positive integer.", 1)
+    if getattr(args, "incremental", False):
+        raise ReqError("Error: --token-budget cannot be combined with --incremental.", 1)
+    return budget
+
+
+def _stream_threshold(args: Namespace) -> int:
+    """!
+    @brief Validate the `--stream-threshold` option.
+    @param args Parsed CLI namespace.
+    @return Size in bytes from which brace-language files are analyzed in streaming mode; `STREAM_THRESHOLD_BYTES` when the option is absent.
+    @throws ReqError If the threshold is negative.
+    """
+    from .source_analyzer import STREAM_THRESHOLD_BYTES
+
+    threshold = getattr(args, "stream_threshold", None)
+    if threshold is None:
+        return STREAM_THRESHOLD_BYTES
+    if threshold < 0:
+        raise ReqError("Error: --stream-threshold must not be negative.", 1)
+    return threshold
+
+
+def _output_format(args: Namespace) -> str:
+    """!
+    @brief Validate the `--format` option.
+    @param args Parsed CLI namespace.
+    @return `markdown` or `jsonl`.
+    @throws ReqError If `jsonl` is combined with `--token-budget`.
+    """
+    output_format = getattr(args, "output_format", None) or "markdown"
+    if output_format == "jsonl" and getattr(args, "token_budget", None) is not None:
+        raise ReqError("Error: --format jsonl cannot be combined with --token-budget.", 1)
+    return output_format
+
+
+def _write_packed(packer, output: str | None, header: str | None = None) -> None:
+    """!
+    @brief Write a token-budget pack and report degradation on stderr.
+    @param packer Filled `TokenPacker`.
+    @param output Destination file path, or None for stdout.
+    @param header Optional header written before the sections.
+    @return {None} Function return value.
+    @satisfies SRS-389
+    """
+    fragments = packer.fragments()
+    if header is not None and not packer.sections:
+        fragments = iter([header])
+        header = None
+    _write_stream(fragments, output, header=header)
+    if packer.levels["signatures"] or packer.levels["tree"] or packer.omitted or VERBOSE:
+        print(packer.summary(), file=sys.stderr)
+
+
+def _requirements_text(args: Namespace, project_base: Path) -> str:
+    """!
+    @brief Read REQUIREMENTS.md used to rank files for `--token-budget`.
+    @param args Parsed CLI namespace.
+    @param project_base Resolved project root.
+    @return File content from `--docs-dir` or the configured docs-dir, or an empty string.
+    """
+    from .context_pack import read_requirements_text
+
+    docs_dir = getattr(args, "docs_dir", None)
+    if not docs_dir:
+        try:
+            docs_dir = load_config(project_base).get("docs-dir")
+        except ReqError:
+            docs_dir = None
+    if not isinstance(docs_dir, str) or not docs_dir:
+        return ""
+    return read_requirements_text(project_base / make_relative_if_contains_project(docs_dir, project_base))
 
 
 def run_references(args: Namespace) -> None:
     """!
     @brief Execute --references: generate markdown for project source files.
-    @details Implements the run_references function behavior with deterministic control flow.
+    @details Implements the run_references function behavior with deterministic control flow. With `--incremental`, unchanged files reuse the sections recorded
+    by the previous incremental run. With `--token-budget`, sections are ranked and degraded by `context_pack.pack_references()` to fit the budget. With
+    `--format jsonl`, file and construct records replace the `# Files Structure` header and the markdown sections; incremental runs keep a separate manifest
+    per format.
     @param args Input parameter `args`.
     @return {None} Function return value.
     """
-    from .generate_markdown import generate_markdown
+    from .generate_markdown import iter_markdown_sections
 
     project_base, src_dirs = _resolve_project_src_dirs(args)
     files = _collect_source_files(src_dirs, project_base)
     if not files:
         raise ReqError("Error: no source files found in configured directories.", 1)
-    md = generate_markdown(files, verbose=VERBOSE, output_base=project_base)
-    files_structure = _format_files_structure_markdown(files, project_base)
-    print(f"{files_structure}\n\n{md}")
+    cache = _build_analysis_cache(args, project_base)
+    output_format = _output_format(args)
+    budget = _token_budget(args)
+    if budget is not None:
+        from .context_pack import pack_references
+
+        header = _format_files_structure_markdown(files, project_base)
+        try:
+            packer = pack_references(
+                files,
+                project_base,
+                budget,
+                header,
+                requirements_text=_requirements_text(args, project_base),
+                jobs=getattr(args, "jobs", None),
+                cache=cache,
+                verbose=VERBOSE,
+            )
+        except ValueError as e:
+            raise ReqError(f"Error: {e}", 1)
+        _write_packed(packer, getattr(args, "output", None), header=header)
+        return
+    incremental = None
+    if getattr(args, "incremental", False):
+        if cache is None:
+            raise ReqError("Error: --incremental requires the analysis cache; remove --no-cache.", 1)
+        from .incremental import IncrementalScan
+
+        incremental = IncrementalScan.begin(
+            cache, project_base, "references" if output_format == "markdown" else f"references.{output_format}")
+    sections = iter_markdown_sections(
+        files,
+        verbose=VERBOSE,
+        output_base=project_base,
+        jobs=getattr(args, "jobs", None),
+        cache=cache,
+        reuse=incremental.reuse if incremental else None,
+        record=incremental.sections if incremental else None,
+        stream_threshold=_stream_threshold(args),
+        output_format=output_format,
+    )
+    files_structure = _format_files_structure_markdown(files, project_base) if output_format == "markdown" else None
+    _write_stream(sections, getattr(args, "output", None), header=files_structure)
+    if incremental is not None:
+        incremental.commit()
 
 
 def run_compress_cmd(args: Namespace) -> None:
     """!
     @brief Execute --compress: compress project source files.
         @param args Parsed CLI arguments namespace.
-    @details Implements the run_compress_cmd function behavior with deterministic control flow.
+    @details Implements the run_compress_cmd function behavior with deterministic control flow. With `--token-budget`, blocks are ranked and degraded by
+    `context_pack.pack_compressed()` to fit the budget. With `--dedup`, repeated runs are replaced by back-references to their first block.
     @return {None} Function return value.
+    @throws ReqError If `--dedup` is combined with `--token-budget`.
     """
-    from .compress_files import compress_files
+    from .compress_files import iter_compressed_sections
 
     project_base, src_dirs = _resolve_project_src_dirs(args)
     files = _collect_source_files(src_dirs, project_base)
     if not files:
         raise ReqError("Error: no source files found in configured directories.", 1)
-    output = compress_files(
-        files,
-        include_line_numbers=getattr(args, "enable_line_numbers", False),
-        verbose=VERBOSE,
-        output_base=project_base,
+    output_format = _output_format(args)
+    budget = _token_budget(args)
+    if budget is not None and getattr(args, "dedup", False):
+        raise ReqError("Error: --dedup cannot be combined with --token-budget.", 1)
+    if budget is not None:
+        from .context_pack import pack_compressed
+
+        packer = pack_compressed(
+            files,
+            project_base,
+            budget,
+            include_line_numbers=getattr(args, "enable_line_numbers", False),
+            requirements_text=_requirements_text(args, project_base),
+            jobs=getattr(args, "jobs", None),
+            cache=_build_analysis_cache(args, project_base),
+            verbose=VERBOSE,
+        )
+        _write_packed(packer, getattr(args, "output", None))
+        return
+    _write_stream(
+        iter_compressed_sections(
+            files,
+            include_line_numbers=getattr(args, "enable_line_numbers", False),
+            verbose=VERBOSE,
+            output_base=project_base,
+            jobs=getattr(args, "jobs", None),
+            cache=_build_analysis_cache(args, project_base),
+            dedup=getattr(args, "dedup", False),
+            output_format=output_format,
+        ),
+        getattr(args, "output", None),
     )
-    print(output)
 
 
 def run_find(args: Namespace) -> None:
@@ -5047,7 +5786,7 @@ def run_find(args: Namespace) -> None:
     @details Implements the run_find function behavior with deterministic control flow.
     @return {None} Function return value.
     """
-    from .find_constructs import find_constructs_in_files
+    from .find_constructs import iter_construct_sections
 
     project_base, src_dirs = _resolve_project_src_dirs(args)
     files = _collect_source_files(src_dirs, project_base)
@@ -5057,18 +5796,114 @@ def run_find(args: Namespace) -> None:
     # args.find is a list [TAG, PATTERN]
     tag_filter, pattern = args.find
     try:
-        output = find_constructs_in_files(
-            files,
-            tag_filter,
-            pattern,
-            include_line_numbers=getattr(args, "enable_line_numbers", False),
-            verbose=VERBOSE,
+        _write_stream(
+            iter_construct_sections(
+                files,
+                tag_filter,
+                pattern,
+                include_line_numbers=getattr(args, "enable_line_numbers", False),
+                verbose=VERBOSE,
+                jobs=getattr(args, "jobs", None),
+                cache=_build_analysis_cache(args, project_base),
+                output_format=_output_format(args),
+            ),
+            getattr(args, "output", None),
         )
-        print(output)
     except ValueError as e:
         raise ReqError(str(e), 1)
 
 
+WATCH_REFERENCES_FILE_NAME = "references.md"
+"""Default `--watch` artifact name below `.req/cache/`."""
+
+
+def run_watch(args: Namespace) -> None:
+    """!
+    @brief Execute --watch: keep the rendered `--references` output and the symbol index current while sources change.
+    @param args Parsed CLI namespace.
+    @return {None} Function return value; returns when interrupted.
+    @throws ReqError If `--no-cache` or `--format jsonl` is set or no source directory exists.
+    @details Renders the full `--references` output once, then re-renders only the files named by each debounced change batch (or below a changed
+    directory), splicing the previous sections of the other files. Every refresh re-collects the file list, atomically replaces the artifact
+    (`.req/cache/references.md` or `--output FILE`), refreshes and saves the `--find` symbol index, and prints one status line on stderr. Batches touching
+    no directory, `.gitignore`, or supported source file are ignored.
+    @satisfies SRS-394
+    """
+    from . import watch
+    from .analysis_cache import _atomic_write_bytes
+    from .generate_markdown import iter_markdown_sections
+    from .symbol_index import SymbolIndex
+
+    project_base, src_dirs = _resolve_project_src_dirs(args)
+    cache = _build_analysis_cache(args, project_base)
+    if cache is None:
+        raise ReqError("Error: --watch requires the analysis cache; remove --no-cache.", 1)
+    if getattr(args, "output_format", "markdown") != "markdown":
+        raise ReqError("Error: --watch renders markdown only; remove --format.", 1)
+    roots = []
+    for src_dir in src_dirs:
+        root = (project_base / make_relative_if_contains_project(src_dir, project_base)).resolve()
+        if root.is_dir() and str(root) not in roots:
+            roots.append(str(root))
+    if not roots:
+        raise ReqError("Error: no source directories found to watch.", 1)
+    output = Path(args.output) if getattr(args, "output", None) else cache.root / WATCH_REFERENCES_FILE_NAME
+    jobs = getattr(args, "jobs", None)
+    stream_threshold = _stream_threshold(args)
+    sections: dict = {}
+    index = SymbolIndex.for_cache(cache)
+
+    def _refresh(changed: Optional[set]) -> None:
+        started = time.perf_counter()
+        if changed is not None:
+            changed_dirs = tuple(path + os.sep for path in changed if os.path.isdir(path))
+            if not changed_dirs and not any(
+                Path(path).suffix.lower() in SUPPORTED_EXTENSIONS or Path(path).name == ".gitignore" for path in changed
+            ):
+                return
+        files = _collect_source_files(src_dirs, project_base)
+        if changed is None:
+            reuse = {}
+        else:
+            reuse = {
+                path: section for path, section in sections.items()
+                if path not in changed and not path.startswith(changed_dirs)
+            }
+        record: dict = {}
+        try:
+            chunks = list(iter_markdown_sections(
+                files, verbose=VERBOSE, output_base=project_base, jobs=jobs, cache=cache, reuse=reuse, record=record,
+                stream_threshold=stream_threshold,
+            ))
+        except ValueError as e:
+            sections.clear()
+            print(f"watch: {e}", file=sys.stderr, flush=True)
+            return
+        sections.clear()
+        sections.update(record)
+        text = _format_files_structure_markdown(files, project_base) + "\n\n" + "".join(chunks) + "\n"
+        try:
+            output.parent.mkdir(parents=True, exist_ok=True)
+            _atomic_write_bytes(output, text.encode("utf-8"))
+        except OSError as e:
+            raise ReqError(f"Error: cannot write output file {output}: {e}", 1)
+        index.refresh(files, jobs=jobs)
+        index.save()
+        rendered = len(files) - sum(1 for path in files if path in reuse)
+        elapsed = (time.perf_counter() - started) * 1000
+        print(f"watch: {len(files)} files, {rendered} re-rendered in {elapsed:.0f} ms -> {output}", file=sys.stderr, flush=True)
+
+    watcher = watch.create_watcher(roots)
+    print(f"watch: {type(watcher).__name__} on {', '.join(roots)}", file=sys.stderr, flush=True)
+    try:
+        _refresh(None)
+        watch.watch_loop(watcher, _refresh)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        watcher.close()
+
+
 def run_tokens(args: Namespace) -> None:
     """! @brief Execute --tokens on the canonical documentation files in --docs-dir.
     @param args Parsed CLI arguments namespace.
@@ -5094,7 +5929,7 @@ def run_tokens(args: Namespace) -> None:
     ]
     if not files:
         raise ReqError("Error: no canonical docs files found in --docs-dir.", 1)
-    run_files_tokens(files)
+    run_files_tokens(files, cache=_build_analysis_cache(args, project_base))
 
 
 def run_files_static_check_cmd(files: list[str], args: Namespace) -> int:
@@ -5114,15 +5949,19 @@ def run_files_static_check_cmd(files: list[str], args: Namespace) -> int:
       - Resolves absolute path; skips with warning if not a regular file.
       - Detects language via `STATIC_CHECK_EXT_TO_LANG` keyed on the lowercase extension.
       - Looks up language in the `"static-check"` config section; skips silently if absent.
-      - Executes each configured language entry sequentially via
+      - Executes each configured language entry in order via
         `dispatch_static_check_for_file(filepath, lang_config, fail_only=True, project_base=...)`.
+      Files are scheduled by `run_static_check_plan`: up to `--jobs` files are checked concurrently and
+      their output is printed in file order; `--static-check-batch` first checks file groups with one
+      invocation per batchable tool and rechecks only failing groups per file (SRS-384).
+      Verdicts of unchanged files are replayed from the `.req/cache` result cache unless `--no-cache` is set (SRS-395).
       - For `Command` module entries, execution order is `<cmd> [params...] <filename>`.
       Dispatch context provides project root for checker runtime execution.
       All checks execute with `fail_only=True`: passing checks produce no stdout output (SRS-253).
       Overall exit code: max of all per-file codes (0=all pass, 1=any fail). (SRS-253, SRS-255)
     @see SRS-253, SRS-254, SRS-255, SRS-341
     """
-    from .static_check import STATIC_CHECK_EXT_TO_LANG, dispatch_static_check_for_file
+    from .static_check import STATIC_CHECK_EXT_TO_LANG, run_static_check_plan
 
     # Resolve project base for config.json lookup
     base_arg = getattr(args, "base", None)
@@ -5144,7 +5983,7 @@ def run_files_static_check_cmd(files: list[str], args: Namespace) -> int:
             )
             return 0
 
-    overall = 0
+    plan: list[tuple[str, list[dict]]] = []
     for raw_path in files:
         p = Path(raw_path)
         if not p.is_file():
@@ -5163,16 +6002,14 @@ def run_files_static_check_cmd(files: list[str], args: Namespace) -> int:
         if not lang_configs:
             vlog(f"Skipping {raw_path}: no static-check config for language '{lang}'")
             continue
-        for lang_config in lang_configs:
-            rc = dispatch_static_check_for_file(
-                filepath,
-                lang_config,
-                fail_only=True,
-                project_base=project_base,
-            )
-            if rc != 0:
-                overall = 1
-    return overall
+        plan.append((filepath, lang_configs))
+    return run_static_check_plan(
+        plan,
+        project_base=project_base,
+        jobs=getattr(args, "jobs", None),
+        batch=getattr(args, "static_check_batch", False),
+        result_cache=_build_static_check_cache(args, project_base),
+    )
 
 
 def run_project_static_check_cmd(args: Namespace) -> int:
@@ -5192,8 +6029,12 @@ def run_project_static_check_cmd(args: Namespace) -> int:
       - Detects language via `STATIC_CHECK_EXT_TO_LANG` keyed on lowercase extension.
       - Looks up language in the `"static-check"` section of `.req/config.json`.
       - Skips silently when no tool is configured for the file's language.
-      - Executes each configured language entry sequentially via
+      - Executes each configured language entry in order via
         `dispatch_static_check_for_file(filepath, lang_config, fail_only=True, project_base=...)`.
+      Files are scheduled by `run_static_check_plan`: up to `--jobs` files are checked concurrently and
+      their output is printed in file order; `--static-check-batch` first checks file groups with one
+      invocation per batchable tool and rechecks only failing groups per file (SRS-384).
+      Verdicts of unchanged files are replayed from the `.req/cache` result cache unless `--no-cache` is set (SRS-395).
       - For `Command` module entries, execution order is `<cmd> [params...] <filename>`.
       Dispatch context provides project root for checker runtime execution.
       All checks execute with `fail_only=True`: passing checks produce no stdout output (SRS-256).
@@ -5201,7 +6042,7 @@ def run_project_static_check_cmd(args: Namespace) -> int:
     @throws ReqError If no source files are found.
     @see SRS-256, SRS-257, SRS-336, SRS-341
     """
-    from .static_check import STATIC_CHECK_EXT_TO_LANG, dispatch_static_check_for_file
+    from .static_check import STATIC_CHECK_EXT_TO_LANG, run_static_check_plan
 
     project_base, src_dirs = _resolve_project_src_dirs(args)
     sc_config = load_static_check_from_config(project_base)
@@ -5230,29 +6071,17 @@ def run_project_static_check_cmd(args: Namespace) -> int:
         )
         if configured_root not in fixture_roots:
             fixture_roots.append(configured_root)
-    filtered_files: list[str] = []
-    for filepath in files:
-        try:
-            rel_posix = (
-                Path(filepath).resolve().relative_to(project_base.resolve()).as_posix()
-            )
-        except ValueError:
-            filtered_files.append(filepath)
-            continue
-        should_skip = False
-        for fixture_root in fixture_roots:
-            fixture_prefix = f"{fixture_root}/"
-            if rel_posix == fixture_root or rel_posix.startswith(fixture_prefix):
-                should_skip = True
-                break
-        if should_skip:
-            continue
-        filtered_files.append(filepath)
-    files = filtered_files
+    fixture_prefixes = tuple(f"{fixture_root}/" for fixture_root in fixture_roots)
+    files = [
+        filepath
+        for filepath, rel_posix in zip(files, _project_relative_paths(files, project_base))
+        if rel_posix is None
+        or not (rel_posix in fixture_roots or rel_posix.startswith(fixture_prefixes))
+    ]
     if not files:
         raise ReqError("Error: no source files found in configured directories.", 1)
 
-    overall = 0
+    plan: list[tuple[str, list[dict]]] = []
     for filepath in files:
         ext = Path(filepath).suffix.lower()
         lang = STATIC_CHECK_EXT_TO_LANG.get(ext)
@@ -5263,16 +6092,145 @@ def run_project_static_check_cmd(args: Namespace) -> int:
         if not lang_configs:
             vlog(f"Skipping {filepath}: no static-check config for language '{lang}'")
             continue
-        for lang_config in lang_configs:
-            rc = dispatch_static_check_for_file(
-                filepath,
-                lang_config,
-                fail_only=True,
-                project_base=project_base,
+        plan.append((filepath, lang_configs))
+    return run_static_check_plan(
+        plan,
+        project_base=project_base,
+        jobs=getattr(args, "jobs", None),
+        batch=getattr(args, "static_check_batch", False),
+        result_cache=_build_static_check_cache(args, project_base),
+    )
+
+
+def _batch_project_args(args: Namespace, project_base: Path) -> Namespace:
+    """!
+    @brief Build the namespace of one `--batch` project.
+    @param args Parsed CLI namespace of the batch.
+    @param project_base Project root.
+    @return Copy of `args` scoped to `project_base` in here-only mode, so `_resolve_project_src_dirs()` reads the project's own `.req/config.json`.
+    """
+    return Namespace(**{**vars(args), "base": project_base, "here": True, "batch": None})
+
+
+def _run_batch_references(args: Namespace, projects: list, output_format: str, started: float) -> None:
+    """!
+    @brief Render `--references` for every `--batch` project on one shared worker pool.
+    @param args Parsed CLI namespace of the batch.
+    @param projects `batch.BatchProject` entries; updated with files, counters, timings, and errors.
+    @param output_format `markdown` or `jsonl`.
+    @param started `time.perf_counter()` value at batch start.
+    @return {None} Function return value.
+    @details Projects are resolved first; the files of all resolved projects are then scheduled on one ordered pool, and each project's output is written
+    from its own slice of the results exactly as `--references` would write it, while workers already render the following projects.
+    """
+    from . import batch
+    from .generate_markdown import iter_markdown_sections, markdown_file_worker
+
+    stream_threshold = _stream_threshold(args)
+    for project in projects:
+        try:
+            project_args = _batch_project_args(args, project.base)
+            project_base, src_dirs = _resolve_project_src_dirs(project_args)
+            files = _collect_source_files(src_dirs, project_base)
+            if not files:
+                raise ReqError("Error: no source files found in configured directories.", 1)
+            project.worker = markdown_file_worker(
+                project_base, _build_analysis_cache(project_args, project_base), stream_threshold, output_format
+            )
+            project.files = files
+        except ReqError as e:
+            project.error, project.code = e.message, e.code
+    shared = batch.schedule(projects, getattr(args, "jobs", None))
+    for project in projects:
+        if project.error is not None:
+            continue
+        outcomes = batch.ProjectOutcomes(project, shared)
+        header = _format_files_structure_markdown(project.files, project.base) if output_format == "markdown" else None
+        try:
+            project.output.parent.mkdir(parents=True, exist_ok=True)
+            _write_stream(
+                iter_markdown_sections(
+                    project.files, verbose=VERBOSE, output_base=project.base, output_format=output_format, outcomes=outcomes
+                ),
+                str(project.output),
+                header=header,
             )
-            if rc != 0:
-                overall = 1
-    return overall
+        except ValueError as e:
+            project.error, project.code = f"Error: {e}", 1
+        except ReqError as e:
+            project.error, project.code = e.message, e.code
+        except OSError as e:
+            project.error, project.code = f"Error: cannot write output file {project.output}: {e}", 1
+        outcomes.drain()
+        project.finished_seconds = time.perf_counter() - started
+
+
+def _run_batch_static_check(args: Namespace, projects: list, started: float) -> None:
+    """!
+    @brief Run `--static-check` for every `--batch` project in this process.
+    @param args Parsed CLI namespace of the batch.
+    @param projects `batch.BatchProject` entries; updated with exit codes, timings, and errors.
+    @param started `time.perf_counter()` value at batch start.
+    @return {None} Function return value.
+    @details Projects run one after another, each with up to `--jobs` concurrent tool invocations; the stdout of `run_project_static_check_cmd()` is
+    redirected to the project's output file.
+    """
+    import contextlib
+
+    for project in projects:
+        project_started = time.perf_counter()
+        try:
+            project_args = _batch_project_args(args, project.base)
+            _resolve_project_src_dirs(project_args)
+            project.output.parent.mkdir(parents=True, exist_ok=True)
+            with open(project.output, "w", encoding="utf-8") as handle, contextlib.redirect_stdout(handle):
+                project.code = run_project_static_check_cmd(project_args)
+        except ReqError as e:
+            project.error, project.code = e.message, e.code
+        except OSError as e:
+            project.error, project.code = f"Error: cannot write output file {project.output}: {e}", 1
+        project.worker_seconds = time.perf_counter() - project_started
+        project.finished_seconds = time.perf_counter() - started
+
+
+def run_batch(args: Namespace) -> int:
+    """!
+    @brief Execute `--batch`: run `--references` or `--static-check` for several projects in one process.
+    @param args Parsed CLI namespace; `args.batch` lists the project roots.
+    @return Highest exit code of all projects (0 when every project succeeded).
+    @throws ReqError If no batch command is selected or `--batch` is combined with `--base`, `--output`, `--token-budget`, `--incremental`, or
+    `--format jsonl` for static checks.
+    @details Each project is resolved through `_resolve_project_src_dirs()` from its own `.req/config.json`. A project that cannot be resolved or fails is
+    reported and does not stop the batch. The per-project summary of `batch.format_report()` is printed on stderr.
+    @satisfies SRS-404
+    """
+    from . import batch
+
+    if getattr(args, "references", False):
+        command = "references"
+    elif getattr(args, "static_check", False):
+        command = "static-check"
+    else:
+        raise ReqError("Error: --batch requires --references or --static-check.", 1)
+    for flag, dest in (("--base", "base"), ("--output", "output"), ("--token-budget", "token_budget"), ("--incremental", "incremental")):
+        if getattr(args, dest, None):
+            raise ReqError(f"Error: --batch cannot be combined with {flag}.", 1)
+    output_format = _output_format(args)
+    if (command, output_format) not in batch.BATCH_OUTPUT_SUFFIXES:
+        raise ReqError(f"Error: --batch --{command} does not support --format {output_format}.", 1)
+    output_dir = getattr(args, "batch_output_dir", None)
+    bases = [Path(project).resolve() for project in args.batch]
+    outputs = batch.output_paths(
+        bases, Path(output_dir).resolve() if output_dir else None, batch.BATCH_OUTPUT_SUFFIXES[(command, output_format)]
+    )
+    projects = [batch.BatchProject(base, output) for base, output in zip(bases, outputs)]
+    started = time.perf_counter()
+    if command == "references":
+        _run_batch_references(args, projects, output_format, started)
+    else:
+        _run_batch_static_check(args, projects, started)
+    print(batch.format_report(projects, time.perf_counter() - started), file=sys.stderr, flush=True)
+    return max([project.code for project in projects] + [0])
 
 
 def _resolve_project_base(args: Namespace) -> Path:
@@ -5349,6 +6307,191 @@ def _resolve_project_src_dirs(args: Namespace) -> tuple[Path, list[str]]:
     return project_base, src_dirs
 
 
+def _is_server_forwardable(args: Namespace) -> bool:
+    """!
+    @brief Check whether a command may be forwarded to a running `--serve` server.
+    @param args Parsed CLI namespace.
+    @return True for `--references`, `--compress`, `--find`, `--tokens`, `--files-tokens`, `--files-references`, `--files-compress`, and `--files-find`
+    without `--no-server`, `--profile`, or `--batch`.
+    @satisfies SRS-393
+    """
+    if getattr(args, "no_server", False) or getattr(args, "profile", False) or getattr(args, "batch", None):
+        return False
+    return bool(
+        getattr(args, "references", False)
+        or getattr(args, "compress", False)
+        or getattr(args, "find", None)
+        or getattr(args, "tokens", False)
+        or getattr(args, "files_tokens", None)
+        or getattr(args, "files_references", None)
+        or getattr(args, "files_compress", None)
+        or getattr(args, "files_find", None)
+    )
+
+
+def run_serve(args: Namespace) -> int:
+    """!
+    @brief Run the resident command server of the current directory in the foreground.
+    @param args Parsed CLI namespace.
+    @return Exit code 0 once the server stopped or went idle.
+    @throws ReqError If unix sockets are unavailable or a server already runs for this directory.
+    @details Enables the `_collect_source_files()` memo for the lifetime of the server and executes each forwarded command through `_main()` without the
+    release check.
+    @satisfies SRS-393
+    """
+    from . import server
+
+    global _SOURCE_FILES_MEMO
+    project = Path.cwd().resolve()
+    previous_memo = _SOURCE_FILES_MEMO
+    _SOURCE_FILES_MEMO = {}
+    try:
+        server.serve(
+            project,
+            lambda argv: _main(argv, serving=True),
+            load_package_version(),
+            on_ready=lambda path: print(f"usereq server listening on {path}", file=sys.stderr, flush=True),
+        )
+    except ValueError as e:
+        raise ReqError(f"Error: {e}.", 1)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        _SOURCE_FILES_MEMO = previous_memo
+    return 0
+
+
+def run_serve_stop() -> int:
+    """!
+    @brief Stop the resident command server of the current directory.
+    @return Exit code 0 when a server was stopped.
+    @throws ReqError If no server is running for the current directory.
+    """
+    from . import server
+
+    if not server.stop(os.getcwd()):
+        raise ReqError("Error: no usereq server is running for this directory.", 1)
+    return 0
+
+
+def _dispatch(args: Namespace) -> int:
+    """!
+    @brief Run the command selected by parsed CLI arguments.
+    @param args Parsed CLI namespace.
+    @return Exit code of the command.
+    @throws ReqError On command validation or execution errors.
+    """
+    if getattr(args, "serve", False):
+        return run_serve(args)
+    if getattr(args, "serve_stop", False):
+        return run_serve_stop()
+    if getattr(args, "batch", None):
+        return run_batch(args)
+    if _is_here_only_project_scan_command(args):
+        if getattr(args, "base", None):
+            raise ReqError(
+                "Error: --references, --compress, --tokens, --find, --static-check, "
+                "--git-check, --docs-check, --git-wt-name, --git-wt-create, "
+                "--git-wt-delete, --git-path, --get-base-path, and --watch do not allow --base; use --here.",
+                1,
+            )
+        args.here = True
+    # Standalone file commands (no --base/--here required)
+    if _is_standalone_command(args):
+        if getattr(args, "files_tokens", None):
+            run_files_tokens(args.files_tokens, cache=_build_standalone_cache(args))
+        elif getattr(args, "files_references", None):
+            run_files_references(
+                args.files_references,
+                jobs=getattr(args, "jobs", None),
+                output=getattr(args, "output", None),
+                stream_threshold=_stream_threshold(args),
+                output_format=_output_format(args),
+            )
+        elif getattr(args, "files_compress", None):
+            run_files_compress(
+                args.files_compress,
+                enable_line_numbers=getattr(args, "enable_line_numbers", False),
+                jobs=getattr(args, "jobs", None),
+                output=getattr(args, "output", None),
+                dedup=getattr(args, "dedup", False),
+                output_format=_output_format(args),
+            )
+        elif getattr(args, "files_find", None):
+            run_files_find(
+                args.files_find,
+                enable_line_numbers=getattr(args, "enable_line_numbers", False),
+                jobs=getattr(args, "jobs", None),
+                output=getattr(args, "output", None),
+                cache=_build_standalone_cache(args),
+                output_format=_output_format(args),
+            )
+        elif getattr(args, "test_static_check", None) is not None:
+            from .static_check import run_static_check
+
+            rc = run_static_check(args.test_static_check)
+            return rc
+        elif getattr(args, "files_static_check", None):
+            rc = run_files_static_check_cmd(args.files_static_check, args)
+            return rc
+        return 0
+    # Project scan commands
+    if _is_project_scan_command(args):
+        if getattr(args, "references", False):
+            run_references(args)
+        elif getattr(args, "compress", False):
+            run_compress_cmd(args)
+        elif getattr(args, "tokens", False):
+            run_tokens(args)
+        elif getattr(args, "find", None):
+            run_find(args)
+        elif getattr(args, "static_check", False):
+            rc = run_project_static_check_cmd(args)
+            return rc
+        elif getattr(args, "git_check", False):
+            run_git_check(args)
+        elif getattr(args, "docs_check", False):
+            run_docs_check(args)
+        elif getattr(args, "git_wt_name", False):
+            run_git_wt_name(args)
+        elif getattr(args, "git_wt_create", None):
+            run_git_wt_create(args)
+        elif getattr(args, "git_wt_delete", None):
+            run_git_wt_delete(args)
+        elif getattr(args, "git_path_cmd", False):
+            run_git_path(args)
+        elif getattr(args, "get_base_path_cmd", False):
+            run_get_base_path(args)
+        elif getattr(args, "watch", False):
+            run_watch(args)
+        return 0
+    # Standard init flow requires --base or --here
+    if not getattr(args, "base", None) and not getattr(args, "here", False):
+        raise ReqError("Error: --base or --here is required for initialization.", 1)
+    run(args)
+    return 0
+
+
+def _dispatch_profiled(args: Namespace) -> int:
+    """!
+    @brief Run the selected command with `--profile` instrumentation.
+    @param args Parsed CLI namespace.
+    @return Exit code of the command.
+    @details Enables the process profiler, times the whole command as the `command` span, and prints the report in `--profile-format` on stderr when the
+    command returns or raises.
+    @satisfies SRS-391
+    """
+    from . import profiling
+
+    profiler = profiling.start()
+    try:
+        with profiling.span("command"):
+            return _dispatch(args)
+    finally:
+        profiling.stop()
+        print(profiler.format(getattr(args, "profile_format", "table")), file=sys.stderr)
+
+
 def main(argv: Optional[list[str]] = None) -> int:
     """!
     @brief CLI entry point for console_scripts and `-m` execution.
@@ -5356,98 +6499,59 @@ def main(argv: Optional[list[str]] = None) -> int:
     @param argv Input parameter `argv`.
     @return {int} Function return value.
     """
+    return _main(sys.argv[1:] if argv is None else argv)
+
+
+def _main(argv_list: list[str], serving: bool = False) -> int:
+    """!
+    @brief Parse and run one command line.
+    @param argv_list CLI arguments.
+    @param serving True when a `--serve` server runs a forwarded command: the release check and forwarding are skipped and only forwardable commands are
+    accepted.
+    @return {int} Command exit code (0 success, non-zero on error).
+    @details Forwardable commands are sent to the running `--serve` server of the working directory when there is one; otherwise, and when the server is
+    unavailable or of another version, the command runs in this process. Plain standalone commands skip the argparse tree through `_fast_path_args()`.
+    @satisfies SRS-393, SRS-402
+    """
     try:
         global VERBOSE, DEBUG
-        argv_list = sys.argv[1:] if argv is None else argv
-        force_online_release_check = "--ver" in argv_list or "--version" in argv_list
-        # Run release-check at startup before argument parsing/validation.
-        global FORCE_ONLINE_RELEASE_CHECK
-        previous_force_online_release_check = FORCE_ONLINE_RELEASE_CHECK
-        FORCE_ONLINE_RELEASE_CHECK = force_online_release_check
-        try:
-            maybe_notify_newer_version(timeout_seconds=RELEASE_CHECK_TIMEOUT_SECONDS)
-        finally:
-            FORCE_ONLINE_RELEASE_CHECK = previous_force_online_release_check
-        if not argv_list:
-            build_parser().print_help()
-            return 0
-        if "--uninstall" in argv_list:
-            run_uninstall()
-            return 0
-        if "--upgrade" in argv_list:
-            run_upgrade()
-            return 0
-        if maybe_print_version(argv_list):
-            return 0
-        args = parse_args(argv_list)
+        if serving:
+            args = parse_args(argv_list)
+            if not _is_server_forwardable(args):
+                raise ReqError("Error: the usereq server only runs --references, --compress, --find, --tokens, and --files-* commands.", 1)
+        else:
+            force_online_release_check = "--ver" in argv_list or "--version" in argv_list
+            # Show the cached release notice before argument parsing/validation; only --ver waits on the network.
+            global FORCE_ONLINE_RELEASE_CHECK
+            previous_force_online_release_check = FORCE_ONLINE_RELEASE_CHECK
+            FORCE_ONLINE_RELEASE_CHECK = force_online_release_check
+            try:
+                maybe_notify_newer_version(timeout_seconds=RELEASE_CHECK_TIMEOUT_SECONDS)
+            finally:
+                FORCE_ONLINE_RELEASE_CHECK = previous_force_online_release_check
+            if not argv_list:
+                build_parser().print_help()
+                return 0
+            if "--uninstall" in argv_list:
+                run_uninstall()
+                return 0
+            if "--upgrade" in argv_list:
+                run_upgrade()
+                return 0
+            if maybe_print_version(argv_list):
+                return 0
+            args = _fast_path_args(argv_list) or parse_args(argv_list)
+            if _is_server_forwardable(args):
+                from . import server
+
+                forwarded = server.forward(argv_list, os.getcwd(), load_package_version())
+                if forwarded is not None:
+                    return forwarded
         VERBOSE = getattr(args, "verbose", False)
         DEBUG = getattr(args, "debug", False)
-        if _is_here_only_project_scan_command(args):
-            if getattr(args, "base", None):
-                raise ReqError(
-                    "Error: --references, --compress, --tokens, --find, --static-check, "
-                    "--git-check, --docs-check, --git-wt-name, --git-wt-create, and "
-                    "--git-wt-delete, --git-path, and --get-base-path do not allow --base; use --here.",
-                    1,
-                )
-            args.here = True
-        # Standalone file commands (no --base/--here required)
-        if _is_standalone_command(args):
-            if getattr(args, "files_tokens", None):
-                run_files_tokens(args.files_tokens)
-            elif getattr(args, "files_references", None):
-                run_files_references(args.files_references)
-            elif getattr(args, "files_compress", None):
-                run_files_compress(
-                    args.files_compress,
-                    enable_line_numbers=getattr(args, "enable_line_numbers", False),
-                )
-            elif getattr(args, "files_find", None):
-                run_files_find(
-                    args.files_find,
-                    enable_line_numbers=getattr(args, "enable_line_numbers", False),
-                )
-            elif getattr(args, "test_static_check", None) is not None:
-                from .static_check import run_static_check
-
-                rc = run_static_check(args.test_static_check)
-                return rc
-            elif getattr(args, "files_static_check", None):
-                rc = run_files_static_check_cmd(args.files_static_check, args)
-                return rc
-            return 0
-        # Project scan commands
-        if _is_project_scan_command(args):
-            if getattr(args, "references", False):
-                run_references(args)
-            elif getattr(args, "compress", False):
-                run_compress_cmd(args)
-            elif getattr(args, "tokens", False):
-                run_tokens(args)
-            elif getattr(args, "find", None):
-                run_find(args)
-            elif getattr(args, "static_check", False):
-                rc = run_project_static_check_cmd(args)
-                return rc
-            elif getattr(args, "git_check", False):
-                run_git_check(args)
-            elif getattr(args, "docs_check", False):
-                run_docs_check(args)
-            elif getattr(args, "git_wt_name", False):
-                run_git_wt_name(args)
-            elif getattr(args, "git_wt_create", None):
-                run_git_wt_create(args)
-            elif getattr(args, "git_wt_delete", None):
-                run_git_wt_delete(args)
-            elif getattr(args, "git_path_cmd", False):
-                run_git_path(args)
-            elif getattr(args, "get_base_path_cmd", False):
-                run_get_base_path(args)
-            return 0
-        # Standard init flow requires --base or --here
-        if not getattr(args, "base", None) and not getattr(args, "here", False):
-            raise ReqError("Error: --base or --here is required for initialization.", 1)
-        run(args)
+        if getattr(args, "profile", False):
+            return _dispatch_profiled(args)
+        return _dispatch(args)
     except ReqError as e:
         print(e.message, file=sys.stderr)
         return e.code
@@ -5458,7 +6562,6 @@ def main(argv: Optional[list[str]] = None) -> int:
 
             traceback.print_exc()
         return 1
-    return 0
 
 
 if __name__ == "__main__":
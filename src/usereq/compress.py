@@ -9,8 +9,11 @@
 
 import os
 import sys
+from typing import Iterable, Iterator
 
-from .source_analyzer import build_language_specs
+from .line_lexer import get_line_lexer
+from .source_analyzer import SPEC_REGISTRY
+from .source_buffer import SourceBuffer
 
 # Extension-to-language map (mirrors generate_markdown.py)
 EXT_LANG_MAP = {
@@ -28,19 +31,13 @@ EXT_LANG_MAP = {
 INDENT_SIGNIFICANT = {"python", "haskell", "elixir"}
 """! @brief Languages requiring indentation-preserving compression behavior."""
 
-_specs_cache = None
-"""! @brief Cached language specification dictionary initialized lazily."""
-
-
 def _get_specs():
-    """! @brief Return cached language specifications, initializing once.
-    @return Dictionary mapping normalized language keys to language specs.
-    @details If cache is empty, calls `build_language_specs()` to populate it.
+    """! @brief Return the shared lazy language specification registry.
+    @return Mapping from normalized language keys to language specs.
+    @details Returns `SPEC_REGISTRY`, so only the languages actually compressed compile their regex tables and the compiled tables are shared with
+    `SourceAnalyzer`.
     """
-    global _specs_cache
-    if _specs_cache is None:
-        _specs_cache = build_language_specs()
-    return _specs_cache
+    return SPEC_REGISTRY
 
 
 def detect_language(filepath: str) -> str | None:
@@ -59,40 +56,9 @@ def _is_in_string(line: str, pos: int, string_delimiters: tuple) -> bool:
     @param pos The character index to check.
     @param string_delimiters Tuple of string delimiter characters/sequences.
     @return True if `pos` is inside a string, False otherwise.
-    @details iterates through the line handling escaped delimiters.
+    @details Uses the shared linear-time `LineLexer`; backslashes escape only single-character delimiters.
     """
-    in_string = None
-    i = 0
-    sorted_delims = sorted(string_delimiters, key=len, reverse=True)
-    while i < pos:
-        if in_string is not None:
-            if line[i:].startswith(in_string):
-                # Check for escaped delimiter (single-char only)
-                if len(in_string) == 1 and i > 0 and line[i - 1] == '\\':
-                    # Count consecutive backslashes
-                    bs = 0
-                    j = i - 1
-                    while j >= 0 and line[j] == '\\':
-                        bs += 1
-                        j -= 1
-                    if bs % 2 == 1:
-                        i += 1
-                        continue
-                i += len(in_string)
-                in_string = None
-                continue
-            i += 1
-        else:
-            matched = False
-            for delim in sorted_delims:
-                if line[i:].startswith(delim):
-                    in_string = delim
-                    i += len(delim)
-                    matched = True
-                    break
-            if not matched:
-                i += 1
-    return in_string is not None
+    return get_line_lexer(string_delimiters, None, False).in_string(line, pos)
 
 
 def _remove_inline_comment(line: str, single_comment: str,
@@ -102,41 +68,12 @@ def _remove_inline_comment(line: str, single_comment: str,
     @param single_comment The single-line comment marker (e.g., "//", "#").
     @param string_delimiters Tuple of string delimiters to respect.
     @return The line content before the comment starts.
-    @details Respects string literals; does not remove comments inside strings.
+    @details Respects string literals; does not remove comments inside strings. Uses the shared linear-time `LineLexer`.
     """
     if not single_comment:
         return line
-    sc_len = len(single_comment)
-    i = 0
-    sorted_delims = sorted(string_delimiters, key=len, reverse=True)
-    in_string = None
-    while i < len(line):
-        if in_string is not None:
-            if line[i:].startswith(in_string):
-                if len(in_string) == 1 and i > 0 and line[i - 1] == '\\':
-                    bs = 0
-                    j = i - 1
-                    while j >= 0 and line[j] == '\\':
-                        bs += 1
-                        j -= 1
-                    if bs % 2 == 1:
-                        i += 1
-                        continue
-                i += len(in_string)
-                in_string = None
-                continue
-            i += 1
-        else:
-            if line[i:i + sc_len] == single_comment:
-                return line[:i]
-            for delim in sorted_delims:
-                if line[i:].startswith(delim):
-                    in_string = delim
-                    i += len(delim)
-                    break
-            else:
-                i += 1
-    return line
+    comment_idx = get_line_lexer(string_delimiters, single_comment, False).find_comment(line)
+    return line if comment_idx is None else line[:comment_idx]
 
 
 def _is_python_docstring_line(line: str) -> bool:
@@ -153,11 +90,11 @@ def _is_python_docstring_line(line: str) -> bool:
     return False
 
 
-def _format_result(entries: list[tuple[int, str]],
+def _format_result(entries: Iterable[tuple[int, str]],
                    include_line_numbers: bool) -> str:
     """!
     @brief Format compressed entries, optionally prefixing original line numbers.
-        @param entries List of tuples (line_number, text).
+        @param entries Iterable of tuples (line_number, text), consumed once.
         @param include_line_numbers Boolean flag to enable line prefixes.
         @return Formatted string.
     @details Implements the _format_result function behavior with deterministic control flow.
@@ -167,25 +104,51 @@ def _format_result(entries: list[tuple[int, str]],
     return '\n'.join(f"{lineno}: {text}" for lineno, text in entries)
 
 
-def compress_source(source: str, language: str,
-                    include_line_numbers: bool = True) -> str:
-    """! @brief Compress source code by removing comments, blank lines, and extra whitespace.
-    @param source The source code string.
+def _iter_text_lines(text: str) -> Iterator[str]:
+    """! @brief Yield the `\\n`-separated lines of a text without building a line list.
+    @param text Decoded source text.
+    @return Iterator equal to iterating `text.split('\\n')`.
+    """
+    start = 0
+    find = text.find
+    while True:
+        end = find('\n', start)
+        if end < 0:
+            yield text[start:]
+            return
+        yield text[start:end]
+        start = end + 1
+
+
+def iter_compressed_lines(source: str | SourceBuffer,
+                          language: str) -> Iterator[tuple[int, str]]:
+    """! @brief Compress source code lazily, yielding each kept line with its original line number.
+    @param source The source code string, or a SourceBuffer whose decoded text is used.
     @param language Language identifier (e.g. "python", "javascript").
-    @param include_line_numbers If True (default), prefix each line with <n>: format.
-    @return Compressed source code string.
-    @throws ValueError If language is unsupported.
-    @details Preserves indentation for indent-significant languages (Python, Haskell, Elixir).
+    @return Iterator of `(line_number, text)` tuples in source order; `line_number` is 1-based.
+    @throws ValueError If language is unsupported (raised by this call, before iteration).
+    @details Streaming core of `compress_source()`: lines are read one at a time and the remainder after a closing block comment or docstring is
+    re-processed in place, so no line list or result list is built.
+    @satisfies SRS-399
     """
     specs = _get_specs()
     lang_key = language.lower().strip().lstrip(".")
     if lang_key not in specs:
         raise ValueError(f"Unsupported language: {language}")
+    if isinstance(source, SourceBuffer):
+        source = source.text
+    return _compress_lines(_iter_text_lines(source), specs[lang_key], lang_key)
+
 
-    spec = specs[lang_key]
+def _compress_lines(lines: Iterable[str], spec, lang_key: str) -> Iterator[tuple[int, str]]:
+    """! @brief Generator behind `iter_compressed_lines()`.
+    @param lines Iterable of source lines without terminators.
+    @param spec LanguageSpec of `lang_key`.
+    @param lang_key Normalized language identifier.
+    @return Iterator of `(line_number, text)` tuples.
+    @details Preserves indentation for indent-significant languages (Python, Haskell, Elixir).
+    """
     preserve_indent = lang_key in INDENT_SIGNIFICANT
-    lines = source.split('\n')
-    result = []        # list of (original_line_number, text)
 
     in_multi_comment = False
     mc_end = spec.multi_comment_end
@@ -197,151 +160,151 @@ def compress_source(source: str, language: str,
     in_python_docstring = False
     python_docstring_delim = None
 
-    i = 0
-    while i < len(lines):
-        line = lines[i]
-
-        # --- Handle multi-line comment continuation ---
-        if in_multi_comment:
-            if mc_end and mc_end in line:
-                # End of multi-line comment found
-                end_pos = line.index(mc_end) + len(mc_end)
-                remainder = line[end_pos:]
-                in_multi_comment = False
-                # Process remainder as a new line
-                if remainder.strip():
-                    lines[i] = remainder
-                    continue
-            i += 1
-            continue
-
-        # --- Python docstrings (""" / ''') used as standalone comments ---
-        if is_python and in_python_docstring:
-            if python_docstring_delim and python_docstring_delim in line:
-                end_pos = line.index(python_docstring_delim) + len(python_docstring_delim)
-                remainder = line[end_pos:]
-                in_python_docstring = False
-                python_docstring_delim = None
-                if remainder.strip():
-                    lines[i] = remainder
-                    continue
-            i += 1
-            continue
-
-        stripped = line.strip()
-
-        # Skip empty lines
-        if not stripped:
-            i += 1
-            continue
-
-        # --- Detect multi-line comment start ---
-        if mc_start:
-            # For Python, triple-quotes can be strings or docstrings.
-            # We only strip standalone docstrings (line starts with triple-quote
-            # after optional whitespace).
-            if is_python:
-                for q in ('"""', "'''"):
-                    if stripped.startswith(q):
-                        # Single-line docstring: """..."""
-                        if stripped.count(q) >= 2 and stripped.endswith(q) and len(stripped) > 3:
-                            # Check it's not a variable assignment like x = """..."""
-                            leading = line[:len(line) - len(line.lstrip())]
-                            code_before = line[:line.index(q)].strip()
-                            if not code_before or code_before.endswith('='):
-                                # Standalone docstring or assigned — skip if standalone
+    for i, line in enumerate(lines):
+        # Each pass handles `line`; `continue` re-processes a comment remainder, `break` moves to the next line
+        while True:
+            # --- Handle multi-line comment continuation ---
+            if in_multi_comment:
+                if mc_end and mc_end in line:
+                    # End of multi-line comment found
+                    end_pos = line.index(mc_end) + len(mc_end)
+                    remainder = line[end_pos:]
+                    in_multi_comment = False
+                    # Process remainder as a new line
+                    if remainder.strip():
+                        line = remainder
+                        continue
+                break
+
+            # --- Python docstrings (""" / ''') used as standalone comments ---
+            if is_python and in_python_docstring:
+                if python_docstring_delim and python_docstring_delim in line:
+                    end_pos = line.index(python_docstring_delim) + len(python_docstring_delim)
+                    remainder = line[end_pos:]
+                    in_python_docstring = False
+                    python_docstring_delim = None
+                    if remainder.strip():
+                        line = remainder
+                        continue
+                break
+
+            stripped = line.strip()
+
+            # Skip empty lines
+            if not stripped:
+                break
+
+            # --- Detect multi-line comment start ---
+            if mc_start:
+                # For Python, triple-quotes can be strings or docstrings.
+                # We only strip standalone docstrings (line starts with triple-quote
+                # after optional whitespace).
+                if is_python:
+                    for q in ('"""', "'''"):
+                        if stripped.startswith(q):
+                            # Single-line docstring: """..."""
+                            if stripped.count(q) >= 2 and stripped.endswith(q) and len(stripped) > 3:
+                                # Check it's not a variable assignment like x = """..."""
+                                code_before = line[:line.index(q)].strip()
+                                if not code_before or code_before.endswith('='):
+                                    # Standalone docstring or assigned — skip if standalone
+                                    if not code_before:
+                                        line = None
+                                        break
+                                # If code before and not assignment, keep line
+                            elif stripped.startswith(q) and stripped.count(q) == 1:
+                                # Multi-line docstring start
+                                code_before = line[:line.index(q)].strip()
                                 if not code_before:
+                                    in_python_docstring = True
+                                    python_docstring_delim = q
                                     line = None
                                     break
-                            # If code before and not assignment, keep line
-                        elif stripped.startswith(q) and stripped.count(q) == 1:
-                            # Multi-line docstring start
-                            code_before = line[:line.index(q)].strip()
-                            if not code_before:
-                                in_python_docstring = True
-                                python_docstring_delim = q
-                                line = None
-                                break
-                if line is None:
-                    i += 1
-                    continue
-            else:
-                # Non-Python: check for multi-line comment start
-                mc_pos = stripped.find(mc_start)
-                if mc_pos != -1:
-                    # Check if inside a string
-                    full_pos = line.find(mc_start)
-                    if not _is_in_string(line, full_pos, string_delims):
-                        # Check for same-line close
-                        after_start = line[full_pos + len(mc_start):]
-                        close_pos = after_start.find(mc_end) if mc_end else -1
-                        if close_pos != -1 and mc_start != mc_end:
-                            # Single-line block comment: remove it
-                            before = line[:full_pos]
-                            after = after_start[close_pos + len(mc_end):]
-                            line = before + after
-                            if not line.strip():
-                                i += 1
+                    if line is None:
+                        break
+                else:
+                    # Non-Python: check for multi-line comment start
+                    mc_pos = stripped.find(mc_start)
+                    if mc_pos != -1:
+                        # Check if inside a string
+                        full_pos = line.find(mc_start)
+                        if not _is_in_string(line, full_pos, string_delims):
+                            # Check for same-line close
+                            after_start = line[full_pos + len(mc_start):]
+                            close_pos = after_start.find(mc_end) if mc_end else -1
+                            if close_pos != -1 and mc_start != mc_end:
+                                # Single-line block comment: remove it
+                                before = line[:full_pos]
+                                after = after_start[close_pos + len(mc_end):]
+                                line = before + after
+                                if not line.strip():
+                                    break
+                                # Re-process this reconstructed line
                                 continue
-                            # Re-process this reconstructed line
-                            lines[i] = line
-                            continue
-                        else:
-                            # Multi-line comment starts here
-                            before = line[:full_pos]
-                            in_multi_comment = True
-                            if before.strip():
-                                line = before
                             else:
-                                i += 1
-                                continue
+                                # Multi-line comment starts here
+                                before = line[:full_pos]
+                                in_multi_comment = True
+                                if before.strip():
+                                    line = before
+                                else:
+                                    break
+
+            # --- Full-line single-line comment ---
+            if spec.single_comment and stripped.startswith(spec.single_comment):
+                # Special: keep shebangs
+                if stripped.startswith('#!') and i == 0:
+                    yield (i + 1, stripped)
+                break
+
+            # --- Remove inline comment ---
+            if spec.single_comment:
+                line = _remove_inline_comment(line, spec.single_comment, string_delims)
+
+            # --- Clean whitespace ---
+            if preserve_indent:
+                # Keep leading whitespace, strip trailing
+                leading = line[:len(line) - len(line.lstrip())]
+                content = line.strip()
+                if not content:
+                    break
+                # Collapse internal multiple spaces (but not in strings)
+                line = leading + content
+            else:
+                line = line.strip()
+                if not line:
+                    break
+
+            # Remove trailing whitespace
+            line = line.rstrip()
 
-        # --- Full-line single-line comment ---
-        if spec.single_comment and stripped.startswith(spec.single_comment):
-            # Special: keep shebangs
-            if stripped.startswith('#!') and i == 0:
-                result.append((i + 1, stripped))
-            i += 1
-            continue
-
-        # --- Remove inline comment ---
-        if spec.single_comment:
-            line = _remove_inline_comment(line, spec.single_comment, string_delims)
-
-        # --- Clean whitespace ---
-        if preserve_indent:
-            # Keep leading whitespace, strip trailing
-            leading = line[:len(line) - len(line.lstrip())]
-            content = line.strip()
-            if not content:
-                i += 1
-                continue
-            # Collapse internal multiple spaces (but not in strings)
-            line = leading + content
-        else:
-            line = line.strip()
-            if not line:
-                i += 1
-                continue
-
-        # Remove trailing whitespace
-        line = line.rstrip()
-
-        if line:
-            result.append((i + 1, line))
-
-        i += 1
-
-    return _format_result(result, include_line_numbers)
+            if line:
+                yield (i + 1, line)
+            break
+
+
+def compress_source(source: str | SourceBuffer, language: str,
+                    include_line_numbers: bool = True) -> str:
+    """! @brief Compress source code by removing comments, blank lines, and extra whitespace.
+    @param source The source code string, or a SourceBuffer whose decoded text is used.
+    @param language Language identifier (e.g. "python", "javascript").
+    @param include_line_numbers If True (default), prefix each line with <n>: format.
+    @return Compressed source code string.
+    @throws ValueError If language is unsupported.
+    @details Preserves indentation for indent-significant languages (Python, Haskell, Elixir). Joins `iter_compressed_lines()`.
+    """
+    return _format_result(iter_compressed_lines(source, language), include_line_numbers)
 
 
 def compress_file(filepath: str, language: str | None = None,
-                  include_line_numbers: bool = True) -> str:
+                  include_line_numbers: bool = True,
+                  source: SourceBuffer | None = None) -> str:
     """!
     @brief Compress a source file by removing comments and extra whitespace.
         @param filepath Path to the source file.
         @param language Optional language override. Auto-detected if None.
         @param include_line_numbers If True (default), prefix each line with <n>: format.
+        @param source Optional pre-loaded SourceBuffer of `filepath`; when given the file is not read again.
         @return Compressed source code string.
         @throws ValueError If language cannot be detected.
     @details Implements the compress_file function behavior with deterministic control flow.
@@ -353,8 +316,8 @@ def compress_file(filepath: str, language: str | None = None,
                 f"Cannot detect language for '{filepath}'. "
                 "Use --lang to specify explicitly.")
 
-    with open(filepath, 'r', encoding='utf-8', errors='replace') as f:
-        source = f.read()
+    if source is None:
+        source = SourceBuffer.from_path(filepath)
 
     return compress_source(source, language, include_line_numbers)
 
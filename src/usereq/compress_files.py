@@ -9,9 +9,106 @@
 
 import os
 import sys
+from functools import partial
 from pathlib import Path
+from typing import Iterable, Iterator
 
-from .compress import compress_file, detect_language
+from . import profiling
+from .analysis_cache import AnalysisCache
+from .compress import _format_result, compress_file, detect_language
+from .jsonl_records import FORMAT_JSONL, FORMAT_MARKDOWN, RECORD_SEPARATOR, dump_records, file_record
+from .parallel import (
+    STATUS_FAIL,
+    STATUS_OK,
+    STATUS_SKIP,
+    FileOutcome,
+    emit_outcome,
+    iter_ordered,
+)
+
+
+DEDUP_MIN_LINES = 4
+"""! @brief Minimum number of consecutive compressed lines a repeated run must span to be replaced by a back-reference."""
+
+DEDUP_MIN_CHARS = 160
+"""! @brief Minimum total text length of a repeated run, so runs of short lines such as closing braces are never replaced."""
+
+DEDUP_REFERENCE = "[same as {path}:{start}-{end}]"
+"""! @brief Back-reference line emitted in place of a run already shown in an earlier file block."""
+
+
+class BoilerplateDeduplicator:
+    """! @brief Replace runs of compressed lines already emitted by an earlier file with back-references.
+    @details Files are fed in output order. Every window of `DEDUP_MIN_LINES` consecutive literal lines is indexed by its line hashes at its first
+    occurrence; in a later file, a window found in the index is extended line by line against the literal lines of the indexed file, and the whole run is
+    replaced by one `DEDUP_REFERENCE` line carrying the path and original line range of the first occurrence, so every reference points at text printed
+    verbatim. Only line hashes, line numbers, and literal flags are retained, never the line text. Runs inside the same file are kept.
+    """
+
+    __slots__ = ("_files", "_windows", "runs", "lines")
+
+    def __init__(self):
+        """! @brief Start with an empty index.
+        @return {None} Function return value.
+        """
+        self._files: list = []
+        self._windows: dict = {}
+        self.runs = 0
+        """! @brief Number of runs replaced so far."""
+        self.lines = 0
+        """! @brief Number of compressed lines replaced so far."""
+
+    def rewrite(self, path: str, entries: Iterable[tuple[int, str]]) -> Iterator[tuple[int, str]]:
+        """! @brief Feed the compressed lines of the next file and yield them with repeated runs replaced.
+        @param path Header-visible path of the file, used by later back-references.
+        @param entries `(line_number, text)` tuples of the file, as produced by `iter_compressed_lines()`.
+        @return Iterator of `(line_number, text)` tuples; a replaced run becomes one back-reference entry numbered with the run's first line.
+        @satisfies SRS-399
+        """
+        entries = list(entries)
+        hashes = [hash(text) for _, text in entries]
+        numbers = [number for number, _ in entries]
+        count = len(entries)
+        literal = [True] * count
+        file_id = len(self._files)
+        self._files.append((path, numbers, hashes, literal))
+        windows = self._windows
+        i = 0
+        while i < count:
+            found = windows.get(tuple(hashes[i:i + DEDUP_MIN_LINES])) if i + DEDUP_MIN_LINES <= count else None
+            if found is not None:
+                source_id, start = found
+                source_path, source_numbers, source_hashes, source_literal = self._files[source_id]
+                length = DEDUP_MIN_LINES
+                while (i + length < count and start + length < len(source_hashes) and source_literal[start + length]
+                       and hashes[i + length] == source_hashes[start + length]):
+                    length += 1
+                if sum(len(text) for _, text in entries[i:i + length]) >= DEDUP_MIN_CHARS:
+                    yield (numbers[i], DEDUP_REFERENCE.format(
+                        path=source_path, start=source_numbers[start], end=source_numbers[start + length - 1]))
+                    for k in range(i, i + length):
+                        literal[k] = False
+                    self.runs += 1
+                    self.lines += length
+                    i += length
+                    continue
+            yield entries[i]
+            i += 1
+        for k in range(count - DEDUP_MIN_LINES + 1):
+            if all(literal[k:k + DEDUP_MIN_LINES]):
+                windows.setdefault(tuple(hashes[k:k + DEDUP_MIN_LINES]), (file_id, k))
+
+
+def _parse_numbered(compressed_with_line_numbers: str) -> Iterator[tuple[int, str]]:
+    """! @brief Parse compressed output with <n>: prefixes back into entries.
+    @param compressed_with_line_numbers Compressed payload generated with include_line_numbers=True.
+    @return Iterator of `(line_number, text)` tuples.
+    """
+    if not compressed_with_line_numbers:
+        return
+    for line in compressed_with_line_numbers.split("\n"):
+        number, _, text = line.partition(": ")
+        yield int(number), text
 
 
 def _extract_line_range(compressed_with_line_numbers: str) -> tuple[int, int]:
@@ -46,65 +143,198 @@ def _format_output_path(filepath: str, output_base: Path | None) -> str:
     return Path(os.path.relpath(absolute_path, output_base)).as_posix()
 
 
-def compress_files(filepaths: list[str],
-                   include_line_numbers: bool = True,
-                   verbose: bool = False,
-                   output_base: Path | None = None) -> str:
-    """! @brief Compress multiple source files and concatenate with identifying headers.
+def _strip_line_numbers(compressed_with_line_numbers: str) -> str:
+    """! @brief Remove <n>: prefixes from compressed output.
+    @param compressed_with_line_numbers Compressed payload generated with include_line_numbers=True.
+    @return Payload identical to compress_source(..., include_line_numbers=False).
+    @details Every emitted line has the exact form `<n>: <text>`, so dropping the text before the first `: ` restores the unnumbered rendering without a second
+    compression pass.
+    """
+    if not compressed_with_line_numbers:
+        return compressed_with_line_numbers
+    return "\n".join(
+        line.partition(": ")[2] for line in compressed_with_line_numbers.split("\n")
+    )
+
+
+def _cached_compress(
+    fpath: str,
+    lang: str,
+    cache: AnalysisCache | None,
+) -> str:
+    """! @brief Compress one file with line numbers, reusing the persistent cache when enabled.
+    @param fpath Source file path.
+    @param lang Canonical language identifier.
+    @param cache Optional persistent analysis cache.
+    @return Compressed source text with <n>: prefixes.
+    """
+    if cache is None:
+        with profiling.span("compress"):
+            return compress_file(fpath, lang, True)
+
+    def _compute(buffer):
+        with profiling.span("compress"):
+            return compress_file(fpath, lang, True, source=buffer)
+
+    return cache.get_or_compute(fpath, f"compress.{lang}", _compute)
+
+
+def _compress_one(
+    fpath: str,
+    include_line_numbers: bool,
+    output_base: Path | None,
+    cache: AnalysisCache | None = None,
+    render: bool = True,
+    output_format: str = FORMAT_MARKDOWN,
+) -> FileOutcome:
+    """! @brief Compress one source file and render its identifying block.
+    @param fpath Source file path.
+    @param include_line_numbers If True, keep <n>: prefixes in code block lines.
+    @param output_base Resolved project-home base used to relativize the header path, or None.
+    @param cache Optional persistent analysis cache.
+    @param render If False, the payload is the compressed text with <n>: prefixes instead of the rendered block, for the ordered dedup stage.
+    @param output_format `markdown` or `jsonl` rendering of the block.
+    @return FileOutcome with status OK and the rendered block, SKIP with the skip reason, or FAIL with the exception text.
+    @details Top-level picklable worker executed either in-process or inside the `parallel` process pool.
+    """
+    if not os.path.isfile(fpath):
+        return FileOutcome(STATUS_SKIP, fpath, note="not found")
+
+    lang = detect_language(fpath)
+    if not lang:
+        return FileOutcome(STATUS_SKIP, fpath, note="unsupported extension")
+
+    try:
+        compressed_with_line_numbers = _cached_compress(fpath, lang, cache)
+        if not render:
+            return FileOutcome(STATUS_OK, fpath, payload=compressed_with_line_numbers)
+        block = _render_block(
+            _format_output_path(fpath, output_base),
+            lang,
+            compressed_with_line_numbers,
+            compressed_with_line_numbers if include_line_numbers else _strip_line_numbers(compressed_with_line_numbers),
+            output_format,
+        )
+    except Exception as e:
+        return FileOutcome(STATUS_FAIL, fpath, note=str(e))
+    return FileOutcome(STATUS_OK, fpath, payload=block)
+
+
+def _render_block(
+    output_path: str,
+    lang: str,
+    compressed_with_line_numbers: str,
+    compressed: str,
+    output_format: str = FORMAT_MARKDOWN,
+) -> str:
+    """! @brief Render the identifying block of one compressed file.
+    @param output_path Header-visible file path.
+    @param lang Canonical language identifier.
+    @param compressed_with_line_numbers Full compressed payload with <n>: prefixes, used for the line range.
+    @param compressed Code block body.
+    @param output_format `markdown`, or `jsonl` for one `file` record carrying `line_start`, `line_end`, and the body as `code`.
+    @return Block made of the `@@@ <path> | <lang>` header, the `> Lines: <start>-<end>` metadata, and the fenced body; or the JSON Lines record.
+    @satisfies SRS-400
+    """
+    line_start, line_end = _extract_line_range(compressed_with_line_numbers)
+    if output_format == FORMAT_JSONL:
+        return dump_records([file_record(output_path, lang, line_start=line_start, line_end=line_end, code=compressed)])
+    return f"@@@ {output_path} | {lang}\n> Lines: {line_start}-{line_end}\n```\n{compressed}\n```"
+
+
+def iter_compressed_sections(filepaths: list[str],
+                             include_line_numbers: bool = True,
+                             verbose: bool = False,
+                             output_base: Path | None = None,
+                             jobs: int | None = 1,
+                             cache: AnalysisCache | None = None,
+                             dedup: bool = False,
+                             output_format: str = FORMAT_MARKDOWN) -> Iterator[str]:
+    """! @brief Compress multiple source files and yield output fragments as each file completes.
     @param filepaths List of source file paths.
     @param include_line_numbers If True (default), keep <n>: prefixes in code block lines.
     @param verbose If True, emits progress status messages on stderr.
     @param output_base Project-home base used to render header paths as relative paths.
-    @return Concatenated compressed output string.
-    @throws ValueError If no files could be processed.
-    @details Each file is compressed and emitted as: header line `@@@ <path> | <lang>`, line-range metadata `> Lines: <start>-<end>`, and fenced code block delimited by triple backticks. Line range is derived from the already computed <n>: prefixes to preserve existing numbering logic. Files are separated by a blank line.
+    @param jobs Worker process count; `1` (default) runs sequentially, `None` selects the CPU core count.
+    @param cache Optional persistent analysis cache reused across runs.
+    @param dedup If True, runs repeated from an earlier file block are replaced by `BoilerplateDeduplicator` back-references.
+    @param output_format `markdown` (default) or `jsonl`; JSON Lines payloads are separated by `RECORD_SEPARATOR` instead of a blank line.
+    @return Iterator over fragments whose concatenation equals `compress_files()` output.
+    @throws ValueError If no files could be processed (raised before any fragment when nothing succeeds).
+    @details File blocks and their blank-line separators are yielded separately in input order for bounded-memory streaming. Deduplication runs on the
+    ordered results in this process, so its output does not depend on `jobs`; the `> Lines:` range keeps the full compressed range.
+    @satisfies SRS-375, SRS-376, SRS-382, SRS-399, SRS-400
     """
-    parts = []
     ok_count = 0
     fail_count = 0
     resolved_output_base = output_base.resolve() if output_base is not None else None
+    deduplicator = BoilerplateDeduplicator() if dedup else None
+    separator = RECORD_SEPARATOR if output_format == FORMAT_JSONL else "\n\n"
 
-    for fpath in filepaths:
-        if not os.path.isfile(fpath):
-            if verbose:
-                print(f"  SKIP  {fpath} (not found)", file=sys.stderr)
-            continue
-
-        lang = detect_language(fpath)
-        if not lang:
-            if verbose:
-                print(f"  SKIP  {fpath} (unsupported extension)", file=sys.stderr)
-            continue
-
-        try:
-            compressed_with_line_numbers = compress_file(fpath, lang, True)
-            line_start, line_end = _extract_line_range(compressed_with_line_numbers)
-            compressed = (
-                compressed_with_line_numbers
-                if include_line_numbers
-                else compress_file(fpath, lang, False)
-            )
-            output_path = _format_output_path(fpath, resolved_output_base)
-            header = f"@@@ {output_path} | {lang}"
-            parts.append(
-                f"{header}\n> Lines: {line_start}-{line_end}\n```\n{compressed}\n```"
-            )
+    worker = partial(
+        _compress_one,
+        include_line_numbers=include_line_numbers,
+        output_base=resolved_output_base,
+        cache=cache,
+        render=deduplicator is None,
+        output_format=output_format,
+    )
+    for outcome in iter_ordered(worker, filepaths, jobs):
+        emit_outcome(outcome, verbose)
+        if outcome.status == STATUS_OK:
+            if ok_count:
+                yield separator
+            if deduplicator is None:
+                yield outcome.payload
+            else:
+                output_path = _format_output_path(outcome.path, resolved_output_base)
+                entries = deduplicator.rewrite(output_path, _parse_numbered(outcome.payload))
+                yield _render_block(
+                    output_path,
+                    detect_language(outcome.path),
+                    outcome.payload,
+                    _format_result(entries, include_line_numbers),
+                    output_format,
+                )
             ok_count += 1
-            if verbose:
-                print(f"  OK    {fpath}", file=sys.stderr)
-        except Exception as e:
-            if verbose:
-                print(f"  FAIL  {fpath} ({e})", file=sys.stderr)
+        elif outcome.status == STATUS_FAIL:
             fail_count += 1
 
-    if not parts:
+    if not ok_count:
         raise ValueError("No valid source files processed")
 
     if verbose:
         print(f"\n  Compressed: {ok_count} ok, {fail_count} failed",
               file=sys.stderr)
+        if deduplicator is not None:
+            print(f"  Deduplicated: {deduplicator.runs} runs, {deduplicator.lines} lines",
+                  file=sys.stderr)
 
-    return "\n\n".join(parts)
+
+def compress_files(filepaths: list[str],
+                   include_line_numbers: bool = True,
+                   verbose: bool = False,
+                   output_base: Path | None = None,
+                   jobs: int | None = 1,
+                   cache: AnalysisCache | None = None,
+                   dedup: bool = False,
+                   output_format: str = FORMAT_MARKDOWN) -> str:
+    """! @brief Compress multiple source files and concatenate with identifying headers.
+    @param filepaths List of source file paths.
+    @param include_line_numbers If True (default), keep <n>: prefixes in code block lines.
+    @param verbose If True, emits progress status messages on stderr.
+    @param output_base Project-home base used to render header paths as relative paths.
+    @param jobs Worker process count; `1` (default) runs sequentially, `None` selects the CPU core count.
+    @param cache Optional persistent analysis cache reused across runs.
+    @param dedup If True, runs repeated from an earlier file block are replaced by back-references.
+    @param output_format `markdown` (default) or `jsonl`.
+    @return Concatenated compressed output string.
+    @throws ValueError If no files could be processed.
+    @details Each file is compressed and emitted as: header line `@@@ <path> | <lang>`, line-range metadata `> Lines: <start>-<end>`, and fenced code block delimited by triple backticks. Line range is derived from the already computed <n>: prefixes to preserve existing numbering logic. Files are separated by a blank line. Per-file work runs on the `parallel` worker pool and is merged in input order. Joins `iter_compressed_sections()`.
+    @satisfies SRS-375, SRS-376, SRS-399
+    """
+    return "".join(iter_compressed_sections(
+        filepaths, include_line_numbers, verbose, output_base, jobs, cache, dedup, output_format))
 
 
 def main():
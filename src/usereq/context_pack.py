@@ -0,0 +1,291 @@
+"""!
+@file context_pack.py
+@brief Token-budget packing of `--references` and `--compress` output.
+@details Files are ranked by priority (dirty or untracked in git, then referenced by name from `REQUIREMENTS.md`, then the rest, keeping input order within a tier)
+and emitted at the richest level that still fits the remaining budget: the full section, a signatures-only view built from the enriched elements, or tree-only
+(a header stub, or nothing when the file is already listed in the output header). Tokens are counted per fragment with the shared `TokenCounter`; every fragment
+boundary is placed after a newline followed by non-whitespace, where tiktoken never joins pre-tokenizer pieces, so the per-fragment sum equals the token count of
+the written output.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import re
+from functools import partial
+from pathlib import Path
+from typing import Callable, Iterator, Optional
+
+from .analysis_cache import AnalysisCache, load_analysis
+from .parallel import STATUS_OK, emit_outcome, iter_ordered
+from .token_counter import get_token_counter
+
+PACK_LEVELS = ("full", "signatures", "tree")
+"""! @brief Degradation levels in preference order."""
+
+_SIGNATURE_SKIP_PREFIXES = ("COMMENT", "IMPORT")
+"""! @brief Element type name prefixes excluded from signatures-only views."""
+
+
+def rank_files(files: list[str], project_base: Path, requirements_text: str = "") -> list[str]:
+    """! @brief Order files by packing priority.
+    @param files Source file paths in scan order.
+    @param project_base Project root used for git status and relative paths.
+    @param requirements_text Content of `REQUIREMENTS.md`, or empty.
+    @return Files dirty or untracked in git first, then files whose relative path or basename occurs in `requirements_text`, then the rest; scan order is kept
+    within each tier.
+    """
+    from .incremental import git_dirty_paths
+
+    dirty = git_dirty_paths(project_base) or set()
+    base = Path(project_base).resolve()
+
+    def _tier(fpath: str) -> int:
+        absolute = Path(fpath).resolve()
+        if str(absolute) in dirty:
+            return 0
+        try:
+            relative = absolute.relative_to(base).as_posix()
+        except ValueError:
+            relative = absolute.as_posix()
+        for name in (relative, absolute.name):
+            if re.search(rf"(?<![\w.-]){re.escape(name)}(?![\w-])", requirements_text):
+                return 1
+        return 2
+
+    return sorted(files, key=_tier)
+
+
+def render_signatures(fpath: str, heading: str, cache: Optional[AnalysisCache] = None) -> Optional[str]:
+    """! @brief Render the signatures-only view of one file.
+    @param fpath Source file path.
+    @param heading First lines of the view (the command's file header).
+    @param cache Optional persistent analysis cache.
+    @return Heading followed by one bullet per named definition (type label, signature or name, line range; indented by nesting depth), or None when the file
+    cannot be analyzed.
+    """
+    from .compress import detect_language
+    from .generate_markdown import _get_analyzer
+
+    lang = detect_language(fpath)
+    if not lang:
+        return None
+    try:
+        elements, _ = load_analysis(_get_analyzer(), fpath, lang, cache)
+    except Exception:
+        return None
+    lines = [heading, "> Signatures only (token budget)"]
+    for element in sorted(elements, key=lambda item: (item.line_start, item.line_end)):
+        if not element.name or element.element_type.name.startswith(_SIGNATURE_SKIP_PREFIXES):
+            continue
+        indent = "  " * getattr(element, "depth", 0)
+        lines.append(
+            f"{indent}- {element.type_label} `{element.signature or element.name}` "
+            f"(L{element.line_start}-{element.line_end})"
+        )
+    return "\n".join(lines)
+
+
+class TokenPacker:
+    """! @brief Greedy budgeted assembler of output sections.
+    @details Tracks the exact token count of `header + "\\n\\n" + separator.join(sections) + "\\n"`: the last section is counted with the final newline and
+    re-counted with the separator once another section follows it.
+    """
+
+    def __init__(self, budget: int, separator: str, header: Optional[str] = None,
+                 encoding_name: str = "cl100k_base"):
+        """! @brief Start an empty pack.
+        @param budget Maximum token count of the written output.
+        @param separator Text written between sections.
+        @param header Optional text written before the first section, followed by a blank line.
+        @param encoding_name Tiktoken encoding name.
+        @return {None} Function return value.
+        @throws ValueError If the header alone exceeds the budget.
+        """
+        self.budget = budget
+        self.separator = separator
+        self.counter = get_token_counter(encoding_name)
+        self.sections: list[str] = []
+        self.levels = {level: 0 for level in PACK_LEVELS}
+        self.omitted = 0
+        self._closed_cost = 0
+        self._last_open = 0
+        self._last_closed = 0
+        if header is not None:
+            self._closed_cost = self.counter.count_tokens(f"{header}\n\n")
+            if self._closed_cost > budget:
+                raise ValueError(
+                    f"Token budget {budget} is smaller than the output header ({self._closed_cost} tokens)."
+                )
+
+    @property
+    def used(self) -> int:
+        """! @brief Return the token count of the output assembled so far.
+        @return Exact token count including the final newline.
+        """
+        return self._closed_cost + self._last_open
+
+    def offer(self, alternatives: list) -> Optional[str]:
+        """! @brief Add the first alternative that fits the remaining budget.
+        @param alternatives `(level, text)` pairs in preference order; a None text is skipped, an empty text is accepted at no cost and not emitted.
+        @return Accepted level, or None when no alternative fits (the file is omitted).
+        """
+        for level, text in alternatives:
+            if text is None:
+                continue
+            if text == "":
+                self.levels[level] += 1
+                return level
+            open_cost = self.counter.count_tokens(f"{text}\n")
+            total = self._closed_cost + open_cost
+            closed_previous = 0
+            if self.sections:
+                if not self._last_closed:
+                    self._last_closed = self.counter.count_tokens(f"{self.sections[-1]}{self.separator}")
+                closed_previous = self._last_closed
+                total += closed_previous
+            if total > self.budget:
+                continue
+            self._closed_cost += closed_previous
+            self._last_open = open_cost
+            self._last_closed = 0
+            self.sections.append(text)
+            self.levels[level] += 1
+            return level
+        self.omitted += 1
+        return None
+
+    def fragments(self) -> Iterator[str]:
+        """! @brief Yield the accepted sections and separators in output order.
+        @return Iterator over output fragments.
+        """
+        for index, section in enumerate(self.sections):
+            if index:
+                yield self.separator
+            yield section
+
+    def summary(self) -> str:
+        """! @brief Describe budget use and degradation.
+        @return One-line summary.
+        """
+        levels = ", ".join(f"{count} {level}" for level, count in self.levels.items())
+        return f"Token budget: {self.used}/{self.budget} tokens; {levels}, {self.omitted} omitted"
+
+
+def pack_outcomes(
+    packer: TokenPacker,
+    ranked: list[str],
+    worker: Callable,
+    degrade: Callable[[str, str], list],
+    jobs: Optional[int] = 1,
+    verbose: bool = False,
+) -> TokenPacker:
+    """! @brief Render ranked files and offer each to the packer.
+    @param packer Target TokenPacker.
+    @param ranked Files in priority order.
+    @param worker Picklable per-file worker returning a `FileOutcome` with the full section.
+    @param degrade Callable `(fpath, full_section)` returning the signatures and tree alternatives.
+    @param jobs Worker process count for full rendering.
+    @param verbose If True, emits per-file progress on stderr.
+    @return The packer, for chaining.
+    @satisfies SRS-389
+    """
+    for outcome in iter_ordered(worker, ranked, jobs):
+        emit_outcome(outcome, verbose)
+        if outcome.status != STATUS_OK:
+            continue
+        packer.offer([("full", outcome.payload), *degrade(outcome.path, outcome.payload)])
+    return packer
+
+
+def pack_references(
+    files: list[str],
+    project_base: Path,
+    budget: int,
+    header: str,
+    requirements_text: str = "",
+    jobs: Optional[int] = 1,
+    cache: Optional[AnalysisCache] = None,
+    verbose: bool = False,
+) -> TokenPacker:
+    """! @brief Pack `--references` sections into a token budget.
+    @param files Project source files.
+    @param project_base Project root; rendered paths are relative to it.
+    @param budget Maximum output tokens including the header.
+    @param header Files Structure header listing every file.
+    @param requirements_text Content of `REQUIREMENTS.md` used for ranking.
+    @param jobs Worker process count.
+    @param cache Optional persistent analysis cache.
+    @param verbose If True, emits per-file progress on stderr.
+    @return Filled TokenPacker. Tree-only files contribute no section, since the header already lists them.
+    @throws ValueError If the header alone exceeds the budget.
+    """
+    from .generate_markdown import SECTION_SEPARATOR, _format_output_path, _render_file
+
+    base = Path(project_base).resolve()
+    packer = TokenPacker(budget, SECTION_SEPARATOR, header)
+
+    def _degrade(fpath: str, full: str) -> list:
+        heading = full.split("\n", 1)[0]
+        heading = f"{heading}\n> Path: `{_format_output_path(fpath, base)}`"
+        return [("signatures", render_signatures(fpath, heading, cache)), ("tree", "")]
+
+    return pack_outcomes(
+        packer,
+        rank_files(files, base, requirements_text),
+        partial(_render_file, output_base=base, cache=cache),
+        _degrade,
+        jobs,
+        verbose,
+    )
+
+
+def pack_compressed(
+    files: list[str],
+    project_base: Path,
+    budget: int,
+    include_line_numbers: bool = True,
+    requirements_text: str = "",
+    jobs: Optional[int] = 1,
+    cache: Optional[AnalysisCache] = None,
+    verbose: bool = False,
+) -> TokenPacker:
+    """! @brief Pack `--compress` blocks into a token budget.
+    @param files Project source files.
+    @param project_base Project root; header paths are relative to it.
+    @param budget Maximum output tokens.
+    @param include_line_numbers If True, keep <n>: prefixes in full blocks.
+    @param requirements_text Content of `REQUIREMENTS.md` used for ranking.
+    @param jobs Worker process count.
+    @param cache Optional persistent analysis cache.
+    @param verbose If True, emits per-file progress on stderr.
+    @return Filled TokenPacker. Tree-only files keep their `@@@ <path> | <lang>` header line.
+    """
+    from .compress_files import _compress_one
+
+    base = Path(project_base).resolve()
+    packer = TokenPacker(budget, "\n\n")
+
+    def _degrade(fpath: str, full: str) -> list:
+        heading = full.split("\n", 1)[0]
+        return [("signatures", render_signatures(fpath, heading, cache)), ("tree", heading)]
+
+    return pack_outcomes(
+        packer,
+        rank_files(files, base, requirements_text),
+        partial(_compress_one, include_line_numbers=include_line_numbers, output_base=base, cache=cache),
+        _degrade,
+        jobs,
+        verbose,
+    )
+
+
+def read_requirements_text(docs_dir: Path) -> str:
+    """! @brief Read `REQUIREMENTS.md` from a docs directory.
+    @param docs_dir Documentation directory.
+    @return File content, or an empty string when it is missing or unreadable.
+    """
+    try:
+        return (Path(docs_dir) / "REQUIREMENTS.md").read_text(encoding="utf-8", errors="replace")
+    except OSError:
+        return ""
+
@@ -10,9 +10,23 @@
 import os
 import re
 import sys
+from functools import partial
+from typing import Iterator
 
+from . import profiling
 from .doxygen_parser import format_doxygen_fields_as_markdown, parse_doxygen_comment
+from .analysis_cache import AnalysisCache, load_analysis
+from .jsonl_records import FORMAT_JSONL, FORMAT_MARKDOWN, RECORD_SEPARATOR, construct_record, dump_records, file_record
+from .parallel import (
+    STATUS_FAIL,
+    STATUS_OK,
+    STATUS_SKIP,
+    FileOutcome,
+    emit_outcome,
+    iter_ordered,
+)
 from .source_analyzer import SourceAnalyzer
+from .source_buffer import SourceBuffer
 from .compress import compress_source, detect_language
 
 
@@ -81,7 +95,8 @@ def construct_matches(element, tag_set: set[str], pattern: str) -> bool:
     @param tag_set Set of requested TAG identifiers.
     @param pattern Regex pattern string to test against element name.
     @return True if element type is in tag_set and name matches pattern.
-    @details Validates the element type and then applies the regex search on the element name.
+    @details Validates the element type and then applies the regex search on the element name. Single-element helper; bulk queries build one
+    `ConstructMatcher` instead.
     """
     if element.type_label not in tag_set:
         return False
@@ -93,6 +108,78 @@ def construct_matches(element, tag_set: set[str], pattern: str) -> bool:
         return False
 
 
+_REGEX_METACHARACTERS = re.compile(r"[.^$*+?{}\[\]\\|()]")
+"""! @brief Characters that give a pattern regex meaning beyond plain text."""
+
+
+class ConstructMatcher:
+    """! @brief Tag filter and name pattern compiled once per construct query.
+    @details Patterns whose body (after an optional leading `^` and trailing `$`) has no regex metacharacters are answered with substring, prefix, suffix, or
+    equality checks; all others use the precompiled regex. Names containing a newline always use the regex so `$` keeps its before-final-newline semantics.
+    Instances are picklable for the `parallel` process pool.
+    """
+
+    __slots__ = ("tag_set", "pattern", "regex", "kind", "literal")
+
+    def __init__(self, tag_set: set[str], pattern: str):
+        """! @brief Compile the pattern and select the matching strategy.
+        @param tag_set Set of requested TAG identifiers.
+        @param pattern Regex pattern string matched with `re.search` semantics against construct names.
+        @return {None} Function return value.
+        @throws ValueError If the pattern is not a valid regular expression.
+        @satisfies SRS-387
+        """
+        try:
+            self.regex = re.compile(pattern)
+        except re.error as e:
+            raise ValueError(f"Invalid regex pattern '{pattern}': {e}") from None
+        self.tag_set = set(tag_set)
+        self.pattern = pattern
+        body = pattern[1:] if pattern.startswith("^") else pattern
+        anchored_end = body.endswith("$")
+        if anchored_end:
+            body = body[:-1]
+        self.kind = "regex"
+        self.literal = body
+        if body and not _REGEX_METACHARACTERS.search(body):
+            if pattern.startswith("^"):
+                self.kind = "equal" if anchored_end else "prefix"
+            else:
+                self.kind = "suffix" if anchored_end else "substring"
+
+    def match_name(self, name: str) -> bool:
+        """! @brief Test one construct name against the pattern.
+        @param name Non-empty construct name.
+        @return True when `re.search(pattern, name)` would match.
+        """
+        if self.kind == "regex" or "\n" in name:
+            return self.regex.search(name) is not None
+        if self.kind == "substring":
+            return self.literal in name
+        if self.kind == "prefix":
+            return name.startswith(self.literal)
+        if self.kind == "equal":
+            return name == self.literal
+        return name.endswith(self.literal)
+
+    def matches(self, element) -> bool:
+        """! @brief Check if a source element matches tag filter and pattern.
+        @param element SourceElement instance or symbol index record.
+        @return Same result as `construct_matches(element, tag_set, pattern)` for a valid pattern.
+        """
+        return element.type_label in self.tag_set and bool(element.name) and self.match_name(element.name)
+
+    def any_name(self, names) -> bool:
+        """! @brief Check whether any name of a set can match.
+        @param names Set of construct names of one file.
+        @return False when no name matches, so the file's records need not be tested.
+        @details Equality patterns use one set lookup; other patterns test each distinct name once.
+        """
+        if self.kind == "equal":
+            return self.literal in names or f"{self.literal}\n" in names
+        return any(name and self.match_name(name) for name in names)
+
+
 def _merge_doxygen_fields(
     base_fields: dict[str, list[str]],
     extra_fields: dict[str, list[str]],
@@ -201,13 +288,13 @@ def _strip_construct_comments(
 
 def format_construct(
     element,
-    source_lines: list[str],
+    source_lines: list[str] | SourceBuffer,
     include_line_numbers: bool,
     language: str = "python",
 ) -> str:
     """! @brief Format a single matched construct for markdown output with complete code extraction.
     @param element SourceElement instance containing line range indices.
-    @param source_lines Complete source file content as list of lines.
+    @param source_lines Complete source file content as list of lines, or the file SourceBuffer.
     @param include_line_numbers If True, prefix code lines with <n>: format.
     @param language Normalized source language key used for comment stripping.
     @return Formatted markdown block for the construct with complete code from line_start to line_end.
@@ -226,7 +313,10 @@ def format_construct(
         lines.extend(dox_lines)
 
     # Extract COMPLETE code block from source file and strip comments
-    code_lines = source_lines[element.line_start - 1:element.line_end]
+    if isinstance(source_lines, SourceBuffer):
+        code_lines = source_lines.slice_lines(element.line_start, element.line_end)
+    else:
+        code_lines = source_lines[element.line_start - 1:element.line_end]
     formatted = _strip_construct_comments(
         code_lines=code_lines,
         language=language,
@@ -241,104 +331,299 @@ def format_construct(
     return "\n".join(lines)
 
 
-def find_constructs_in_files(
+_ANALYZER: SourceAnalyzer | None = None
+"""! @brief Process-local analyzer cache populated by `_get_analyzer`."""
+
+
+def _get_analyzer() -> SourceAnalyzer:
+    """! @brief Return the process-local shared SourceAnalyzer instance.
+    @return Lazily created analyzer reused by every file processed in the current process.
+    """
+    global _ANALYZER
+    if _ANALYZER is None:
+        _ANALYZER = SourceAnalyzer()
+    return _ANALYZER
+
+
+def _render_file_block(
+    fpath: str,
+    lang: str,
+    source: SourceBuffer,
+    matches: list,
+    file_level_doxygen_fields: dict[str, list[str]],
+    include_line_numbers: bool,
+    output_format: str = FORMAT_MARKDOWN,
+) -> str:
+    """! @brief Render the output block of one file with at least one match.
+    @param fpath Source file path shown in the header.
+    @param lang Canonical language identifier.
+    @param source File SourceBuffer providing construct code.
+    @param matches Matched elements or symbol index records, in source order.
+    @param file_level_doxygen_fields File-level Doxygen fields (may be empty).
+    @param include_line_numbers If True, prefix code lines with <n>: format.
+    @param output_format `markdown`, or `jsonl` for one `file` record followed by one `construct` record per match.
+    @return Markdown block: header, optional file-level Doxygen lines, and the formatted constructs; or the newline-joined JSON Lines records.
+    @details JSON Lines `code` equals the fenced code block of the markdown rendering.
+    @satisfies SRS-400
+    """
+    if output_format == FORMAT_JSONL:
+        with profiling.span("find.render"):
+            return dump_records(_construct_records(
+                fpath, lang, source, matches, file_level_doxygen_fields, include_line_numbers))
+    header = f"@@@ {fpath} | {lang}"
+    with profiling.span("find.render"):
+        constructs_md = "\n\n".join(
+            format_construct(
+                el,
+                source,
+                include_line_numbers,
+                language=lang,
+            )
+            for el in matches
+        )
+    if file_level_doxygen_fields:
+        file_level_block = "\n".join(format_doxygen_fields_as_markdown(file_level_doxygen_fields))
+        return f"{header}\n{file_level_block}\n\n{constructs_md}"
+    return f"{header}\n\n{constructs_md}"
+
+
+def _construct_records(
+    fpath: str,
+    lang: str,
+    source: SourceBuffer,
+    matches: list,
+    file_level_doxygen_fields: dict[str, list[str]],
+    include_line_numbers: bool,
+) -> Iterator[dict]:
+    """! @brief Yield the JSON Lines records of one file with at least one match.
+    @param fpath Source file path.
+    @param lang Canonical language identifier.
+    @param source File SourceBuffer providing construct code.
+    @param matches Matched elements or symbol index records, in source order.
+    @param file_level_doxygen_fields File-level Doxygen fields (may be empty).
+    @param include_line_numbers If True, prefix code lines with <n>: format.
+    @return Iterator over the `file` record and the `construct` records.
+    """
+    yield file_record(fpath, lang, doxygen_fields=file_level_doxygen_fields)
+    for element in matches:
+        code = _strip_construct_comments(
+            code_lines=source.slice_lines(element.line_start, element.line_end),
+            language=lang,
+            line_start=element.line_start,
+            include_line_numbers=include_line_numbers,
+        )
+        yield construct_record(fpath, element, _extract_construct_doxygen_fields(element), code)
+
+
+def _find_in_file(
+    fpath: str,
+    matcher: ConstructMatcher,
+    include_line_numbers: bool,
+    cache: AnalysisCache | None = None,
+    output_format: str = FORMAT_MARKDOWN,
+) -> FileOutcome:
+    """! @brief Extract matching constructs from one source file.
+    @param fpath Source file path.
+    @param matcher Compiled tag filter and name pattern.
+    @param include_line_numbers If True, prefix code lines with <n>: format.
+    @param cache Optional persistent analysis cache.
+    @param output_format `markdown` or `jsonl` rendering of the file block.
+    @return FileOutcome with status OK, the rendered file block, and the match count; SKIP with the skip reason; or FAIL with the exception text.
+    @details Top-level picklable worker executed either in-process or inside the `parallel` process pool.
+    """
+    if not os.path.isfile(fpath):
+        return FileOutcome(STATUS_SKIP, fpath, note="not found")
+
+    lang = detect_language(fpath)
+    if not lang:
+        return FileOutcome(STATUS_SKIP, fpath, note="unsupported extension")
+
+    # Check if language supports at least one requested tag
+    if not language_supports_tags(lang, matcher.tag_set):
+        return FileOutcome(
+            STATUS_SKIP,
+            fpath,
+            note=f"language {lang} does not support any requested tags",
+        )
+
+    try:
+        # Read complete source file once for analysis and full construct extraction
+        source = SourceBuffer.from_path(fpath)
+        elements, _ = load_analysis(_get_analyzer(), fpath, lang, cache, source)
+
+        # Filter elements matching tag and pattern
+        matches = [el for el in elements if matcher.matches(el)]
+        if not matches:
+            return FileOutcome(STATUS_SKIP, fpath, note="no matches")
+
+        block = _render_file_block(
+            fpath, lang, source, matches,
+            _extract_file_level_doxygen_fields(elements), include_line_numbers, output_format,
+        )
+    except Exception as e:
+        return FileOutcome(STATUS_FAIL, fpath, note=str(e))
+    return FileOutcome(
+        STATUS_OK,
+        fpath,
+        payload=block,
+        note=f"{len(matches)} matches",
+        count=len(matches),
+    )
+
+
+def _find_in_indexed_file(
+    item: tuple,
+    matcher: ConstructMatcher,
+    include_line_numbers: bool,
+    cache: AnalysisCache | None = None,
+    output_format: str = FORMAT_MARKDOWN,
+) -> FileOutcome:
+    """! @brief Render one file from its symbol index entry.
+    @param item Tuple `(fpath, entry, matches)`: the requested path, its `FileEntry` (None when not indexable), and the matched records in source order.
+    @param matcher Compiled tag filter and name pattern.
+    @param include_line_numbers If True, prefix code lines with <n>: format.
+    @param cache Optional persistent analysis cache.
+    @param output_format `markdown` or `jsonl` rendering of the file block.
+    @return FileOutcome identical to the `_find_in_file()` outcome of the same file.
+    @details Files without an entry take the `_find_in_file()` path; indexed files read their source only when at least one record matched.
+    """
+    fpath, entry, matches = item
+    if entry is None:
+        return _find_in_file(fpath, matcher, include_line_numbers, cache, output_format)
+    if not language_supports_tags(entry.lang, matcher.tag_set):
+        return FileOutcome(
+            STATUS_SKIP,
+            fpath,
+            note=f"language {entry.lang} does not support any requested tags",
+        )
+    if not matches:
+        return FileOutcome(STATUS_SKIP, fpath, note="no matches")
+    try:
+        source = SourceBuffer.from_path(fpath)
+        block = _render_file_block(
+            fpath, entry.lang, source, matches, entry.file_fields, include_line_numbers, output_format)
+    except Exception as e:
+        return FileOutcome(STATUS_FAIL, fpath, note=str(e))
+    return FileOutcome(
+        STATUS_OK,
+        fpath,
+        payload=block,
+        note=f"{len(matches)} matches",
+        count=len(matches),
+    )
+
+
+def _indexed_items(
+    filepaths: list[str],
+    matcher: ConstructMatcher,
+    cache: AnalysisCache,
+    jobs: int | None,
+) -> list[tuple]:
+    """! @brief Match the requested files against the persistent symbol index.
+    @param filepaths Requested source paths.
+    @param matcher Compiled tag filter and name pattern.
+    @param cache Project analysis cache storing the index.
+    @param jobs Worker process count used to re-analyze stale files.
+    @return One `(fpath, entry, matches)` item per requested path, in input order.
+    @details Refreshes and saves the index first. With a literal-prefix pattern only the records found by bisecting the name table are tested; otherwise files
+    whose tag and name sets cannot match are skipped whole and every record of the remaining files is tested. `ConstructMatcher.matches()` is applied in both
+    cases, so results equal a full scan.
+    @satisfies SRS-386, SRS-387
+    """
+    from .symbol_index import SymbolIndex, literal_prefix
+
+    index = SymbolIndex.for_cache(cache)
+    entries = index.refresh(filepaths, jobs)
+    index.save()
+    prefix = literal_prefix(matcher.pattern)
+    candidates = index.prefix_candidates(prefix) if prefix else None
+    items = []
+    for fpath in filepaths:
+        path = os.path.abspath(fpath)
+        entry = entries.get(path)
+        matches: list = []
+        if entry is not None:
+            if candidates is not None:
+                records = [entry.records[position] for position in candidates.get(path, ())]
+            elif entry.type_labels.isdisjoint(matcher.tag_set) or not matcher.any_name(entry.names):
+                records = ()
+            else:
+                records = entry.records
+            matches = [record for record in records if matcher.matches(record)]
+        items.append((fpath, entry, matches))
+    return items
+
+
+def iter_construct_sections(
     filepaths: list[str],
     tag_filter: str,
     pattern: str,
     include_line_numbers: bool = True,
     verbose: bool = False,
-) -> str:
-    """! @brief Find and extract constructs matching tag filter and regex pattern from multiple files.
+    jobs: int | None = 1,
+    cache: AnalysisCache | None = None,
+    output_format: str = FORMAT_MARKDOWN,
+) -> Iterator[str]:
+    """! @brief Find constructs in multiple files and yield output fragments as each file completes.
     @param filepaths List of source file paths.
     @param tag_filter Pipe-separated TAG identifiers (e.g., "CLASS|FUNCTION").
     @param pattern Regex pattern for construct name matching.
     @param include_line_numbers If True (default), prefix code lines with <n>: format.
     @param verbose If True, emits progress status messages on stderr.
-    @return Concatenated markdown output string.
-    @throws ValueError If no files could be processed or no constructs found.
-    @details Analyzes each file with SourceAnalyzer, filters elements by tag and name pattern, formats results as markdown with file headers.
+    @param jobs Worker process count; `1` (default) runs sequentially, `None` selects the CPU core count.
+    @param cache Optional persistent analysis cache reused across runs.
+    @param output_format `markdown` (default) or `jsonl`; JSON Lines payloads are separated by `RECORD_SEPARATOR`.
+    @return Iterator over fragments whose concatenation equals `find_constructs_in_files()` output.
+    @throws ValueError If the tag filter is empty, the pattern is not a valid regex (both raised before any file is read), or no constructs are found (raised
+    before any fragment when nothing matches).
+    @details Per-file match blocks and their blank-line separators are yielded separately in input order for bounded-memory streaming. The pattern is compiled
+    once into a `ConstructMatcher` shared by every file. With a cache, matches are answered from the persistent symbol index and only stale files are
+    re-analyzed.
+    @satisfies SRS-375, SRS-376, SRS-382, SRS-386, SRS-387, SRS-400
     """
     tag_set = parse_tag_filter(tag_filter)
     if not tag_set:
         available = format_available_tags()
         raise ValueError(f"No valid tags specified in tag filter.\n\nAvailable tags by language:\n{available}")
+    matcher = ConstructMatcher(tag_set, pattern)
 
-    parts = []
     ok_count = 0
     skip_count = 0
     fail_count = 0
     total_matches = 0
+    separator = RECORD_SEPARATOR if output_format == FORMAT_JSONL else "\n\n"
 
-    for fpath in filepaths:
-        if not os.path.isfile(fpath):
-            if verbose:
-                print(f"  SKIP  {fpath} (not found)", file=sys.stderr)
-            skip_count += 1
-            continue
-
-        lang = detect_language(fpath)
-        if not lang:
-            if verbose:
-                print(f"  SKIP  {fpath} (unsupported extension)", file=sys.stderr)
-            skip_count += 1
-            continue
-
-        # Check if language supports at least one requested tag
-        if not language_supports_tags(lang, tag_set):
-            if verbose:
-                print(f"  SKIP  {fpath} (language {lang} does not support any requested tags)", file=sys.stderr)
+    items = filepaths
+    worker = partial(
+        _find_in_file,
+        matcher=matcher,
+        include_line_numbers=include_line_numbers,
+        cache=cache,
+        output_format=output_format,
+    )
+    if cache is not None:
+        items = _indexed_items(filepaths, matcher, cache, jobs)
+        worker = partial(
+            _find_in_indexed_file,
+            matcher=matcher,
+            include_line_numbers=include_line_numbers,
+            cache=cache,
+            output_format=output_format,
+        )
+    for outcome in iter_ordered(worker, items, jobs):
+        emit_outcome(outcome, verbose)
+        if outcome.status == STATUS_OK:
+            if ok_count:
+                yield separator
+            yield outcome.payload
+            total_matches += outcome.count
+            ok_count += 1
+        elif outcome.status == STATUS_SKIP:
             skip_count += 1
-            continue
-
-        try:
-            # Read complete source file for full construct extraction
-            with open(fpath, 'r', encoding='utf-8', errors='replace') as f:
-                source_lines = f.readlines()
-
-            analyzer = SourceAnalyzer()
-            elements = analyzer.analyze(fpath, lang)
-            analyzer.enrich(elements, lang, fpath)
-
-            # Filter elements matching tag and pattern
-            matches = [el for el in elements if construct_matches(el, tag_set, pattern)]
-
-            if matches:
-                header = f"@@@ {fpath} | {lang}"
-                file_level_doxygen_fields = _extract_file_level_doxygen_fields(elements)
-                file_level_doxygen_lines = []
-                if file_level_doxygen_fields:
-                    file_level_doxygen_lines = format_doxygen_fields_as_markdown(
-                        file_level_doxygen_fields
-                    )
-                constructs_md = "\n\n".join(
-                    format_construct(
-                        el,
-                        source_lines,
-                        include_line_numbers,
-                        language=lang,
-                    )
-                    for el in matches
-                )
-                if file_level_doxygen_lines:
-                    file_level_block = "\n".join(file_level_doxygen_lines)
-                    parts.append(f"{header}\n{file_level_block}\n\n{constructs_md}")
-                else:
-                    parts.append(f"{header}\n\n{constructs_md}")
-                total_matches += len(matches)
-                ok_count += 1
-                if verbose:
-                    print(f"  OK    {fpath} ({len(matches)} matches)", file=sys.stderr)
-            else:
-                if verbose:
-                    print(f"  SKIP  {fpath} (no matches)", file=sys.stderr)
-                skip_count += 1
-
-        except Exception as e:
-            if verbose:
-                print(f"  FAIL  {fpath} ({e})", file=sys.stderr)
+        else:
             fail_count += 1
 
-    if not parts:
+    if not ok_count:
         available = format_available_tags()
         raise ValueError(f"No constructs found matching the specified criteria.\n\nAvailable tags by language:\n{available}")
 
@@ -349,7 +634,33 @@ def find_constructs_in_files(
             file=sys.stderr,
         )
 
-    return "\n\n".join(parts)
+
+def find_constructs_in_files(
+    filepaths: list[str],
+    tag_filter: str,
+    pattern: str,
+    include_line_numbers: bool = True,
+    verbose: bool = False,
+    jobs: int | None = 1,
+    cache: AnalysisCache | None = None,
+    output_format: str = FORMAT_MARKDOWN,
+) -> str:
+    """! @brief Find and extract constructs matching tag filter and regex pattern from multiple files.
+    @param filepaths List of source file paths.
+    @param tag_filter Pipe-separated TAG identifiers (e.g., "CLASS|FUNCTION").
+    @param pattern Regex pattern for construct name matching.
+    @param include_line_numbers If True (default), prefix code lines with <n>: format.
+    @param verbose If True, emits progress status messages on stderr.
+    @param jobs Worker process count; `1` (default) runs sequentially, `None` selects the CPU core count.
+    @param cache Optional persistent analysis cache reused across runs.
+    @param output_format `markdown` (default) or `jsonl`.
+    @return Concatenated markdown output string, or JSON Lines records for `jsonl`.
+    @throws ValueError If no files could be processed or no constructs found.
+    @details Analyzes each file with SourceAnalyzer, filters elements by tag and name pattern, formats results as markdown with file headers. Per-file work runs on the `parallel` worker pool and is merged in input order. Joins `iter_construct_sections()`.
+    @satisfies SRS-375, SRS-376
+    """
+    return "".join(iter_construct_sections(
+        filepaths, tag_filter, pattern, include_line_numbers, verbose, jobs, cache, output_format))
 
 
 def main():
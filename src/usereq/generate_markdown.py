@@ -9,9 +9,23 @@
 
 import os
 import sys
+from functools import partial
 from pathlib import Path
+from typing import Callable, Iterator, Mapping
 
-from .source_analyzer import SourceAnalyzer, format_markdown
+from . import profiling
+from .analysis_cache import AnalysisCache, load_analysis
+from .find_constructs import _extract_construct_doxygen_fields, _extract_file_level_doxygen_fields
+from .jsonl_records import FORMAT_JSONL, FORMAT_MARKDOWN, RECORD_SEPARATOR, construct_record, dump_records, file_record
+from .parallel import (
+    STATUS_FAIL,
+    STATUS_OK,
+    STATUS_SKIP,
+    FileOutcome,
+    emit_outcome,
+    iter_ordered,
+)
+from .source_analyzer import STREAM_THRESHOLD_BYTES, SourceAnalyzer, format_markdown
 
 # Map file extensions to languages
 EXT_LANG_MAP = {
@@ -66,73 +80,196 @@ def _format_output_path(filepath: str, output_base: Path | None) -> str:
     return Path(os.path.relpath(absolute_path, output_base)).as_posix()
 
 
-def generate_markdown(
-    filepaths: list[str],
-    verbose: bool = False,
-    output_base: Path | None = None,
-) -> str:
-    """! @brief Analyze source files and return concatenated markdown.
-    @param filepaths List of source file paths to analyze.
-    @param verbose If True, emits progress status messages on stderr.
-    @param output_base Project-home base used to render file paths in markdown as relative paths.
-    @return Concatenated markdown string with all file analyses.
-    @throws ValueError If no valid source files are found.
-    @details Iterates through files, detecting language, analyzing constructs, and formatting output. Disables legacy comment/exit annotation traces in rendered markdown, emitting only construct references plus Doxygen field bullets when available.
+_ANALYZER: SourceAnalyzer | None = None
+"""! @brief Process-local analyzer cache populated by `_get_analyzer`."""
+
+
+def _get_analyzer() -> SourceAnalyzer:
+    """! @brief Return the process-local shared SourceAnalyzer instance.
+    @return Lazily created analyzer reused by every file processed in the current process.
+    @details Worker processes build their language specs once instead of once per file.
     """
-    analyzer = SourceAnalyzer()
-    md_parts = []
-    ok_count = 0
-    fail_count = 0
-    resolved_output_base = output_base.resolve() if output_base is not None else None
+    global _ANALYZER
+    if _ANALYZER is None:
+        _ANALYZER = SourceAnalyzer()
+    return _ANALYZER
 
-    for fpath in filepaths:
-        if not os.path.isfile(fpath):
-            if verbose:
-                print(f"  SKIP  {fpath} (file not found)", file=sys.stderr)
-            continue
-
-        lang = detect_language(fpath)
-        if not lang:
-            if verbose:
-                print(f"  SKIP  {fpath} (unsupported extension)", file=sys.stderr)
-            continue
-
-        try:
-            elements = analyzer.analyze(fpath, lang)
-            lang_key = lang.lower().strip().lstrip(".")
-            spec = analyzer.specs[lang_key]
-            analyzer.enrich(elements, lang_key, filepath=fpath)
-
-            with open(fpath, "r", encoding="utf-8", errors="replace") as f:
-                total_lines = sum(1 for _ in f)
 
+def _render_file(
+    fpath: str,
+    output_base: Path | None,
+    cache: AnalysisCache | None = None,
+    stream_threshold: int | None = STREAM_THRESHOLD_BYTES,
+    output_format: str = FORMAT_MARKDOWN,
+) -> FileOutcome:
+    """! @brief Analyze one source file and render its markdown section.
+    @param fpath Source file path.
+    @param output_base Resolved project-home base used to relativize the rendered path, or None.
+    @param cache Optional persistent analysis cache.
+    @param stream_threshold Size from which brace-language files are analyzed in streaming mode (None disables streaming).
+    @param output_format `markdown`, or `jsonl` to render the records of `_file_records()` instead of calling `format_markdown()`.
+    @return FileOutcome with status OK and the markdown payload, SKIP with the skip reason, or FAIL with the exception text.
+    @details Top-level picklable worker executed either in-process or inside the `parallel` process pool.
+    """
+    if not os.path.isfile(fpath):
+        return FileOutcome(STATUS_SKIP, fpath, note="file not found")
+
+    lang = detect_language(fpath)
+    if not lang:
+        return FileOutcome(STATUS_SKIP, fpath, note="unsupported extension")
+
+    try:
+        analyzer = _get_analyzer()
+        lang_key = lang.lower().strip().lstrip(".")
+        spec = analyzer.specs[lang_key]
+        elements, total_lines = load_analysis(analyzer, fpath, lang_key, cache, stream_threshold=stream_threshold)
+
+        if output_format == FORMAT_JSONL:
+            with profiling.span("format_jsonl"):
+                payload = dump_records(_file_records(
+                    elements, _format_output_path(fpath, output_base), lang_key, total_lines))
+            return FileOutcome(STATUS_OK, fpath, payload=payload)
+        with profiling.span("format_markdown"):
             md_output = format_markdown(
                 elements,
-                _format_output_path(fpath, resolved_output_base),
+                _format_output_path(fpath, output_base),
                 lang_key,
                 spec.name,
                 total_lines,
                 include_legacy_annotations=False,
             )
+    except Exception as e:
+        return FileOutcome(STATUS_FAIL, fpath, note=str(e))
+    return FileOutcome(STATUS_OK, fpath, payload=md_output)
 
-            md_parts.append(md_output)
-            ok_count += 1
-            if verbose:
-                print(f"  OK    {fpath}", file=sys.stderr)
 
-        except Exception as e:
-            if verbose:
-                print(f"  FAIL  {fpath} ({e})", file=sys.stderr)
+def _file_records(elements: list, path: str, lang: str, total_lines: int) -> Iterator[dict]:
+    """! @brief Yield the JSON Lines records of one analyzed file.
+    @param elements Enriched SourceElement list.
+    @param path Header-visible file path.
+    @param lang Canonical language identifier.
+    @param total_lines File line count.
+    @return Iterator over one `file` record followed by one `construct` record per non-comment element, in source order.
+    @satisfies SRS-400
+    """
+    yield file_record(path, lang, lines=total_lines, doxygen_fields=_extract_file_level_doxygen_fields(elements))
+    for element in elements:
+        if not element.element_type.name.startswith("COMMENT"):
+            yield construct_record(path, element, _extract_construct_doxygen_fields(element))
+
+
+SECTION_SEPARATOR = "\n\n---\n\n"
+"""! @brief Separator emitted between per-file markdown sections."""
+
+
+def markdown_file_worker(
+    output_base: Path | None = None,
+    cache: AnalysisCache | None = None,
+    stream_threshold: int | None = STREAM_THRESHOLD_BYTES,
+    output_format: str = FORMAT_MARKDOWN,
+) -> Callable[[str], FileOutcome]:
+    """! @brief Build the picklable per-file worker of `iter_markdown_sections()`.
+    @param output_base Project-home base used to render file paths as relative paths.
+    @param cache Optional persistent analysis cache.
+    @param stream_threshold Size from which brace-language files are analyzed in streaming mode (None disables streaming).
+    @param output_format `markdown` or `jsonl`.
+    @return Callable mapping one file path to its `FileOutcome`.
+    """
+    return partial(
+        _render_file,
+        output_base=output_base.resolve() if output_base is not None else None,
+        cache=cache,
+        stream_threshold=stream_threshold,
+        output_format=output_format,
+    )
+
+
+def iter_markdown_sections(
+    filepaths: list[str],
+    verbose: bool = False,
+    output_base: Path | None = None,
+    jobs: int | None = 1,
+    cache: AnalysisCache | None = None,
+    reuse: Mapping[str, str] | None = None,
+    record: dict | None = None,
+    stream_threshold: int | None = STREAM_THRESHOLD_BYTES,
+    output_format: str = FORMAT_MARKDOWN,
+    outcomes: Iterator[FileOutcome] | None = None,
+) -> Iterator[str]:
+    """! @brief Analyze source files and yield markdown output fragments as each file completes.
+    @param filepaths List of source file paths to analyze.
+    @param verbose If True, emits progress status messages on stderr.
+    @param output_base Project-home base used to render file paths in markdown as relative paths.
+    @param jobs Worker process count; `1` (default) runs sequentially, `None` selects the CPU core count.
+    @param cache Optional persistent analysis cache reused across runs.
+    @param reuse Optional map from file path to a previously rendered section; listed files are not analyzed again.
+    @param record Optional dictionary receiving the rendered section of every successfully processed file, keyed by path.
+    @param stream_threshold Size from which brace-language files are analyzed by `SourceAnalyzer.analyze_stream()` without loading them (None disables streaming).
+    @param output_format `markdown` (default) or `jsonl`; JSON Lines payloads are separated by `RECORD_SEPARATOR` instead of `SECTION_SEPARATOR`.
+    @param outcomes Optional outcomes of the files not in `reuse`, in input order, produced by the caller's `markdown_file_worker()` (batch mode schedules
+    several projects on one pool); None runs the files on a pool of `jobs` workers.
+    @return Iterator over fragments whose concatenation equals `generate_markdown()` output.
+    @throws ValueError If no valid source files are found (raised before any fragment when nothing succeeds).
+    @details Sections and `SECTION_SEPARATOR` are yielded separately in input order, so consumers can write them immediately with bounded memory. Reused sections
+    are spliced into the ordered worker results at their input position.
+    @satisfies SRS-375, SRS-376, SRS-382, SRS-383, SRS-398, SRS-400, SRS-404
+    """
+    ok_count = 0
+    fail_count = 0
+    reuse = reuse or {}
+
+    separator = RECORD_SEPARATOR if output_format == FORMAT_JSONL else SECTION_SEPARATOR
+
+    if outcomes is None:
+        worker = markdown_file_worker(output_base, cache, stream_threshold, output_format)
+        rendered = iter_ordered(worker, [fpath for fpath in filepaths if fpath not in reuse], jobs)
+    else:
+        rendered = outcomes
+    for fpath in filepaths:
+        if fpath in reuse:
+            outcome = FileOutcome(STATUS_OK, fpath, payload=reuse[fpath])
+        else:
+            outcome = next(rendered)
+        emit_outcome(outcome, verbose)
+        if outcome.status == STATUS_OK:
+            if record is not None:
+                record[fpath] = outcome.payload
+            if ok_count:
+                yield separator
+            yield outcome.payload
+            ok_count += 1
+        elif outcome.status == STATUS_FAIL:
             fail_count += 1
 
-    if not md_parts:
+    if not ok_count:
         raise ValueError("No valid source files processed")
 
     if verbose:
         print(f"\n  Processed: {ok_count} ok, {fail_count} failed",
               file=sys.stderr)
 
-    return "\n\n---\n\n".join(md_parts)
+
+def generate_markdown(
+    filepaths: list[str],
+    verbose: bool = False,
+    output_base: Path | None = None,
+    jobs: int | None = 1,
+    cache: AnalysisCache | None = None,
+    stream_threshold: int | None = STREAM_THRESHOLD_BYTES,
+) -> str:
+    """! @brief Analyze source files and return concatenated markdown.
+    @param filepaths List of source file paths to analyze.
+    @param verbose If True, emits progress status messages on stderr.
+    @param output_base Project-home base used to render file paths in markdown as relative paths.
+    @param jobs Worker process count; `1` (default) runs sequentially, `None` selects the CPU core count.
+    @param cache Optional persistent analysis cache reused across runs.
+    @param stream_threshold Size from which brace-language files are analyzed in streaming mode (None disables streaming).
+    @return Concatenated markdown string with all file analyses.
+    @throws ValueError If no valid source files are found.
+    @details Iterates through files, detecting language, analyzing constructs, and formatting output. Disables legacy comment/exit annotation traces in rendered markdown, emitting only construct references plus Doxygen field bullets when available. Per-file work is scheduled on the `parallel` worker pool and merged in input order, so output and counters do not depend on `jobs`. Joins `iter_markdown_sections()`.
+    @satisfies SRS-375, SRS-376
+    """
+    return "".join(iter_markdown_sections(filepaths, verbose, output_base, jobs, cache, stream_threshold=stream_threshold))
 
 
 def main():
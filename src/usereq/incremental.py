@@ -0,0 +1,165 @@
+"""!
+@file incremental.py
+@brief Git-diff-driven incremental project scans.
+@details An `IncrementalScan` reuses the rendered per-file sections recorded by the previous run of the same command and re-renders only the files that git reports
+as changed since then: paths in `git diff <previous HEAD> HEAD`, paths dirty or untracked now (`git status --porcelain`), and paths that were dirty at the previous
+run. Manifests live in the fingerprint namespace of the `.req/cache` analysis cache, so analyzer or version changes discard them together with cached analyses.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import pickle
+import subprocess
+from pathlib import Path
+from typing import Optional
+
+from . import profiling
+from .analysis_cache import AnalysisCache, _atomic_write_bytes
+
+MANIFEST_FORMAT_VERSION = 1
+"""! @brief Manifest payload layout version."""
+
+MANIFEST_DIR_NAME = "manifests"
+"""! @brief Manifest directory name below the cache fingerprint namespace."""
+
+
+def _git(project_base: Path, *args: str) -> Optional[str]:
+    """! @brief Run one git command in the project root.
+    @param project_base Project root directory.
+    @param args Git arguments.
+    @return Command stdout, or None when git fails or is unavailable.
+    """
+    profiling.count("subprocesses.git")
+    try:
+        return subprocess.run(
+            ["git", "-C", str(project_base), *args],
+            check=True,
+            capture_output=True,
+            text=True,
+        ).stdout
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def git_head(project_base: Path) -> Optional[str]:
+    """! @brief Resolve the current HEAD commit.
+    @param project_base Project root directory.
+    @return Commit id, or None for unborn branches and non-repositories.
+    """
+    output = _git(project_base, "rev-parse", "--verify", "--quiet", "HEAD")
+    if output is None:
+        return None
+    return output.strip() or None
+
+
+def git_dirty_paths(project_base: Path) -> Optional[set[str]]:
+    """! @brief Collect modified, staged, deleted, and untracked paths.
+    @param project_base Project root directory.
+    @return Resolved absolute paths reported by `git status --porcelain`, or None when git fails.
+    @details Uses NUL-separated porcelain output without rename detection, so both sides of a rename are reported as separate entries.
+    """
+    toplevel = _git(project_base, "rev-parse", "--show-toplevel")
+    output = _git(project_base, "status", "--porcelain", "-z", "--no-renames", "--untracked-files=all")
+    if toplevel is None or output is None:
+        return None
+    root = Path(toplevel.strip())
+    return {str((root / entry[3:]).resolve()) for entry in output.split("\0") if len(entry) > 3}
+
+
+def git_changed_paths(project_base: Path, since: str) -> Optional[set[str]]:
+    """! @brief Collect paths whose committed content differs between a revision and HEAD.
+    @param project_base Project root directory.
+    @param since Base revision.
+    @return Resolved absolute paths from `git diff --name-only`, or None when the revision is unknown or git fails.
+    """
+    toplevel = _git(project_base, "rev-parse", "--show-toplevel")
+    output = _git(project_base, "diff", "--name-only", "--no-renames", "-z", since, "HEAD", "--")
+    if toplevel is None or output is None:
+        return None
+    root = Path(toplevel.strip())
+    return {str((root / entry).resolve()) for entry in output.split("\0") if entry}
+
+
+class IncrementalScan:
+    """! @brief Reuse plan and recorder for one incremental project-scan command.
+    @details `reuse` maps unchanged absolute paths to their previously rendered sections; `sections` collects the sections of the current run, which `commit()`
+    persists as the next manifest.
+    """
+
+    def __init__(self, cache: AnalysisCache, manifest_path: Path, head: Optional[str],
+                 dirty: set[str], reuse: dict):
+        """! @brief Bind a reuse plan to its manifest location.
+        @param cache Project analysis cache owning the manifest.
+        @param manifest_path Manifest file path.
+        @param head Current HEAD commit, or None.
+        @param dirty Paths dirty at the start of this run.
+        @param reuse Sections reusable from the previous run.
+        @return {None} Function return value.
+        """
+        self.cache = cache
+        self.manifest_path = manifest_path
+        self.head = head
+        self.dirty = dirty
+        self.reuse = reuse
+        self.sections: dict = {}
+
+    @classmethod
+    def begin(cls, cache: AnalysisCache, project_base: Path, command: str) -> "IncrementalScan":
+        """! @brief Load the previous manifest of a command and compute the reuse plan.
+        @param cache Project analysis cache providing the manifest namespace.
+        @param project_base Project root directory.
+        @param command Command identifier (e.g. `references`).
+        @return IncrementalScan; its `reuse` map is empty when no valid previous manifest exists or git cannot report changes.
+        @details Git state is sampled before any file is rendered, so files edited during the run are re-rendered by the next run.
+        @satisfies SRS-383
+        """
+        manifest_path = cache.namespace_dir / MANIFEST_DIR_NAME / f"{command}.pickle"
+        head = git_head(project_base)
+        dirty = git_dirty_paths(project_base)
+        reuse: dict = {}
+        previous = cls._load(manifest_path)
+        if dirty is not None and previous is not None and previous["head"] and head:
+            changed = git_changed_paths(project_base, previous["head"])
+            if changed is not None:
+                stale = changed | dirty | previous["dirty"]
+                reuse = {
+                    path: section
+                    for path, section in previous["sections"].items()
+                    if path not in stale
+                }
+        return cls(cache, manifest_path, head, dirty if dirty is not None else set(), reuse)
+
+    @staticmethod
+    def _load(manifest_path: Path) -> Optional[dict]:
+        """! @brief Read a manifest.
+        @param manifest_path Manifest file path.
+        @return Manifest dictionary, or None when missing, unreadable, or of another format version.
+        """
+        try:
+            with open(manifest_path, "rb") as handle:
+                manifest = pickle.load(handle)
+        except Exception:
+            return None
+        if not isinstance(manifest, dict) or manifest.get("version") != MANIFEST_FORMAT_VERSION:
+            return None
+        return manifest
+
+    def commit(self) -> None:
+        """! @brief Persist the sections of the current run as the next manifest.
+        @return {None} Function return value.
+        @details Write failures are ignored; the next run then falls back to a full scan.
+        """
+        manifest = {
+            "version": MANIFEST_FORMAT_VERSION,
+            "head": self.head,
+            "dirty": self.dirty,
+            "sections": self.sections,
+        }
+        try:
+            self.cache._ensure_root()
+            _atomic_write_bytes(
+                self.manifest_path,
+                pickle.dumps(manifest, protocol=pickle.HIGHEST_PROTOCOL),
+            )
+        except OSError:
+            pass
@@ -0,0 +1,72 @@
+"""!
+@file jsonl_records.py
+@brief JSON Lines records for machine-readable `--references`, `--find`, and `--compress` output.
+@details Builds one JSON object per file and per construct directly from `SourceElement` fields (or symbol index records exposing the same attributes), so
+consumers parse the output incrementally without a markdown round-trip. Workers render a file's records as one newline-joined payload; payloads are joined
+with `RECORD_SEPARATOR`, so the concatenated output has exactly one record per line.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import json
+from typing import Iterable, Optional
+
+FORMAT_MARKDOWN = "markdown"
+"""! @brief Default output format: markdown sections."""
+
+FORMAT_JSONL = "jsonl"
+"""! @brief JSON Lines output format: one record per file and per construct."""
+
+OUTPUT_FORMATS = (FORMAT_MARKDOWN, FORMAT_JSONL)
+"""! @brief Accepted `--format` values."""
+
+RECORD_SEPARATOR = "\n"
+"""! @brief Separator emitted between the JSON Lines payloads of consecutive files."""
+
+
+def file_record(path: str, language: str, **fields) -> dict:
+    """! @brief Build the record that opens the output of one file.
+    @param path Header-visible file path.
+    @param language Canonical language identifier.
+    @param fields Additional command-specific keys (e.g. `lines`, `doxygen_fields`, `code`).
+    @return Record with `record` set to `file`.
+    """
+    record = {"record": "file", "path": path, "language": language}
+    record.update(fields)
+    return record
+
+
+def construct_record(path: str, element, doxygen_fields: dict, code: Optional[str] = None) -> dict:
+    """! @brief Build the record of one construct.
+    @param path Header-visible path of the file containing the construct.
+    @param element SourceElement or SymbolRecord providing `type_label`, `name`, `line_start`, `line_end`, `signature`, and `parent_name`.
+    @param doxygen_fields Aggregate Doxygen fields of the construct (tag -> list of values).
+    @param code Optional construct code; omitted from the record when None.
+    @return Record with `record` set to `construct`; `visibility` and `inherits` are added when the element carries them.
+    """
+    record = {
+        "record": "construct",
+        "path": path,
+        "type_label": element.type_label,
+        "name": element.name,
+        "line_start": element.line_start,
+        "line_end": element.line_end,
+        "signature": element.signature,
+        "parent_name": element.parent_name,
+    }
+    for key in ("visibility", "inherits"):
+        value = getattr(element, key, None)
+        if value:
+            record[key] = value
+    record["doxygen_fields"] = doxygen_fields
+    if code is not None:
+        record["code"] = code
+    return record
+
+
+def dump_records(records: Iterable[dict]) -> str:
+    """! @brief Serialize records as JSON Lines.
+    @param records Records in output order.
+    @return Compact JSON objects (non-ASCII kept verbatim) joined by newlines, without a trailing newline.
+    """
+    return "\n".join(json.dumps(record, ensure_ascii=False, separators=(",", ":")) for record in records)
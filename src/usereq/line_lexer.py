@@ -0,0 +1,410 @@
+"""!
+@file line_lexer.py
+@brief Linear-time string/comment lexer shared by the analyzer and the compressor.
+@details A `LineLexer` is built once per `(string_delimiters, single_comment, escape mode)` combination with its delimiter table pre-sorted longest-first and
+compiled into token regexes. Scans jump between candidate tokens with `Pattern.search()` instead of slicing `line[i:]` at every character, so locating a comment
+marker or classifying a column is linear in line length. The scan state (`None` in code, else the open string delimiter) can be carried from one line to the
+next by the caller. When the optional compiled module `usereq._scan` is importable, `get_line_lexer()` and `iter_brace_marks()` hand the same work to its
+native kernels; the Python classes below stay the reference implementation and the fallback.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import os
+import re
+from functools import lru_cache
+from typing import Optional
+
+NATIVE_SCAN_ENV = "USEREQ_NATIVE_SCAN"
+"""! @brief Environment variable that disables the native kernels when set to `0`."""
+
+
+def _load_native_scan():
+    """! @brief Import the optional native kernels.
+    @return The `usereq._scan` module, or None when it is not built or `USEREQ_NATIVE_SCAN=0`.
+    @satisfies SRS-403
+    """
+    if os.environ.get(NATIVE_SCAN_ENV, "").strip() == "0":
+        return None
+    try:
+        from . import _scan
+    except ImportError:
+        return None
+    return _scan
+
+
+NATIVE_SCAN = _load_native_scan()
+"""! @brief Native kernel module selected at import time, or None for the pure-Python kernels."""
+
+_NEVER = re.compile(r"(?!)")
+"""! @brief Pattern that never matches, used when a token table is empty."""
+
+
+def _token_regex(tokens) -> re.Pattern:
+    """! @brief Compile a leftmost-first alternation of literal tokens.
+    @param tokens Literal tokens in priority order.
+    @return Compiled alternation, or `_NEVER` when `tokens` is empty.
+    """
+    tokens = [token for token in tokens if token]
+    if not tokens:
+        return _NEVER
+    return re.compile("|".join(re.escape(token) for token in tokens))
+
+
+class LineLexer:
+    """! @brief Code/string state machine for one delimiter configuration.
+    @details In code state the next opening delimiter (or comment marker) is located with one regex search; in string state the next backslash or closing
+    delimiter is. With `escape_multi` enabled a backslash escapes the next character in every string (analyzer rules); otherwise only single-character
+    delimiters honor backslash escapes (compressor rules).
+    """
+
+    __slots__ = ("delimiters", "single_comment", "escape_multi", "_open", "_open_or_comment", "_close")
+
+    def __init__(self, string_delimiters: tuple, single_comment: Optional[str] = None,
+                 escape_multi: bool = True):
+        """! @brief Pre-sort delimiters and compile token regexes.
+        @param string_delimiters String delimiter sequences.
+        @param single_comment Single-line comment marker, or None.
+        @param escape_multi Whether backslashes escape inside multi-character delimited strings.
+        @return {None} Function return value.
+        """
+        self.delimiters = tuple(sorted(string_delimiters, key=len, reverse=True))
+        self.single_comment = single_comment or None
+        self.escape_multi = escape_multi
+        self._open = _token_regex(self.delimiters)
+        self._open_or_comment = _token_regex((self.single_comment,) + self.delimiters)
+        self._close = {}
+        for delim in self.delimiters:
+            escaped = escape_multi or len(delim) == 1
+            self._close[delim] = _token_regex(("\\", delim) if escaped else (delim,))
+
+    def advance(self, line: str, start: int, stop: int, state: Optional[str] = None,
+                find_comment: bool = False) -> tuple:
+        """! @brief Run the state machine over `line[start:stop]`.
+        @param line Source line without terminator.
+        @param start First column to scan.
+        @param stop Scan ends before the first token starting at or after this column; tokens starting before it are consumed whole.
+        @param state Open string delimiter at `start`, or None in code.
+        @param find_comment Whether to stop at the first single-line comment marker found in code.
+        @return Tuple `(state, comment_index)`; `comment_index` is the comment column when `find_comment` stopped on one, else None.
+        """
+        i = start
+        while i < stop:
+            if state is None:
+                match = (self._open_or_comment if find_comment else self._open).search(line, i)
+                if match is None or match.start() >= stop:
+                    break
+                token = match.group()
+                if find_comment and token == self.single_comment:
+                    return None, match.start()
+                state = token
+                i = match.end()
+                continue
+            match = self._close[state].search(line, i)
+            if match is None or match.start() >= stop:
+                break
+            if match.group() == "\\":
+                i = match.start() + (2 if match.start() + 1 < len(line) else 1)
+                continue
+            state = None
+            i = match.end()
+        return state, None
+
+    def in_string(self, line: str, pos: int, state: Optional[str] = None) -> bool:
+        """! @brief Check whether column `pos` lies inside a string literal.
+        @param line Source line without terminator.
+        @param pos Column to classify.
+        @param state Open string delimiter at column 0, or None.
+        @return True when a string is open at `pos`.
+        """
+        return self.advance(line, 0, pos, state)[0] is not None
+
+    def find_comment(self, line: str, state: Optional[str] = None) -> Optional[int]:
+        """! @brief Locate the first single-line comment marker outside strings.
+        @param line Source line without terminator.
+        @param state Open string delimiter at column 0, or None.
+        @return Comment column, or None.
+        """
+        if not self.single_comment:
+            return None
+        return self.advance(line, 0, len(line), state, find_comment=True)[1]
+
+
+@lru_cache(maxsize=None)
+def get_line_lexer(string_delimiters: tuple, single_comment: Optional[str] = None,
+                   escape_multi: bool = True) -> LineLexer:
+    """! @brief Return the shared lexer of a delimiter configuration.
+    @param string_delimiters String delimiter sequences.
+    @param single_comment Single-line comment marker, or None.
+    @param escape_multi Whether backslashes escape inside multi-character delimited strings.
+    @return Cached LineLexer instance, or the interchangeable `_scan.Lexer` when the native kernels are loaded.
+    @satisfies SRS-380, SRS-403
+    """
+    if NATIVE_SCAN is not None:
+        return NATIVE_SCAN.Lexer(tuple(sorted(string_delimiters, key=len, reverse=True)), single_comment or None, escape_multi)
+    return LineLexer(tuple(string_delimiters), single_comment, escape_multi)
+
+
+CHAR_LITERAL_LANGUAGES = frozenset({"c", "cpp", "rust", "java", "csharp", "kotlin", "scala", "zig", "go"})
+"""! @brief Languages where `'` opens a one-character literal (`'{'`, `'\\n'`) rather than a string; unmatched quotes (Rust lifetimes, C++ digit separators) are code."""
+
+TEXT_BLOCK_LANGUAGES = frozenset({"java", "kotlin", "scala", "swift"})
+"""! @brief Languages whose `\"\"\"` text blocks may span lines."""
+
+_MULTILINE_DELIMITERS = frozenset({"`", '"""'})
+"""! @brief String delimiters whose literals may span lines (template strings, Go raw strings, text blocks)."""
+
+_RAW_STRING_OPENERS = {
+    "cpp": r'(?<![A-Za-z0-9_])(?:u8|[uUL])?R"(?P<rawdelim>[^()\\\s"]{0,16})\(',
+    "rust": r'(?<![A-Za-z0-9_])b?r(?P<rawdelim>#*)"',
+}
+"""! @brief Raw string opener regex sources; group `rawdelim` is the delimiter sequence that builds the terminator."""
+
+_NATIVE_RAW_MODES = {"cpp": 1, "rust": 2}
+"""! @brief `_scan.BraceScanner` raw string modes matching `_RAW_STRING_OPENERS`."""
+
+_CHAR_LITERAL = re.compile(r"'(?:\\.[^'\\]*|[^'\\])'")
+"""! @brief One-character literal, including escapes such as `'\\''` and `'\\u{1F600}'`."""
+
+
+def iter_brace_marks(lines, spec, language: str):
+    """! @brief Run the brace lexer over lines and yield the scan result of each one.
+    @param lines Iterable of file lines (terminators allowed); consumed lazily.
+    @param spec LanguageSpec providing comment and string delimiters.
+    @param language Canonical language identifier selecting char-literal, text-block, and raw-string rules.
+    @return Iterator of `(line, depth, mark)`: the input line, the brace depth at its end, and its first structural token (`{`, `;`, or None).
+    @details Block comment, multi-line string, and raw string state is carried across lines; braces inside strings, character literals, and comments are ignored.
+    Shared by `BraceIndex.from_lines()` and streaming analysis, which never holds more than the current line. Runs on `_scan.BraceScanner` when the native
+    kernels are loaded, else on `_iter_python_brace_marks()`.
+    @satisfies SRS-403
+    """
+    delimiters = list(spec.string_delimiters)
+    if language in TEXT_BLOCK_LANGUAGES and '"""' not in delimiters:
+        delimiters.append('"""')
+    delimiters.sort(key=len, reverse=True)
+    if NATIVE_SCAN is not None:
+        scanner = NATIVE_SCAN.BraceScanner(
+            spec.multi_comment_start, spec.single_comment, tuple(delimiters), spec.multi_comment_end,
+            language in CHAR_LITERAL_LANGUAGES, _NATIVE_RAW_MODES.get(language, 0),
+        )
+        return _iter_native_brace_marks(lines, scanner)
+    return _iter_python_brace_marks(lines, spec, language, delimiters)
+
+
+def _iter_native_brace_marks(lines, scanner):
+    """! @brief Feed lines to a native brace scanner.
+    @param lines Iterable of file lines.
+    @param scanner Configured `_scan.BraceScanner`.
+    @return Iterator of `(line, depth, mark)` as documented by `iter_brace_marks()`.
+    """
+    feed = scanner.feed
+    for raw_line in lines:
+        depth, mark = feed(raw_line)
+        yield raw_line, depth, mark
+
+
+def _iter_python_brace_marks(lines, spec, language: str, delimiters: list):
+    """! @brief Pure-Python brace lexer behind `iter_brace_marks()`.
+    @param lines Iterable of file lines.
+    @param spec LanguageSpec providing comment and string delimiters.
+    @param language Canonical language identifier.
+    @param delimiters String delimiters including text-block delimiters, longest first.
+    @return Iterator of `(line, depth, mark)` as documented by `iter_brace_marks()`.
+    """
+    char_literals = language in CHAR_LITERAL_LANGUAGES
+    tokens = [spec.multi_comment_start, spec.single_comment] + delimiters + ["{", "}", "(", ")", ";"]
+    code_re = _token_regex(tokens)
+    raw_opener = _RAW_STRING_OPENERS.get(language)
+    if raw_opener is not None:
+        code_re = re.compile(f"(?P<raw>{raw_opener})|{code_re.pattern}")
+    close_res = {delim: _token_regex(("\\", delim)) for delim in delimiters}
+    block_end = spec.multi_comment_end
+    depth = 0
+    parens = 0
+    # state: None (code), ("block", end), ("raw", terminator), ("str", delimiter)
+    state = None
+    for raw_line in lines:
+        line = raw_line.rstrip("\n\r")
+        mark = None
+        i = 0
+        length = len(line)
+        while i < length:
+            if state is None:
+                match = code_re.search(line, i)
+                if match is None:
+                    break
+                token = match.group()
+                i = match.end()
+                if match.lastgroup == "raw":
+                    rawdelim = match.group("rawdelim")
+                    state = ("raw", f"){rawdelim}\"" if language == "cpp" else f"\"{rawdelim}")
+                elif token == "{":
+                    depth += 1
+                    mark = mark or "{"
+                elif token == "}":
+                    depth -= 1
+                elif token == "(":
+                    parens += 1
+                elif token == ")":
+                    parens = max(0, parens - 1)
+                elif token == ";":
+                    if parens == 0:
+                        mark = mark or ";"
+                elif token == spec.single_comment:
+                    break
+                elif token == spec.multi_comment_start:
+                    state = ("block", block_end)
+                elif token == "'" and char_literals:
+                    literal = _CHAR_LITERAL.match(line, match.start())
+                    if literal is not None:
+                        i = literal.end()
+                else:
+                    state = ("str", token)
+                continue
+            kind, closer = state
+            if kind != "str":
+                found = line.find(closer, i) if closer else -1
+                if found < 0:
+                    break
+                state = None
+                i = found + len(closer)
+                continue
+            match = close_res[closer].search(line, i)
+            if match is None:
+                break
+            if match.group() == "\\":
+                i = match.start() + 2
+                continue
+            state = None
+            i = match.end()
+        if (state is not None and state[0] == "str" and state[1] not in _MULTILINE_DELIMITERS
+                and not line.endswith("\\")):
+            state = None
+        yield raw_line, depth, mark
+
+
+class BraceIndex:
+    """! @brief One-pass brace-depth index of a file for brace-delimited languages.
+    @details Built by a lexer pass that carries block comment, multi-line string, and raw string state across lines and ignores braces inside strings, character
+    literals, and comments. Stores, per line, the brace depth at end of line, whether the line first opens a code brace or first terminates a statement
+    (`;` outside parentheses), and the next line whose depth is strictly lower, so each block end lookup walks only the depth chain instead of rescanning the body.
+    """
+
+    __slots__ = ("depths", "next_mark", "next_lower")
+
+    def __init__(self, depths: list, marks: list):
+        """! @brief Derive lookup tables from per-line scan results.
+        @param depths Brace depth at the end of every line.
+        @param marks First structural token of every line: `{`, `;`, or None.
+        @return {None} Function return value.
+        """
+        count = len(depths)
+        self.depths = depths
+        self.next_mark = [(count, None)] * (count + 1)
+        for index in range(count - 1, -1, -1):
+            self.next_mark[index] = (index, marks[index]) if marks[index] else self.next_mark[index + 1]
+        self.next_lower = [count] * count
+        stack: list = []
+        for index in range(count - 1, -1, -1):
+            while stack and depths[stack[-1]] >= depths[index]:
+                stack.pop()
+            if stack:
+                self.next_lower[index] = stack[-1]
+            stack.append(index)
+
+    @classmethod
+    def from_lines(cls, lines: list, spec, language: str) -> "BraceIndex":
+        """! @brief Scan file lines once and build the index.
+        @param lines File lines (terminators allowed).
+        @param spec LanguageSpec providing comment and string delimiters.
+        @param language Canonical language identifier selecting char-literal, text-block, and raw-string rules.
+        @return BraceIndex instance.
+        """
+        depths: list = []
+        marks: list = []
+        for _, depth, mark in iter_brace_marks(lines, spec, language):
+            depths.append(depth)
+            marks.append(mark)
+        return cls(depths, marks)
+
+    def block_end(self, start_idx: int) -> int:
+        """! @brief Return the end line of the block opened at or after a start line.
+        @param start_idx 0-based index of the construct's first line.
+        @return 1-based end line: the first line at or after the first code `{` that closes back to the starting depth; `start_idx + 1` when no `{` follows or a
+        statement-terminating `;` precedes it (declarations); the last line when the block is unbalanced.
+        """
+        count = len(self.depths)
+        line, mark = self.next_mark[min(start_idx, count)]
+        if mark != "{":
+            return start_idx + 1
+        base = self.depths[start_idx - 1] if start_idx > 0 else 0
+        while line < count:
+            if self.depths[line] <= base:
+                return line + 1
+            line = self.next_lower[line]
+        return count
+
+
+class BlockEndTracker:
+    """! @brief Incremental counterpart of `BraceIndex.block_end()` for lines delivered one at a time.
+    @details Constructs are registered on their first line, before that line is fed; each fed `(depth, mark)` pair from `iter_brace_marks()` resolves the
+    constructs whose block end it decides. Unresolved constructs wait for their first structural token (`pending`) or for the depth to return to the depth
+    before their first line (`open`), so state is proportional to the unresolved constructs and never to the number of lines. Resolved end lines equal
+    `BraceIndex.block_end()` on the complete file.
+    """
+
+    __slots__ = ("line_count", "_depth", "_pending", "_open", "_open_floor")
+
+    def __init__(self):
+        """! @brief Start before the first line.
+        @return {None} Function return value.
+        """
+        self.line_count = 0
+        """! @brief Number of lines fed so far."""
+        self._depth = 0
+        self._pending: list = []
+        self._open: list = []
+        self._open_floor: Optional[int] = None
+
+    def register(self, key) -> None:
+        """! @brief Register a construct starting on the next line to be fed.
+        @param key Caller object returned with the resolved end line.
+        @return {None} Function return value.
+        """
+        self._pending.append((self.line_count + 1, self._depth, key))
+
+    def feed(self, depth: int, mark: Optional[str]) -> list:
+        """! @brief Consume the scan result of the next line.
+        @param depth Brace depth at the end of the line.
+        @param mark First structural token of the line: `{`, `;`, or None.
+        @return `(key, end_line)` pairs of the constructs resolved by this line (1-based end lines); empty when none.
+        """
+        self.line_count += 1
+        self._depth = depth
+        resolved: list = []
+        if mark is not None and self._pending:
+            if mark == "{":
+                self._open.extend(self._pending)
+                self._open_floor = max(base for _, base, _ in self._open)
+            else:
+                resolved.extend((key, start) for start, _, key in self._pending)
+            self._pending = []
+        if self._open_floor is not None and depth <= self._open_floor:
+            remaining = []
+            for entry in self._open:
+                if depth <= entry[1]:
+                    resolved.append((entry[2], self.line_count))
+                else:
+                    remaining.append(entry)
+            self._open = remaining
+            self._open_floor = max(base for _, base, _ in remaining) if remaining else None
+        return resolved
+
+    def finish(self) -> list:
+        """! @brief Resolve every construct still waiting at end of input.
+        @return `(key, end_line)` pairs: the start line for constructs that never reached a structural token, the last line for unbalanced blocks.
+        """
+        resolved = [(key, start) for start, _, key in self._pending]
+        resolved.extend((key, self.line_count) for _, _, key in self._open)
+        self._pending, self._open, self._open_floor = [], [], None
+        return resolved
@@ -0,0 +1,278 @@
+"""!
+@file parallel.py
+@brief Ordered multi-process worker pool for per-file source pipelines.
+@details Provides the shared scheduling primitives used by `generate_markdown`, `compress_files`, and `find_constructs_in_files`: per-file workers return a `FileOutcome`
+record and the parent process merges outcomes in input order, so concatenated payloads, verbose status lines, and summary counters are identical to sequential execution.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import os
+import sys
+import time
+from collections import deque
+from concurrent.futures import ProcessPoolExecutor, ThreadPoolExecutor
+from dataclasses import dataclass
+from functools import partial
+from typing import Callable, Iterable, Iterator, Sequence, TypeVar
+
+from . import profiling
+
+T = TypeVar("T")
+R = TypeVar("R")
+
+STATUS_OK = "OK"
+"""! @brief Outcome status for a successfully processed file."""
+
+STATUS_SKIP = "SKIP"
+"""! @brief Outcome status for a file excluded before or after processing."""
+
+STATUS_FAIL = "FAIL"
+"""! @brief Outcome status for a file whose processing raised an exception."""
+
+MIN_FILES_PER_PROCESS = 2
+"""! @brief Minimum input count required before a process pool is started."""
+
+MAX_CHUNK_SIZE = 16
+"""! @brief Upper bound on items per scheduled chunk, bounding results held per in-flight task."""
+
+CHUNKS_IN_FLIGHT_PER_JOB = 2
+"""! @brief Scheduled-but-unconsumed chunks allowed per worker; bounds parent memory while keeping workers busy."""
+
+
+@dataclass(frozen=True)
+class FileOutcome:
+    """! @brief Picklable result of processing one input file in a worker.
+    @details `payload` carries the rendered output fragment for `OK` outcomes; `note` is the parenthesized verbose suffix; `count` carries per-file match totals.
+    """
+
+    status: str
+    path: str
+    payload: str | None = None
+    note: str = ""
+    count: int = 0
+
+
+def format_outcome_line(outcome: FileOutcome) -> str:
+    """! @brief Render the verbose stderr status line of one outcome.
+    @param outcome Worker outcome to render.
+    @return Line formatted as `  <STATUS>  <path>[ (<note>)]` with the status left-aligned in a 6-column field.
+    """
+    line = f"  {outcome.status:<6}{outcome.path}"
+    if outcome.note:
+        line += f" ({outcome.note})"
+    return line
+
+
+def emit_outcome(outcome: FileOutcome, verbose: bool) -> None:
+    """! @brief Print an outcome status line on stderr when verbose mode is enabled.
+    @param outcome Worker outcome to report.
+    @param verbose Whether progress messages are enabled.
+    @return {None} Function return value.
+    """
+    if verbose:
+        print(format_outcome_line(outcome), file=sys.stderr)
+
+
+def resolve_jobs(jobs: int | None) -> int:
+    """! @brief Normalize a requested worker count.
+    @param jobs Requested worker count; `None` or values lower than 1 select the CPU core count.
+    @return Effective worker count, always >= 1.
+    """
+    if jobs is None or jobs < 1:
+        return max(1, os.cpu_count() or 1)
+    return jobs
+
+
+def _chunk_size(item_count: int, jobs: int) -> int:
+    """! @brief Compute the scheduling chunk size for a workload.
+    @param item_count Number of scheduled items.
+    @param jobs Effective worker count.
+    @return Chunk size targeting four chunks per worker to amortize IPC, capped at `MAX_CHUNK_SIZE`.
+    """
+    return max(1, min(MAX_CHUNK_SIZE, item_count // (jobs * 4)))
+
+
+def _run_chunk(worker: Callable[[T], R], chunk: Sequence[T]) -> list[R]:
+    """! @brief Apply a worker to every item of one chunk inside a pool process.
+    @param worker Picklable callable.
+    @param chunk Items scheduled together.
+    @return Worker results in chunk order.
+    """
+    return [worker(item) for item in chunk]
+
+
+def _item_path(item) -> str | None:
+    """! @brief Return the file path a work item refers to.
+    @param item Work item: a path, or a tuple whose first element is a path.
+    @return File path, or None when the item carries none.
+    """
+    if isinstance(item, str):
+        return item
+    if isinstance(item, tuple) and item and isinstance(item[0], str):
+        return item[0]
+    return None
+
+
+def _timed_call(worker: Callable[[T], R], item: T) -> R:
+    """! @brief Apply a worker and record its wall time under the item path in the active profiler.
+    @param worker Callable.
+    @param item Work item.
+    @return Worker result.
+    """
+    start = time.perf_counter()
+    try:
+        return worker(item)
+    finally:
+        profiling.record_file(_item_path(item), time.perf_counter() - start)
+
+
+def _run_chunk_profiled(worker: Callable[[T], R], chunk: Sequence[T]) -> tuple[list[R], dict]:
+    """! @brief Profiled variant of `_run_chunk`.
+    @param worker Picklable callable.
+    @param chunk Items scheduled together.
+    @return Tuple `(results, snapshot)` where `snapshot` is the chunk's `Profiler.snapshot()`, merged by the parent.
+    @details A fresh profiler is started per chunk, so data inherited from a forked parent is never reported twice.
+    """
+    profiler = profiling.start()
+    try:
+        results = [_timed_call(worker, item) for item in chunk]
+    finally:
+        profiling.stop()
+    return results, profiler.snapshot()
+
+
+def _bound_objects(worker) -> Iterator:
+    """! @brief Yield the arguments bound into a worker and its nested partials.
+    @param worker Callable or `functools.partial`.
+    @return Iterator over bound argument and keyword values, those of nested partials included.
+    """
+    if isinstance(worker, partial):
+        yield from _bound_objects(worker.func)
+        for value in (*worker.args, *worker.keywords.values()):
+            yield value
+            yield from _bound_objects(value)
+
+
+def _prepare_for_pool(worker: Callable, items: Sequence) -> None:
+    """! @brief Let objects bound into the workers load shared state before the pool starts.
+    @param worker Worker passed to `iter_ordered`.
+    @param items Work items; tuple items may carry their own worker partials (batch mode).
+    @return {None} Function return value.
+    @details Calls `prepare_for_pool()` once on every distinct bound object defining it (e.g. `AnalysisCache` reading the git index), so forked workers inherit
+    the loaded state instead of rebuilding it per process or per pickled chunk.
+    """
+    sources = {id(worker): worker}
+    for item in items:
+        if isinstance(item, tuple):
+            sources.update((id(value), value) for value in item if isinstance(value, partial))
+    seen: set = set()
+    for source in sources.values():
+        for value in _bound_objects(source):
+            prepare = getattr(value, "prepare_for_pool", None)
+            if callable(prepare) and id(value) not in seen:
+                seen.add(id(value))
+                prepare()
+
+
+def iter_ordered(
+    worker: Callable[[T], R],
+    items: Sequence[T],
+    jobs: int | None = 1,
+) -> Iterator[R]:
+    """! @brief Apply `worker` to each item and yield results in input order.
+    @param worker Picklable top-level callable (or `functools.partial` thereof).
+    @param items Input sequence.
+    @param jobs Worker process count; `1` runs in-process, `None` selects the core count.
+    @return Iterator over worker results ordered like `items`.
+    @details Runs sequentially when one worker is requested, when fewer than `MIN_FILES_PER_PROCESS` items exist, or when the platform cannot start a process pool
+    (e.g. missing semaphore support); results are identical in every mode. In pool mode at most `jobs * CHUNKS_IN_FLIGHT_PER_JOB` chunks are scheduled ahead of
+    the consumer, so results are yielded as soon as the head chunk completes and memory stays bounded regardless of input size. Before the pool starts, bound
+    objects defining `prepare_for_pool()` load their shared state once in the parent. While profiling is active, per-item times are recorded and worker
+    profiles are merged into the parent profiler.
+    @satisfies SRS-382, SRS-391
+    """
+    profiler = profiling.active()
+    call = worker if profiler is None else partial(_timed_call, worker)
+    effective_jobs = min(resolve_jobs(jobs), len(items))
+    if effective_jobs <= 1 or len(items) < MIN_FILES_PER_PROCESS:
+        for item in items:
+            yield call(item)
+        return
+    _prepare_for_pool(worker, items)
+    try:
+        executor = ProcessPoolExecutor(max_workers=effective_jobs)
+    except (OSError, NotImplementedError, ImportError):
+        for item in items:
+            yield call(item)
+        return
+    size = _chunk_size(len(items), effective_jobs)
+    chunks = (items[start:start + size] for start in range(0, len(items), size))
+    window = effective_jobs * CHUNKS_IN_FLIGHT_PER_JOB
+    run_chunk = _run_chunk if profiler is None else _run_chunk_profiled
+    pending: deque = deque()
+
+    def _collect(future) -> list:
+        if profiler is None:
+            return future.result()
+        results, snapshot = future.result()
+        profiler.merge(snapshot)
+        return results
+
+    with executor:
+        for chunk in chunks:
+            pending.append(executor.submit(run_chunk, worker, chunk))
+            if len(pending) >= window:
+                yield from _collect(pending.popleft())
+        while pending:
+            yield from _collect(pending.popleft())
+
+
+def iter_ordered_threads(
+    worker: Callable[[T], R],
+    items: Sequence[T],
+    jobs: int | None = 1,
+) -> Iterator[R]:
+    """! @brief Thread-pool variant of `iter_ordered` for subprocess-bound workers.
+    @param worker Callable applied to each item; it need not be picklable.
+    @param items Input sequence.
+    @param jobs Worker thread count; `1` runs in-process, `None` selects the core count.
+    @return Iterator over worker results ordered like `items`.
+    @details Workers that mostly wait on child processes release the GIL, so threads overlap tool runtimes without process pool start-up or pickling. At most
+    `jobs * CHUNKS_IN_FLIGHT_PER_JOB` items are scheduled ahead of the consumer. While profiling is active, per-item times are recorded in the shared profiler.
+    @satisfies SRS-384, SRS-391
+    """
+    if profiling.active() is not None:
+        worker = partial(_timed_call, worker)
+    effective_jobs = min(resolve_jobs(jobs), len(items))
+    if effective_jobs <= 1:
+        for item in items:
+            yield worker(item)
+        return
+    window = effective_jobs * CHUNKS_IN_FLIGHT_PER_JOB
+    pending: deque = deque()
+    with ThreadPoolExecutor(max_workers=effective_jobs) as executor:
+        try:
+            for item in items:
+                pending.append(executor.submit(worker, item))
+                if len(pending) >= window:
+                    yield pending.popleft().result()
+            while pending:
+                yield pending.popleft().result()
+        finally:
+            for future in pending:
+                future.cancel()
+
+
+def map_ordered(
+    worker: Callable[[T], R],
+    items: Iterable[T],
+    jobs: int | None = 1,
+) -> list[R]:
+    """! @brief Eager variant of `iter_ordered`.
+    @param worker Picklable callable applied to each item.
+    @param items Input iterable.
+    @param jobs Worker process count.
+    @return List of worker results ordered like `items`.
+    """
+    return list(iter_ordered(worker, list(items), jobs))
@@ -0,0 +1,241 @@
+"""!
+@file profiling.py
+@brief Opt-in phase timings and counters for `--profile`.
+@details A process holds at most one active `Profiler`. Instrumented code calls the module-level `span()`, `count()`, and `record_file()` helpers, which return a
+shared no-op context manager or return immediately while profiling is disabled, so the disabled cost is one global lookup per call site. Spans are inclusive
+monotonic-clock totals keyed by dotted phase names; pool workers profile each chunk with a fresh `Profiler` and ship its `snapshot()` back to the parent, which
+merges it, so reports cover every process of a `--jobs` run.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import json
+import threading
+import time
+from contextlib import nullcontext
+from typing import Optional
+
+PROFILE_TOP_FILES = 10
+"""! @brief Number of slowest files listed in a profile report."""
+
+PROFILE_FORMATS = ("table", "json")
+"""! @brief Report formats accepted by `--profile-format`."""
+
+
+class Profiler:
+    """! @brief Accumulator of span timings, counters, and per-file times.
+    @details Updates are serialized by a lock, so thread-pool workers (static checks) may record into the parent profiler concurrently.
+    """
+
+    __slots__ = ("spans", "counters", "files", "started", "_lock")
+
+    def __init__(self):
+        """! @brief Start an empty profile at the current monotonic time.
+        @return {None} Function return value.
+        """
+        self.spans: dict = {}
+        self.counters: dict = {}
+        self.files: dict = {}
+        self.started = time.perf_counter()
+        self._lock = threading.Lock()
+
+    def add_span(self, name: str, seconds: float, calls: int = 1) -> None:
+        """! @brief Add elapsed time to a span.
+        @param name Dotted phase name.
+        @param seconds Elapsed wall time.
+        @param calls Number of span executions represented.
+        @return {None} Function return value.
+        """
+        with self._lock:
+            entry = self.spans.get(name)
+            if entry is None:
+                self.spans[name] = [seconds, calls]
+            else:
+                entry[0] += seconds
+                entry[1] += calls
+
+    def add(self, name: str, amount: int = 1) -> None:
+        """! @brief Increment a counter.
+        @param name Counter name.
+        @param amount Increment.
+        @return {None} Function return value.
+        """
+        with self._lock:
+            self.counters[name] = self.counters.get(name, 0) + amount
+
+    def add_file(self, path: str, seconds: float) -> None:
+        """! @brief Add worker time spent on one file.
+        @param path File path.
+        @param seconds Elapsed wall time.
+        @return {None} Function return value.
+        """
+        with self._lock:
+            self.files[path] = self.files.get(path, 0.0) + seconds
+
+    def snapshot(self) -> dict:
+        """! @brief Return the recorded data as picklable plain containers.
+        @return Dictionary with `spans`, `counters`, and `files` keys.
+        """
+        with self._lock:
+            return {
+                "spans": {name: list(entry) for name, entry in self.spans.items()},
+                "counters": dict(self.counters),
+                "files": dict(self.files),
+            }
+
+    def merge(self, snapshot: dict) -> None:
+        """! @brief Fold a worker snapshot into this profile.
+        @param snapshot Value returned by `snapshot()` in another process.
+        @return {None} Function return value.
+        """
+        for name, (seconds, calls) in snapshot["spans"].items():
+            self.add_span(name, seconds, calls)
+        for name, amount in snapshot["counters"].items():
+            self.add(name, amount)
+        for path, seconds in snapshot["files"].items():
+            self.add_file(path, seconds)
+
+    def report(self, top: int = PROFILE_TOP_FILES) -> dict:
+        """! @brief Build the JSON-serializable profile report.
+        @param top Number of slowest files to list.
+        @return Dictionary with `wall_seconds`, `spans` (name-sorted `{name, seconds, calls}`), `counters` (name-sorted), and `slowest_files`.
+        @details Span seconds are summed over all processes, so with `--jobs` they can exceed the wall time.
+        """
+        data = self.snapshot()
+        slowest = sorted(data["files"].items(), key=lambda item: (-item[1], item[0]))[:top]
+        return {
+            "wall_seconds": time.perf_counter() - self.started,
+            "spans": [
+                {"name": name, "seconds": seconds, "calls": calls}
+                for name, (seconds, calls) in sorted(data["spans"].items())
+            ],
+            "counters": dict(sorted(data["counters"].items())),
+            "slowest_files": [{"path": path, "seconds": seconds} for path, seconds in slowest],
+        }
+
+    def format_table(self, top: int = PROFILE_TOP_FILES) -> str:
+        """! @brief Render the profile report as an aligned text table.
+        @param top Number of slowest files to list.
+        @return Multi-line report with span, counter, and slowest-file sections.
+        """
+        report = self.report(top)
+        wall = report["wall_seconds"]
+        lines = [f"Profile: {wall * 1000:.1f} ms wall", "", f"  {'phase':<32}{'calls':>8}{'ms':>12}{'%wall':>8}"]
+        for entry in report["spans"]:
+            share = 100 * entry["seconds"] / wall if wall > 0 else 0.0
+            lines.append(f"  {entry['name']:<32}{entry['calls']:>8}{entry['seconds'] * 1000:>12.1f}{share:>7.1f}%")
+        if report["counters"]:
+            lines += ["", f"  {'counter':<32}{'value':>20}"]
+            lines += [f"  {name:<32}{value:>20,}" for name, value in report["counters"].items()]
+        if report["slowest_files"]:
+            lines += ["", f"  slowest files (top {top})"]
+            lines += [f"  {entry['seconds'] * 1000:>10.1f} ms  {entry['path']}" for entry in report["slowest_files"]]
+        return "\n".join(lines)
+
+    def format(self, output_format: str = "table", top: int = PROFILE_TOP_FILES) -> str:
+        """! @brief Render the report in one of `PROFILE_FORMATS`.
+        @param output_format `table` or `json`.
+        @param top Number of slowest files to list.
+        @return Rendered report.
+        @throws ValueError If `output_format` is unknown.
+        """
+        if output_format == "json":
+            return json.dumps(self.report(top), indent=2)
+        if output_format == "table":
+            return self.format_table(top)
+        raise ValueError(f"Unknown profile format '{output_format}'.")
+
+
+class _Span:
+    """! @brief Context manager adding its elapsed time to a profiler span."""
+
+    __slots__ = ("profiler", "name", "start")
+
+    def __init__(self, profiler: Profiler, name: str):
+        """! @brief Bind the span to a profiler.
+        @param profiler Active profiler.
+        @param name Dotted phase name.
+        @return {None} Function return value.
+        """
+        self.profiler = profiler
+        self.name = name
+        self.start = 0.0
+
+    def __enter__(self) -> "_Span":
+        """! @brief Start timing.
+        @return This span.
+        """
+        self.start = time.perf_counter()
+        return self
+
+    def __exit__(self, *exc_info) -> bool:
+        """! @brief Stop timing and record the elapsed time, also when the body raised.
+        @param exc_info Exception triple, ignored.
+        @return False, so exceptions propagate.
+        """
+        self.profiler.add_span(self.name, time.perf_counter() - self.start)
+        return False
+
+
+_ACTIVE: Optional[Profiler] = None
+"""! @brief Profiler receiving instrumentation in this process, or None when profiling is disabled."""
+
+_DISABLED_SPAN = nullcontext()
+"""! @brief Shared no-op context manager returned by `span()` while profiling is disabled."""
+
+
+def start() -> Profiler:
+    """! @brief Enable profiling in this process with an empty profiler.
+    @return The new active profiler (any previous one is discarded).
+    @satisfies SRS-391
+    """
+    global _ACTIVE
+    _ACTIVE = Profiler()
+    return _ACTIVE
+
+
+def stop() -> Optional[Profiler]:
+    """! @brief Disable profiling in this process.
+    @return The profiler that was active, or None.
+    """
+    global _ACTIVE
+    profiler, _ACTIVE = _ACTIVE, None
+    return profiler
+
+
+def active() -> Optional[Profiler]:
+    """! @brief Return the active profiler.
+    @return Active profiler, or None when profiling is disabled.
+    """
+    return _ACTIVE
+
+
+def span(name: str):
+    """! @brief Time a block under a phase name.
+    @param name Dotted phase name.
+    @return Timing context manager, or a shared no-op one while profiling is disabled.
+    @satisfies SRS-391
+    """
+    if _ACTIVE is None:
+        return _DISABLED_SPAN
+    return _Span(_ACTIVE, name)
+
+
+def count(name: str, amount: int = 1) -> None:
+    """! @brief Increment a counter of the active profiler.
+    @param name Counter name.
+    @param amount Increment.
+    @return {None} Function return value; does nothing while profiling is disabled.
+    """
+    if _ACTIVE is not None:
+        _ACTIVE.add(name, amount)
+
+
+def record_file(path: Optional[str], seconds: float) -> None:
+    """! @brief Add per-file worker time to the active profiler.
+    @param path File path, or None when the work item has no path.
+    @param seconds Elapsed wall time.
+    @return {None} Function return value; does nothing while profiling is disabled.
+    """
+    if _ACTIVE is not None and path is not None:
+        _ACTIVE.add_file(path, seconds)
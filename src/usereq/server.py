@@ -0,0 +1,347 @@
+"""!
+@file server.py
+@brief Resident command server for `--serve` and the thin client used by `main()`.
+@details One server process per project directory listens on a unix socket and runs forwarded `--references`, `--compress`, `--find`, `--tokens`, and
+`--files-*` commands in-process, so interpreter startup, module imports, the tokenizer encoding, language specs, the `git ls-files` file list, and
+analysis payloads stay loaded between calls. Requests are one JSON line `{"argv", "cwd", "version"}`; responses are frames of a one-byte channel (`o`
+stdout, `e` stderr, `x` exit status, `r` refused) and a 4-byte big-endian payload length. Commands run one at a time. A client that finds no live server,
+or a server of another package version, returns None and the caller runs the command locally. Sockets are only used inside a private directory owned by
+the current user, so on a shared temporary directory another user cannot plant a server that answers in their place.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import hashlib
+import io
+import json
+import os
+import socket
+import stat
+import struct
+import sys
+import tempfile
+from contextlib import redirect_stderr, redirect_stdout
+from pathlib import Path
+from typing import Callable, Optional
+
+SERVER_IDLE_TIMEOUT_SECONDS = 1800
+"""! @brief Idle time after which a server without requests exits."""
+
+CONNECT_TIMEOUT_SECONDS = 1.0
+"""! @brief Timeout for connecting to a server socket; the command itself is not time limited."""
+
+FRAME_FLUSH_CHARS = 1 << 16
+"""! @brief Buffered output characters sent as one frame."""
+
+_HEADER = struct.Struct(">cI")
+"""! @brief Frame header: channel byte and payload length."""
+
+
+def socket_path(project: Path | str) -> Path:
+    """! @brief Return the socket location of the server of a project directory.
+    @param project Project directory.
+    @return `<tmp>/usereq-<uid>/<sha1(project)[:16]>.sock`; short enough for the unix socket path limit wherever the project lives.
+    """
+    key = hashlib.sha1(os.path.realpath(project).encode("utf-8", "surrogateescape")).hexdigest()[:16]
+    uid = os.getuid() if hasattr(os, "getuid") else 0
+    return Path(tempfile.gettempdir()) / f"usereq-{uid}" / f"{key}.sock"
+
+
+def socket_dir_is_private(directory: Path) -> bool:
+    """! @brief Check that a socket directory can only be used by the current user.
+    @param directory Directory holding server sockets.
+    @return True when `directory` is a real directory (not a symlink) owned by the current user with no group or other permission bits.
+    """
+    try:
+        st = os.lstat(directory)
+    except OSError:
+        return False
+    if not stat.S_ISDIR(st.st_mode) or st.st_mode & 0o077:
+        return False
+    return not hasattr(os, "getuid") or st.st_uid == os.getuid()
+
+
+def _send_frame(conn: socket.socket, channel: bytes, payload: bytes) -> None:
+    """! @brief Send one response frame.
+    @param conn Connected socket.
+    @param channel One-byte channel identifier.
+    @param payload Frame payload.
+    @return {None} Function return value.
+    """
+    conn.sendall(_HEADER.pack(channel, len(payload)) + payload)
+
+
+def _recv_exact(conn: socket.socket, size: int) -> Optional[bytes]:
+    """! @brief Read exactly `size` bytes.
+    @param conn Connected socket.
+    @param size Byte count.
+    @return Bytes read, or None when the peer closed the connection first.
+    """
+    chunks = []
+    while size:
+        chunk = conn.recv(min(size, 1 << 20))
+        if not chunk:
+            return None
+        chunks.append(chunk)
+        size -= len(chunk)
+    return b"".join(chunks)
+
+
+class _FrameStream(io.TextIOBase):
+    """! @brief Text stream forwarding writes to the client as frames of one channel."""
+
+    def __init__(self, conn: socket.socket, channel: bytes):
+        """! @brief Bind the stream to a connection and channel.
+        @param conn Connected client socket.
+        @param channel `o` or `e`.
+        @return {None} Function return value.
+        """
+        super().__init__()
+        self._conn = conn
+        self._channel = channel
+        self._parts: list = []
+        self._size = 0
+
+    def writable(self) -> bool:
+        """! @brief Report the stream as writable.
+        @return True.
+        """
+        return True
+
+    def write(self, text: str) -> int:
+        """! @brief Buffer text and send a frame once `FRAME_FLUSH_CHARS` are pending.
+        @param text Text to write.
+        @return Number of characters written.
+        """
+        self._parts.append(text)
+        self._size += len(text)
+        if self._size >= FRAME_FLUSH_CHARS:
+            self.flush()
+        return len(text)
+
+    def flush(self) -> None:
+        """! @brief Send the pending text as one frame.
+        @return {None} Function return value.
+        """
+        if self._parts:
+            data = "".join(self._parts).encode("utf-8", "surrogateescape")
+            self._parts, self._size = [], 0
+            _send_frame(self._conn, self._channel, data)
+
+
+def _request(path: Path, payload: dict) -> Optional[socket.socket]:
+    """! @brief Connect to a server socket and send one request line.
+    @param path Socket path.
+    @param payload JSON-serializable request.
+    @return Connected socket, or None when no server accepts connections on `path` or its directory is not private (`socket_dir_is_private()`).
+    """
+    if not hasattr(socket, "AF_UNIX") or not socket_dir_is_private(path.parent) or not path.exists():
+        return None
+    conn = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        conn.settimeout(CONNECT_TIMEOUT_SECONDS)
+        conn.connect(str(path))
+        conn.settimeout(None)
+        conn.sendall(json.dumps(payload).encode("utf-8") + b"\n")
+    except OSError:
+        conn.close()
+        return None
+    return conn
+
+
+def forward(argv: list, cwd: str, version: str, stdout=None, stderr=None) -> Optional[int]:
+    """! @brief Run a command on the server of `cwd` and relay its output.
+    @param argv CLI arguments.
+    @param cwd Client working directory; also selects the server.
+    @param version Client package version; a server of another version refuses the request.
+    @param stdout Destination of command stdout (default: current `sys.stdout`).
+    @param stderr Destination of command stderr (default: current `sys.stderr`).
+    @return Exit status of the command, or None when no compatible server handled it and the caller must run it locally.
+    @details Output is relayed as it arrives. A connection lost after output started is reported on stderr with status 1 instead of re-running the command.
+    @satisfies SRS-393
+    """
+    conn = _request(socket_path(cwd), {"argv": list(argv), "cwd": cwd, "version": version})
+    if conn is None:
+        return None
+    out = stdout if stdout is not None else sys.stdout
+    err = stderr if stderr is not None else sys.stderr
+    streams = {b"o": out, b"e": err}
+    started = False
+    try:
+        while True:
+            header = _recv_exact(conn, _HEADER.size)
+            if header is None:
+                break
+            channel, size = _HEADER.unpack(header)
+            payload = _recv_exact(conn, size) if size else b""
+            if payload is None:
+                break
+            if channel == b"r":
+                return None
+            if channel == b"x":
+                out.flush()
+                return int(payload)
+            streams[channel].write(payload.decode("utf-8", "surrogateescape"))
+            started = True
+    except OSError:
+        pass
+    finally:
+        conn.close()
+    if not started:
+        return None
+    print("Error: connection to the usereq server was lost.", file=err)
+    return 1
+
+
+def stop(cwd: str) -> bool:
+    """! @brief Ask the server of a project directory to exit.
+    @param cwd Project directory.
+    @return True when a running server acknowledged the request.
+    """
+    conn = _request(socket_path(cwd), {"op": "stop"})
+    if conn is None:
+        return False
+    try:
+        return _recv_exact(conn, _HEADER.size) is not None
+    except OSError:
+        return False
+    finally:
+        conn.close()
+
+
+def _warm_up() -> None:
+    """! @brief Load the modules, language specs, and tokenizer encoding used by forwarded commands.
+    @return {None} Function return value; a missing optional component is loaded on first use instead.
+    """
+    from . import compress_files, find_constructs, generate_markdown  # noqa: F401
+    from .source_analyzer import SourceAnalyzer
+
+    SourceAnalyzer()
+    try:
+        from .token_counter import get_token_counter
+
+        get_token_counter()
+    except Exception:
+        pass
+
+
+def _handle(conn: socket.socket, run: Callable[[list], int], version: str) -> bool:
+    """! @brief Serve one connection.
+    @param conn Accepted client socket.
+    @param run Callable executing CLI arguments in-process and returning the exit status.
+    @param version Server package version.
+    @return False when the client asked the server to stop.
+    @details The command runs in the client working directory with stdout and stderr redirected to the connection; the server working directory is restored
+    afterwards.
+    """
+    with conn:
+        line = conn.makefile("rb").readline()
+        try:
+            request = json.loads(line)
+        except ValueError:
+            return True
+        if request.get("op") == "stop":
+            _send_frame(conn, b"x", b"0")
+            return False
+        if request.get("version") != version:
+            _send_frame(conn, b"r", b"")
+            return True
+        out, err = _FrameStream(conn, b"o"), _FrameStream(conn, b"e")
+        previous_cwd = os.getcwd()
+        try:
+            os.chdir(request["cwd"])
+            with redirect_stdout(out), redirect_stderr(err):
+                try:
+                    status = run(list(request["argv"]))
+                except SystemExit as e:
+                    status = e.code if isinstance(e.code, int) else 1
+            out.flush()
+            err.flush()
+            _send_frame(conn, b"x", str(status).encode("ascii"))
+        except OSError:
+            pass
+        finally:
+            os.chdir(previous_cwd)
+    return True
+
+
+def is_running(path: Path) -> bool:
+    """! @brief Check whether a server accepts connections on a socket path.
+    @param path Socket path.
+    @return True when a connection succeeds.
+    """
+    if not hasattr(socket, "AF_UNIX") or not Path(path).exists():
+        return False
+    probe = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        probe.settimeout(CONNECT_TIMEOUT_SECONDS)
+        probe.connect(str(path))
+        return True
+    except OSError:
+        return False
+    finally:
+        probe.close()
+
+
+def serve(project: Path, run: Callable[[list], int], version: str, path: Optional[Path] = None,
+          idle_timeout: Optional[float] = SERVER_IDLE_TIMEOUT_SECONDS, on_ready: Optional[Callable[[Path], None]] = None) -> None:
+    """! @brief Run the server of a project directory until stopped, idle, or interrupted.
+    @param project Project directory served.
+    @param run Callable executing CLI arguments in-process and returning the exit status.
+    @param version Package version accepted from clients.
+    @param path Socket path override (default: `socket_path(project)`).
+    @param idle_timeout Seconds without connections before exiting, or None to wait forever.
+    @param on_ready Optional callback receiving the bound socket path.
+    @return {None} Function return value.
+    @throws ValueError If unix sockets are unavailable, the socket directory is not private to the current user, or another server already listens on the
+    socket.
+    @details Loads the shared modules and enables the in-memory analysis cache layer before accepting connections; the socket, created with owner-only
+    permissions, is removed on exit.
+    @satisfies SRS-393
+    """
+    if not hasattr(socket, "AF_UNIX"):
+        raise ValueError("unix domain sockets are not supported on this platform")
+    from . import analysis_cache
+
+    path = Path(path) if path is not None else socket_path(project)
+    path.parent.mkdir(mode=0o700, parents=True, exist_ok=True)
+    if not socket_dir_is_private(path.parent):
+        raise ValueError(f"socket directory {path.parent} is not a private directory owned by the current user")
+    if is_running(path):
+        raise ValueError(f"a usereq server is already running on {path}")
+    try:
+        path.unlink()
+    except FileNotFoundError:
+        pass
+    _warm_up()
+    analysis_cache.enable_memory()
+    listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    previous_umask = os.umask(0o177)
+    try:
+        listener.bind(str(path))
+    finally:
+        os.umask(previous_umask)
+    try:
+        listener.listen(16)
+        listener.settimeout(idle_timeout)
+        if on_ready is not None:
+            on_ready(path)
+        while True:
+            try:
+                conn, _ = listener.accept()
+            except socket.timeout:
+                break
+            conn.settimeout(None)
+            try:
+                if not _handle(conn, run, version):
+                    break
+            except OSError:
+                continue
+    finally:
+        listener.close()
+        analysis_cache.disable_memory()
+        try:
+            path.unlink()
+        except OSError:
+            pass
+
@@ -11,14 +11,23 @@ import argparse
 import os
 import re
 import sys
+from bisect import bisect_left, bisect_right
+from collections import deque
+from collections.abc import Mapping
 from dataclasses import dataclass, field
 from enum import Enum, auto
-from typing import Optional
+from typing import Callable, Optional, Sequence
 
 try:
+    from . import profiling
     from .doxygen_parser import parse_doxygen_comment
+    from .line_lexer import BlockEndTracker, BraceIndex, get_line_lexer, iter_brace_marks
+    from .source_buffer import SourceBuffer
 except ImportError:
+    from usereq import profiling
     from usereq.doxygen_parser import parse_doxygen_comment
+    from usereq.line_lexer import BlockEndTracker, BraceIndex, get_line_lexer, iter_brace_marks
+    from usereq.source_buffer import SourceBuffer
 
 
 class ElementType(Enum):
@@ -52,31 +61,226 @@ class ElementType(Enum):
     TYPEDEF = auto()
 
 
-@dataclass
+_TYPE_LABELS = {
+    **{element_type: element_type.name for element_type in ElementType},
+    ElementType.COMMENT_SINGLE: "COMMENT",
+    ElementType.COMMENT_MULTI: "COMMENT",
+}
+"""! @brief Printable label of every ElementType (both comment kinds render as `COMMENT`)."""
+
+EXTRACT_MAX_LINES = 5
+"""! @brief Maximum number of lines kept in `SourceElement.extract` (SRS-133)."""
+
+
+class _EmptyFields(dict):
+    """! @brief Read-only empty mapping shared as the default `SourceElement.doxygen_fields`.
+    @details Compares equal to `{}` and pickles as a plain empty dict; mutation raises so the shared instance cannot leak state between elements.
+    """
+
+    __slots__ = ()
+
+    def _read_only(self, *args, **kwargs):
+        """! @brief Reject in-place mutation of the shared default.
+        @param args Ignored.
+        @param kwargs Ignored.
+        @return {None} Never returns.
+        @throws TypeError Always; assign a new dict to `doxygen_fields` instead.
+        """
+        raise TypeError("default doxygen_fields is read-only; assign a new dict")
+
+    __setitem__ = __delitem__ = __ior__ = _read_only
+    clear = pop = popitem = setdefault = update = _read_only
+
+    def __hash__(self) -> int:
+        """! @brief Hash the immutable empty mapping.
+        @return Constant hash.
+        """
+        return 0
+
+    def __reduce__(self):
+        """! @brief Pickle as a plain empty dict.
+        @return Reduction tuple.
+        """
+        return dict, ()
+
+
+NO_DOXYGEN_FIELDS = _EmptyFields()
+"""! @brief Shared empty default of `SourceElement.doxygen_fields`."""
+
+_FROM_SOURCE = object()
+"""! @brief `comment_source` marker: the full comment text is the joined source lines of the element range."""
+
+
+def _source_extract(lines: list, line_start: int, line_end: int) -> str:
+    """! @brief Build the display extract of a line range.
+    @param lines File lines with terminators.
+    @param line_start First line (1-based).
+    @param line_end Last line (1-based, inclusive).
+    @return Lines joined without terminators; ranges longer than `EXTRACT_MAX_LINES` keep 4 lines followed by `    ...`.
+    """
+    if line_end - line_start + 1 > EXTRACT_MAX_LINES:
+        shown = [line.rstrip("\n\r") for line in lines[line_start - 1:line_start + 3]]
+        shown.append("    ...")
+        return "\n".join(shown)
+    return "\n".join(line.rstrip("\n\r") for line in lines[line_start - 1:line_end])
+
+
 class SourceElement:
     """! @brief Element found in source file.
-    @details Data class representing a single extracted code construct with its metadata.
+    @details Slotted record of a single extracted code construct with its metadata. Elements built by `SourceAnalyzer.analyze()` keep a reference to the
+    file's shared line list instead of private `extract`/`comment_source` copies and derive them on access; pickling stores the derived text, so cached
+    payloads are independent of the source buffer. Empty annotations share immutable defaults (`()` and `NO_DOXYGEN_FIELDS`); enrichment assigns new
+    containers instead of mutating them.
+    @satisfies SRS-392
     """
-    element_type: ElementType
-    line_start: int
-    line_end: int
-    extract: str
-    """! @brief Truncated display text of the element (max 5 lines per SRS-133)."""
-    name: Optional[str] = None
-    signature: Optional[str] = None
-    visibility: Optional[str] = None
-    parent_name: Optional[str] = None
-    inherits: Optional[str] = None
-    depth: int = 0
-    comment_source: Optional[str] = None
-    """! @brief Full untruncated comment text for COMMENT_MULTI elements.
-    @details Preserves the complete multi-line comment content for Doxygen field
-    extraction (SRS-143) while allowing extract to remain truncated (SRS-133).
-    None for non-comment elements and single-line comments.
-    """
-    body_comments: list = field(default_factory=list)
-    exit_points: list = field(default_factory=list)
-    doxygen_fields: dict = field(default_factory=dict)
+
+    __slots__ = (
+        "element_type",
+        "line_start",
+        "line_end",
+        "_extract",
+        "name",
+        "signature",
+        "visibility",
+        "parent_name",
+        "inherits",
+        "depth",
+        "_comment_source",
+        "body_comments",
+        "exit_points",
+        "doxygen_fields",
+        "_lines",
+    )
+
+    __hash__ = None
+
+    def __init__(
+        self,
+        element_type: ElementType,
+        line_start: int,
+        line_end: int,
+        extract: Optional[str] = None,
+        name: Optional[str] = None,
+        signature: Optional[str] = None,
+        visibility: Optional[str] = None,
+        parent_name: Optional[str] = None,
+        inherits: Optional[str] = None,
+        depth: int = 0,
+        comment_source: Optional[str] = None,
+        body_comments: Sequence = (),
+        exit_points: Sequence = (),
+        doxygen_fields: dict = NO_DOXYGEN_FIELDS,
+        source_lines: Optional[list] = None,
+    ):
+        """! @brief Create an element.
+        @param element_type Construct kind.
+        @param line_start First line (1-based).
+        @param line_end Last line (1-based, inclusive).
+        @param extract Truncated display text; None derives it from `source_lines`.
+        @param name Construct name.
+        @param signature Cleaned declaration signature.
+        @param visibility Visibility keyword.
+        @param parent_name Enclosing container name.
+        @param inherits Inheritance clause.
+        @param depth Nesting depth.
+        @param comment_source Full untruncated comment text for COMMENT_MULTI elements, or the `_FROM_SOURCE` marker.
+        @param body_comments `(start, end, text)` body comment tuples.
+        @param exit_points `(line, text)` exit point tuples.
+        @param doxygen_fields Parsed Doxygen fields.
+        @param source_lines Shared file lines from which a None `extract` and a `_FROM_SOURCE` `comment_source` are derived.
+        @return {None} Function return value.
+        """
+        self.element_type = element_type
+        self.line_start = line_start
+        self.line_end = line_end
+        self._extract = extract
+        self.name = name
+        self.signature = signature
+        self.visibility = visibility
+        self.parent_name = parent_name
+        self.inherits = inherits
+        self.depth = depth
+        self._comment_source = comment_source
+        self.body_comments = body_comments
+        self.exit_points = exit_points
+        self.doxygen_fields = doxygen_fields
+        self._lines = source_lines
+
+    @property
+    def extract(self) -> str:
+        """! @brief Truncated display text of the element (max 5 lines per SRS-133).
+        @return Stored extract, or the extract derived from the shared source lines.
+        """
+        if self._extract is None and self._lines is not None:
+            return _source_extract(self._lines, self.line_start, self.line_end)
+        return self._extract
+
+    @extract.setter
+    def extract(self, value: str) -> None:
+        """! @brief Replace the extract text.
+        @param value New extract.
+        @return {None} Function return value.
+        """
+        self._extract = value
+
+    @property
+    def first_line(self) -> str:
+        """! @brief Return the first line of `extract` without building the whole extract.
+        @return First extract line, or an empty string for an empty extract.
+        """
+        if self._extract is None and self._lines is not None:
+            if self.line_end < self.line_start:
+                return ""
+            return self._lines[self.line_start - 1].rstrip("\n\r")
+        return self._extract.split("\n", 1)[0]
+
+    def extract_lines(self) -> list:
+        """! @brief Return `extract` split into lines without joining derived text first.
+        @return Extract lines without terminators.
+        """
+        if self._extract is None and self._lines is not None:
+            if self.line_end - self.line_start + 1 > EXTRACT_MAX_LINES:
+                shown = [line.rstrip("\n\r") for line in self._lines[self.line_start - 1:self.line_start + 3]]
+                shown.append("    ...")
+                return shown
+            if self.line_end < self.line_start:
+                return [""]
+            return [line.rstrip("\n\r") for line in self._lines[self.line_start - 1:self.line_end]]
+        return self._extract.split("\n")
+
+    def search_text(self, pattern) -> bool:
+        """! @brief Test whether a single-line pattern occurs in `comment_source`, or in `extract` when there is no comment source.
+        @details Text derived from the shared source lines is searched line by line without joining it first.
+        @param pattern Compiled regular expression that never spans a line break.
+        @return True when `pattern.search()` matches.
+        """
+        if self._lines is not None and (self._comment_source is _FROM_SOURCE or (self._comment_source is None and self._extract is None)):
+            end = self.line_end
+            if self._comment_source is not _FROM_SOURCE and end - self.line_start + 1 > EXTRACT_MAX_LINES:
+                end = self.line_start + EXTRACT_MAX_LINES - 2
+            return any(pattern.search(line) for line in self._lines[self.line_start - 1:end])
+        text = self.comment_source or self.extract
+        return bool(text) and bool(pattern.search(text))
+
+    @property
+    def comment_source(self) -> Optional[str]:
+        """! @brief Full untruncated comment text for COMMENT_MULTI elements.
+        @details Preserves the complete multi-line comment content for Doxygen field extraction (SRS-143) while allowing extract to remain truncated
+        (SRS-133). None for non-comment elements and single-line comments.
+        @return Comment text, or None.
+        """
+        if self._comment_source is _FROM_SOURCE:
+            return "\n".join(
+                line.rstrip("\n\r") for line in self._lines[self.line_start - 1:self.line_end])
+        return self._comment_source
+
+    @comment_source.setter
+    def comment_source(self, value: Optional[str]) -> None:
+        """! @brief Replace the full comment text.
+        @param value New comment text, or None.
+        @return {None} Function return value.
+        """
+        self._comment_source = value
 
     @property
     def type_label(self) -> str:
@@ -84,34 +288,54 @@ class SourceElement:
         @return Stable uppercase label used in markdown rendering output.
         @details Maps internal ElementType enum to a string representation for reporting.
         """
-        labels = {
-            ElementType.FUNCTION: "FUNCTION",
-            ElementType.METHOD: "METHOD",
-            ElementType.CLASS: "CLASS",
-            ElementType.STRUCT: "STRUCT",
-            ElementType.ENUM: "ENUM",
-            ElementType.TRAIT: "TRAIT",
-            ElementType.INTERFACE: "INTERFACE",
-            ElementType.MODULE: "MODULE",
-            ElementType.IMPL: "IMPL",
-            ElementType.MACRO: "MACRO",
-            ElementType.CONSTANT: "CONSTANT",
-            ElementType.VARIABLE: "VARIABLE",
-            ElementType.TYPE_ALIAS: "TYPE_ALIAS",
-            ElementType.IMPORT: "IMPORT",
-            ElementType.DECORATOR: "DECORATOR",
-            ElementType.COMMENT_SINGLE: "COMMENT",
-            ElementType.COMMENT_MULTI: "COMMENT",
-            ElementType.COMPONENT: "COMPONENT",
-            ElementType.PROTOCOL: "PROTOCOL",
-            ElementType.EXTENSION: "EXTENSION",
-            ElementType.UNION: "UNION",
-            ElementType.NAMESPACE: "NAMESPACE",
-            ElementType.PROPERTY: "PROPERTY",
-            ElementType.SIGNAL: "SIGNAL",
-            ElementType.TYPEDEF: "TYPEDEF",
-        }
-        return labels.get(self.element_type, "UNKNOWN")
+        return _TYPE_LABELS.get(self.element_type, "UNKNOWN")
+
+    def _fields(self) -> tuple:
+        """! @brief Return every public field value in constructor order, with derived text materialized.
+        @return Field tuple.
+        """
+        return (
+            self.element_type, self.line_start, self.line_end, self.extract, self.name, self.signature, self.visibility,
+            self.parent_name, self.inherits, self.depth, self.comment_source, self.body_comments, self.exit_points,
+            self.doxygen_fields,
+        )
+
+    def __eq__(self, other) -> bool:
+        """! @brief Compare two elements field by field.
+        @param other Object to compare.
+        @return True when `other` is a SourceElement with equal fields; NotImplemented for other types.
+        """
+        if other is self:
+            return True
+        if other.__class__ is not self.__class__:
+            return NotImplemented
+        if (self.line_start, self.line_end, self.element_type) != (other.line_start, other.line_end, other.element_type):
+            return False
+        return self._fields() == other._fields()
+
+    def __repr__(self) -> str:
+        """! @brief Render the element like a dataclass.
+        @return `SourceElement(field=value, ...)`.
+        """
+        names = ("element_type", "line_start", "line_end", "extract", "name", "signature", "visibility", "parent_name",
+                 "inherits", "depth", "comment_source", "body_comments", "exit_points", "doxygen_fields")
+        values = ", ".join(f"{name}={value!r}" for name, value in zip(names, self._fields()))
+        return f"SourceElement({values})"
+
+    def __getstate__(self) -> tuple:
+        """! @brief Return the picklable state with derived text materialized and no source reference.
+        @return Field tuple.
+        """
+        return self._fields()
+
+    def __setstate__(self, state: tuple) -> None:
+        """! @brief Restore an element from `__getstate__()` output.
+        @param state Field tuple.
+        @return {None} Function return value.
+        """
+        if not state[13]:
+            state = state[:13] + (NO_DOXYGEN_FIELDS,)
+        self.__init__(*state)
 
 
 @dataclass
@@ -125,18 +349,52 @@ class LanguageSpec:
     multi_comment_end: Optional[str] = None
     string_delimiters: tuple = ("\"", "'")
     patterns: list = field(default_factory=list)
+    _fused: Optional[re.Pattern] = field(default=None, init=False, repr=False, compare=False)
 
+    def fused_pattern(self) -> Optional[re.Pattern]:
+        """! @brief Return the single-pass alternation of every construct pattern.
+        @return Compiled `(?P<_p0>...)|(?P<_p1>...)|...` regex, or None when the patterns cannot be fused (mixed flags, inline flags, or backreferences).
+        @details Built once per specification on first use. Alternatives keep `patterns` order, so the leftmost-first alternation selects the same pattern as the
+        sequential loop.
+        """
+        if self._fused is None and self.patterns:
+            flags = {pattern.flags for _, pattern in self.patterns}
+            sources = [pattern.pattern for _, pattern in self.patterns]
+            if len(flags) == 1 and not any(
+                    "(?P" in src or re.search(r"\(\?[aiLmsux]|\\[1-9]", src)
+                    for src in sources):
+                self._fused = re.compile(
+                    "|".join(f"(?P<_p{index}>{src})" for index, src in enumerate(sources)),
+                    flags.pop())
+        return self._fused
+
+    def match_construct(self, line: str) -> Optional[tuple]:
+        """! @brief Match a line against the construct patterns with one regex attempt.
+        @param line Source line without terminator.
+        @return Tuple `(ElementType, re.Match)` of the first matching pattern in `patterns` order, or None.
+        @details Non-matching lines (the common case) cost one fused regex attempt; on a hit the selected pattern is re-run so match groups keep their original
+        numbering. Falls back to the sequential scan when the patterns cannot be fused.
+        @satisfies SRS-379
+        """
+        fused = self.fused_pattern()
+        if fused is None:
+            for elem_type, pattern in self.patterns:
+                match = pattern.match(line)
+                if match:
+                    return elem_type, match
+            return None
+        hit = fused.match(line)
+        if hit is None:
+            return None
+        elem_type, pattern = self.patterns[int(hit.lastgroup[2:])]
+        return elem_type, pattern.match(line)
 
-def build_language_specs() -> dict:
-    """!
-    @brief Build specifications for all supported languages.
-    @details Implements the build_language_specs function behavior with deterministic control flow.
-    @return {dict} Function return value.
-    """
-    specs = {}
 
-    # ── Python ──────────────────────────────────────────────────────────
-    specs["python"] = LanguageSpec(
+def _python_spec() -> LanguageSpec:
+    """! @brief Build the Python language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Python",
         single_comment="#",
         multi_comment_start='"""',
@@ -156,8 +414,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── C ───────────────────────────────────────────────────────────────
-    specs["c"] = LanguageSpec(
+
+def _c_spec() -> LanguageSpec:
+    """! @brief Build the C language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="C",
         single_comment="//",
         multi_comment_start="/*",
@@ -190,8 +452,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── C++ ─────────────────────────────────────────────────────────────
-    specs["cpp"] = LanguageSpec(
+
+def _cpp_spec() -> LanguageSpec:
+    """! @brief Build the C++ language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="C++",
         single_comment="//",
         multi_comment_start="/*",
@@ -220,8 +486,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Rust ────────────────────────────────────────────────────────────
-    specs["rust"] = LanguageSpec(
+
+def _rust_spec() -> LanguageSpec:
+    """! @brief Build the Rust language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Rust",
         single_comment="//",
         multi_comment_start="/*",
@@ -252,8 +522,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── JavaScript ──────────────────────────────────────────────────────
-    specs["javascript"] = LanguageSpec(
+
+def _javascript_spec() -> LanguageSpec:
+    """! @brief Build the JavaScript language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="JavaScript",
         single_comment="//",
         multi_comment_start="/*",
@@ -280,8 +554,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── TypeScript ──────────────────────────────────────────────────────
-    specs["typescript"] = LanguageSpec(
+
+def _typescript_spec() -> LanguageSpec:
+    """! @brief Build the TypeScript language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="TypeScript",
         single_comment="//",
         multi_comment_start="/*",
@@ -313,8 +591,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Java ────────────────────────────────────────────────────────────
-    specs["java"] = LanguageSpec(
+
+def _java_spec() -> LanguageSpec:
+    """! @brief Build the Java language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Java",
         single_comment="//",
         multi_comment_start="/*",
@@ -345,8 +627,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Go ──────────────────────────────────────────────────────────────
-    specs["go"] = LanguageSpec(
+
+def _go_spec() -> LanguageSpec:
+    """! @brief Build the Go language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Go",
         single_comment="//",
         multi_comment_start="/*",
@@ -372,8 +658,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Ruby ────────────────────────────────────────────────────────────
-    specs["ruby"] = LanguageSpec(
+
+def _ruby_spec() -> LanguageSpec:
+    """! @brief Build the Ruby language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Ruby",
         single_comment="#",
         multi_comment_start="=begin",
@@ -394,8 +684,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── PHP ─────────────────────────────────────────────────────────────
-    specs["php"] = LanguageSpec(
+
+def _php_spec() -> LanguageSpec:
+    """! @brief Build the PHP language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="PHP",
         single_comment="//",
         multi_comment_start="/*",
@@ -418,8 +712,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Swift ───────────────────────────────────────────────────────────
-    specs["swift"] = LanguageSpec(
+
+def _swift_spec() -> LanguageSpec:
+    """! @brief Build the Swift language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Swift",
         single_comment="//",
         multi_comment_start="/*",
@@ -448,8 +746,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Kotlin ──────────────────────────────────────────────────────────
-    specs["kotlin"] = LanguageSpec(
+
+def _kotlin_spec() -> LanguageSpec:
+    """! @brief Build the Kotlin language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Kotlin",
         single_comment="//",
         multi_comment_start="/*",
@@ -477,8 +779,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Scala ───────────────────────────────────────────────────────────
-    specs["scala"] = LanguageSpec(
+
+def _scala_spec() -> LanguageSpec:
+    """! @brief Build the Scala language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Scala",
         single_comment="//",
         multi_comment_start="/*",
@@ -503,8 +809,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Lua ─────────────────────────────────────────────────────────────
-    specs["lua"] = LanguageSpec(
+
+def _lua_spec() -> LanguageSpec:
+    """! @brief Build the Lua language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Lua",
         single_comment="--",
         multi_comment_start="--[[",
@@ -519,8 +829,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Shell (Bash) ────────────────────────────────────────────────────
-    specs["shell"] = LanguageSpec(
+
+def _shell_spec() -> LanguageSpec:
+    """! @brief Build the Shell (Bash) language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Shell",
         single_comment="#",
         multi_comment_start=None,
@@ -535,12 +849,13 @@ def build_language_specs() -> dict:
                 r"^(\s*(?:source|\\.)\s+(.+))")),
         ],
     )
-    specs["bash"] = specs["shell"]
-    specs["sh"] = specs["shell"]
-    specs["zsh"] = specs["shell"]
 
-    # ── Perl ────────────────────────────────────────────────────────────
-    specs["perl"] = LanguageSpec(
+
+def _perl_spec() -> LanguageSpec:
+    """! @brief Build the Perl language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Perl",
         single_comment="#",
         multi_comment_start="=pod",
@@ -557,8 +872,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Haskell ─────────────────────────────────────────────────────────
-    specs["haskell"] = LanguageSpec(
+
+def _haskell_spec() -> LanguageSpec:
+    """! @brief Build the Haskell language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Haskell",
         single_comment="--",
         multi_comment_start="{-",
@@ -579,8 +898,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Zig ─────────────────────────────────────────────────────────────
-    specs["zig"] = LanguageSpec(
+
+def _zig_spec() -> LanguageSpec:
+    """! @brief Build the Zig language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Zig",
         single_comment="//",
         multi_comment_start=None,
@@ -603,8 +926,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── Elixir ──────────────────────────────────────────────────────────
-    specs["elixir"] = LanguageSpec(
+
+def _elixir_spec() -> LanguageSpec:
+    """! @brief Build the Elixir language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="Elixir",
         single_comment="#",
         multi_comment_start=None,
@@ -625,8 +952,12 @@ def build_language_specs() -> dict:
         ],
     )
 
-    # ── C# ──────────────────────────────────────────────────────────────
-    specs["csharp"] = LanguageSpec(
+
+def _csharp_spec() -> LanguageSpec:
+    """! @brief Build the C# language specification.
+    @return {LanguageSpec} Freshly compiled specification.
+    """
+    return LanguageSpec(
         name="C#",
         single_comment="//",
         multi_comment_start="/*",
@@ -662,25 +993,434 @@ def build_language_specs() -> dict:
                 r"^(\s*(?:public\s+|private\s+)?const\s+\w+\s+(\w+)\s*=)")),
         ],
     )
-    specs["cs"] = specs["csharp"]
-
-    # Common aliases
-    specs["js"] = specs["javascript"]
-    specs["ts"] = specs["typescript"]
-    specs["rs"] = specs["rust"]
-    specs["py"] = specs["python"]
-    specs["rb"] = specs["ruby"]
-    specs["hs"] = specs["haskell"]
-    specs["cc"] = specs["cpp"]
-    specs["cxx"] = specs["cpp"]
-    specs["h"] = specs["c"]
-    specs["hpp"] = specs["cpp"]
-    specs["kt"] = specs["kotlin"]
-    specs["ex"] = specs["elixir"]
-    specs["exs"] = specs["elixir"]
-    specs["pl"] = specs["perl"]
-
-    return specs
+
+
+_LANGUAGE_SPEC_BUILDERS = {
+    "python": _python_spec,
+    "c": _c_spec,
+    "cpp": _cpp_spec,
+    "rust": _rust_spec,
+    "javascript": _javascript_spec,
+    "typescript": _typescript_spec,
+    "java": _java_spec,
+    "go": _go_spec,
+    "ruby": _ruby_spec,
+    "php": _php_spec,
+    "swift": _swift_spec,
+    "kotlin": _kotlin_spec,
+    "scala": _scala_spec,
+    "lua": _lua_spec,
+    "shell": _shell_spec,
+    "perl": _perl_spec,
+    "haskell": _haskell_spec,
+    "zig": _zig_spec,
+    "elixir": _elixir_spec,
+    "csharp": _csharp_spec,
+}
+"""! @brief Canonical language identifier to specification builder map."""
+
+
+LANGUAGE_ALIASES = {
+    "bash": "shell",
+    "sh": "shell",
+    "zsh": "shell",
+    "cs": "csharp",
+    "js": "javascript",
+    "ts": "typescript",
+    "rs": "rust",
+    "py": "python",
+    "rb": "ruby",
+    "hs": "haskell",
+    "cc": "cpp",
+    "cxx": "cpp",
+    "h": "c",
+    "hpp": "cpp",
+    "kt": "kotlin",
+    "ex": "elixir",
+    "exs": "elixir",
+    "pl": "perl",
+}
+"""! @brief Alias identifier to canonical language identifier map."""
+
+
+_SPEC_KEYS = (
+    "python",
+    "c",
+    "cpp",
+    "rust",
+    "javascript",
+    "typescript",
+    "java",
+    "go",
+    "ruby",
+    "php",
+    "swift",
+    "kotlin",
+    "scala",
+    "lua",
+    "shell",
+    "bash",
+    "sh",
+    "zsh",
+    "perl",
+    "haskell",
+    "zig",
+    "elixir",
+    "csharp",
+    "cs",
+    "js",
+    "ts",
+    "rs",
+    "py",
+    "rb",
+    "hs",
+    "cc",
+    "cxx",
+    "h",
+    "hpp",
+    "kt",
+    "ex",
+    "exs",
+    "pl",
+)
+"""! @brief Registry key order (canonical languages interleaved with aliases as historically returned by `build_language_specs()`)."""
+
+
+class LanguageSpecRegistry(Mapping):
+    """! @brief Process-wide lazy language specification registry.
+    @details Read-only mapping over every canonical language identifier and alias. A language's regex table is compiled on first lookup only, so analyzing a
+    C++-only project never compiles the Haskell, Elixir, or Zig tables. Aliases resolve to the identical LanguageSpec object as their canonical language.
+    Membership tests never compile anything.
+    """
+
+    def __init__(self):
+        """! @brief Create an empty registry.
+        @return {None} Function return value.
+        """
+        self._specs: dict = {}
+
+    @staticmethod
+    def canonical(language: str) -> Optional[str]:
+        """! @brief Resolve an identifier or alias to its canonical language.
+        @param language Language identifier or alias (already normalized).
+        @return Canonical identifier, or None when unsupported.
+        """
+        if language in _LANGUAGE_SPEC_BUILDERS:
+            return language
+        return LANGUAGE_ALIASES.get(language)
+
+    def __getitem__(self, language: str) -> LanguageSpec:
+        """! @brief Return the compiled specification of a language, building it on first use.
+        @param language Language identifier or alias.
+        @return Shared LanguageSpec instance.
+        @throws KeyError If the language is unsupported.
+        """
+        canonical = self.canonical(language)
+        if canonical is None:
+            raise KeyError(language)
+        spec = self._specs.get(canonical)
+        if spec is None:
+            spec = _LANGUAGE_SPEC_BUILDERS[canonical]()
+            self._specs[canonical] = spec
+        return spec
+
+    def __contains__(self, language) -> bool:
+        """! @brief Check language support without compiling its specification.
+        @param language Candidate identifier.
+        @return True when `language` is a canonical identifier or alias.
+        """
+        return isinstance(language, str) and self.canonical(language) is not None
+
+    def __iter__(self):
+        """! @brief Iterate over every registry key in historical order.
+        @return Iterator over canonical identifiers and aliases.
+        """
+        return iter(_SPEC_KEYS)
+
+    def __len__(self) -> int:
+        """! @brief Count registry keys.
+        @return Number of canonical identifiers plus aliases.
+        """
+        return len(_SPEC_KEYS)
+
+    def built_languages(self) -> list:
+        """! @brief List canonical languages whose specification has been compiled.
+        @return Canonical identifiers in build order.
+        """
+        return list(self._specs)
+
+
+SPEC_REGISTRY = LanguageSpecRegistry()
+"""! @brief Shared lazy registry used by SourceAnalyzer, compress, find_constructs, and generate_markdown."""
+
+
+def get_language_spec(language: str) -> Optional[LanguageSpec]:
+    """! @brief Return the shared compiled specification of a language.
+    @param language Language identifier or alias (case and leading dot are normalized).
+    @return Shared LanguageSpec, or None when unsupported.
+    """
+    key = language.lower().strip().lstrip(".")
+    if key not in SPEC_REGISTRY:
+        return None
+    return SPEC_REGISTRY[key]
+
+
+def build_language_specs() -> dict:
+    """!
+    @brief Build specifications for all supported languages.
+    @details Compiles a fresh, independent specification set (aliases share the canonical object). Runtime callers use the lazy shared `SPEC_REGISTRY`
+    instead.
+    @return {dict} Function return value.
+    """
+    specs = {}
+    for key in _SPEC_KEYS:
+        canonical = LanguageSpecRegistry.canonical(key)
+        if canonical not in specs:
+            specs[canonical] = _LANGUAGE_SPEC_BUILDERS[canonical]()
+        specs[key] = specs[canonical]
+    return {key: specs[key] for key in _SPEC_KEYS}
+
+
+BRACE_LANGUAGES = frozenset({
+    "c", "cpp", "cc", "cxx", "h", "hpp", "rust", "rs",
+    "javascript", "js", "typescript", "ts", "java",
+    "go", "csharp", "cs", "swift", "kotlin", "kt",
+    "php", "scala", "zig",
+})
+"""! @brief Language identifiers and aliases whose blocks are delimited by braces."""
+
+STREAM_THRESHOLD_BYTES = 64 << 20
+"""! @brief Default size from which brace-language files are analyzed by `SourceAnalyzer.analyze_stream()` instead of being loaded whole."""
+
+
+CONTAINER_TYPES = frozenset({
+    ElementType.CLASS, ElementType.STRUCT, ElementType.MODULE,
+    ElementType.IMPL, ElementType.INTERFACE, ElementType.TRAIT,
+    ElementType.NAMESPACE, ElementType.ENUM, ElementType.EXTENSION,
+    ElementType.PROTOCOL,
+})
+"""! @brief Element types that own nested members for hierarchy detection."""
+
+COMMENT_TYPES = frozenset({ElementType.COMMENT_SINGLE, ElementType.COMMENT_MULTI})
+"""! @brief Element types representing comments."""
+
+_FILE_TAG_RE = re.compile(r"(?<!\w)(?:@|\\)file\b")
+"""! @brief Standalone `@file` / `\\file` tag marking file-scoped Doxygen metadata."""
+
+
+def _is_file_level_comment(comment) -> bool:
+    """! @brief Detect whether a comment block is file-scoped Doxygen metadata.
+    @details Resolves canonical text from `comment_source` or fallback `extract` and checks for a standalone `@file` or `\\file` tag token; empty comment payloads are treated as non file-level.
+    @param comment {SourceElement} Candidate comment element.
+    @return {bool} True when the comment declares file-level metadata and must not be bound to a symbol.
+    """
+    return comment.search_text(_FILE_TAG_RE)
+
+
+class _SparseTable:
+    """! @brief Static range-query table over an idempotent function (`min`/`max`).
+    @details Built in O(n log n); answers `func(values[lo:hi])` in O(1).
+    """
+
+    __slots__ = ("_levels", "_func")
+
+    def __init__(self, values: list, func):
+        """! @brief Precompute power-of-two window aggregates.
+        @param values Values to aggregate.
+        @param func Idempotent binary aggregate.
+        @return {None} Function return value.
+        """
+        levels = [list(values)]
+        width = 1
+        while 2 * width <= len(values):
+            previous = levels[-1]
+            levels.append([func(previous[i], previous[i + width])
+                           for i in range(len(previous) - width)])
+            width *= 2
+        self._levels = levels
+        self._func = func
+
+    def query(self, lo: int, hi: int):
+        """! @brief Aggregate the non-empty half-open range `[lo, hi)`.
+        @param lo First index.
+        @param hi End index, greater than `lo`.
+        @return Aggregated value.
+        """
+        level = (hi - lo).bit_length() - 1
+        row = self._levels[level]
+        return self._func(row[lo], row[hi - (1 << level)])
+
+
+class ElementIndex:
+    """! @brief Per-file interval index over analyzed elements, built once per `enrich()` call.
+    @details Sorts containers, non-comment elements, and comments once so that innermost-container and doc-comment lookups run in logarithmic time instead of
+    rescanning every element per query. Lookups reproduce the selection and tie-breaking rules of the original linear scans exactly (ties resolve to the earliest
+    element in input order). Elements must not change line ranges while the index is in use.
+    @satisfies SRS-385
+    """
+
+    def __init__(self, elements: list):
+        """! @brief Build all lookup tables in one pass over sorted element views.
+        @param elements SourceElement list of one file.
+        @return {None} Function return value.
+        """
+        ordered = sorted(elements, key=lambda e: e.line_start)
+        self.comments = [e for e in ordered if e.element_type in COMMENT_TYPES]
+        """! @brief Comment elements ordered by start line."""
+        non_def_types = COMMENT_TYPES | {ElementType.IMPORT, ElementType.DECORATOR}
+        self.def_starts = {e.line_start for e in elements if e.element_type not in non_def_types}
+        """! @brief Start lines of definition elements."""
+        self.import_starts = {e.line_start for e in elements if e.element_type == ElementType.IMPORT}
+        """! @brief Start lines of import elements."""
+
+        # Containers sorted by (start asc, end desc, position desc): the rightmost entry with start <= s and end >= e is the innermost enclosing container.
+        containers = sorted(
+            ((e.line_start, -e.line_end, -pos, e) for pos, e in enumerate(elements)
+             if e.element_type in CONTAINER_TYPES),
+            key=lambda item: item[:3],
+        )
+        self._containers = [item[3] for item in containers]
+        self._container_starts = [item[0] for item in containers]
+        self._container_ends = (
+            _SparseTable([-item[1] for item in containers], max) if containers else None
+        )
+
+        # Non-comment elements as blockers between a comment and its target symbol.
+        blockers = [e for e in elements if e.element_type not in COMMENT_TYPES]
+        self._blocker_starts = sorted(e.line_start for e in blockers)
+        by_end = sorted(blockers, key=lambda e: e.line_end)
+        self._blocker_ends = [e.line_end for e in by_end]
+        self._blocker_min_start = (
+            _SparseTable([e.line_start for e in by_end], min) if by_end else None
+        )
+
+        comments = [e for e in elements if e.element_type in COMMENT_TYPES]
+        self._inline_postfix: dict = {}
+        self._block_by_end: dict = {}
+        preceding = []
+        following = []
+        for pos, comment in enumerate(comments):
+            if comment.name == "inline":
+                if (SourceAnalyzer._is_postfix_doxygen_comment(comment.first_line)
+                        and not _is_file_level_comment(comment)):
+                    self._inline_postfix.setdefault(comment.line_start, comment)
+                continue
+            current = self._block_by_end.get(comment.line_end)
+            if current is None or comment.line_start > current.line_start:
+                self._block_by_end[comment.line_end] = comment
+            if _is_file_level_comment(comment):
+                continue
+            preceding.append((comment.line_end, comment.line_start, -pos, comment))
+            if SourceAnalyzer._is_postfix_doxygen_comment(comment.first_line):
+                following.append((comment.line_start, comment.line_end, pos, comment))
+        preceding.sort(key=lambda item: item[:3])
+        following.sort(key=lambda item: item[:3])
+        self._preceding = [item[3] for item in preceding]
+        self._preceding_ends = [item[0] for item in preceding]
+        self._following = [item[3] for item in following]
+        self._following_starts = [item[0] for item in following]
+        self._previous_doxygen: Optional[list] = None
+        self._doxygen_cache: dict = {}
+
+    def enclosing_container(self, elem) -> Optional["SourceElement"]:
+        """! @brief Return the innermost container whose line range encloses a non-container element.
+        @param elem Non-container SourceElement.
+        @return Container with the greatest start line (then smallest end line, then earliest input position) spanning `elem`, or None.
+        """
+        limit = bisect_right(self._container_starts, elem.line_start)
+        ends = self._container_ends
+        if limit == 0 or ends.query(0, limit) < elem.line_end:
+            return None
+        lo, hi = 0, limit - 1
+        while lo < hi:
+            mid = (lo + hi + 1) // 2
+            if ends.query(mid, limit) >= elem.line_end:
+                lo = mid
+            else:
+                hi = mid - 1
+        return self._containers[lo]
+
+    def doxygen_fields(self, comment) -> dict:
+        """! @brief Parse the Doxygen fields of a comment once per index.
+        @param comment Comment SourceElement.
+        @return Parsed field dictionary (empty when the comment has no tags).
+        """
+        key = id(comment)
+        fields = self._doxygen_cache.get(key)
+        if fields is None:
+            fields = parse_doxygen_comment(comment.comment_source or comment.extract)
+            self._doxygen_cache[key] = fields
+        return fields
+
+    def _is_blocked(self, comment_end: int, target_start: int) -> bool:
+        """! @brief Check whether a non-comment element lies between a comment end and a target start line.
+        @param comment_end Last line of the candidate comment.
+        @param target_start First line of the target element.
+        @return True when an element starts inside `(comment_end, target_start)`, or spans `comment_end` and ends before `target_start`.
+        @details Blocking is monotone in `comment_end`: if a comment is blocked, every comment ending earlier is blocked too, so only the nearest candidate of
+        each association rule needs this check.
+        """
+        starts = self._blocker_starts
+        if bisect_right(starts, comment_end) < bisect_left(starts, target_start):
+            return True
+        lo = bisect_right(self._blocker_ends, comment_end)
+        hi = bisect_left(self._blocker_ends, target_start)
+        return lo < hi and self._blocker_min_start.query(lo, hi) <= comment_end
+
+    def doc_comment(self, elem, max_gap: int = 2) -> Optional["SourceElement"]:
+        """! @brief Return the documentation comment associated with a non-comment element.
+        @param elem Target SourceElement.
+        @param max_gap Maximum line distance for preceding and following association.
+        @return Same-line postfix comment, else the nearest unblocked preceding comment within `max_gap` lines (or, when none is that close, the nearest
+        preceding comment carrying Doxygen fields), else the nearest following postfix comment within `max_gap` lines; None when no rule matches.
+        """
+        comment = self._inline_postfix.get(elem.line_end)
+        if comment is not None:
+            return comment
+        top = bisect_left(self._preceding_ends, elem.line_start) - 1
+        if top >= 0:
+            candidate = self._preceding[top]
+            if elem.line_start - candidate.line_end > max_gap:
+                if self._previous_doxygen is None:
+                    self._previous_doxygen = self._link_previous_doxygen()
+                match = self._previous_doxygen[top]
+                candidate = self._preceding[match] if match >= 0 else None
+            if candidate is not None and not self._is_blocked(candidate.line_end, elem.line_start):
+                return candidate
+        index = bisect_right(self._following_starts, elem.line_end)
+        if index < len(self._following):
+            candidate = self._following[index]
+            if candidate.line_start - elem.line_end <= max_gap:
+                return candidate
+        return None
+
+    def _link_previous_doxygen(self) -> list:
+        """! @brief Map every preceding-candidate slot to the nearest slot at or before it whose comment carries Doxygen fields.
+        @return Slot index list; -1 where no earlier candidate has fields.
+        """
+        links = []
+        last = -1
+        for slot, comment in enumerate(self._preceding):
+            if self.doxygen_fields(comment):
+                last = slot
+            links.append(last)
+        return links
+
+    def preceding_block(self, comment) -> list:
+        """! @brief Extend a comment with the contiguous non-inline comments directly above it.
+        @param comment Comment SourceElement.
+        @return Comments ordered top-down, ending with `comment`.
+        """
+        block = [comment]
+        current_start = comment.line_start
+        while True:
+            previous = self._block_by_end.get(current_start - 1)
+            if previous is None:
+                break
+            block.append(previous)
+            current_start = previous.line_start
+        block.reverse()
+        return block
 
 
 class SourceAnalyzer:
@@ -691,32 +1431,30 @@ class SourceAnalyzer:
     def __init__(self):
         """!
         @brief Initialize analyzer state with language specifications.
-        @details Implements the __init__ function behavior with deterministic control flow.
+        @details Binds the process-wide lazy `SPEC_REGISTRY`, so constructing analyzers compiles no regex and every instance shares compiled tables.
         @return {None} Function return value.
+        @satisfies SRS-378
         """
-        self.specs = build_language_specs()
+        self.specs = SPEC_REGISTRY
 
     def get_supported_languages(self) -> list:
         """!
         @brief Return list of supported languages (without aliases).
                 @return Sorted list of unique language identifiers.
-        @details Implements the get_supported_languages function behavior with deterministic control flow.
+        @details Reads canonical identifiers from the registry builder table, so no language specification is compiled.
         """
-        seen = set()
-        result = []
-        for key, spec in self.specs.items():
-            if id(spec) not in seen:
-                seen.add(id(spec))
-                result.append(key)
-        return sorted(result)
-
-    def analyze(self, filepath: str, language: str) -> list:
+        return sorted(_LANGUAGE_SPEC_BUILDERS)
+
+    def analyze(self, filepath: str, language: str,
+                source: Optional[SourceBuffer] = None) -> list:
         """! @brief Analyze a source file and return the list of SourceElement found.
         @param filepath Path to the source file.
         @param language Language identifier.
+        @param source Optional pre-loaded SourceBuffer of `filepath`; when given the file is not read again.
         @return List of SourceElement instances.
         @throws ValueError If language is not supported.
         @details Reads file content, detects single/multi-line comments, and matches regex patterns for definitions.
+        @satisfies SRS-377
         """
         language = language.lower().strip().lstrip(".")
         if language not in self.specs:
@@ -727,36 +1465,148 @@ class SourceAnalyzer:
 
         spec = self.specs[language]
 
-        with open(filepath, "r", encoding="utf-8", errors="replace") as f:
-            lines = f.readlines()
+        if source is None:
+            source = SourceBuffer.from_path(filepath)
+        lines = source.lines
 
         elements = []
+        brace_index = None
+        for elem_type, line_num, line_end, name, extract, comment_source, stripped in self._scan_lines(lines, spec):
+            if line_end is None:
+                if brace_index is None and language in BRACE_LANGUAGES:
+                    brace_index = self._build_brace_index(lines, language)
+                line_end = self._find_block_end(
+                    lines, line_num - 1, language, stripped, brace_index)
+            # The extract (max 5 lines) is derived from the shared lines on access
+            elements.append(SourceElement(
+                element_type=elem_type,
+                line_start=line_num,
+                line_end=line_end,
+                extract=extract,
+                name=name,
+                comment_source=comment_source,
+                source_lines=lines if extract is None else None,
+            ))
+        return elements
+
+    def iter_stream(self, lines, language: str):
+        """! @brief Analyze a brace-language line stream and yield the elements `analyze()` returns for the same text, in the same order.
+        @param lines Iterable of file lines with terminators, consumed once.
+        @param language Brace-delimited language identifier.
+        @return Iterator of SourceElement with materialized `extract` and `comment_source` and with `body_comments` and `exit_points` already collected.
+        @throws ValueError If the language is not supported or not brace-delimited.
+        @details Each line passes once through the shared brace lexer (`iter_brace_marks()`) and the shared line classifier (`_scan_lines()`). A
+        `BlockEndTracker` resolves block ends as braces close; until then a definition keeps a window of at most `EXTRACT_MAX_LINES` lines and a body
+        annotation scanner, and an open multi-line comment keeps its own lines. Elements are yielded once they and every earlier element are resolved, so
+        memory is bounded by the unresolved constructs and the longest line, not by the file size.
+        @satisfies SRS-398
+        """
+        language = language.lower().strip().lstrip(".")
+        if language not in self.specs or language not in BRACE_LANGUAGES:
+            raise ValueError(f"Language '{language}' does not support streaming analysis.")
+        canonical = LanguageSpecRegistry.canonical(language) or language
+        spec = self.specs[canonical]
+        tracker = BlockEndTracker()
+        queue: deque = deque()  # elements in analyze() order; unresolved ones have line_end None
+        unresolved: dict = {}  # id(element) -> (element, first lines, body annotation scanner)
+        comment: list = []  # lines of the open multi-line comment
+        current: list = [None]
+
+        def _resolve(pairs) -> None:
+            for key, line_end in pairs:
+                elem, window, scanner = unresolved.pop(key)
+                elem.line_end = line_end
+                elem.extract = _source_extract(window, 1, line_end - elem.line_start + 1)
+                if line_end > elem.line_start:
+                    elem.body_comments = scanner.body_comments or ()
+                    elem.exit_points = scanner.exit_points or ()
+
+        def _stream():
+            previous = None
+            for index, (line, depth, mark) in enumerate(iter_brace_marks(lines, spec, canonical)):
+                if previous is not None:
+                    _resolve(tracker.feed(*previous))
+                previous = (depth, mark)
+                for _, window, scanner in unresolved.values():
+                    scanner.scan(index, (line,))
+                    if len(window) < EXTRACT_MAX_LINES:
+                        window.append(line)
+                if comment:
+                    comment.append(line)
+                current[0] = line
+                yield line
+            if previous is not None:
+                _resolve(tracker.feed(*previous))
+            _resolve(tracker.finish())
+
+        def _comment_opened(line_num: int) -> None:
+            comment.append(current[0])
+
+        for elem_type, line_num, line_end, name, extract, comment_source, stripped in self._scan_lines(_stream(), spec, _comment_opened):
+            if comment_source is _FROM_SOURCE:
+                comment_source = "\n".join(line.rstrip("\n\r") for line in comment)
+                extract = _source_extract(comment, 1, len(comment))
+                comment.clear()
+            elif extract is None and line_end is not None:
+                extract = stripped
+            elem = SourceElement(elem_type, line_num, line_end, extract, name=name, comment_source=comment_source)
+            if line_end is None:
+                unresolved[id(elem)] = (elem, [current[0]], _BodyAnnotationScanner(self, spec))
+                tracker.register(id(elem))
+            queue.append(elem)
+            while queue and queue[0].line_end is not None:
+                yield queue.popleft()
+        yield from queue
+
+    def analyze_stream(self, filepath: str, language: str) -> tuple:
+        """! @brief Analyze a brace-language file without loading it whole.
+        @param filepath Path to the source file.
+        @param language Brace-delimited language identifier.
+        @return Tuple `(elements, total_lines)`; elements equal `analyze()` output after body annotation, line count equals `SourceBuffer.line_count`.
+        @throws ValueError If the language is not supported or not brace-delimited.
+        @throws OSError If the file cannot be read.
+        @details Reads the file through a text stream with the decoding and newline rules of `SourceBuffer` and drains `iter_stream()`. Call `enrich()` with
+        `annotate_bodies=False` afterwards; body annotations are already collected.
+        @satisfies SRS-398
+        """
+        line_count = 0
+
+        with open(filepath, "r", encoding="utf-8", errors="replace") as handle:
+            def _counted():
+                nonlocal line_count
+                for line in handle:
+                    line_count += 1
+                    yield line
+
+            elements = list(self.iter_stream(_counted(), language))
+        return elements, line_count
+
+    def _scan_lines(self, lines, spec: LanguageSpec, comment_opened: Optional[Callable[[int], None]] = None):
+        """! @brief Classify source lines and yield the elements they start.
+        @param lines Iterable of file lines with terminators, consumed lazily.
+        @param spec LanguageSpec of the file.
+        @param comment_opened Optional callback receiving the start line of every multi-line comment that stays open past its first line.
+        @return Iterator of `(element_type, line_start, line_end, name, extract, comment_source, stripped)` in `analyze()` order; `line_end` is None for
+        constructs whose block end must be searched, `extract` is None when it derives from the source lines, and `stripped` is the start line without
+        terminator.
+        @details Shared by `analyze()` and `iter_stream()`: detects single/multi-line comments and matches the fused construct pattern, carrying the multi-line
+        comment state across lines.
+        @satisfies SRS-377
+        """
+        regex_attempts = 0
 
         # Multi-line comment state
         in_multiline_comment = False
         multiline_comment_start_line = 0
-        multiline_comment_lines = []
 
         for line_num, line in enumerate(lines, start=1):
             stripped = line.rstrip("\n\r")
 
             # ── Multi-line comment handling ──────────────────────────
             if in_multiline_comment:
-                multiline_comment_lines.append(stripped)
                 if spec.multi_comment_end and spec.multi_comment_end in stripped:
                     in_multiline_comment = False
-                    full_text = "\n".join(multiline_comment_lines)
-                    mc_extract = multiline_comment_lines
-                    if len(mc_extract) > 5:
-                        mc_extract = mc_extract[:4] + ["    ..."]
-                    elements.append(SourceElement(
-                        element_type=ElementType.COMMENT_MULTI,
-                        line_start=multiline_comment_start_line,
-                        line_end=line_num,
-                        extract="\n".join(mc_extract),
-                        comment_source=full_text,
-                    ))
-                    multiline_comment_lines = []
+                    yield (ElementType.COMMENT_MULTI, multiline_comment_start_line, line_num, None, None, _FROM_SOURCE, stripped)
                 continue
 
             # ── Multi-line comment start ────────────────────────────
@@ -772,28 +1622,19 @@ class SourceAnalyzer:
                         if (spec.multi_comment_end
                                 and spec.multi_comment_end in after_start
                                 and mc_start != spec.multi_comment_end):
-                            elements.append(SourceElement(
-                                element_type=ElementType.COMMENT_MULTI,
-                                line_start=line_num,
-                                line_end=line_num,
-                                extract=stripped,
-                            ))
+                            yield (ElementType.COMMENT_MULTI, line_num, line_num, None, None, None, stripped)
                             continue
                         # Python: """ ... """ sulla stessa riga
                         if mc_start == '"""' or mc_start == "'''":
                             rest = stripped[start_idx + 3:]
                             if mc_start in rest:
-                                elements.append(SourceElement(
-                                    element_type=ElementType.COMMENT_MULTI,
-                                    line_start=line_num,
-                                    line_end=line_num,
-                                    extract=stripped,
-                                ))
+                                yield (ElementType.COMMENT_MULTI, line_num, line_num, None, None, None, stripped)
                                 continue
 
                         in_multiline_comment = True
                         multiline_comment_start_line = line_num
-                        multiline_comment_lines = [stripped]
+                        if comment_opened is not None:
+                            comment_opened(line_num)
                         continue
 
             # ── Single-line comment ───────────────────────────────────
@@ -803,68 +1644,39 @@ class SourceAnalyzer:
                     # If comment is the entire line (aside from whitespace)
                     before_comment = stripped[:comment_idx].strip()
                     if not before_comment:
-                        elements.append(SourceElement(
-                            element_type=ElementType.COMMENT_SINGLE,
-                            line_start=line_num,
-                            line_end=line_num,
-                            extract=stripped,
-                        ))
+                        yield (ElementType.COMMENT_SINGLE, line_num, line_num, None, None, None, stripped)
                         continue
                     else:
                         # Inline comment: add both element and comment
                         comment_text = stripped[comment_idx:]
-                        elements.append(SourceElement(
-                            element_type=ElementType.COMMENT_SINGLE,
-                            line_start=line_num,
-                            line_end=line_num,
-                            extract=comment_text,
-                            name="inline",
-                        ))
+                        yield (ElementType.COMMENT_SINGLE, line_num, line_num, "inline", comment_text, None, stripped)
 
             # ── Language patterns ─────────────────────────────────────
             if not stripped.strip():
                 continue
 
-            for elem_type, pattern in spec.patterns:
-                match = pattern.match(stripped)
-                if match:
-                    name = None
-                    if match.lastindex and match.lastindex >= 2:
-                        name = match.group(2)
-                    elif match.lastindex and match.lastindex >= 1:
-                        name = match.group(1)
-
-                    # Single-line types: don't search for block
-                    single_line_types = (
-                        ElementType.IMPORT, ElementType.CONSTANT,
-                        ElementType.VARIABLE, ElementType.DECORATOR,
-                        ElementType.MACRO, ElementType.TYPE_ALIAS,
-                        ElementType.TYPEDEF, ElementType.PROPERTY,
-                    )
-
-                    if elem_type in single_line_types:
-                        block_end = line_num
-                    else:
-                        block_end = self._find_block_end(
-                            lines, line_num - 1, language, stripped)
-
-                    extract_lines = [lines[i].rstrip("\n\r")
-                                     for i in range(line_num - 1, block_end)]
-
-                    # Limit extract to max 5 lines for readability
-                    if len(extract_lines) > 5:
-                        extract_lines = extract_lines[:4] + ["    ..."]
-
-                    elements.append(SourceElement(
-                        element_type=elem_type,
-                        line_start=line_num,
-                        line_end=block_end,
-                        extract="\n".join(extract_lines),
-                        name=name,
-                    ))
-                    break
+            regex_attempts += 1
+            construct = spec.match_construct(stripped)
+            if construct is None:
+                continue
+            elem_type, match = construct
+            name = None
+            if match.lastindex and match.lastindex >= 2:
+                name = match.group(2)
+            elif match.lastindex and match.lastindex >= 1:
+                name = match.group(1)
+
+            # Single-line types: don't search for block
+            single_line_types = (
+                ElementType.IMPORT, ElementType.CONSTANT,
+                ElementType.VARIABLE, ElementType.DECORATOR,
+                ElementType.MACRO, ElementType.TYPE_ALIAS,
+                ElementType.TYPEDEF, ElementType.PROPERTY,
+            )
 
-        return elements
+            yield (elem_type, line_num, line_num if elem_type in single_line_types else None, name, None, None, stripped)
+
+        profiling.count("analyze.regex_attempts", regex_attempts)
 
     def _in_string_context(self, line: str, pos: int, spec: LanguageSpec) -> bool:
         """!
@@ -873,34 +1685,10 @@ class SourceAnalyzer:
                 @param pos The column index.
                 @param spec The LanguageSpec instance.
                 @return True if pos is within a string.
-        @details Implements the _in_string_context function behavior with deterministic control flow.
+        @details Delegates to the shared linear-time `LineLexer` of the language delimiters.
+        @satisfies SRS-380
         """
-        in_string = False
-        current_delim = None
-        i = 0
-        while i < pos:
-            ch = line[i]
-            if in_string:
-                if ch == "\\" and i + 1 < len(line):
-                    i += 2
-                    continue
-                if current_delim and line[i:].startswith(current_delim):
-                    in_string = False
-                    i += len(current_delim)
-                    continue
-            else:
-                for delim in sorted(spec.string_delimiters, key=len, reverse=True):
-                    if line[i:].startswith(delim):
-                        in_string = True
-                        current_delim = delim
-                        i += len(delim)
-                        break
-                else:
-                    i += 1
-                    continue
-                continue
-            i += 1
-        return in_string
+        return get_line_lexer(spec.string_delimiters, spec.single_comment).in_string(line, pos)
 
     def _find_comment(self, line: str, spec: LanguageSpec) -> Optional[int]:
         """!
@@ -908,49 +1696,35 @@ class SourceAnalyzer:
                 @param line The line of code.
                 @param spec The LanguageSpec instance.
                 @return Column index of comment start, or None.
-        @details Implements the _find_comment function behavior with deterministic control flow.
+        @details Delegates to the shared linear-time `LineLexer` of the language delimiters.
+        @satisfies SRS-380
         """
         if not spec.single_comment:
             return None
+        return get_line_lexer(spec.string_delimiters, spec.single_comment).find_comment(line)
 
-        in_string = False
-        current_delim = None
-        i = 0
-        while i < len(line):
-            ch = line[i]
-            if in_string:
-                if ch == "\\" and i + 1 < len(line):
-                    i += 2
-                    continue
-                if current_delim and line[i:].startswith(current_delim):
-                    in_string = False
-                    i += len(current_delim)
-                    continue
-            else:
-                if line[i:].startswith(spec.single_comment):
-                    return i
-                for delim in sorted(spec.string_delimiters, key=len, reverse=True):
-                    if line[i:].startswith(delim):
-                        in_string = True
-                        current_delim = delim
-                        i += len(delim)
-                        break
-                else:
-                    i += 1
-                    continue
-                continue
-            i += 1
-        return None
+    def _build_brace_index(self, lines: list, language: str) -> BraceIndex:
+        """! @brief Build the brace-depth index of a file.
+        @param lines List of all file lines.
+        @param language Brace-delimited language identifier or alias.
+        @return BraceIndex built with the language's comment and string delimiters.
+        """
+        canonical = LanguageSpecRegistry.canonical(language) or language
+        return BraceIndex.from_lines(lines, self.specs[canonical], canonical)
 
     def _find_block_end(self, lines: list, start_idx: int,
-                        language: str, first_line: str) -> int:
+                        language: str, first_line: str,
+                        brace_index: Optional[BraceIndex] = None) -> int:
         """! @brief Find the end of a block (function, class, struct, etc.).
         @param lines List of all file lines.
         @param start_idx Index of the start line.
         @param language Language identifier.
         @param first_line Content of the start line.
+        @param brace_index Optional prebuilt BraceIndex of `lines`; built on demand for brace-delimited languages when omitted.
         @return 1-based index of the end line.
-        @details Returns the index (1-based) of the final line of the block. Limits search for performance.
+        @details Returns the index (1-based) of the final line of the block. Indentation- and keyword-delimited languages limit the search for performance;
+        brace-delimited languages use the uncapped, string- and comment-aware brace-depth index.
+        @satisfies SRS-381
         """
         # Per Python: basato sull'indentazione
         if language in ("python", "py"):
@@ -968,28 +1742,10 @@ class SourceAnalyzer:
             return end
 
         # Per linguaggi con parentesi graffe
-        if language in ("c", "cpp", "cc", "cxx", "h", "hpp", "rust", "rs",
-                        "javascript", "js", "typescript", "ts", "java",
-                        "go", "csharp", "cs", "swift", "kotlin", "kt",
-                        "php", "scala", "zig"):
-            brace_count = 0
-            found_open = False
-            end = start_idx
-            while end < min(len(lines), start_idx + 300):
-                line = lines[end].rstrip("\n\r")
-                for ch in line:
-                    if ch == "{":
-                        brace_count += 1
-                        found_open = True
-                    elif ch == "}":
-                        brace_count -= 1
-                if found_open and brace_count <= 0:
-                    return end + 1
-                end += 1
-            # If no opening braces found, return just the first line
-            if not found_open:
-                return start_idx + 1
-            return end
+        if language in BRACE_LANGUAGES:
+            if brace_index is None:
+                brace_index = self._build_brace_index(lines, language)
+            return brace_index.block_end(start_idx)
 
         # Per Ruby/Elixir/Lua: basato su end keyword
         if language in ("ruby", "rb", "elixir", "ex", "exs", "lua"):
@@ -1024,24 +1780,40 @@ class SourceAnalyzer:
     # ── Enrichment methods for LLM-optimized output ───────────────────
 
     def enrich(self, elements: list, language: str,
-               filepath: Optional[str] = None) -> list:
+               filepath: Optional[str] = None,
+               source: Optional[SourceBuffer] = None,
+               annotate_bodies: bool = True) -> list:
         """!
         @brief Enrich elements with signatures, hierarchy, visibility, inheritance.
-                @details Call after analyze() to add metadata for LLM-optimized markdown output. Modifies elements in-place and returns them. If filepath is provided, also extracts body comments and exit points.
+                @details Call after analyze() to add metadata for LLM-optimized markdown output. Modifies elements in-place and returns them. If filepath or source is provided, also extracts body comments and exit points.
         @param elements Input parameter `elements`.
         @param language Input parameter `language`.
         @param filepath Input parameter `filepath`.
+        @param source Optional pre-loaded SourceBuffer reused for body annotations instead of re-reading `filepath`.
+        @param annotate_bodies Whether to extract body comments and exit points; False for elements from `analyze_stream()`, which collects them while streaming.
         @return {list} Function return value.
+        @satisfies SRS-385
         """
         language = language.lower().strip().lstrip(".")
-        self._clean_names(elements, language)
-        self._extract_signatures(elements, language)
-        self._detect_hierarchy(elements)
-        self._extract_visibility(elements, language)
-        self._extract_inheritance(elements, language)
-        if filepath:
-            self._extract_body_annotations(elements, language, filepath)
-            self._extract_doxygen_fields(elements)
+        with profiling.span("enrich.clean_names"):
+            self._clean_names(elements, language)
+        with profiling.span("enrich.signatures"):
+            self._extract_signatures(elements, language)
+        with profiling.span("enrich.element_index"):
+            index = ElementIndex(elements)
+        with profiling.span("enrich.hierarchy"):
+            self._detect_hierarchy(elements, index)
+        with profiling.span("enrich.visibility"):
+            self._extract_visibility(elements, language)
+        with profiling.span("enrich.inheritance"):
+            self._extract_inheritance(elements, language)
+        if filepath or source is not None:
+            if annotate_bodies:
+                with profiling.span("enrich.body_annotations"):
+                    self._extract_body_annotations(elements, language, filepath,
+                                                   source=source)
+            with profiling.span("enrich.doxygen_fields"):
+                self._extract_doxygen_fields(elements, index)
         return elements
 
     def _clean_names(self, elements: list, language: str):
@@ -1059,7 +1831,7 @@ class SourceAnalyzer:
             # using the original pattern (which has group 2 as the identifier)
             spec = self.specs.get(language)
             if spec:
-                first_line = elem.extract.split("\n")[0]
+                first_line = elem.first_line
                 for etype, pattern in spec.patterns:
                     if etype == elem.element_type:
                         m = pattern.match(first_line)
@@ -1086,7 +1858,7 @@ class SourceAnalyzer:
         for elem in elements:
             if elem.element_type in skip_types:
                 continue
-            first_line = elem.extract.split("\n")[0].strip()
+            first_line = elem.first_line.strip()
             sig = first_line
             for suffix in (" {", "{", ":", ";"):
                 if sig.endswith(suffix) and not sig.endswith("::"):
@@ -1094,39 +1866,24 @@ class SourceAnalyzer:
                     break
             elem.signature = sig
 
-    def _detect_hierarchy(self, elements: list):
+    def _detect_hierarchy(self, elements: list, index: Optional[ElementIndex] = None):
         """!
         @brief Detect parent-child relationships between elements.
-                @details Containers (class, struct, module, etc.) remain at depth=0. Non-container elements inside containers get depth=1 and parent_name set.
+                @details Containers (class, struct, module, etc.) remain at depth=0. Non-container elements inside containers get depth=1 and parent_name set to the innermost enclosing container resolved by `ElementIndex.enclosing_container()`.
         @param elements Input parameter `elements`.
+        @param index Optional prebuilt ElementIndex of `elements`.
         @return {None} Function return value.
         """
-        container_types = (
-            ElementType.CLASS, ElementType.STRUCT, ElementType.MODULE,
-            ElementType.IMPL, ElementType.INTERFACE, ElementType.TRAIT,
-            ElementType.NAMESPACE, ElementType.ENUM, ElementType.EXTENSION,
-            ElementType.PROTOCOL)
-        containers = [e for e in elements if e.element_type in container_types]
+        if index is None:
+            index = ElementIndex(elements)
         skip_types = (ElementType.COMMENT_SINGLE, ElementType.COMMENT_MULTI,
                       ElementType.IMPORT)
         for elem in elements:
             if elem.element_type in skip_types:
                 continue
-            if elem.element_type in container_types:
+            if elem.element_type in CONTAINER_TYPES:
                 continue
-            best = None
-            for c in containers:
-                if c is elem:
-                    continue
-                if (c.line_start <= elem.line_start
-                        and c.line_end >= elem.line_end):
-                    if best is None:
-                        best = c
-                    elif c.line_start > best.line_start:
-                        best = c
-                    elif (c.line_start == best.line_start
-                          and c.line_end < best.line_end):
-                        best = c
+            best = index.enclosing_container(elem)
             if best is not None:
                 elem.parent_name = best.name
                 elem.depth = 1
@@ -1144,7 +1901,7 @@ class SourceAnalyzer:
                                       ElementType.COMMENT_MULTI,
                                       ElementType.IMPORT):
                 continue
-            sig = elem.extract.split("\n")[0].strip()
+            sig = elem.first_line.strip()
             vis = self._parse_visibility(sig, elem.name, language)
             if vis:
                 elem.visibility = vis
@@ -1213,7 +1970,7 @@ class SourceAnalyzer:
             if elem.element_type not in (ElementType.CLASS, ElementType.STRUCT,
                                           ElementType.INTERFACE):
                 continue
-            first_line = elem.extract.split("\n")[0].strip()
+            first_line = elem.first_line.strip()
             inh = self._parse_inheritance(first_line, language)
             if inh:
                 elem.inherits = inh
@@ -1261,24 +2018,28 @@ class SourceAnalyzer:
         r'^\s*(sys\.exit\(.*|os\._exit\(.*|exit\(.*|process\.exit\(.*)')
 
     def _extract_body_annotations(self, elements: list,
-                                  language: str, filepath: str):
+                                  language: str, filepath: Optional[str],
+                                  source: Optional[SourceBuffer] = None):
         """!
         @brief Extract comments and exit points from within function/class bodies.
                 @details Reads the source file and scans each definition's line range for: - Single-line comments (# or // etc.) - Multi-line comments (docstrings, /* */ blocks) - Exit points (return, yield, raise, throw, panic!, sys.exit) Populates body_comments and exit_points on each element.
         @param elements Input parameter `elements`.
         @param language Input parameter `language`.
         @param filepath Input parameter `filepath`.
+        @param source Optional pre-loaded SourceBuffer; avoids reopening `filepath`.
         @return {None} Function return value.
         """
         spec = self.specs.get(language)
         if not spec:
             return
 
-        try:
-            with open(filepath, "r", encoding="utf-8", errors="replace") as f:
-                all_lines = f.readlines()
-        except (OSError, IOError):
-            return
+        if source is not None:
+            all_lines = source.lines
+        else:
+            try:
+                all_lines = SourceBuffer.from_path(filepath).lines
+            except (OSError, IOError):
+                return
 
         # Only process definitions that span multiple lines
         single_line_types = (
@@ -1295,248 +2056,44 @@ class SourceAnalyzer:
             if elem.line_end <= elem.line_start:
                 continue
 
-            body_comments = []
-            exit_points = []
-
             # Scan the body (lines after the definition line)
             body_start = elem.line_start  # 1-based, skip def line itself
             body_end = min(elem.line_end, len(all_lines))
+            scanner = _BodyAnnotationScanner(self, spec)
+            scanner.scan(body_start, all_lines[body_start:body_end])
+            elem.body_comments = scanner.body_comments or ()
+            elem.exit_points = scanner.exit_points or ()
 
-            in_multi = False
-            multi_start = 0
-            multi_lines = []
-
-            for line_idx in range(body_start, body_end):
-                raw = all_lines[line_idx].rstrip("\n\r")
-                stripped = raw.strip()
-
-                if not stripped:
-                    continue
-
-                # Multi-line comment tracking within body
-                if in_multi:
-                    multi_lines.append(stripped)
-                    if spec.multi_comment_end and spec.multi_comment_end in stripped:
-                        in_multi = False
-                        text = " ".join(
-                            self._clean_comment_line(ln, spec)
-                            for ln in multi_lines)
-                        text = text.strip()
-                        if text:
-                            body_comments.append(
-                                (multi_start, line_idx + 1, text))
-                        multi_lines = []
-                    continue
-
-                # Check for multi-line comment start
-                if spec.multi_comment_start and spec.multi_comment_start in stripped:
-                    mc_start = spec.multi_comment_start
-                    start_pos = stripped.index(mc_start)
-                    if not self._in_string_context(stripped, start_pos, spec):
-                        # Single-line multi-comment
-                        if mc_start == '"""' or mc_start == "'''":
-                            after = stripped[start_pos + 3:]
-                            if mc_start in after:
-                                text = self._clean_comment_line(
-                                    stripped, spec)
-                                if text:
-                                    body_comments.append(
-                                        (line_idx + 1, line_idx + 1, text))
-                                continue
-                        elif (spec.multi_comment_end
-                              and spec.multi_comment_end in stripped[
-                                  start_pos + len(mc_start):]):
-                            text = self._clean_comment_line(stripped, spec)
-                            if text:
-                                body_comments.append(
-                                    (line_idx + 1, line_idx + 1, text))
-                            continue
-
-                        in_multi = True
-                        multi_start = line_idx + 1
-                        multi_lines = [stripped]
-                        continue
-
-                # Single-line comment (full line)
-                if spec.single_comment:
-                    comment_pos = self._find_comment(stripped, spec)
-                    if comment_pos is not None:
-                        before = stripped[:comment_pos].strip()
-                        comment_text = stripped[comment_pos:]
-                        cleaned = self._clean_comment_line(
-                            comment_text, spec)
-
-                        if not before:
-                            # Standalone comment line in body
-                            if cleaned:
-                                body_comments.append(
-                                    (line_idx + 1, line_idx + 1, cleaned))
-                            continue
-                        else:
-                            # Inline comment after code
-                            if cleaned:
-                                body_comments.append(
-                                    (line_idx + 1, line_idx + 1, cleaned))
-
-                # Exit points
-                if self._EXIT_PATTERNS_RETURN.match(stripped):
-                    exit_text = stripped.strip()
-                    exit_points.append((line_idx + 1, exit_text))
-                elif self._EXIT_PATTERNS_IMPLICIT.match(stripped):
-                    exit_text = stripped.strip()
-                    exit_points.append((line_idx + 1, exit_text))
-
-            elem.body_comments = body_comments
-            elem.exit_points = exit_points
-
-    def _extract_doxygen_fields(self, elements: list):
+    def _extract_doxygen_fields(self, elements: list, index: Optional[ElementIndex] = None):
         """!
         @brief Extract Doxygen tag fields from associated documentation comments.
-                @details For each non-comment element, resolves the nearest associated documentation comment using language-agnostic adjacency rules: same-line postfix comment (`//!<`, `#!<`, `/**<`), nearest preceding standalone comment block within two lines, or nearest following postfix standalone comment within two lines. When the nearest preceding match is a standalone comment, contiguous preceding standalone comments are merged into one logical block before parsing so multi-line tag sets split across `#`/`//` lines are preserved. Parsed fields are stored in element.doxygen_fields.
+                @details For each non-comment element, resolves the nearest associated documentation comment using language-agnostic adjacency rules: same-line postfix comment (`//!<`, `#!<`, `/**<`), nearest preceding standalone comment block within two lines, or nearest following postfix standalone comment within two lines. When the nearest preceding match is a standalone comment, contiguous preceding standalone comments are merged into one logical block before parsing so multi-line tag sets split across `#`/`//` lines are preserved. Parsed fields are stored in element.doxygen_fields. Lookups go through `ElementIndex.doc_comment()` and `ElementIndex.preceding_block()`.
         @param elements Input parameter `elements`.
+        @param index Optional prebuilt ElementIndex of `elements`.
         @return {None} Function return value.
         """
-        comment_elements = [e for e in elements if e.element_type in
-                           (ElementType.COMMENT_SINGLE, ElementType.COMMENT_MULTI)]
-        non_comment_elements = [
-            e for e in elements
-            if e.element_type not in (ElementType.COMMENT_SINGLE, ElementType.COMMENT_MULTI)
-        ]
-
+        if index is None:
+            index = ElementIndex(elements)
         for elem in elements:
             # Skip comments themselves
-            if elem.element_type in (ElementType.COMMENT_SINGLE, ElementType.COMMENT_MULTI):
+            if elem.element_type in COMMENT_TYPES:
                 continue
-
-            associated_comment = None
-
-            def _is_file_level_comment(comment) -> bool:
-                """! @brief Detect whether a comment block is file-scoped Doxygen metadata.
-                @details Resolves canonical text from `comment_source` or fallback `extract` and checks for a standalone `@file` or `\\file` tag token; empty comment payloads are treated as non file-level.
-                @param comment {SourceElement} Candidate comment element.
-                @return {bool} True when the comment declares file-level metadata and must not be bound to a symbol.
-                """
-                comment_text = comment.comment_source or comment.extract
-                if not comment_text:
-                    return False
-                return bool(re.search(r"(?<!\w)(?:@|\\)file\b", comment_text))
-
-            same_line_postfix_candidates = [
-                comment
-                for comment in comment_elements
-                if comment.line_start == elem.line_end
-                and comment.name == "inline"
-                and self._is_postfix_doxygen_comment(comment.extract)
-                and not _is_file_level_comment(comment)
-            ]
-            if same_line_postfix_candidates:
-                associated_comment = min(
-                    same_line_postfix_candidates,
-                    key=lambda comment: comment.line_start,
-                )
-
+            associated_comment = index.doc_comment(elem)
             if associated_comment is None:
-                preceding_candidates = [
-                    comment
-                    for comment in comment_elements
-                    if comment.name != "inline"
-                    and comment.line_end < elem.line_start
-                    and not _is_file_level_comment(comment)
-                ]
-                if preceding_candidates:
-                    def _has_blocking_element(comment) -> bool:
-                        """! @brief Validate that no non-comment construct exists between comment and target symbol.
-                        @details Evaluates direct-span and overlap-span blockers in `non_comment_elements`; returns True when any unrelated construct occupies the interval between `comment.line_end` and `elem.line_start`.
-                        @param comment {SourceElement} Candidate preceding comment element.
-                        @return {bool} True when association must be rejected due to an intervening non-comment element.
-                        """
-                        return any(
-                            other is not elem
-                            and (
-                                (
-                                    other.line_start > comment.line_end
-                                    and other.line_start < elem.line_start
-                                )
-                                or (
-                                    other.line_start <= comment.line_end
-                                    and comment.line_end < other.line_end
-                                    and other.line_end < elem.line_start
-                                )
-                            )
-                            for other in non_comment_elements
-                        )
-
-                    near_preceding_candidates = [
-                        comment
-                        for comment in preceding_candidates
-                        if elem.line_start - comment.line_end <= 2
-                    ]
-                    if near_preceding_candidates:
-                        for comment in sorted(
-                            near_preceding_candidates,
-                            key=lambda c: (c.line_end, c.line_start),
-                            reverse=True,
-                        ):
-                            if not _has_blocking_element(comment):
-                                associated_comment = comment
-                                break
-                    else:
-                        for comment in sorted(
-                            preceding_candidates,
-                            key=lambda c: (c.line_end, c.line_start),
-                            reverse=True,
-                        ):
-                            comment_text = comment.comment_source or comment.extract
-                            if not parse_doxygen_comment(comment_text):
-                                continue
-                            if not _has_blocking_element(comment):
-                                associated_comment = comment
-                                break
-
-            if associated_comment is None:
-                following_postfix_candidates = [
-                    comment
-                    for comment in comment_elements
-                    if comment.name != "inline"
-                    and comment.line_start > elem.line_end
-                    and comment.line_start - elem.line_end <= 2
-                    and self._is_postfix_doxygen_comment(comment.extract)
-                    and not _is_file_level_comment(comment)
-                ]
-                if following_postfix_candidates:
-                    associated_comment = min(
-                        following_postfix_candidates,
-                        key=lambda comment: (comment.line_start, comment.line_end),
-                    )
-
-            if associated_comment:
-                comment_text = associated_comment.comment_source or associated_comment.extract
-                if (
-                    associated_comment.name != "inline"
-                    and associated_comment.line_end < elem.line_start
-                    and parse_doxygen_comment(comment_text)
-                ):
-                    merged_preceding_comments = [associated_comment]
-                    current_start = associated_comment.line_start
-                    while True:
-                        contiguous_candidates = [
-                            comment
-                            for comment in comment_elements
-                            if comment.name != "inline"
-                            and comment.line_end == current_start - 1
-                        ]
-                        if not contiguous_candidates:
-                            break
-                        previous_comment = max(
-                            contiguous_candidates,
-                            key=lambda comment: (comment.line_end, comment.line_start),
-                        )
-                        merged_preceding_comments.insert(0, previous_comment)
-                        current_start = previous_comment.line_start
-                    comment_text = "\n".join(
-                        (comment.comment_source or comment.extract) for comment in merged_preceding_comments
-                    )
+                continue
+            if (
+                associated_comment.name != "inline"
+                and associated_comment.line_end < elem.line_start
+                and index.doxygen_fields(associated_comment)
+            ):
+                comment_text = "\n".join(
+                    (comment.comment_source or comment.extract)
+                    for comment in index.preceding_block(associated_comment)
+                )
                 elem.doxygen_fields = parse_doxygen_comment(comment_text)
+            else:
+                elem.doxygen_fields = parse_doxygen_comment(
+                    associated_comment.comment_source or associated_comment.extract)
 
     @staticmethod
     def _is_postfix_doxygen_comment(comment_text: str) -> bool:
@@ -1567,6 +2124,132 @@ class SourceAnalyzer:
         return s
 
 
+class _BodyAnnotationScanner:
+    """! @brief Incremental collector of the body comments and exit points of one definition.
+    @details Carries the multi-line comment state between `scan()` calls, so a body can be scanned in one call over a line slice or line by line while the
+    file is streamed.
+    """
+
+    __slots__ = ("analyzer", "spec", "body_comments", "exit_points", "in_multi", "multi_start", "multi_lines")
+
+    def __init__(self, analyzer: "SourceAnalyzer", spec: LanguageSpec):
+        """! @brief Start before the first body line.
+        @param analyzer SourceAnalyzer providing the comment and string helpers.
+        @param spec LanguageSpec of the file.
+        @return {None} Function return value.
+        """
+        self.analyzer = analyzer
+        self.spec = spec
+        self.body_comments: list = []
+        """! @brief Collected `(start, end, text)` body comment tuples."""
+        self.exit_points: list = []
+        """! @brief Collected `(line, text)` exit point tuples."""
+        self.in_multi = False
+        self.multi_start = 0
+        self.multi_lines: list = []
+
+    def scan(self, first_idx: int, lines) -> None:
+        """! @brief Scan consecutive body lines for comments (single-line, inline, docstrings, block comments) and exit points (return, yield, raise, throw,
+        panic!, sys.exit).
+        @param first_idx 0-based file index of the first line in `lines`.
+        @param lines Body lines (terminators allowed).
+        @return {None} Function return value.
+        """
+        analyzer = self.analyzer
+        spec = self.spec
+        body_comments = self.body_comments
+        exit_points = self.exit_points
+        exit_return = SourceAnalyzer._EXIT_PATTERNS_RETURN
+        exit_implicit = SourceAnalyzer._EXIT_PATTERNS_IMPLICIT
+        in_multi = self.in_multi
+        multi_start = self.multi_start
+        multi_lines = self.multi_lines
+
+        for line_idx, line in enumerate(lines, first_idx):
+            raw = line.rstrip("\n\r")
+            stripped = raw.strip()
+
+            if not stripped:
+                continue
+
+            # Multi-line comment tracking within body
+            if in_multi:
+                multi_lines.append(stripped)
+                if spec.multi_comment_end and spec.multi_comment_end in stripped:
+                    in_multi = False
+                    text = " ".join(
+                        analyzer._clean_comment_line(ln, spec)
+                        for ln in multi_lines)
+                    text = text.strip()
+                    if text:
+                        body_comments.append(
+                            (multi_start, line_idx + 1, text))
+                    multi_lines = []
+                continue
+
+            # Check for multi-line comment start
+            if spec.multi_comment_start and spec.multi_comment_start in stripped:
+                mc_start = spec.multi_comment_start
+                start_pos = stripped.index(mc_start)
+                if not analyzer._in_string_context(stripped, start_pos, spec):
+                    # Single-line multi-comment
+                    if mc_start == '"""' or mc_start == "'''":
+                        after = stripped[start_pos + 3:]
+                        if mc_start in after:
+                            text = analyzer._clean_comment_line(
+                                stripped, spec)
+                            if text:
+                                body_comments.append(
+                                    (line_idx + 1, line_idx + 1, text))
+                            continue
+                    elif (spec.multi_comment_end
+                          and spec.multi_comment_end in stripped[
+                              start_pos + len(mc_start):]):
+                        text = analyzer._clean_comment_line(stripped, spec)
+                        if text:
+                            body_comments.append(
+                                (line_idx + 1, line_idx + 1, text))
+                        continue
+
+                    in_multi = True
+                    multi_start = line_idx + 1
+                    multi_lines = [stripped]
+                    continue
+
+            # Single-line comment (full line)
+            if spec.single_comment:
+                comment_pos = analyzer._find_comment(stripped, spec)
+                if comment_pos is not None:
+                    before = stripped[:comment_pos].strip()
+                    comment_text = stripped[comment_pos:]
+                    cleaned = analyzer._clean_comment_line(
+                        comment_text, spec)
+
+                    if not before:
+                        # Standalone comment line in body
+                        if cleaned:
+                            body_comments.append(
+                                (line_idx + 1, line_idx + 1, cleaned))
+                        continue
+                    else:
+                        # Inline comment after code
+                        if cleaned:
+                            body_comments.append(
+                                (line_idx + 1, line_idx + 1, cleaned))
+
+            # Exit points
+            if exit_return.match(stripped):
+                exit_text = stripped.strip()
+                exit_points.append((line_idx + 1, exit_text))
+            elif exit_implicit.match(stripped):
+                exit_text = stripped.strip()
+                exit_points.append((line_idx + 1, exit_text))
+
+        self.in_multi = in_multi
+        self.multi_start = multi_start
+        self.multi_lines = multi_lines
+
+
 def _md_loc(elem) -> str:
     """!
     @brief Format element location compactly for markdown.
@@ -1619,7 +2302,7 @@ def _extract_comment_text(comment_elem, max_length: int = 0) -> str:
     @param max_length Input parameter `max_length`.
     @return {str} Function return value.
     """
-    lines = comment_elem.extract.split("\n")
+    lines = comment_elem.extract_lines()
     cleaned = []
     for ln in lines:
         s = ln.strip()
@@ -1645,7 +2328,7 @@ def _extract_comment_lines(comment_elem) -> list:
     @param comment_elem Input parameter `comment_elem`.
     @return {list} Function return value.
     """
-    lines = comment_elem.extract.split("\n")
+    lines = comment_elem.extract_lines()
     cleaned = []
     for ln in lines:
         s = ln.strip()
@@ -1659,31 +2342,25 @@ def _extract_comment_lines(comment_elem) -> list:
     return cleaned
 
 
-def _build_comment_maps(elements: list) -> tuple:
+def _build_comment_maps(elements: list, index: Optional[ElementIndex] = None) -> tuple:
     """!
     @brief Build maps that associate comments with their adjacent definitions.
-        @details Returns: - doc_for_def: dict mapping def line_start -> list of comment texts (comments immediately preceding a definition) - standalone_comments: list of comment elements not attached to defs - file_description: text from the first comment block (file-level docs)
+        @details Returns: - doc_for_def: dict mapping def line_start -> list of comment texts (comments immediately preceding a definition) - standalone_comments: list of comment elements not attached to defs - file_description: text from the first comment block (file-level docs). Sorted comments and definition/import start lines come from the ElementIndex.
     @param elements Input parameter `elements`.
+    @param index Optional prebuilt ElementIndex of `elements`.
     @return {tuple} Function return value.
     """
-    all_sorted = sorted(elements, key=lambda e: e.line_start)
-
-    # Identify definition elements
-    def_types = set(ElementType) - {
-        ElementType.COMMENT_SINGLE, ElementType.COMMENT_MULTI,
-        ElementType.IMPORT, ElementType.DECORATOR}
-    def_starts = {e.line_start for e in elements if e.element_type in def_types}
-    import_starts = {e.line_start for e in elements
-                     if e.element_type == ElementType.IMPORT}
+    if index is None:
+        index = ElementIndex(elements)
+    def_starts = index.def_starts
+    import_starts = index.import_starts
 
     # Build adjacency map: comments preceding a definition (within 2 lines)
     doc_for_def = {}
     standalone_comments = []
     file_description = ""
 
-    comments = [e for e in all_sorted
-                if e.element_type in (ElementType.COMMENT_SINGLE,
-                                      ElementType.COMMENT_MULTI)]
+    comments = index.comments
 
     # Extract file description from first comment(s), skip shebangs
     for first_c in comments:
@@ -1853,8 +2530,9 @@ def format_markdown(
     filepath: str,
     language: str,
     spec_name: str,
-    total_lines: int,
+    total_lines: Optional[int] = None,
     include_legacy_annotations: bool = True,
+    source: Optional[SourceBuffer] = None,
 ) -> str:
     """! @brief Format analysis as compact Markdown optimized for LLM agent consumption.
     @details Produces token-efficient output with: - File header with language, line count, element summary, and optional file description - Imports in a code block - Hierarchical definitions enriched with ordered Doxygen field bullets when available - Optional legacy comment/exit traces when include_legacy_annotations is enabled - Symbol index table for quick reference by line number.
@@ -1862,10 +2540,13 @@ def format_markdown(
     @param filepath Absolute or relative source file path.
     @param language Normalized source language key.
     @param spec_name Display language name from LanguageSpec.
-    @param total_lines Total source file line count.
+    @param total_lines Total source file line count; derived from `source` when None.
     @param include_legacy_annotations Enable legacy L<n>> comment/exit traces and standalone comments section.
+    @param source Optional SourceBuffer of the analyzed file.
     @return Markdown payload for one analyzed file.
     """
+    if total_lines is None:
+        total_lines = source.line_count if source is not None else 0
     out = []
     fname = os.path.basename(filepath)
 
@@ -1908,7 +2589,7 @@ def format_markdown(
         out.append("## Imports")
         out.append("```")
         for imp in imports:
-            first = imp.extract.split("\n")[0].strip()
+            first = imp.first_line.strip()
             out.append(first)
         out.append("```")
         out.append("")
@@ -1917,7 +2598,7 @@ def format_markdown(
     dec_map = {}
     for e in elements:
         if e.element_type == ElementType.DECORATOR:
-            dec_map[e.line_start] = e.extract.split("\n")[0].strip()
+            dec_map[e.line_start] = e.first_line.strip()
 
     # ── Definitions ───────────────────────────────────────────────────
     defs = sorted(
@@ -1925,10 +2606,13 @@ def format_markdown(
         key=lambda e: e.line_start)
 
     top_level = [e for e in defs if e.depth == 0]
+    top_level_by_name = {}
+    for top in top_level:
+        top_level_by_name.setdefault(top.name, []).append(top)
     children_map = {}
     for e in defs:
         if e.depth > 0 and e.parent_name:
-            for top in top_level:
+            for top in top_level_by_name.get(e.parent_name, ()):
                 if (top.name == e.parent_name
                         and top.line_start <= e.line_start
                         and top.line_end >= e.line_end):
@@ -1989,7 +2673,7 @@ def format_markdown(
             is_inline = (elem.element_type in inline_types or is_single_line)
 
             if is_inline:
-                first_line = elem.extract.split("\n")[0].strip()
+                first_line = elem.first_line.strip()
                 line = f"- {kind} `{first_line}`{vis_str} (L{elem.line_start})"
                 if include_legacy_annotations and doc_text:
                     line += f" — {doc_text}"
@@ -2000,7 +2684,7 @@ def format_markdown(
             else:
                 # For impl blocks, use the full first line as sig
                 if elem.element_type == ElementType.IMPL:
-                    first_line = elem.extract.split("\n")[0].strip()
+                    first_line = elem.first_line.strip()
                     sig = first_line.rstrip(" {")
 
                 out.append(f"### {kind} `{sig}`{inherit_str}{vis_str}"
@@ -2221,7 +2905,8 @@ def main():
         sys.exit(0)
 
     try:
-        elements = analyzer.analyze(args.file, args.language)
+        source = SourceBuffer.from_path(args.file)
+        elements = analyzer.analyze(args.file, args.language, source=source)
     except FileNotFoundError:
         print(f"Error: file '{args.file}' not found.", file=sys.stderr)
         sys.exit(1)
@@ -2252,11 +2937,9 @@ def main():
                                           ElementType.COMMENT_MULTI)]
 
     if args.markdown or not args.quiet:
-        with open(args.file, "r", encoding="utf-8", errors="replace") as f:
-            total_lines = sum(1 for _ in f)
-        analyzer.enrich(elements, lang_key, filepath=args.file)
+        analyzer.enrich(elements, lang_key, filepath=args.file, source=source)
         output = format_markdown(
-            elements, args.file, lang_key, spec.name, total_lines)
+            elements, args.file, lang_key, spec.name, source=source)
         print(output)
     elif args.quiet:
         sorted_elements = sorted(elements, key=lambda e: e.line_start)
@@ -2269,7 +2952,7 @@ def main():
                         if elem.line_start == elem.line_end
                         else f"L{elem.line_start}-L{elem.line_end}")
             print(f"{elem.line_start:>6} | [{elem.type_label}]{name_str} {location}")
-            first_line = elem.extract.split("\n")[0]
+            first_line = elem.first_line
             if len(first_line) > 72:
                 first_line = first_line[:69] + "..."
             print(f"       | {first_line}")
@@ -0,0 +1,163 @@
+"""!
+@file source_buffer.py
+@brief Single-read source file buffer shared by analysis, enrichment, and formatting.
+@details A `SourceBuffer` reads a file exactly once (memory-mapped above `MMAP_THRESHOLD_BYTES`), decodes it with the same UTF-8/replace and universal-newline
+rules as text-mode `open()`, computes the git blob digest from the raw bytes, and exposes `readlines()`-compatible line access backed by a lazily built line offset
+index. `SourceAnalyzer.analyze()`, `SourceAnalyzer.enrich()`, `format_markdown()`, `format_construct()`, and `compress_source()` accept it instead of reopening the
+file.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import hashlib
+import mmap
+import os
+from bisect import bisect_right
+from typing import Optional
+
+from . import profiling
+
+MMAP_THRESHOLD_BYTES = 1 << 20
+"""! @brief Files at least this large are memory-mapped instead of read into a bytes object."""
+
+DIGEST_BLOCK_BYTES = 1 << 20
+"""! @brief Bytes read per block by `file_blob_digest()`."""
+
+
+def git_blob_digest(data) -> str:
+    """! @brief Compute the git blob object id of a bytes-like payload.
+    @param data Bytes-like object (bytes or mmap).
+    @return Hex SHA-1 of `blob <size>\\0<data>`, identical to `git hash-object`.
+    """
+    hasher = hashlib.sha1(b"blob %d\0" % len(data))
+    hasher.update(data)
+    return hasher.hexdigest()
+
+
+def file_blob_digest(path: str, size: Optional[int] = None) -> str:
+    """! @brief Compute the git blob digest of a file without loading it whole.
+    @param path File path.
+    @param size File size in bytes from `os.stat()`; taken from the open file when None.
+    @return Hex git blob object id, identical to `SourceBuffer.digest`.
+    @throws OSError If the file cannot be read.
+    """
+    with open(path, "rb") as handle:
+        if size is None:
+            size = os.fstat(handle.fileno()).st_size
+        hasher = hashlib.sha1(b"blob %d\0" % size)
+        for block in iter(lambda: handle.read(DIGEST_BLOCK_BYTES), b""):
+            hasher.update(block)
+    return hasher.hexdigest()
+
+
+def _normalize_newlines(text: str) -> str:
+    """! @brief Apply text-mode universal newline translation.
+    @param text Decoded file content.
+    @return Text with `\\r\\n` and lone `\\r` translated to `\\n`.
+    """
+    if "\r" not in text:
+        return text
+    return text.replace("\r\n", "\n").replace("\r", "\n")
+
+
+class SourceBuffer:
+    """! @brief Immutable decoded view of one source file.
+    @details `lines` matches `open(path, encoding="utf-8", errors="replace").readlines()` exactly: only `\\n` terminates lines and terminators are kept.
+    """
+
+    __slots__ = ("path", "text", "digest", "_lines", "_offsets")
+
+    def __init__(self, text: str, path: Optional[str] = None,
+                 digest: Optional[str] = None):
+        """! @brief Wrap already decoded text.
+        @param text Decoded source text; newline translation is applied.
+        @param path Optional originating file path.
+        @param digest Optional git blob digest of the raw bytes; computed from the UTF-8 encoding of `text` when omitted.
+        @return {None} Function return value.
+        """
+        self.path = path
+        self.text = _normalize_newlines(text)
+        self.digest = digest or git_blob_digest(text.encode("utf-8", "surrogatepass"))
+        self._lines: Optional[list[str]] = None
+        self._offsets: Optional[list[int]] = None
+
+    @classmethod
+    def from_bytes(cls, data, path: Optional[str] = None) -> "SourceBuffer":
+        """! @brief Decode a raw bytes-like payload.
+        @param data File bytes or memory map.
+        @param path Optional originating file path.
+        @return SourceBuffer instance.
+        """
+        return cls(str(data, "utf-8", "replace"), path, git_blob_digest(data))
+
+    @classmethod
+    def from_path(cls, path: str) -> "SourceBuffer":
+        """! @brief Read and decode a file in a single pass.
+        @param path Source file path.
+        @return SourceBuffer instance.
+        @throws OSError If the file cannot be opened or read.
+        @details Files of at least `MMAP_THRESHOLD_BYTES` are decoded and hashed directly from a read-only memory map, avoiding an intermediate bytes copy.
+        """
+        with profiling.span("read"), open(path, "rb") as handle:
+            size = os.fstat(handle.fileno()).st_size
+            profiling.count("read.files")
+            profiling.count("read.bytes", size)
+            if size >= MMAP_THRESHOLD_BYTES:
+                try:
+                    with mmap.mmap(handle.fileno(), 0, access=mmap.ACCESS_READ) as mapped:
+                        return cls.from_bytes(mapped, path)
+                except (OSError, ValueError):
+                    handle.seek(0)
+            return cls.from_bytes(handle.read(), path)
+
+    @property
+    def lines(self) -> list[str]:
+        """! @brief Lines with terminators, equivalent to text-mode `readlines()`.
+        @return Cached list of lines.
+        """
+        if self._lines is None:
+            parts = self.text.split("\n")
+            lines = [part + "\n" for part in parts[:-1]]
+            if parts[-1]:
+                lines.append(parts[-1])
+            self._lines = lines
+        return self._lines
+
+    @property
+    def line_count(self) -> int:
+        """! @brief Number of lines, equivalent to `sum(1 for _ in open(path))`.
+        @return Line count.
+        """
+        if self._lines is not None:
+            return len(self._lines)
+        newlines = self.text.count("\n")
+        return newlines + (0 if self.text.endswith("\n") or not self.text else 1)
+
+    @property
+    def line_offsets(self) -> list[int]:
+        """! @brief Character offset of the first character of every line.
+        @return Cached ascending offset list with one entry per line.
+        """
+        if self._offsets is None:
+            offsets = []
+            position = 0
+            for line in self.lines:
+                offsets.append(position)
+                position += len(line)
+            self._offsets = offsets
+        return self._offsets
+
+    def line_of_offset(self, offset: int) -> int:
+        """! @brief Map a character offset to its 1-based line number.
+        @param offset Character offset into `text`.
+        @return 1-based line number containing `offset`.
+        """
+        return max(1, bisect_right(self.line_offsets, offset))
+
+    def slice_lines(self, line_start: int, line_end: int) -> list[str]:
+        """! @brief Return lines of an inclusive 1-based range.
+        @param line_start First line (1-based).
+        @param line_end Last line (1-based, inclusive).
+        @return Lines with terminators, same as `lines[line_start - 1:line_end]`.
+        """
+        return self.lines[line_start - 1:line_end]
@@ -5,7 +5,9 @@
   Exposes `run_static_check(argv)` as the primary entry point for `--test-static-check` called
   from cli.py. Also exposes `parse_enable_static_check`, `dispatch_static_check_for_file`,
   `STATIC_CHECK_LANG_CANONICAL`, and `STATIC_CHECK_EXT_TO_LANG` for `--enable-static-check`,
-  `--files-static-check`, and `--static-check` command support.
+  `--files-static-check`, and `--static-check` command support; `run_static_check_plan` schedules
+  those per-file checks concurrently and optionally batches tools that accept many paths, and
+  `StaticCheckResultCache` replays verdicts of unchanged files from the project analysis cache.
   Class hierarchy: StaticCheckBase (Dummy) -> StaticCheckPylance, StaticCheckRuff, StaticCheckCommand.
   File resolution supports: explicit file paths, glob patterns (with full `**` recursive expansion),
   and direct-children-only directory traversal. No custom `--recursive` flag; recursive traversal
@@ -17,6 +19,10 @@
 from __future__ import annotations
 
 import glob
+import hashlib
+import importlib.metadata
+import json
+import os
 import shutil
 import subprocess
 import sys
@@ -24,6 +30,8 @@ from pathlib import Path
 from typing import List, Optional, Sequence
 
 from .cli import ReqError
+from . import profiling
+from .parallel import iter_ordered_threads
 
 
 # ---------------------------------------------------------------------------
@@ -104,6 +112,22 @@ _CANONICAL_MODULES: dict[str, str] = {
     "command": "Command",
 }
 
+BATCH_COMMANDS: frozenset[str] = frozenset({"cppcheck", "clang-tidy", "shellcheck"})
+"""!
+@brief External command basenames that accept many file paths in one invocation with per-invocation exit status.
+@details `Command` entries whose `cmd` basename is listed here are eligible for batched invocation (SRS-384); any other command keeps one invocation per file
+  because its multi-path semantics are unknown (e.g. `node --check` checks only its first path).
+"""
+
+BATCH_MAX_FILES = 128
+"""! @brief Upper bound on file paths passed to one batched tool invocation, keeping argv well below platform limits."""
+
+TOOL_CONFIG_FILE_NAMES: tuple[str, ...] = ("pyproject.toml", "setup.cfg", "ruff.toml", ".ruff.toml", "pyrightconfig.json")
+"""!
+@brief Project-root configuration files read by the checked tools.
+@details Their content is part of every `StaticCheckResultCache` key, so editing tool settings invalidates cached verdicts (SRS-395).
+"""
+
 
 # ---------------------------------------------------------------------------
 # Configuration parsing helpers (SRS-260)
@@ -231,6 +255,8 @@ def dispatch_static_check_for_file(
     *,
     fail_only: bool = False,
     project_base: Optional[Path] = None,
+    sink: Optional[List[str]] = None,
+    result_cache: Optional["StaticCheckResultCache"] = None,
 ) -> int:
     """!
     @brief Dispatch static-check for a single file based on a language config dict.
@@ -239,6 +265,8 @@ def dispatch_static_check_for_file(
       optional `"params"` (list[str]).
     @param fail_only When True, suppress all stdout output for passing checks (SRS-253, SRS-256).
     @param project_base Absolute project root used for checker runtime context.
+    @param sink Optional list collecting output lines instead of printing them (SRS-384).
+    @param result_cache Optional verdict cache consulted before running the tool (SRS-395).
     @return Exit code: 0 on pass, 1 on fail.
     @throws ReqError If module is unknown, or Command module is missing `"cmd"`.
     @details
@@ -252,37 +280,197 @@ def dispatch_static_check_for_file(
       Delegates actual check to `checker.run()`.
     @see SRS-261, SRS-253, SRS-256, SRS-341
     """
+    checker = _build_checker(
+        [filepath],
+        lang_config,
+        subject=filepath,
+        fail_only=fail_only,
+        project_base=project_base,
+        sink=sink,
+        result_cache=result_cache,
+    )
+    return checker.run()
+
+
+def dispatch_static_check_batch(
+    filepaths: Sequence[str],
+    lang_config: dict,
+    *,
+    project_base: Optional[Path] = None,
+    result_cache: Optional["StaticCheckResultCache"] = None,
+) -> bool:
+    """!
+    @brief Check a file group with one invocation of a language config's tool.
+    @param filepaths Absolute paths of the files to analyse together.
+    @param lang_config Language config dict, as for `dispatch_static_check_for_file`.
+    @param project_base Absolute project root used for checker runtime context.
+    @param result_cache Optional verdict cache receiving a pass verdict for every file of a passing group.
+    @return True when the batched invocation proves every file passes; False when the tool is not batchable or reports any failure.
+    @throws ReqError If module is unknown, or Command module is missing `"cmd"`.
+    @details Produces no output. Batchable tools are Pylance, Ruff, and `Command` entries whose command is in `BATCH_COMMANDS`.
+    @satisfies SRS-384, SRS-395
+    """
+    checker = _build_checker(
+        filepaths,
+        lang_config,
+        subject=filepaths[0] if filepaths else "",
+        fail_only=True,
+        project_base=project_base,
+        result_cache=result_cache,
+    )
+    return checker.batch_passes()
+
+
+def _build_checker(
+    inputs: Sequence[str],
+    lang_config: dict,
+    *,
+    subject: str,
+    fail_only: bool,
+    project_base: Optional[Path],
+    sink: Optional[List[str]] = None,
+    result_cache: Optional["StaticCheckResultCache"] = None,
+) -> "StaticCheckBase":
+    """!
+    @brief Instantiate the checker class selected by a language config dict.
+    @param inputs File paths forwarded as checker inputs.
+    @param lang_config Dict with keys `"module"`, optional `"cmd"`, optional `"params"`.
+    @param subject File path named in configuration error messages.
+    @param fail_only When True, passing checks produce no output.
+    @param project_base Absolute project root forwarded to Pylance.
+    @param sink Optional list collecting output lines instead of printing them.
+    @param result_cache Optional verdict cache forwarded to the checker.
+    @return Configured checker instance.
+    @throws ReqError If module is unknown, or Command module is missing `"cmd"`.
+    """
     module = lang_config.get("module", "")
     params: List[str] = lang_config.get("params", [])
     cmd: Optional[str] = lang_config.get("cmd")
 
     module_key = module.lower()
-    checker: StaticCheckBase
     if module_key == "dummy":
-        checker = StaticCheckBase(inputs=[filepath], extra_args=params, fail_only=fail_only)
-    elif module_key == "pylance":
-        checker = StaticCheckPylance(
-            inputs=[filepath],
+        return StaticCheckBase(inputs=inputs, extra_args=params, fail_only=fail_only, sink=sink, result_cache=result_cache)
+    if module_key == "pylance":
+        return StaticCheckPylance(
+            inputs=inputs,
             extra_args=params,
             fail_only=fail_only,
             project_base=project_base,
+            sink=sink,
+            result_cache=result_cache,
         )
-    elif module_key == "ruff":
-        checker = StaticCheckRuff(inputs=[filepath], extra_args=params, fail_only=fail_only)
-    elif module_key == "command":
+    if module_key == "ruff":
+        return StaticCheckRuff(inputs=inputs, extra_args=params, fail_only=fail_only, sink=sink, result_cache=result_cache)
+    if module_key == "command":
         if not cmd:
             raise ReqError(
-                f"Error: Command module requires 'cmd' in static-check config for '{filepath}'.",
+                f"Error: Command module requires 'cmd' in static-check config for '{subject}'.",
                 1,
             )
-        checker = StaticCheckCommand(cmd=cmd, inputs=[filepath], extra_args=params, fail_only=fail_only)
-    else:
-        raise ReqError(
-            f"Error: unknown static-check module '{module}'. "
-            "Valid modules: Dummy, Pylance, Ruff, Command",
-            1,
+        return StaticCheckCommand(
+            cmd=cmd, inputs=inputs, extra_args=params, fail_only=fail_only, sink=sink, result_cache=result_cache
         )
-    return checker.run()
+    raise ReqError(
+        f"Error: unknown static-check module '{module}'. "
+        "Valid modules: Dummy, Pylance, Ruff, Command",
+        1,
+    )
+
+
+def run_static_check_plan(
+    plan: Sequence[tuple[str, Sequence[dict]]],
+    *,
+    project_base: Optional[Path] = None,
+    jobs: Optional[int] = None,
+    batch: bool = False,
+    result_cache: Optional["StaticCheckResultCache"] = None,
+) -> int:
+    """!
+    @brief Run configured static checks for many files concurrently with deterministic output.
+    @param plan Ordered `(filepath, lang_configs)` pairs; every config of a file runs in list order.
+    @param project_base Absolute project root used for checker runtime context.
+    @param jobs Concurrent tool invocation count (`None` selects the CPU core count, `1` runs sequentially).
+    @param batch When True, batchable tools first check each file group with one invocation.
+    @param result_cache Optional verdict cache; cached verdicts replace tool invocations of unchanged files.
+    @return Exit code: 0 if every check passes, 1 if any fails.
+    @details All checks run with `fail_only=True`. Per-file checks (every config of one file) form one unit executed by `iter_ordered_threads`; each unit
+      collects its output lines, and units are printed in plan order, so stdout is byte-identical to sequential dispatch for any `jobs`.
+      In batch mode files sharing a batchable config are checked in groups of up to `BATCH_MAX_FILES` paths (groups of one file are not batched). A group whose
+      invocation exits 0 drops that config from its files' units, since passing checks emit nothing; a failing group's files are rechecked individually, which
+      demultiplexes failures into the regular per-file `# Static-Check(...)` / `Result: FAIL` / `Evidence:` blocks.
+      With a result cache, configs whose cached verdict for a file is a pass are dropped before batching; cached failures stay in their units and replay
+      their stored evidence without running the tool.
+    @satisfies SRS-253, SRS-256, SRS-384, SRS-395
+    """
+    pending: List[List[dict]] = [list(configs) for _, configs in plan]
+    if result_cache is not None:
+        probes: dict[int, Optional[StaticCheckBase]] = {}
+        for index, configs in enumerate(pending):
+            kept: List[dict] = []
+            for config in configs:
+                if id(config) not in probes:
+                    try:
+                        probes[id(config)] = _build_checker(
+                            [], config, subject=plan[index][0], fail_only=True, project_base=project_base
+                        )
+                    except ReqError:
+                        probes[id(config)] = None
+                probe = probes[id(config)]
+                verdict = result_cache.lookup(probe, plan[index][0]) if probe is not None else None
+                if verdict is None or verdict[0] != 0:
+                    kept.append(config)
+            pending[index] = kept
+    if batch:
+        groups: dict[int, tuple[dict, List[int]]] = {}
+        for index, configs in enumerate(pending):
+            for config in configs:
+                groups.setdefault(id(config), (config, []))[1].append(index)
+        tasks: List[tuple[dict, List[int]]] = []
+        for config, indexes in groups.values():
+            for start in range(0, len(indexes), BATCH_MAX_FILES):
+                chunk = indexes[start:start + BATCH_MAX_FILES]
+                if len(chunk) > 1:
+                    tasks.append((config, chunk))
+
+        def _run_batch(task: tuple[dict, List[int]]) -> bool:
+            config, indexes = task
+            return dispatch_static_check_batch(
+                [plan[index][0] for index in indexes],
+                config,
+                project_base=project_base,
+                result_cache=result_cache,
+            )
+
+        for (config, indexes), passed in zip(tasks, iter_ordered_threads(_run_batch, tasks, jobs)):
+            if passed:
+                for index in indexes:
+                    pending[index] = [entry for entry in pending[index] if entry is not config]
+
+    units = [(plan[index][0], configs) for index, configs in enumerate(pending) if configs]
+
+    def _run_unit(unit: tuple[str, List[dict]]) -> tuple[int, List[str]]:
+        filepath, configs = unit
+        lines: List[str] = []
+        rc = 0
+        for config in configs:
+            if dispatch_static_check_for_file(
+                filepath,
+                config,
+                fail_only=True,
+                project_base=project_base,
+                sink=lines,
+                result_cache=result_cache,
+            ) != 0:
+                rc = 1
+        return rc, lines
+
+    overall = 0
+    for rc, lines in iter_ordered_threads(_run_unit, units, jobs):
+        for line in lines:
+            print(line)
+        if rc != 0:
+            overall = 1
+    return overall
 
 
 # ---------------------------------------------------------------------------
@@ -332,6 +520,161 @@ def _resolve_files(inputs: Sequence[str]) -> List[str]:
     return list(resolved.keys())
 
 
+def _run_tool(cmd: Sequence[str]) -> subprocess.CompletedProcess:
+    """!
+    @brief Run one checker invocation and capture its output.
+    @param cmd Tool argument vector.
+    @return Completed process with text stdout/stderr.
+    @throws FileNotFoundError If the tool executable does not exist.
+    @details Counted as `subprocesses.static_check` and timed as `static_check.subprocess` under `--profile`.
+    """
+    profiling.count("subprocesses.static_check")
+    with profiling.span("static_check.subprocess"):
+        return subprocess.run(
+            cmd,
+            capture_output=True,
+            text=True,
+        )
+
+
+def _executable_identity(path: Optional[str]) -> Optional[str]:
+    """!
+    @brief Identify an executable file by resolved path, size, and modification time.
+    @param path Executable path, or None.
+    @return `<realpath>:<size>:<mtime_ns>`, or None when `path` is missing or cannot be stat-ed.
+    """
+    if not path:
+        return None
+    try:
+        real = os.path.realpath(path)
+        st = os.stat(real)
+    except OSError:
+        return None
+    return f"{real}:{st.st_size}:{st.st_mtime_ns}"
+
+
+def _python_tool_identity(distribution: str) -> Optional[str]:
+    """!
+    @brief Identify a tool run as `sys.executable -m <module>`.
+    @param distribution Installed distribution name providing the module.
+    @return Interpreter identity joined with the distribution version (`missing` when not installed), or None when the interpreter cannot be stat-ed.
+    """
+    interpreter = _executable_identity(sys.executable)
+    if interpreter is None:
+        return None
+    try:
+        version = importlib.metadata.version(distribution)
+    except importlib.metadata.PackageNotFoundError:
+        version = "missing"
+    return f"{interpreter}|{distribution}=={version}"
+
+
+def _tool_config_signature(project_base: Optional[Path]) -> List[str]:
+    """!
+    @brief Fingerprint the tool configuration files of a project root.
+    @param project_base Project root, or None.
+    @return `<name>:<sha1>` for every existing `TOOL_CONFIG_FILE_NAMES` entry, in declaration order.
+    """
+    signature: List[str] = []
+    if project_base is None:
+        return signature
+    for name in TOOL_CONFIG_FILE_NAMES:
+        try:
+            data = (project_base / name).read_bytes()
+        except OSError:
+            continue
+        signature.append(f"{name}:{hashlib.sha1(data).hexdigest()}")
+    return signature
+
+
+class StaticCheckResultCache:
+    """!
+    @brief Content-addressed store of per-file static-check verdicts and evidence.
+    @details Entries live in the project `AnalysisCache`: the payload key is the git blob digest of the checked file and the kind is `static-check.<hash>`,
+      where the hash covers the checker label (module and `cmd`), the complete tool argv for the file (path and `params`), the tool binary identity, and the
+      project tool configuration files. Editing the file, the `"static-check"` entry, the tool settings, or reinstalling the tool therefore selects another entry.
+      The payload is the `(returncode, evidence)` verdict rendered by `_check_file`, so replayed output is byte-identical to a fresh run. Tools that could not
+      start are never cached. Paths below the project root (the checked file, a project virtualenv interpreter) enter the key relative to it, and the project
+      root is stored in the evidence as a NUL placeholder, so worktrees sharing one object store (SRS-396) reuse each other's verdicts with their own paths.
+      Verdicts of tools that also read other files (e.g. pyright resolving imports) are reused while the checked file is unchanged;
+      `--no-cache` forces fresh runs.
+    @satisfies SRS-395, SRS-396
+    """
+
+    KIND_PREFIX = "static-check"
+
+    def __init__(self, cache, project_base: Optional[Path] = None) -> None:
+        """!
+        @brief Bind the verdict store to an analysis cache.
+        @param cache `AnalysisCache` holding the entries.
+        @param project_base Project root whose `TOOL_CONFIG_FILE_NAMES` participate in every key.
+        @return {None} Function return value.
+        """
+        self._cache = cache
+        self._context = _tool_config_signature(project_base)
+        self._identities: dict[str, Optional[str]] = {}
+        self._base = os.path.abspath(project_base) if project_base is not None else None
+
+    def _key(self, checker: "StaticCheckBase", filepath: str) -> Optional[tuple[str, str]]:
+        """!
+        @brief Compute the `(digest, kind)` entry key of one checker/file pair.
+        @param checker Checker whose tool checks `filepath`.
+        @param filepath Absolute path of the checked file.
+        @return Entry key, or None when the checker has no cacheable tool or the file cannot be read.
+        @details Tool identities are resolved once per checker label and cache instance.
+        """
+        if checker.LABEL not in self._identities:
+            self._identities[checker.LABEL] = checker._tool_identity()
+        identity = self._identities[checker.LABEL]
+        if identity is None:
+            return None
+        digest = self._cache.digest_for(filepath)
+        if digest is None:
+            return None
+        argv = checker._command([filepath])
+        if self._base is not None:
+            prefix = self._base + os.sep
+            argv = [os.path.relpath(arg, self._base) if arg.startswith(prefix) else arg for arg in argv]
+        material = json.dumps([checker.LABEL, identity, argv, self._context])
+        kind = f"{self.KIND_PREFIX}.{hashlib.sha1(material.encode('utf-8', 'surrogateescape')).hexdigest()[:24]}"
+        return digest, kind
+
+    def lookup(self, checker: "StaticCheckBase", filepath: str) -> Optional[tuple[int, str]]:
+        """!
+        @brief Return the cached verdict of one checker/file pair.
+        @param checker Checker whose tool checks `filepath`.
+        @param filepath Absolute path of the checked file.
+        @return `(returncode, evidence)`, or None on miss.
+        """
+        key = self._key(checker, filepath)
+        if key is None:
+            return None
+        verdict = self._cache.load(*key)
+        if not isinstance(verdict, tuple) or len(verdict) != 2:
+            return None
+        returncode, evidence = verdict
+        if self._base is not None:
+            evidence = evidence.replace("\0", self._base)
+        return returncode, evidence
+
+    def record(self, checker: "StaticCheckBase", filepath: str, verdict: tuple[int, str]) -> None:
+        """!
+        @brief Store the verdict of one checker/file pair.
+        @param checker Checker whose tool checked `filepath`.
+        @param filepath Absolute path of the checked file.
+        @param verdict `(returncode, evidence)` produced by the tool.
+        @return {None} Function return value.
+        """
+        returncode, evidence = verdict
+        if "\0" in evidence:
+            return
+        key = self._key(checker, filepath)
+        if key is not None:
+            if self._base is not None:
+                evidence = evidence.replace(self._base, "\0")
+            self._cache.store(*key, (returncode, evidence))
+
+
 # ---------------------------------------------------------------------------
 # Base class
 # ---------------------------------------------------------------------------
@@ -348,18 +691,25 @@ class StaticCheckBase:
     #: Tool label used in the header line. Subclasses override this.
     LABEL: str = "Dummy"
 
+    #: Whether one tool invocation may check many files (SRS-384). Subclasses override this.
+    BATCHABLE: bool = False
+
     def __init__(
         self,
         inputs: Sequence[str],
         extra_args: Optional[Sequence[str]] = None,
         *,
         fail_only: bool = False,
+        sink: Optional[List[str]] = None,
+        result_cache: Optional[StaticCheckResultCache] = None,
     ) -> None:
         """!
                 @brief Initialize the static checker with resolved inputs and options.
                 @param inputs Raw path/pattern/directory entries from CLI.
                 @param extra_args Additional CLI arguments forwarded to the external tool (may be None).
                 @param fail_only When True, suppress all stdout output for passing checks (SRS-241).
+                @param sink Optional list collecting output lines instead of printing them (SRS-384).
+                @param result_cache Optional verdict cache replaying results of unchanged files (SRS-395).
                 @details Resolves `inputs` immediately into `self._files` via `_resolve_files`.
                   Recursive traversal is expressed via `**` glob patterns in `inputs` (e.g., `src/**/*.py`);
                   no separate recursive flag exists (SRS-240, SRS-245).
@@ -367,6 +717,8 @@ class StaticCheckBase:
         """
         self._extra_args: List[str] = list(extra_args) if extra_args else []
         self._fail_only: bool = fail_only
+        self._sink: Optional[List[str]] = sink
+        self._result_cache: Optional[StaticCheckResultCache] = result_cache
         self._files = _resolve_files(inputs)
 
     # ------------------------------------------------------------------
@@ -399,10 +751,72 @@ class StaticCheckBase:
                 self._emit_line("")
         return overall
 
+    def batch_passes(self) -> bool:
+        """!
+        @brief Check all resolved files with a single tool invocation.
+        @return True when the batched invocation exits 0, False when it fails, cannot start, or the checker is not batchable.
+        @details Only an exit code 0 is trusted: it proves every file passes, so their per-file checks can be skipped. Any failure carries no reliable per-file
+          attribution, and callers rerun the affected files individually to produce the exact per-file `Result:` blocks. A pass is recorded in the result cache
+          for every file.
+        @satisfies SRS-384, SRS-395
+        """
+        if not self.BATCHABLE or not self._files:
+            return False
+        try:
+            result = _run_tool(self._command(self._files))
+        except FileNotFoundError:
+            return False
+        if result.returncode != 0:
+            return False
+        if self._result_cache is not None:
+            for filepath in self._files:
+                self._result_cache.record(self, filepath, (0, ""))
+        return True
+
     # ------------------------------------------------------------------
     # Internal helpers
     # ------------------------------------------------------------------
 
+    def _command(self, paths: Sequence[str]) -> List[str]:
+        """!
+        @brief Build the tool argv checking `paths`.
+        @param paths Absolute file paths to check.
+        @return Argument vector; the Dummy base has no external tool and returns an empty list.
+        """
+        return []
+
+    def _tool_identity(self) -> Optional[str]:
+        """!
+        @brief Identify the tool binary whose verdicts may be cached.
+        @return Identity string changing whenever the tool changes; the Dummy base runs no tool and returns None, disabling the result cache.
+        """
+        return None
+
+    def _tool_verdict(self, filepath: str) -> Optional[tuple[int, str]]:
+        """!
+        @brief Run the tool on one file, or replay its cached verdict.
+        @param filepath Absolute path of the file to check.
+        @return `(returncode, evidence)` where evidence is the right-stripped concatenation of tool stdout and stderr (empty on pass), or None when the tool
+          cannot start.
+        @details Cache hits spawn no process. Fresh verdicts are recorded in the result cache when one is configured.
+        @satisfies SRS-395
+        """
+        if self._result_cache is not None:
+            verdict = self._result_cache.lookup(self, filepath)
+            if verdict is not None:
+                return verdict
+        try:
+            result = _run_tool(self._command([filepath]))
+        except FileNotFoundError:
+            return None
+        if result.returncode == 0:
+            verdict = (0, "")
+        else:
+            verdict = (1, ((result.stdout or "") + (result.stderr or "")).rstrip())
+        if self._result_cache is not None:
+            self._result_cache.record(self, filepath, verdict)
+        return verdict
+
     def _header_line(self, filepath: str) -> str:
         """!
         @brief Build the per-file header line for output.
@@ -433,10 +847,13 @@ class StaticCheckBase:
         """!
                 @brief Emit one markdown output line.
                 @param line Line content to emit on stdout.
-                @details Emits `line` followed by a newline.
+                @details Emits `line` followed by a newline, or appends it to the sink list when one was supplied.
         @return {None} Function return value.
         """
-        print(line)
+        if self._sink is not None:
+            self._sink.append(line)
+        else:
+            print(line)
 
 
 # ---------------------------------------------------------------------------
@@ -456,6 +873,7 @@ class StaticCheckPylance(StaticCheckBase):
     """
 
     LABEL = "Pylance"
+    BATCHABLE = True
 
     def __init__(
         self,
@@ -464,6 +882,8 @@ class StaticCheckPylance(StaticCheckBase):
         *,
         fail_only: bool = False,
         project_base: Optional[Path] = None,
+        sink: Optional[List[str]] = None,
+        result_cache: Optional[StaticCheckResultCache] = None,
     ) -> None:
         """!
         @brief Initialize Pylance checker with runtime context.
@@ -471,13 +891,38 @@ class StaticCheckPylance(StaticCheckBase):
         @param extra_args Additional CLI arguments forwarded to pyright.
         @param fail_only When True, suppress all stdout output for passing checks.
         @param project_base Absolute project root available as runtime context.
+        @param sink Optional list collecting output lines instead of printing them.
+        @param result_cache Optional verdict cache replaying results of unchanged files.
         @return {None} Function return value.
         @details Stores runtime context for uv-first pyright invocation. No `.venv` probing is used.
         @satisfies SRS-242, SRS-339, SRS-341
         """
-        super().__init__(inputs=inputs, extra_args=extra_args, fail_only=fail_only)
+        super().__init__(inputs=inputs, extra_args=extra_args, fail_only=fail_only, sink=sink, result_cache=result_cache)
         self._project_base = project_base.resolve() if project_base is not None else None
 
+    def _command(self, paths: Sequence[str]) -> List[str]:
+        """!
+        @brief Build the pyright argv checking `paths`.
+        @param paths Absolute file paths to check.
+        @return `[sys.executable, '-m', 'pyright', '--pythonpath', sys.executable, <paths>..., <extra_args>...]`.
+        """
+        return [
+            sys.executable,
+            "-m",
+            "pyright",
+            "--pythonpath",
+            sys.executable,
+            *paths,
+            *self._extra_args,
+        ]
+
+    def _tool_identity(self) -> Optional[str]:
+        """!
+        @brief Identify the interpreter and installed pyright version.
+        @return Tool identity string, or None when the interpreter cannot be stat-ed.
+        """
+        return _python_tool_identity("pyright")
+
     def _check_file(self, filepath: str) -> int:
         """!
         @brief Run pyright on `filepath` via `sys.executable -m pyright` and emit OK or FAIL with evidence.
@@ -494,29 +939,16 @@ class StaticCheckPylance(StaticCheckBase):
         @exception ReqError Not raised; subprocess errors are surfaced as FAIL evidence.
         @satisfies SRS-242, SRS-339, SRS-341
         """
-        cmd = [
-            sys.executable,
-            "-m",
-            "pyright",
-            "--pythonpath",
-            sys.executable,
-            filepath,
-            *self._extra_args,
-        ]
-        try:
-            result = subprocess.run(
-                cmd,
-                capture_output=True,
-                text=True,
-            )
-        except FileNotFoundError:
+        verdict = self._tool_verdict(filepath)
+        if verdict is None:
             self._emit_line(self._header_line(filepath))
             self._emit_line("Result: FAIL")
             self._emit_line("Evidence:")
             self._emit_line("  pyright module not available via sys.executable")
             return 1
 
-        if result.returncode == 0:
+        returncode, evidence = verdict
+        if returncode == 0:
             if not self._fail_only:
                 self._emit_line(self._header_line(filepath))
                 self._emit_line("Result: OK")
@@ -525,8 +957,7 @@ class StaticCheckPylance(StaticCheckBase):
             self._emit_line(self._header_line(filepath))
             self._emit_line("Result: FAIL")
             self._emit_line("Evidence:")
-            evidence = (result.stdout or "") + (result.stderr or "")
-            self._emit_line(evidence.rstrip())
+            self._emit_line(evidence)
             return 1
 
 
@@ -547,6 +978,22 @@ class StaticCheckRuff(StaticCheckBase):
     """
 
     LABEL = "Ruff"
+    BATCHABLE = True
+
+    def _command(self, paths: Sequence[str]) -> List[str]:
+        """!
+        @brief Build the ruff argv checking `paths`.
+        @param paths Absolute file paths to check.
+        @return `[sys.executable, '-m', 'ruff', 'check', <paths>..., <extra_args>...]`.
+        """
+        return [sys.executable, "-m", "ruff", "check", *paths] + self._extra_args
+
+    def _tool_identity(self) -> Optional[str]:
+        """!
+        @brief Identify the interpreter and installed ruff version.
+        @return Tool identity string, or None when the interpreter cannot be stat-ed.
+        """
+        return _python_tool_identity("ruff")
 
     def _check_file(self, filepath: str) -> int:
         """!
@@ -562,21 +1009,16 @@ class StaticCheckRuff(StaticCheckBase):
         @exception ReqError Not raised; subprocess errors are surfaced as FAIL evidence.
         @satisfies SRS-243, SRS-339
         """
-        cmd = [sys.executable, "-m", "ruff", "check", filepath] + self._extra_args
-        try:
-            result = subprocess.run(
-                cmd,
-                capture_output=True,
-                text=True,
-            )
-        except FileNotFoundError:
+        verdict = self._tool_verdict(filepath)
+        if verdict is None:
             self._emit_line(self._header_line(filepath))
             self._emit_line("Result: FAIL")
             self._emit_line("Evidence:")
             self._emit_line("  ruff module not available via sys.executable")
             return 1
 
-        if result.returncode == 0:
+        returncode, evidence = verdict
+        if returncode == 0:
             if not self._fail_only:
                 self._emit_line(self._header_line(filepath))
                 self._emit_line("Result: OK")
@@ -585,8 +1027,7 @@ class StaticCheckRuff(StaticCheckBase):
             self._emit_line(self._header_line(filepath))
             self._emit_line("Result: FAIL")
             self._emit_line("Evidence:")
-            evidence = (result.stdout or "") + (result.stderr or "")
-            self._emit_line(evidence.rstrip())
+            self._emit_line(evidence)
             return 1
 
 
@@ -612,6 +1053,8 @@ class StaticCheckCommand(StaticCheckBase):
         extra_args: Optional[Sequence[str]] = None,
         *,
         fail_only: bool = False,
+        sink: Optional[List[str]] = None,
+        result_cache: Optional[StaticCheckResultCache] = None,
     ) -> None:
         """!
                 @brief Initialize the command checker and verify tool availability.
@@ -619,9 +1062,12 @@ class StaticCheckCommand(StaticCheckBase):
                 @param inputs Raw path/pattern/directory entries from CLI.
                 @param extra_args Additional CLI arguments forwarded to the external command.
                 @param fail_only When True, suppress all stdout output for passing checks (SRS-244).
+                @param sink Optional list collecting output lines instead of printing them.
+                @param result_cache Optional verdict cache replaying results of unchanged files.
                 @throws ReqError If `cmd` is not found on PATH (exit code 1).
                 @details Calls `shutil.which(cmd)` before delegating to the parent constructor.
-                  Sets `LABEL` dynamically to `Command[<cmd>]`.
+                  Sets `LABEL` dynamically to `Command[<cmd>]`; enables batching when the command basename is in
+                  `BATCH_COMMANDS`.
         @return {None} Function return value.
         """
         if not shutil.which(cmd):
@@ -630,7 +1076,23 @@ class StaticCheckCommand(StaticCheckBase):
             )
         self._cmd = cmd
         self.LABEL = f"Command[{cmd}]"
-        super().__init__(inputs=inputs, extra_args=extra_args, fail_only=fail_only)
+        self.BATCHABLE = Path(cmd).name in BATCH_COMMANDS
+        super().__init__(inputs=inputs, extra_args=extra_args, fail_only=fail_only, sink=sink, result_cache=result_cache)
+
+    def _command(self, paths: Sequence[str]) -> List[str]:
+        """!
+        @brief Build the external command argv checking `paths`.
+        @param paths Absolute file paths to check.
+        @return `[<cmd>, <extra_args>..., <paths>...]`.
+        """
+        return [self._cmd] + self._extra_args + list(paths)
+
+    def _tool_identity(self) -> Optional[str]:
+        """!
+        @brief Identify the executable `cmd` resolves to on PATH.
+        @return Resolved path, size, and modification time of the executable, or None when it cannot be found.
+        """
+        return _executable_identity(shutil.which(self._cmd))
 
     def _check_file(self, filepath: str) -> int:
         """!
@@ -644,21 +1106,16 @@ class StaticCheckCommand(StaticCheckBase):
           When `fail_only` is True: on pass produces no output; on fail emits header, FAIL, evidence (SRS-244).
         @satisfies SRS-244, SRS-253, SRS-256
         """
-        cmd = [self._cmd] + self._extra_args + [filepath]
-        try:
-            result = subprocess.run(
-                cmd,
-                capture_output=True,
-                text=True,
-            )
-        except FileNotFoundError:
+        verdict = self._tool_verdict(filepath)
+        if verdict is None:
             self._emit_line(self._header_line(filepath))
             self._emit_line("Result: FAIL")
             self._emit_line("Evidence:")
             self._emit_line(f"  command '{self._cmd}' not found on PATH")
             return 1
 
-        if result.returncode == 0:
+        returncode, evidence = verdict
+        if returncode == 0:
             if not self._fail_only:
                 self._emit_line(self._header_line(filepath))
                 self._emit_line("Result: OK")
@@ -667,8 +1124,7 @@ class StaticCheckCommand(StaticCheckBase):
             self._emit_line(self._header_line(filepath))
             self._emit_line("Result: FAIL")
             self._emit_line("Evidence:")
-            evidence = (result.stdout or "") + (result.stderr or "")
-            self._emit_line(evidence.rstrip())
+            self._emit_line(evidence)
             return 1
 
 
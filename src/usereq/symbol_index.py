@@ -0,0 +1,260 @@
+"""!
+@file symbol_index.py
+@brief Persistent per-project symbol index answering `--find` / `--files-find` queries.
+@details Stores, per indexed file, the stat signature, language, file-level Doxygen fields, and one compact `SymbolRecord` per analyzed element (name, type label,
+line range, parent, signature, visibility, inheritance clause, aggregate Doxygen fields) in the fingerprint namespace of the `.req/cache` analysis cache,
+together with a name-sorted table over all records. Queries re-analyze only files whose stat signature changed; patterns anchored with a literal prefix (`^name...`) bisect the sorted table instead of
+scanning every record.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import os
+import pickle
+import time
+from bisect import bisect_left
+from functools import partial
+from typing import NamedTuple, Optional
+
+from . import profiling
+from .analysis_cache import RACY_WINDOW_NS, AnalysisCache, _atomic_write_bytes, load_analysis
+
+SYMBOL_INDEX_FORMAT_VERSION = 3
+"""! @brief Symbol index payload layout version."""
+
+SYMBOL_INDEX_FILE_NAME = "symbols.pickle"
+"""! @brief Symbol index file name below the cache fingerprint namespace."""
+
+_PREFIX_ESCAPABLE = frozenset(".^$*+?{}[]()|\\/-#&~ ")
+"""! @brief Characters whose backslash escape denotes the literal character itself."""
+
+
+class SymbolRecord(NamedTuple):
+    """! @brief Indexed summary of one analyzed element.
+    @details Exposes the attributes read by `ConstructMatcher.matches()` and `format_construct()`, so records render exactly like the enriched elements they summarize.
+    `doxygen_fields` holds the aggregate construct fields (element fields plus leading body-comment fields); `visibility` and `inherits` feed the
+    `--format jsonl` construct records.
+    """
+
+    name: Optional[str]
+    type_label: str
+    line_start: int
+    line_end: int
+    parent_name: Optional[str]
+    signature: Optional[str]
+    doxygen_fields: dict
+    visibility: Optional[str] = None
+    inherits: Optional[str] = None
+
+
+class FileEntry(NamedTuple):
+    """! @brief Indexed state of one source file.
+    @details `signature` is the `(size, mtime_ns)` pair observed before analysis, or None when it was too recent to be trusted (git "racily clean" rule).
+    `names` and `type_labels` summarize `records` so queries can reject the whole file without testing each record.
+    """
+
+    signature: Optional[tuple]
+    lang: str
+    records: tuple
+    file_fields: dict
+    names: frozenset
+    type_labels: frozenset
+
+
+def literal_prefix(pattern: str) -> Optional[str]:
+    """! @brief Extract the literal text every `re.search(pattern, name)` match must start a name with.
+    @param pattern Regex pattern string.
+    @return Literal prefix when the pattern starts with `^` followed by literal characters and has no alternation; None otherwise.
+    @details Conservative recognizer: identifier characters and backslash-escaped punctuation are literals; a literal followed by `*`, `?`, or `{` is optional
+    and ends the prefix before it. Any `|` disables prefix extraction, since a top-level alternation can bypass the anchor.
+    """
+    if not pattern.startswith("^") or "|" in pattern:
+        return None
+    units: list = []
+    i = 1
+    while i < len(pattern):
+        char = pattern[i]
+        if char.isalnum() or char == "_":
+            units.append(char)
+            i += 1
+        elif char == "\\" and i + 1 < len(pattern) and pattern[i + 1] in _PREFIX_ESCAPABLE:
+            units.append(pattern[i + 1])
+            i += 2
+        else:
+            break
+    if units and i < len(pattern) and pattern[i] in "*?{":
+        units.pop()
+    return "".join(units) or None
+
+
+def _index_file(path: str, cache: Optional[AnalysisCache]) -> tuple:
+    """! @brief Analyze one file into a FileEntry.
+    @param path Absolute source file path.
+    @param cache Optional analysis cache consulted before parsing.
+    @return Tuple `(path, entry)`; `entry` is None when the file is missing, unsupported, or fails to analyze (callers then take the regular per-file path,
+    which reports the skip or failure).
+    @details Top-level picklable worker for the `parallel` pool. The stat signature is sampled before reading, so a concurrent edit leaves a stale signature
+    that forces re-analysis on the next query.
+    """
+    from .compress import detect_language
+    from .find_constructs import (
+        _extract_construct_doxygen_fields,
+        _extract_file_level_doxygen_fields,
+        _get_analyzer,
+    )
+    from .source_buffer import SourceBuffer
+
+    lang = detect_language(path)
+    if not lang:
+        return path, None
+    try:
+        st = os.stat(path)
+        source = SourceBuffer.from_path(path)
+        elements, _ = load_analysis(_get_analyzer(), path, lang, cache, source)
+    except Exception:
+        return path, None
+    signature = None
+    if time.time_ns() - st.st_mtime_ns > RACY_WINDOW_NS:
+        signature = (st.st_size, st.st_mtime_ns)
+    records = tuple(
+        SymbolRecord(
+            element.name,
+            element.type_label,
+            element.line_start,
+            element.line_end,
+            element.parent_name,
+            element.signature,
+            _extract_construct_doxygen_fields(element),
+            element.visibility,
+            element.inherits,
+        )
+        for element in elements
+    )
+    return path, FileEntry(
+        signature,
+        lang,
+        records,
+        _extract_file_level_doxygen_fields(elements),
+        frozenset(record.name for record in records if record.name),
+        frozenset(record.type_label for record in records),
+    )
+
+
+class SymbolIndex:
+    """! @brief On-disk symbol index of one project.
+    @details `files` maps absolute paths to FileEntry values; `names` is the ascending `(name, path, record_index)` table over every named record, rebuilt
+    whenever entries change. Load and save failures degrade to an empty index; the index never changes command output.
+    """
+
+    def __init__(self, cache: AnalysisCache, files: Optional[dict] = None,
+                 names: Optional[list] = None):
+        """! @brief Bind an index to the cache namespace storing it.
+        @param cache Project analysis cache owning the index file.
+        @param files Initial file entries.
+        @param names Initial sorted name table matching `files`.
+        @return {None} Function return value.
+        """
+        self.cache = cache
+        self.path = cache.namespace_dir / SYMBOL_INDEX_FILE_NAME
+        self.files: dict = files if files is not None else {}
+        self.names: Optional[list] = names
+        self._dirty = False
+
+    @classmethod
+    def for_cache(cls, cache: AnalysisCache) -> "SymbolIndex":
+        """! @brief Load the index stored in a cache namespace.
+        @param cache Project analysis cache.
+        @return Loaded index, or an empty one when missing, unreadable, or of another format version.
+        """
+        try:
+            with open(cache.namespace_dir / SYMBOL_INDEX_FILE_NAME, "rb") as handle:
+                payload = pickle.load(handle)
+            if isinstance(payload, dict) and payload.get("version") == SYMBOL_INDEX_FORMAT_VERSION:
+                return cls(cache, payload["files"], payload["names"])
+        except Exception:
+            pass
+        return cls(cache)
+
+    def refresh(self, filepaths: list, jobs: Optional[int] = 1) -> dict:
+        """! @brief Bring the entries of the requested files up to date.
+        @param filepaths Requested source paths (relative paths resolve against the working directory).
+        @param jobs Worker process count for re-analysis.
+        @return Mapping of every requested absolute path to its FileEntry, or None when the file cannot be indexed.
+        @details Files whose current `(size, mtime_ns)` equals the recorded signature are answered from the index; only the others are analyzed, on the
+        `parallel` worker pool. Missing files are dropped from the index.
+        @satisfies SRS-386
+        """
+        from .parallel import iter_ordered
+
+        entries: dict = {}
+        stale: list = []
+        for raw_path in filepaths:
+            path = os.path.abspath(raw_path)
+            if path in entries:
+                continue
+            entry = self.files.get(path)
+            try:
+                st = os.stat(path)
+            except OSError:
+                entries[path] = None
+                if self.files.pop(path, None) is not None:
+                    self._dirty = True
+                continue
+            if entry is not None and entry.signature == (st.st_size, st.st_mtime_ns):
+                entries[path] = entry
+            else:
+                entries[path] = None
+                stale.append(path)
+        profiling.count("symbol_index.reused", len(entries) - len(stale))
+        profiling.count("symbol_index.stale", len(stale))
+        for path, entry in iter_ordered(partial(_index_file, cache=self.cache), stale, jobs):
+            entries[path] = entry
+            if entry is not None:
+                self.files[path] = entry
+            else:
+                self.files.pop(path, None)
+            self._dirty = True
+        if self._dirty or self.names is None:
+            self.names = sorted(
+                (record.name, path, position)
+                for path, entry in self.files.items()
+                for position, record in enumerate(entry.records)
+                if record.name
+            )
+        return entries
+
+    def prefix_candidates(self, prefix: str) -> dict:
+        """! @brief Collect records whose name starts with a literal prefix.
+        @param prefix Non-empty literal name prefix.
+        @return Mapping of absolute path to ascending record positions.
+        @details Bisects the sorted name table, so the cost is proportional to the number of matching names rather than the index size.
+        """
+        names = self.names or []
+        found: dict = {}
+        index = bisect_left(names, (prefix,))
+        while index < len(names) and names[index][0].startswith(prefix):
+            _, path, position = names[index]
+            found.setdefault(path, []).append(position)
+            index += 1
+        for positions in found.values():
+            positions.sort()
+        return found
+
+    def save(self) -> None:
+        """! @brief Persist the index when entries changed.
+        @return {None} Function return value.
+        @details Write failures are ignored; the next query then re-analyzes from the analysis cache.
+        """
+        if not self._dirty:
+            return
+        payload = {
+            "version": SYMBOL_INDEX_FORMAT_VERSION,
+            "files": self.files,
+            "names": self.names,
+        }
+        try:
+            self.cache._ensure_root()
+            _atomic_write_bytes(self.path, pickle.dumps(payload, protocol=pickle.HIGHEST_PROTOCOL))
+        except OSError:
+            return
+        self._dirty = False
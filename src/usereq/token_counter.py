@@ -1,7 +1,9 @@
 """!
 @file token_counter.py
 @brief Token and character counting for generated output.
-@details Uses tiktoken for accurate token counting compatible with OpenAI/Claude models.
+@details Uses tiktoken for accurate token counting compatible with OpenAI/Claude models. One counter per encoding is kept per process; file lists are tokenized
+through tiktoken's multi-threaded batch encoder, files of at least `STREAM_THRESHOLD_BYTES` are tokenized in bounded chunks, and per-file counts can be persisted in
+the `.req/cache` analysis cache keyed by content digest.
 @author GitHub Copilot
 @version 0.0.70
 """
@@ -10,6 +12,18 @@ import os
 
 import tiktoken  # pyright: ignore[reportMissingImports]
 
+from . import profiling
+from .source_buffer import file_blob_digest
+
+STREAM_THRESHOLD_BYTES = 4 << 20
+"""! @brief Files at least this large are tokenized in chunks instead of as one string."""
+
+STREAM_CHUNK_CHARS = 1 << 20
+"""! @brief Characters read per chunk in streaming mode."""
+
+BATCH_MAX_CHARS = 8 << 20
+"""! @brief Upper bound on the total characters handed to one batch encoding call."""
+
 
 class TokenCounter:
     """! @brief Count tokens using tiktoken encoding (cl100k_base by default).
@@ -36,6 +50,51 @@ class TokenCounter:
         except Exception:
             return 0
 
+    def count_tokens_batch(self, contents: list, num_threads: int | None = None) -> list:
+        """! @brief Count tokens of many documents with one multi-threaded batch call.
+        @param contents Text documents.
+        @param num_threads Encoder thread count; `None` selects the CPU core count.
+        @return Token counts in input order.
+        @details Falls back to per-document `count_tokens()` when the batch call fails, so one bad document cannot zero the others.
+        """
+        if not contents:
+            return []
+        try:
+            encoded = self.encoding.encode_batch(
+                list(contents),
+                num_threads=num_threads or os.cpu_count() or 1,
+                disallowed_special=(),
+            )
+            return [len(tokens) for tokens in encoded]
+        except Exception:
+            return [self.count_tokens(content) for content in contents]
+
+    def count_stream(self, handle, chunk_chars: int = STREAM_CHUNK_CHARS) -> tuple:
+        """! @brief Count tokens and chars of a text stream in bounded chunks.
+        @param handle Text stream opened with universal newlines.
+        @param chunk_chars Characters read per chunk.
+        @return Tuple `(tokens, chars)` equal to counting the whole stream content at once.
+        @details Chunks are cut after a newline that is followed by a non-whitespace character: tiktoken's pre-tokenizer never joins text across such a
+        boundary, so chunk counts add up exactly. Peak memory is one chunk plus its token list unless a chunk has no such boundary.
+        """
+        tokens = 0
+        chars = 0
+        pending = ""
+        while True:
+            data = handle.read(chunk_chars)
+            pending += data
+            if not data:
+                break
+            cut = _chunk_boundary(pending)
+            if cut:
+                tokens += self.count_tokens(pending[:cut])
+                chars += cut
+                pending = pending[cut:]
+        if pending:
+            tokens += self.count_tokens(pending)
+            chars += len(pending)
+        return tokens, chars
+
     @staticmethod
     def count_chars(content: str) -> int:
         """!
@@ -47,6 +106,35 @@ class TokenCounter:
         return len(content)
 
 
+def _chunk_boundary(text: str) -> int:
+    """! @brief Locate the last safe chunk cut in a text.
+    @param text Accumulated chunk text.
+    @return Offset just after the last `\\n` followed by a non-whitespace character, or 0 when none exists.
+    """
+    index = text.rfind("\n", 0, len(text) - 1)
+    while index >= 0:
+        if not text[index + 1].isspace():
+            return index + 1
+        index = text.rfind("\n", 0, index)
+    return 0
+
+
+_COUNTERS: dict = {}
+"""! @brief Process-local counters keyed by encoding name, populated by `get_token_counter`."""
+
+
+def get_token_counter(encoding_name: str = "cl100k_base") -> TokenCounter:
+    """! @brief Return the process-wide counter of an encoding.
+    @param encoding_name Name of tiktoken encoding used for tokenization.
+    @return Shared TokenCounter; the encoding tables are loaded once per process.
+    @satisfies SRS-388
+    """
+    counter = _COUNTERS.get(encoding_name)
+    if counter is None:
+        counter = _COUNTERS[encoding_name] = TokenCounter(encoding_name)
+    return counter
+
+
 def count_file_metrics(content: str,
                        encoding_name: str = "cl100k_base") -> dict:
     """!
@@ -54,9 +142,9 @@ def count_file_metrics(content: str,
         @param content The text content to measure.
         @param encoding_name The tiktoken encoding name (default: "cl100k_base").
         @return Dictionary with keys 'tokens' (int) and 'chars' (int).
-    @details Implements the count_file_metrics function behavior with deterministic control flow.
+    @details Uses the process-wide counter returned by `get_token_counter()`.
     """
-    counter = TokenCounter(encoding_name)
+    counter = get_token_counter(encoding_name)
     return {
         "tokens": counter.count_tokens(content),
         "chars": TokenCounter.count_chars(content),
@@ -64,31 +152,78 @@ def count_file_metrics(content: str,
 
 
 def count_files_metrics(file_paths: list,
-                        encoding_name: str = "cl100k_base") -> list:
+                        encoding_name: str = "cl100k_base",
+                        cache=None) -> list:
     """! @brief Count tokens and chars for a list of files.
     @param file_paths List of file paths to process.
     @param encoding_name The tiktoken encoding name.
+    @param cache Optional `AnalysisCache` persisting per-file counts by content digest.
     @return List of dictionaries, each containing 'file', 'tokens', 'chars', and optionally 'error'.
-    @details Iterates through files, reading content and counting metrics. Gracefully handles read errors.
+    @details Cached counts are reused without reading or tokenizing the file (stat-first digest lookup for regular files, streamed digest for large ones).
+    Remaining files below `STREAM_THRESHOLD_BYTES` are tokenized together through `TokenCounter.count_tokens_batch()` in groups of at most `BATCH_MAX_CHARS`
+    characters; larger files are tokenized with `TokenCounter.count_stream()`. Read errors are reported per file.
+    @satisfies SRS-388
     """
-    counter = TokenCounter(encoding_name)
-    results = []
-    for path in file_paths:
+    from .source_buffer import SourceBuffer
+
+    counter = get_token_counter(encoding_name)
+    kind = f"tokens.{encoding_name}"
+    results: list = [None] * len(file_paths)
+    batch: list = []
+    batch_chars = 0
+
+    def _record(index: int, path: str, digest, tokens: int, chars: int) -> None:
+        results[index] = {"file": path, "tokens": tokens, "chars": chars}
+        if cache is not None and digest is not None:
+            cache.store(digest, kind, (tokens, chars))
+
+    def _flush() -> None:
+        if not batch:
+            return
+        with profiling.span("tokenize"):
+            counts = counter.count_tokens_batch([text for _, _, _, text in batch])
+        for (index, path, digest, text), tokens in zip(batch, counts):
+            _record(index, path, digest, tokens, len(text))
+        batch.clear()
+
+    for index, path in enumerate(file_paths):
         try:
-            with open(path, "r", encoding="utf-8", errors="replace") as f:
-                content = f.read()
-            results.append({
-                "file": path,
-                "tokens": counter.count_tokens(content),
-                "chars": counter.count_chars(content),
-            })
+            size = os.stat(path).st_size
+            digest = None
+            source = None
+            if size >= STREAM_THRESHOLD_BYTES:
+                if cache is not None:
+                    digest = file_blob_digest(path, size)
+                    cached = cache.load(digest, kind)
+                    if cached is not None:
+                        results[index] = {"file": path, "tokens": cached[0], "chars": cached[1]}
+                        continue
+                with profiling.span("tokenize"), open(path, "r", encoding="utf-8", errors="replace") as f:
+                    tokens, chars = counter.count_stream(f)
+                _record(index, path, digest, tokens, chars)
+                continue
+            if cache is not None:
+                digest, source = cache.resolve(path)
+                cached = cache.load(digest, kind) if digest is not None else None
+                if cached is not None:
+                    results[index] = {"file": path, "tokens": cached[0], "chars": cached[1]}
+                    continue
+            if source is None:
+                source = SourceBuffer.from_path(path)
         except Exception as e:
-            results.append({
+            results[index] = {
                 "file": path,
                 "tokens": 0,
                 "chars": 0,
                 "error": str(e),
-            })
+            }
+            continue
+        if batch and batch_chars + len(source.text) > BATCH_MAX_CHARS:
+            _flush()
+            batch_chars = 0
+        batch.append((index, path, digest, source.text))
+        batch_chars += len(source.text)
+    _flush()
     return results
 
 
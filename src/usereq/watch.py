@@ -0,0 +1,260 @@
+"""!
+@file watch.py
+@brief Change watchers and the debounced refresh loop behind `--watch`.
+@details `InotifyWatcher` subscribes to Linux inotify events through `ctypes` for every directory below the watched roots; `PollingWatcher` compares
+`(size, mtime_ns)` snapshots and is used on other platforms or when inotify is unavailable or out of watches. Both report changed paths; a directory path
+stands for "anything below it changed" (new directories, queue overflow). `watch_loop()` collects changes until the tree has been quiet for the debounce
+delay and hands each batch to a refresh callback.
+@author GitHub Copilot
+@version 0.0.70
+"""
+
+import ctypes
+import ctypes.util
+import os
+import select
+import struct
+import sys
+import time
+from typing import Callable, Optional
+
+DEBOUNCE_SECONDS = 0.2
+"""! @brief Quiet time that closes a batch of changes."""
+
+MAX_BATCH_SECONDS = 2.0
+"""! @brief Upper bound on the time a batch keeps collecting changes under continuous writes."""
+
+POLL_INTERVAL_SECONDS = 1.0
+"""! @brief Snapshot interval of `PollingWatcher`."""
+
+IGNORED_DIR_NAMES = frozenset({".git", ".req", "__pycache__"})
+"""! @brief Directory names never watched or scanned."""
+
+_IN_MODIFY = 0x002
+_IN_ATTRIB = 0x004
+_IN_CLOSE_WRITE = 0x008
+_IN_MOVED_FROM = 0x040
+_IN_MOVED_TO = 0x080
+_IN_CREATE = 0x100
+_IN_DELETE = 0x200
+_IN_DELETE_SELF = 0x400
+_IN_Q_OVERFLOW = 0x4000
+_IN_IGNORED = 0x8000
+_IN_ONLYDIR = 0x01000000
+_IN_ISDIR = 0x40000000
+_WATCH_MASK = (_IN_MODIFY | _IN_ATTRIB | _IN_CLOSE_WRITE | _IN_MOVED_FROM | _IN_MOVED_TO | _IN_CREATE | _IN_DELETE | _IN_DELETE_SELF
+               | _IN_ONLYDIR)
+_EVENT_HEADER = struct.Struct("iIII")
+
+
+def _walk_dirs(root: str):
+    """! @brief Yield `root` and every directory below it, skipping `IGNORED_DIR_NAMES`.
+    @param root Directory to walk.
+    @return Iterator of directory paths.
+    """
+    for dirpath, dirnames, _ in os.walk(root):
+        dirnames[:] = [name for name in dirnames if name not in IGNORED_DIR_NAMES]
+        yield dirpath
+
+
+class PollingWatcher:
+    """! @brief Portable watcher comparing stat snapshots of every file below the roots."""
+
+    def __init__(self, roots: list, interval: float = POLL_INTERVAL_SECONDS):
+        """! @brief Take the initial snapshot.
+        @param roots Directories to watch.
+        @param interval Seconds between snapshots.
+        @return {None} Function return value.
+        """
+        self.roots = [os.path.abspath(root) for root in roots]
+        self.interval = interval
+        self._snapshot = self._scan()
+
+    def _scan(self) -> dict:
+        """! @brief Stat every file below the roots.
+        @return Mapping of file path to `(size, mtime_ns)`.
+        """
+        snapshot = {}
+        for root in self.roots:
+            for dirpath in _walk_dirs(root):
+                try:
+                    entries = list(os.scandir(dirpath))
+                except OSError:
+                    continue
+                for entry in entries:
+                    try:
+                        if entry.is_file():
+                            st = entry.stat()
+                            snapshot[entry.path] = (st.st_size, st.st_mtime_ns)
+                    except OSError:
+                        continue
+        return snapshot
+
+    def wait(self, timeout: Optional[float]) -> set:
+        """! @brief Block until files change or the timeout expires.
+        @param timeout Seconds to wait, or None to wait indefinitely.
+        @return Paths created, deleted, or modified since the previous call; empty on timeout.
+        """
+        deadline = None if timeout is None else time.monotonic() + timeout
+        while True:
+            delay = self.interval if deadline is None else max(0.0, min(self.interval, deadline - time.monotonic()))
+            time.sleep(delay)
+            current = self._scan()
+            changed = {path for path in current.keys() | self._snapshot.keys() if current.get(path) != self._snapshot.get(path)}
+            self._snapshot = current
+            if changed or (deadline is not None and time.monotonic() >= deadline):
+                return changed
+
+    def close(self) -> None:
+        """! @brief Release watcher resources.
+        @return {None} Function return value.
+        """
+
+
+class InotifyWatcher:
+    """! @brief Linux watcher reading inotify events for every directory below the roots."""
+
+    def __init__(self, roots: list):
+        """! @brief Create the inotify instance and watch every directory.
+        @param roots Directories to watch.
+        @return {None} Function return value.
+        @throws OSError If inotify is unavailable or the watch limit is reached.
+        """
+        library = ctypes.util.find_library("c")
+        self._libc = ctypes.CDLL(library, use_errno=True)
+        self._fd = self._libc.inotify_init1(os.O_NONBLOCK | os.O_CLOEXEC)
+        if self._fd < 0:
+            errno = ctypes.get_errno()
+            raise OSError(errno, os.strerror(errno))
+        self._dirs: dict = {}
+        try:
+            for root in roots:
+                self._watch_tree(os.path.abspath(root))
+        except OSError:
+            self.close()
+            raise
+
+    def _watch_tree(self, root: str) -> None:
+        """! @brief Add watches for a directory and its subdirectories.
+        @param root Directory path.
+        @return {None} Function return value.
+        @throws OSError If a watch cannot be added for a reason other than the directory having disappeared.
+        """
+        for dirpath in _walk_dirs(root):
+            descriptor = self._libc.inotify_add_watch(self._fd, os.fsencode(dirpath), _WATCH_MASK)
+            if descriptor < 0:
+                errno = ctypes.get_errno()
+                if errno in (2, 20):  # ENOENT, ENOTDIR: removed while walking
+                    continue
+                raise OSError(errno, os.strerror(errno))
+            self._dirs[descriptor] = dirpath
+
+    def _read_events(self) -> set:
+        """! @brief Drain pending events.
+        @return Changed paths; new directories are watched and reported as directory paths.
+        """
+        changed: set = set()
+        while True:
+            try:
+                data = os.read(self._fd, 1 << 16)
+            except BlockingIOError:
+                return changed
+            offset = 0
+            while offset + _EVENT_HEADER.size <= len(data):
+                descriptor, mask, _, length = _EVENT_HEADER.unpack_from(data, offset)
+                raw_name = data[offset + _EVENT_HEADER.size:offset + _EVENT_HEADER.size + length].rstrip(b"\0")
+                offset += _EVENT_HEADER.size + length
+                directory = self._dirs.get(descriptor)
+                if mask & _IN_Q_OVERFLOW:
+                    changed.update(self._dirs.values())
+                    continue
+                if mask & _IN_IGNORED:
+                    self._dirs.pop(descriptor, None)
+                    continue
+                if directory is None:
+                    continue
+                path = os.path.join(directory, os.fsdecode(raw_name)) if raw_name else directory
+                if raw_name and os.fsdecode(raw_name) in IGNORED_DIR_NAMES:
+                    continue
+                changed.add(path)
+                if mask & _IN_ISDIR and mask & (_IN_CREATE | _IN_MOVED_TO):
+                    try:
+                        self._watch_tree(path)
+                    except OSError:
+                        pass
+
+    def wait(self, timeout: Optional[float]) -> set:
+        """! @brief Block until events arrive or the timeout expires.
+        @param timeout Seconds to wait, or None to wait indefinitely.
+        @return Changed paths; empty on timeout.
+        """
+        ready, _, _ = select.select([self._fd], [], [], timeout)
+        if not ready:
+            return set()
+        return self._read_events()
+
+    def close(self) -> None:
+        """! @brief Close the inotify descriptor.
+        @return {None} Function return value.
+        """
+        if self._fd >= 0:
+            os.close(self._fd)
+            self._fd = -1
+
+
+def create_watcher(roots: list, poll_interval: float = POLL_INTERVAL_SECONDS):
+    """! @brief Create the best available watcher.
+    @param roots Directories to watch.
+    @param poll_interval Snapshot interval of the polling fallback.
+    @return `InotifyWatcher` on Linux when inotify can watch every directory, else `PollingWatcher`.
+    """
+    if sys.platform.startswith("linux"):
+        try:
+            return InotifyWatcher(roots)
+        except (OSError, AttributeError):
+            pass
+    return PollingWatcher(roots, poll_interval)
+
+
+def collect_batch(watcher, debounce: float = DEBOUNCE_SECONDS, max_wait: float = MAX_BATCH_SECONDS,
+                  timeout: Optional[float] = None) -> set:
+    """! @brief Wait for a change and keep collecting until the tree is quiet.
+    @param watcher Watcher returned by `create_watcher()`.
+    @param debounce Quiet time that closes the batch.
+    @param max_wait Maximum time spent collecting after the first change.
+    @param timeout Seconds to wait for the first change, or None to wait indefinitely.
+    @return Changed paths; empty when `timeout` expired without changes.
+    """
+    changed = set(watcher.wait(timeout))
+    if not changed:
+        return changed
+    deadline = time.monotonic() + max_wait
+    while True:
+        remaining = deadline - time.monotonic()
+        if remaining <= 0:
+            return changed
+        more = watcher.wait(min(debounce, remaining))
+        if not more:
+            return changed
+        changed |= more
+
+
+def watch_loop(watcher, refresh: Callable[[set], None], debounce: float = DEBOUNCE_SECONDS,
+               max_batches: Optional[int] = None, timeout: Optional[float] = None) -> int:
+    """! @brief Hand debounced change batches to a refresh callback until interrupted.
+    @param watcher Watcher returned by `create_watcher()`.
+    @param refresh Callback receiving each batch of changed paths.
+    @param debounce Quiet time that closes a batch.
+    @param max_batches Stop after this many batches (None: run until interrupted).
+    @param timeout Stop when no change arrives for this many seconds (None: wait indefinitely).
+    @return Number of batches processed.
+    @satisfies SRS-394
+    """
+    batches = 0
+    while max_batches is None or batches < max_batches:
+        changed = collect_batch(watcher, debounce, timeout=timeout)
+        if not changed:
+            break
+        refresh(changed)
+        batches += 1
+    return batches
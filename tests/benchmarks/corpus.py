@@ -0,0 +1,104 @@
+"""Synthetic benchmark corpora built from the `tests/fixtures/fixture_*.*` files.
+
+Every corpus is deterministic for a given size, so timings are comparable across runs and against the stored baseline.
+"""
+
+from pathlib import Path
+
+FIXTURES_DIR = Path(__file__).resolve().parents[1] / "fixtures"
+"""Directory holding the per-language fixture files."""
+
+SIZES = {"1k": 1_000, "10k": 10_000, "100k": 100_000}
+"""Named corpus sizes in source lines."""
+
+DEFAULT_SIZES = ("1k", "10k")
+"""Sizes run when none are requested (100k is opt-in)."""
+
+
+def replicate_fixture(fixture: Path, target_lines: int) -> str:
+    """Concatenate copies of one fixture until it reaches at least `target_lines` lines.
+
+    Fixtures are self-contained translation units, so verbatim copies keep every block balanced.
+    """
+    text = fixture.read_text(encoding="utf-8")
+    if not text.endswith("\n"):
+        text += "\n"
+    lines_per_copy = text.count("\n")
+    copies = max(1, -(-target_lines // lines_per_copy))
+    return text * copies
+
+
+def deep_namespaces_cpp(target_lines: int, depth: int = 24) -> str:
+    """Generate C++ with `depth` nested namespaces, each holding classes and free functions, repeated to `target_lines`."""
+    parts = ["#include <string>\n"]
+    lines = 1
+    block = 0
+    while lines < target_lines:
+        for level in range(depth):
+            parts.append(f"{'  ' * level}namespace n{block}_{level} {{\n")
+        indent = "  " * depth
+        for index in range(4):
+            parts.append(
+                f"{indent}/** @brief Widget {index} of block {block}. */\n"
+                f"{indent}class Widget{index} {{\n"
+                f"{indent} public:\n"
+                f"{indent}  int value(int x) const {{ return x + {index}; }}\n"
+                f"{indent}  std::string name() const {{ return \"w{index}\"; }}\n"
+                f"{indent}}};\n"
+                f"{indent}int helper_{block}_{index}(int a, int b) {{\n"
+                f"{indent}  if (a > b) {{ return a; }}\n"
+                f"{indent}  return b;\n"
+                f"{indent}}}\n"
+            )
+        for level in reversed(range(depth)):
+            parts.append(f"{'  ' * level}}}  // namespace n{block}_{level}\n")
+        lines += 2 * depth + 40
+        block += 1
+    return "".join(parts)
+
+
+def long_lines_python(target_lines: int, width: int = 4_000) -> str:
+    """Generate Python whose every fourth line is a `width`-character expression with strings and comment markers."""
+    parts = []
+    lines = 0
+    index = 0
+    while lines < target_lines:
+        items = ", ".join(f"'k{n}#//' + \"v{n}\"" for n in range(width // 22))
+        parts.append(
+            f"def build_{index}(value):\n"
+            f'    """! @brief Build table {index}."""\n'
+            f"    table = [{items}]  # trailing comment\n"
+            f"    return table[value]\n"
+        )
+        lines += 4
+        index += 1
+    return "".join(parts)
+
+
+def build_corpus(root: Path, size: str) -> list:
+    """Write the corpus of one size below `root`.
+
+    Returns `(case, path, language)` tuples: one replicated file per fixture language plus the deep-namespace C++ and long-line Python cases.
+    """
+    from usereq.compress import detect_language
+
+    target = SIZES[size]
+    directory = Path(root) / size
+    directory.mkdir(parents=True, exist_ok=True)
+    cases = []
+    for fixture in sorted(FIXTURES_DIR.glob("fixture_*.*")):
+        language = detect_language(str(fixture))
+        if not language:
+            continue
+        path = directory / fixture.name
+        path.write_text(replicate_fixture(fixture, target), encoding="utf-8")
+        cases.append((f"{fixture.stem.removeprefix('fixture_')}", path, language))
+    generated = (
+        ("cpp_deep_namespaces", "deep_namespaces.cpp", deep_namespaces_cpp(target), "cpp"),
+        ("python_long_lines", "long_lines.py", long_lines_python(target), "python"),
+    )
+    for case, name, text, language in generated:
+        path = directory / name
+        path.write_text(text, encoding="utf-8")
+        cases.append((case, path, language))
+    return cases
@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+"""Throughput benchmarks for the analyzer, compressor, and construct finder.
+
+Builds synthetic corpora from the fixtures (see `corpus.py`), times `analyze`, `enrich`, `format_markdown`, `compress_source`, and
+`find_constructs_in_files` per file, times `generate_markdown` and `find_constructs_in_files` over each whole corpus, and compares lines/sec against a stored
+baseline. Every case runs in a fresh spawned process so its peak RSS is isolated. With `--startup`, measures CLI cold start instead (see `startup.py`) against
+the `startup` section of the same baseline.
+
+Usage: `python tests/benchmarks/run_benchmarks.py [--sizes 1k,10k] [--cases cpp,python] [--repeat 3] [--startup] [--update-baseline]`
+
+Not collected by pytest (no `test_` prefix); `scripts/benchmark.sh` runs it through `uv`.
+"""
+
+import argparse
+import json
+import multiprocessing
+import resource
+import sys
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parents[2] / "src"))
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+
+import startup  # noqa: E402
+from corpus import DEFAULT_SIZES, SIZES, build_corpus  # noqa: E402
+
+BASELINE_PATH = Path(__file__).resolve().parent / "baseline.json"
+"""Stored reference throughput, keyed by size, case, and phase."""
+
+WORK_DIR = Path(__file__).resolve().parents[2] / "temp" / "benchmarks"
+"""Directory receiving generated corpora."""
+
+FILE_PHASES = ("analyze", "enrich", "format_markdown", "compress_source", "find_constructs")
+"""Per-file phases, in pipeline order."""
+
+CORPUS_PHASES = ("generate_markdown", "find_constructs")
+"""Whole-corpus phases reported as files/sec."""
+
+MIN_ROUND_SECONDS = 0.05
+"""Minimum duration of one timing round."""
+
+
+def _best_of(repeat: int, func, setup=None) -> float:
+    """Return the fastest per-call wall time over `repeat` rounds.
+
+    Each round loops enough calls to last about `MIN_ROUND_SECONDS`, so millisecond phases of the small corpora are not dominated by timer noise. When `setup`
+    is given, each call receives a fresh `setup()` result and only `func` is timed.
+    """
+
+    def _one() -> float:
+        argument = setup() if setup is not None else None
+        start = time.perf_counter()
+        func() if setup is None else func(argument)
+        return time.perf_counter() - start
+
+    first = _one()
+    number = max(1, int(MIN_ROUND_SECONDS / first)) if first > 0 else 1
+    best = first
+    for _ in range(repeat):
+        best = min(best, sum(_one() for _ in range(number)) / number)
+    return best
+
+
+def _peak_rss_mib() -> float:
+    """Return the peak resident set size of the current process in MiB."""
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return peak / (1024 * 1024) if sys.platform == "darwin" else peak / 1024
+
+
+def _find_quietly(paths: list) -> None:
+    """Run the construct finder, treating "no constructs found" as a result."""
+    from usereq.find_constructs import find_constructs_in_files
+
+    try:
+        find_constructs_in_files(paths, "CLASS|FUNCTION|STRUCT|MODULE|NAMESPACE", ".*")
+    except ValueError:
+        pass
+
+
+def run_file_case(path: str, language: str, repeat: int) -> dict:
+    """Time every per-file phase of one corpus file (executed in a spawned worker)."""
+    from usereq.compress import compress_source
+    from usereq.source_analyzer import SourceAnalyzer, format_markdown
+    from usereq.source_buffer import SourceBuffer
+
+    source = SourceBuffer.from_path(path)
+    analyzer = SourceAnalyzer()
+    spec = analyzer.specs[language]
+    timings = {}
+    timings["analyze"] = _best_of(repeat, lambda: analyzer.analyze(path, language, source=source))
+    timings["enrich"] = _best_of(
+        repeat,
+        lambda elements: analyzer.enrich(elements, language, filepath=path, source=source),
+        setup=lambda: analyzer.analyze(path, language, source=source),
+    )
+    elements = analyzer.enrich(analyzer.analyze(path, language, source=source), language, filepath=path, source=source)
+    timings["format_markdown"] = _best_of(
+        repeat,
+        lambda: format_markdown(elements, path, language, spec.name, source.line_count,
+                                include_legacy_annotations=False, source=source),
+    )
+    timings["compress_source"] = _best_of(repeat, lambda: compress_source(source, language))
+    timings["find_constructs"] = _best_of(repeat, lambda: _find_quietly([path]))
+    return {
+        "lines": source.line_count,
+        "seconds": timings,
+        "peak_rss_mib": _peak_rss_mib(),
+    }
+
+
+def run_corpus_case(paths: list, repeat: int) -> dict:
+    """Time the whole-corpus phases (executed in a spawned worker)."""
+    from usereq.generate_markdown import generate_markdown
+
+    lines = sum(Path(path).read_text(encoding="utf-8").count("\n") for path in paths)
+    timings = {
+        "generate_markdown": _best_of(repeat, lambda: generate_markdown(paths, jobs=1)),
+        "find_constructs": _best_of(repeat, lambda: _find_quietly(paths)),
+    }
+    return {"lines": lines, "files": len(paths), "seconds": timings, "peak_rss_mib": _peak_rss_mib()}
+
+
+def _isolated(func, *args) -> dict:
+    """Run one case in a fresh spawned process."""
+    context = multiprocessing.get_context("spawn")
+    with context.Pool(1) as pool:
+        return pool.apply(func, args)
+
+
+def run(sizes: list, cases: list | None, repeat: int) -> dict:
+    """Build the requested corpora and collect results keyed by size and case."""
+    results: dict = {}
+    for size in sizes:
+        corpus = build_corpus(WORK_DIR, size)
+        selected = [entry for entry in corpus if not cases or entry[0] in cases]
+        size_results = {}
+        for case, path, language in selected:
+            size_results[case] = _isolated(run_file_case, str(path), language, repeat)
+            print(f"  {size:>4} {case:<22} done", file=sys.stderr)
+        corpus_case = "all_files" if not cases else "all_files:" + "+".join(sorted(cases))
+        size_results[corpus_case] = _isolated(run_corpus_case, [str(entry[1]) for entry in selected], repeat)
+        results[size] = size_results
+    return results
+
+
+def throughput(result: dict) -> dict:
+    """Convert phase timings to lines/sec."""
+    rates = {}
+    for phase, seconds in result["seconds"].items():
+        rates[phase] = result["lines"] / seconds if seconds > 0 else float("inf")
+    return rates
+
+
+def compare(results: dict, baseline: dict, tolerance: float) -> list:
+    """List `(size, case, phase, ratio)` for phases slower than `1 - tolerance` times the baseline."""
+    regressions = []
+    for size, cases in results.items():
+        for case, result in cases.items():
+            reference = baseline.get(size, {}).get(case, {})
+            for phase, rate in throughput(result).items():
+                expected = reference.get(phase)
+                if expected:
+                    ratio = rate / expected
+                    if ratio < 1 - tolerance:
+                        regressions.append((size, case, phase, ratio))
+    return regressions
+
+
+def format_report(results: dict, baseline: dict) -> str:
+    """Render a plain-text table of throughput, baseline ratio, and peak RSS."""
+    rows = []
+    for size, cases in results.items():
+        for case, result in cases.items():
+            rates = throughput(result)
+            reference = baseline.get(size, {}).get(case, {})
+            phases = CORPUS_PHASES if "files" in result else FILE_PHASES
+            cells = []
+            for phase in phases:
+                cell = f"{phase}={rates[phase]:,.0f} l/s"
+                if "files" in result:
+                    cell += f" {result['files'] / result['seconds'][phase]:,.1f} f/s"
+                if reference.get(phase):
+                    cell += f" ({rates[phase] / reference[phase]:.2f}x)"
+                cells.append(cell)
+            rows.append(
+                f"{size:>4} {case:<22} {result['lines']:>8} lines  rss={result['peak_rss_mib']:.0f}MiB  " + "  ".join(cells)
+            )
+    return "\n".join(rows)
+
+
+def run_startup(args, commands: list | None, baseline: dict, baseline_path: Path) -> int:
+    """Run the cold-start benchmark and compare or update the `startup` baseline section."""
+    unknown = [name for name in commands or () if name not in startup.STARTUP_COMMANDS]
+    if unknown:
+        raise SystemExit(f"unknown startup commands: {', '.join(unknown)}")
+    results = startup.run(commands, max(1, args.repeat))
+    reference = baseline.get("startup", {})
+    print(startup.format_report(results, reference))
+    if args.json:
+        Path(args.json).write_text(json.dumps({"startup": results}, indent=2) + "\n", encoding="utf-8")
+    if args.update_baseline:
+        updated = dict(baseline)
+        updated.setdefault("startup", {}).update({
+            name: {metric: round(value, 1) for metric, value in metrics.items()} for name, metrics in results.items()
+        })
+        baseline_path.write_text(json.dumps(updated, indent=2, sort_keys=True) + "\n", encoding="utf-8")
+        return 0
+    regressions = startup.compare(results, reference, args.tolerance)
+    for name, metric, ratio in regressions:
+        print(f"REGRESSION startup {name} {metric}: {ratio:.2f}x baseline", file=sys.stderr)
+    return 1 if regressions and args.fail_on_regression else 0
+
+
+def main(argv: list | None = None) -> int:
+    """Parse arguments, run the benchmarks, and compare or update the baseline."""
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n", 1)[0])
+    parser.add_argument("--sizes", default=",".join(DEFAULT_SIZES), help=f"Comma-separated corpus sizes among {', '.join(SIZES)}.")
+    parser.add_argument("--cases", default="", help="Comma-separated case names (default: all fixtures plus generated cases).")
+    parser.add_argument("--repeat", type=int, default=3, help="Timed repetitions per phase; the fastest is kept.")
+    parser.add_argument("--baseline", default=str(BASELINE_PATH), help="Baseline JSON file.")
+    parser.add_argument("--update-baseline", action="store_true", help="Write the measured throughput as the new baseline.")
+    parser.add_argument("--tolerance", type=float, default=0.35, help="Allowed slowdown fraction before a phase is reported as a regression.")
+    parser.add_argument("--fail-on-regression", action="store_true", help="Exit with status 1 when any phase regresses.")
+    parser.add_argument("--json", metavar="FILE", help="Also write raw results as JSON.")
+    parser.add_argument("--startup", action="store_true",
+                        help="Measure CLI import time and time to first output per command instead of throughput; --cases selects commands.")
+    args = parser.parse_args(argv)
+
+    sizes = [size for size in args.sizes.split(",") if size]
+    unknown = [size for size in sizes if size not in SIZES]
+    if unknown:
+        parser.error(f"unknown sizes: {', '.join(unknown)}")
+    cases = [case for case in args.cases.split(",") if case] or None
+
+    baseline_path = Path(args.baseline)
+    baseline = json.loads(baseline_path.read_text(encoding="utf-8")) if baseline_path.is_file() else {}
+    if args.startup:
+        return run_startup(args, cases, baseline, baseline_path)
+    results = run(sizes, cases, max(1, args.repeat))
+    print(format_report(results, baseline))
+    if args.json:
+        Path(args.json).write_text(json.dumps(results, indent=2) + "\n", encoding="utf-8")
+    if args.update_baseline:
+        updated = dict(baseline)
+        for size, size_results in results.items():
+            updated.setdefault(size, {}).update({
+                case: {phase: round(rate) for phase, rate in throughput(result).items()}
+                for case, result in size_results.items()
+            })
+        baseline_path.write_text(json.dumps(updated, indent=2, sort_keys=True) + "\n", encoding="utf-8")
+        return 0
+    regressions = compare(results, baseline, args.tolerance)
+    for size, case, phase, ratio in regressions:
+        print(f"REGRESSION {size} {case} {phase}: {ratio:.2f}x baseline", file=sys.stderr)
+    return 1 if regressions and args.fail_on_regression else 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,129 @@
+"""Cold-start benchmark for the `req` command line.
+
+Runs each command of `STARTUP_COMMANDS` in a fresh interpreter started with `-X importtime` and records the total import time reported by the interpreter
+and the wall time from process start to the first byte on stdout. The child gets a private `HOME` whose release-check idle window is still open, and runs in
+an empty directory, so neither the background release check nor the `.req/` analysis cache take part in the measurement. Bytecode goes to
+`PYCACHE_DIR` and one unmeasured warm-up run precedes the timed runs, so the numbers match an installed package with compiled modules.
+
+Used by `run_benchmarks.py --startup`.
+"""
+
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+SRC_DIR = Path(__file__).resolve().parents[2] / "src"
+"""Package sources put on the child `PYTHONPATH`."""
+
+FIXTURE = Path(__file__).resolve().parents[1] / "fixtures" / "fixture_python.py"
+"""Input file of the standalone commands."""
+
+PYCACHE_DIR = Path(__file__).resolve().parents[2] / "temp" / "benchmarks" / "pycache"
+"""Bytecode cache of the measured interpreters, kept out of the source tree."""
+
+STARTUP_COMMANDS = {
+    "help": [],
+    "files-tokens": ["--files-tokens", str(FIXTURE)],
+    "files-references": ["--files-references", str(FIXTURE)],
+    "files-compress": ["--files-compress", str(FIXTURE)],
+    "files-find": ["--files-find", "FUNCTION", ".*", str(FIXTURE)],
+}
+"""Measured commands: name -> CLI arguments."""
+
+STARTUP_METRICS = ("import_ms", "first_output_ms")
+"""Per-command metrics, in milliseconds (lower is better)."""
+
+
+def import_ms(importtime_log: str) -> float:
+    """Sum the cumulative time of the top-level imports reported by `-X importtime`."""
+    total_us = 0
+    for line in importtime_log.splitlines():
+        if not line.startswith("import time:"):
+            continue
+        _, cumulative, name = line.split("|", 2)
+        if cumulative.strip().isdigit() and not name.startswith("  "):
+            total_us += int(cumulative)
+    return total_us / 1000
+
+
+def _child_env(home: str) -> dict:
+    """Return the child environment: sources on `PYTHONPATH` and a `HOME` with an open release-check idle window."""
+    idle_dir = Path(home) / ".cache" / "usereq"
+    idle_dir.mkdir(parents=True, exist_ok=True)
+    far = int(time.time()) + 86400
+    (idle_dir / "check_version_idle-time.json").write_text(json.dumps({
+        "last_success_timestamp": far,
+        "last_success_human_readable_timestamp": "benchmark",
+        "idle_until_timestamp": far,
+        "idle_until_human_readable_timestamp": "benchmark",
+    }), encoding="utf-8")
+    env = dict(os.environ, HOME=home, PYTHONPYCACHEPREFIX=str(PYCACHE_DIR))
+    env.pop("PYTHONDONTWRITEBYTECODE", None)
+    env["PYTHONPATH"] = os.pathsep.join(filter(None, (str(SRC_DIR), env.get("PYTHONPATH"))))
+    env.pop("PYTHONPROFILEIMPORTTIME", None)
+    return env
+
+
+def _run_once(argv: list, env: dict, cwd: str) -> dict:
+    """Run one command and return its import time and time to first output."""
+    start = time.perf_counter()
+    process = subprocess.Popen(
+        [sys.executable, "-X", "importtime", "-m", "usereq.cli", *argv],
+        stdout=subprocess.PIPE, stderr=subprocess.PIPE, env=env, cwd=cwd,
+    )
+    first = process.stdout.read(1)
+    first_output = time.perf_counter() - start
+    process.stdout.read()
+    stderr = process.stderr.read().decode("utf-8", "replace")
+    process.wait()
+    if not first or process.returncode != 0:
+        raise RuntimeError(f"req {' '.join(argv)} failed ({process.returncode}): {stderr[-500:]}")
+    return {"import_ms": import_ms(stderr), "first_output_ms": first_output * 1000}
+
+
+def measure_command(name: str, repeat: int) -> dict:
+    """Return the fastest of `repeat` runs of one command, per metric."""
+    with tempfile.TemporaryDirectory() as home, tempfile.TemporaryDirectory() as cwd:
+        env = _child_env(home)
+        _run_once(STARTUP_COMMANDS[name], env, cwd)
+        runs = [_run_once(STARTUP_COMMANDS[name], env, cwd) for _ in range(max(1, repeat))]
+    return {metric: min(run[metric] for run in runs) for metric in STARTUP_METRICS}
+
+
+def run(commands: list | None, repeat: int) -> dict:
+    """Measure the requested commands (default: all), keyed by command name."""
+    results = {}
+    for name in commands or STARTUP_COMMANDS:
+        results[name] = measure_command(name, repeat)
+        print(f"  startup {name:<18} done", file=sys.stderr)
+    return results
+
+
+def compare(results: dict, baseline: dict, tolerance: float) -> list:
+    """List `(command, metric, ratio)` for metrics slower than `1 + tolerance` times the baseline."""
+    regressions = []
+    for name, metrics in results.items():
+        for metric, value in metrics.items():
+            expected = baseline.get(name, {}).get(metric)
+            if expected and value / expected > 1 + tolerance:
+                regressions.append((name, metric, value / expected))
+    return regressions
+
+
+def format_report(results: dict, baseline: dict) -> str:
+    """Render one line per command with both metrics and their baseline ratios."""
+    rows = []
+    for name, metrics in results.items():
+        cells = []
+        for metric in STARTUP_METRICS:
+            cell = f"{metric}={metrics[metric]:.1f}"
+            expected = baseline.get(name, {}).get(metric)
+            if expected:
+                cell += f" ({metrics[metric] / expected:.2f}x)"
+            cells.append(cell)
+        rows.append(f"startup {name:<18} " + "  ".join(cells))
+    return "\n".join(rows)
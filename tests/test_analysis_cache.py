@@ -0,0 +1,257 @@
+"""Tests for the usereq.analysis_cache module.
+
+Covers: ACH-001 through ACH-007.
+"""
+
+import json
+import os
+import subprocess
+import time
+
+import usereq.cli as cli_module
+from usereq import profiling
+from usereq.analysis_cache import AnalysisCache, find_git_common_dir, git_blob_digest, load_analysis, read_git_index_digests
+from usereq.cli import main
+from usereq.source_analyzer import SourceAnalyzer
+from usereq.source_buffer import SourceBuffer
+
+
+def _age(path, seconds: int = 60) -> None:
+    """Move a file mtime into the past so its stat signature is not racy."""
+    st = os.stat(path)
+    os.utime(path, ns=(st.st_atime_ns, st.st_mtime_ns - seconds * 1_000_000_000))
+
+
+class TestGitBlobDigest:
+    """ACH-001: Content digests use the git blob object id format."""
+
+    def test_matches_git_hash_object(self, repo_temp_dir):
+        path = repo_temp_dir / "a.py"
+        path.write_bytes(b"def foo():\n    return 1\n")
+        expected = subprocess.run(
+            ["git", "hash-object", str(path)],
+            check=True,
+            capture_output=True,
+            text=True,
+        ).stdout.strip()
+        assert git_blob_digest(path.read_bytes()) == expected
+
+
+class TestAnalysisCacheLookup:
+    """ACH-002, ACH-003: Stat-first lookup with content-hash fallback."""
+
+    def test_warm_lookup_skips_analysis(self, repo_temp_dir, monkeypatch):
+        path = repo_temp_dir / "a.py"
+        path.write_text("def foo():\n    return 1\n", encoding="utf-8")
+        _age(path)
+        cache = AnalysisCache(repo_temp_dir / "cache", fingerprint="f" * 40)
+        analyzer = SourceAnalyzer()
+        cold_elements, cold_lines = load_analysis(analyzer, str(path), "python", cache)
+
+        def _fail(*_args, **_kwargs):
+            raise AssertionError("analyze() must not run on a warm cache")
+
+        monkeypatch.setattr(analyzer, "analyze", _fail)
+        warm_elements, warm_lines = load_analysis(analyzer, str(path), "python", cache)
+        assert warm_lines == cold_lines == 2
+        assert [e.name for e in warm_elements] == [e.name for e in cold_elements]
+
+    def test_content_change_invalidates_entry(self, repo_temp_dir):
+        path = repo_temp_dir / "a.py"
+        path.write_text("def foo():\n    return 1\n", encoding="utf-8")
+        _age(path, 120)
+        cache = AnalysisCache(repo_temp_dir / "cache", fingerprint="f" * 40)
+        analyzer = SourceAnalyzer()
+        load_analysis(analyzer, str(path), "python", cache)
+        path.write_text("def bar():\n    return 2\n", encoding="utf-8")
+        _age(path)
+        elements, _ = load_analysis(analyzer, str(path), "python", cache)
+        assert "bar" in [e.name for e in elements]
+
+    def test_touch_without_change_reuses_digest(self, repo_temp_dir):
+        path = repo_temp_dir / "a.py"
+        path.write_text("x = 1\n", encoding="utf-8")
+        _age(path, 120)
+        cache = AnalysisCache(repo_temp_dir / "cache", fingerprint="f" * 40)
+        first = cache.digest_for(str(path))
+        _age(path, -60)
+        assert cache.digest_for(str(path)) == first
+
+
+    def test_streamed_file_is_never_loaded(self, repo_temp_dir, monkeypatch):
+        path = repo_temp_dir / "big.c"
+        path.write_text("int foo(int a) {\n    return a;\n}\n" * 50, encoding="utf-8")
+        _age(path)
+        cache = AnalysisCache(repo_temp_dir / "cache", fingerprint="f" * 40)
+        analyzer = SourceAnalyzer()
+        expected, expected_lines = load_analysis(analyzer, str(path), "c", None, stream_threshold=None)
+
+        def _fail(*_args, **_kwargs):
+            raise AssertionError("a streamed file must not be loaded into a SourceBuffer")
+
+        monkeypatch.setattr(SourceBuffer, "from_path", _fail)
+        elements, total_lines = load_analysis(analyzer, str(path), "c", cache, stream_threshold=0)
+        assert (elements, total_lines) == (expected, expected_lines) == (elements, 150)
+        assert cache.digest_for(str(path)) == git_blob_digest(path.read_bytes())
+
+
+class TestAnalysisCacheFingerprint:
+    """ACH-004: Fingerprint changes select a fresh namespace."""
+
+    def test_fingerprint_isolates_entries(self, tmp_path):
+        first = AnalysisCache(tmp_path, fingerprint="a" * 40)
+        second = AnalysisCache(tmp_path, fingerprint="b" * 40)
+        first.store("0" * 40, "analysis.python", ([], 1))
+        assert first.load("0" * 40, "analysis.python") == ([], 1)
+        assert second.load("0" * 40, "analysis.python") is None
+
+    def test_default_fingerprint_is_stable(self, tmp_path):
+        assert AnalysisCache(tmp_path).fingerprint == AnalysisCache(tmp_path).fingerprint
+
+
+class TestProjectScanCache:
+    """ACH-005: Project-scan commands populate and reuse `.req/cache`."""
+
+    def _setup_project(self, repo_temp_dir):
+        src = repo_temp_dir / "src"
+        src.mkdir()
+        (src / "main.py").write_text("def hello():\n    return 1\n", encoding="utf-8")
+        req_dir = repo_temp_dir / ".req"
+        req_dir.mkdir()
+        config = {
+            "guidelines-dir": "docs/",
+            "docs-dir": "docs/",
+            "tests-dir": "tests/",
+            "src-dir": ["src"],
+        }
+        (req_dir / "config.json").write_text(json.dumps(config), encoding="utf-8")
+        _age(src / "main.py")
+
+    def test_references_output_is_stable_across_warm_runs(
+        self, capsys, repo_temp_dir, monkeypatch
+    ):
+        monkeypatch.setattr(
+            cli_module,
+            "maybe_notify_newer_version",
+            lambda timeout_seconds=2.0: None,
+        )
+        self._setup_project(repo_temp_dir)
+        monkeypatch.chdir(repo_temp_dir)
+        assert main(["--references", "--jobs", "1"]) == 0
+        cold = capsys.readouterr().out
+        assert (repo_temp_dir / ".req" / "cache" / ".gitignore").is_file()
+        assert main(["--references", "--jobs", "1"]) == 0
+        assert capsys.readouterr().out == cold
+
+    def test_no_cache_leaves_req_untouched(self, capsys, repo_temp_dir, monkeypatch):
+        monkeypatch.setattr(
+            cli_module,
+            "maybe_notify_newer_version",
+            lambda timeout_seconds=2.0: None,
+        )
+        self._setup_project(repo_temp_dir)
+        monkeypatch.chdir(repo_temp_dir)
+        assert main(["--compress", "--no-cache"]) == 0
+        assert not (repo_temp_dir / ".req" / "cache").exists()
+
+
+class TestWorktreeSharedCache:
+    """ACH-006: Worktrees of one repository share objects and take digests from the git index."""
+
+    @staticmethod
+    def _git(cwd, *args):
+        subprocess.run(["git", "-C", str(cwd), *args], check=True, capture_output=True)
+
+    def _repo_with_worktree(self, repo_temp_dir):
+        main_tree = repo_temp_dir / "main"
+        main_tree.mkdir()
+        self._git(main_tree, "init", "-q")
+        (main_tree / "a.py").write_text("def foo():\n    return 1\n", encoding="utf-8")
+        (main_tree / "b.py").write_text("def bar():\n    return 2\n", encoding="utf-8")
+        self._git(main_tree, "add", ".")
+        self._git(main_tree, "-c", "user.email=a@b", "-c", "user.name=a", "commit", "-q", "-m", "init")
+        worktree = repo_temp_dir / "wt"
+        self._git(main_tree, "worktree", "add", "-q", str(worktree), "-b", "task")
+        time.sleep(0.2)
+        return main_tree, worktree
+
+    def test_fresh_worktree_reuses_sibling_objects(self, repo_temp_dir, monkeypatch):
+        main_tree, worktree = self._repo_with_worktree(repo_temp_dir)
+        assert find_git_common_dir(worktree) == find_git_common_dir(main_tree) == main_tree / ".git"
+        analyzer = SourceAnalyzer()
+        load_analysis(analyzer, str(main_tree / "a.py"), "python", AnalysisCache.for_project(main_tree))
+        cache = AnalysisCache.for_project(worktree)
+        assert cache.objects_dir == AnalysisCache.for_project(main_tree).objects_dir
+        assert cache.namespace_dir.is_relative_to(worktree)
+
+        def _fail(*_args, **_kwargs):
+            raise AssertionError("a fresh worktree must reuse the shared analysis")
+
+        monkeypatch.setattr(analyzer, "analyze", _fail)
+        profiler = profiling.start()
+        try:
+            elements, _ = load_analysis(analyzer, str(worktree / "a.py"), "python", cache)
+        finally:
+            profiling.stop()
+        assert [e.name for e in elements if e.name] == ["foo"]
+        assert profiler.snapshot()["counters"].get("cache.index_hits") == 1
+        assert "cache.rehashes" not in profiler.snapshot()["counters"]
+
+    def test_modified_and_untracked_files_are_hashed(self, repo_temp_dir):
+        _, worktree = self._repo_with_worktree(repo_temp_dir)
+        changed = worktree / "b.py"
+        changed.write_text("def baz():\n    return 3\n", encoding="utf-8")
+        untracked = worktree / "c.py"
+        untracked.write_text("x = 1\n", encoding="utf-8")
+        _age(changed)
+        _age(untracked)
+        time.sleep(0.2)
+        cache = AnalysisCache.for_project(worktree)
+        for path in (changed, untracked):
+            assert cache.digest_for(str(path)) == git_blob_digest(path.read_bytes())
+        assert cache.index_digest(str(worktree / "a.py"), os.stat(worktree / "a.py")) is not None
+
+
+    def test_converted_files_are_not_taken_from_index(self, repo_temp_dir):
+        repo = repo_temp_dir / "conv"
+        repo.mkdir()
+        self._git(repo, "init", "-q")
+        self._git(repo, "config", "core.autocrlf", "true")
+        for name in ("crlf.py", "filtered.py", "plain.py"):
+            (repo / name).write_text(f"def {name[:-3]}():\n    return 1\n", encoding="utf-8")
+        (repo / ".gitattributes").write_text("filtered.py filter=lfs\nplain.py -text\n", encoding="utf-8")
+        self._git(repo, "add", ".")
+        self._git(repo, "-c", "user.email=a@b", "-c", "user.name=a", "commit", "-q", "-m", "init")
+        (repo / "crlf.py").unlink()
+        self._git(repo, "checkout", "--", "crlf.py")
+        assert (repo / "crlf.py").read_bytes().endswith(b"\r\n")
+        digests = read_git_index_digests(repo)
+        assert str(repo / "crlf.py") not in digests
+        assert str(repo / "filtered.py") not in digests
+        assert digests[str(repo / "plain.py")] == git_blob_digest((repo / "plain.py").read_bytes())
+
+
+class TestIndexReadOncePerRun:
+    """ACH-007: A pooled run reads the git index once, not once per scheduled chunk."""
+
+    def test_jobs_run_reads_index_once(self, capsys, repo_temp_dir, monkeypatch):
+        monkeypatch.setattr(
+            cli_module,
+            "maybe_notify_newer_version",
+            lambda timeout_seconds=2.0: None,
+        )
+        src = repo_temp_dir / "src"
+        src.mkdir()
+        for index in range(40):
+            (src / f"mod{index}.py").write_text(f"def f{index}():\n    return {index}\n", encoding="utf-8")
+        req_dir = repo_temp_dir / ".req"
+        req_dir.mkdir()
+        config = {"guidelines-dir": "docs/", "docs-dir": "docs/", "tests-dir": "tests/", "src-dir": ["src"]}
+        (req_dir / "config.json").write_text(json.dumps(config), encoding="utf-8")
+        subprocess.run(["git", "-C", str(repo_temp_dir), "add", "src"], check=True, capture_output=True)
+        time.sleep(0.2)
+        monkeypatch.chdir(repo_temp_dir)
+        assert main(["--references", "--jobs", "4", "--profile", "--profile-format", "json"]) == 0
+        counters = json.loads(capsys.readouterr().err)["counters"]
+        assert counters["cache.index_hits"] == 40
+        assert counters["cache.index_reads"] == 1
@@ -0,0 +1,111 @@
+"""Smoke tests for the benchmark corpus and harness in `tests/benchmarks`.
+
+Covers: BEN-001 through BEN-004.
+"""
+
+import json
+import sys
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent / "benchmarks"))
+
+import corpus  # noqa: E402
+import run_benchmarks  # noqa: E402
+import startup  # noqa: E402
+
+from usereq.compress import compress_source  # noqa: E402
+from usereq.source_analyzer import SourceAnalyzer  # noqa: E402
+
+
+class TestCorpus:
+    """BEN-001: corpora are deterministic, reach the target size and stay analyzable."""
+
+    def test_every_case_reaches_target_and_analyzes(self, repo_temp_dir):
+        """Each generated file has at least 1k lines and yields constructs."""
+        cases = corpus.build_corpus(repo_temp_dir, "1k")
+        names = [case for case, _, _ in cases]
+        assert "cpp_deep_namespaces" in names and "python_long_lines" in names
+        assert {"c", "python", "rust"} <= set(names)
+        analyzer = SourceAnalyzer()
+        for case, path, language in cases:
+            text = path.read_text(encoding="utf-8")
+            assert text.count("\n") >= corpus.SIZES["1k"], case
+            assert analyzer.analyze(str(path), language), case
+            assert compress_source(text, language), case
+
+    def test_generation_is_deterministic(self):
+        """Generators return identical text for identical arguments."""
+        assert corpus.deep_namespaces_cpp(500) == corpus.deep_namespaces_cpp(500)
+        assert corpus.long_lines_python(40) == corpus.long_lines_python(40)
+        assert max(len(line) for line in corpus.long_lines_python(40).splitlines()) >= 3_000
+
+
+class TestBaselineComparison:
+    """BEN-002: regressions are the phases slower than the tolerated baseline fraction."""
+
+    def test_compare_flags_only_slow_phases(self):
+        """A phase at half the baseline rate is a regression; one at 0.9x is not."""
+        results = {"1k": {"c": {"lines": 1000, "seconds": {"analyze": 0.02, "enrich": 0.011}}}}
+        baseline = {"1k": {"c": {"analyze": 100_000, "enrich": 100_000}}}
+        regressions = run_benchmarks.compare(results, baseline, tolerance=0.25)
+        assert [(size, case, phase) for size, case, phase, _ in regressions] == [("1k", "c", "analyze")]
+        assert run_benchmarks.compare(results, {}, tolerance=0.25) == []
+
+    def test_stored_baseline_covers_default_sizes(self):
+        """The committed baseline has every phase of every default-size case."""
+        baseline = json.loads(run_benchmarks.BASELINE_PATH.read_text(encoding="utf-8"))
+        for size in corpus.DEFAULT_SIZES:
+            for case, phases in baseline[size].items():
+                expected = run_benchmarks.CORPUS_PHASES if case == "all_files" else run_benchmarks.FILE_PHASES
+                assert set(phases) == set(expected), (size, case)
+
+
+class TestHarness:
+    """BEN-003: one per-file case runs end to end."""
+
+    def test_run_file_case_reports_every_phase(self, repo_temp_dir):
+        """Per-file results carry lines, every phase timing and peak RSS."""
+        path = repo_temp_dir / "sample.py"
+        path.write_text(corpus.replicate_fixture(corpus.FIXTURES_DIR / "fixture_python.py", 200), encoding="utf-8")
+        result = run_benchmarks.run_file_case(str(path), "python", 1)
+        assert result["lines"] >= 200
+        assert set(result["seconds"]) == set(run_benchmarks.FILE_PHASES)
+        assert all(seconds > 0 for seconds in result["seconds"].values())
+        assert result["peak_rss_mib"] > 0
+        assert "analyze=" in run_benchmarks.format_report({"1k": {"python": result}}, {})
+
+
+class TestStartupBenchmark:
+    """BEN-004: cold-start metrics are measured per command and compared with the baseline."""
+
+    def test_import_time_sums_top_level_imports(self):
+        """Only unindented `-X importtime` entries count, so nested imports are not added twice."""
+        log = "\n".join([
+            "import time: self [us] | cumulative | imported package",
+            "import time:       100 |        100 | json",
+            "import time:       200 |        300 |   re",
+            "import time:       400 |       1700 | usereq.cli",
+            "warning: unrelated stderr line",
+        ])
+        assert startup.import_ms(log) == 1.8
+
+    def test_compare_flags_only_slower_metrics(self):
+        """Startup metrics regress when they exceed the baseline by more than the tolerance."""
+        results = {"files-find": {"import_ms": 40.0, "first_output_ms": 90.0}}
+        baseline = {"files-find": {"import_ms": 40.0, "first_output_ms": 60.0}}
+        assert [(name, metric) for name, metric, _ in startup.compare(results, baseline, tolerance=0.35)] == [
+            ("files-find", "first_output_ms")
+        ]
+
+    def test_stored_baseline_covers_every_command(self):
+        """The committed baseline has both metrics of every startup command."""
+        baseline = json.loads(run_benchmarks.BASELINE_PATH.read_text(encoding="utf-8"))["startup"]
+        assert set(baseline) == set(startup.STARTUP_COMMANDS)
+        for metrics in baseline.values():
+            assert set(metrics) == set(startup.STARTUP_METRICS)
+
+    def test_measure_command_runs_the_cli(self):
+        """One command runs end to end in a fresh interpreter and reports both metrics."""
+        result = startup.measure_command("files-find", 1)
+        assert set(result) == set(startup.STARTUP_METRICS)
+        assert 0 < result["import_ms"] < result["first_output_ms"]
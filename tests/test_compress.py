@@ -1,6 +1,6 @@
 """Tests for the usereq.compress and usereq.compress_files modules.
 
-Covers: CMP-001 through CMP-012.
+Covers: CMP-001 through CMP-013.
 """
 
 import os
@@ -8,8 +8,8 @@ import tempfile
 
 import pytest
 
-from usereq.compress import compress_source, compress_file, detect_language
-from usereq.compress_files import compress_files
+from usereq.compress import compress_source, compress_file, detect_language, iter_compressed_lines
+from usereq.compress_files import BoilerplateDeduplicator, compress_files
 
 
 class TestDetectLanguage:
@@ -236,3 +236,67 @@ class TestCompressFiles:
         finally:
             for path in files:
                 os.unlink(path)
+
+
+class TestCompressionStreamAndDedup:
+    """CMP-013: Generator pipeline and cross-file boilerplate deduplication."""
+
+    PREAMBLE = (
+        "#include <stdint.h>\n#include <stdlib.h>\n#include <string.h>\n"
+        "#include \"generated/runtime_support_header.h\"\n#include \"generated/message_descriptor_table.h\"\n"
+        "#include \"generated/reflection_registry.h\"\n"
+    )
+
+    def _write(self, tmp_path, name, body):
+        path = tmp_path / name
+        path.write_text("/* License banner\n * line two\n */\n" + self.PREAMBLE + body, encoding="utf-8")
+        return str(path)
+
+    def test_iter_compressed_lines_matches_compress_source(self):
+        source = "int a; /* x */ int b;\n/* open\n close */ int c; // tail\n\n  int d;\n"
+        entries = list(iter_compressed_lines(source, "c"))
+        assert entries == [(1, "int a;  int b;"), (3, "int c;"), (5, "int d;")]
+        assert compress_source(source, "c") == "\n".join(f"{n}: {t}" for n, t in entries)
+
+    def test_unsupported_language_raises_before_iteration(self):
+        with pytest.raises(ValueError, match="Unsupported language"):
+            iter_compressed_lines("x", "cobol")
+
+    def test_dedup_replaces_repeated_preamble(self, tmp_path):
+        first = self._write(tmp_path, "a.c", "int a(void) { return 1; }\n")
+        second = self._write(tmp_path, "b.c", "int b(void) { return 2; }\n")
+        plain = compress_files([first, second], include_line_numbers=True, output_base=tmp_path)
+        deduped = compress_files([first, second], include_line_numbers=True, output_base=tmp_path, dedup=True)
+        first_block, second_block = deduped.split("\n\n")
+        assert first_block == plain.split("\n\n")[0]
+        assert "4: [same as a.c:4-9]" in second_block
+        assert "#include" not in second_block
+        assert "> Lines: 4-10" in second_block
+        assert "10: int b(void) { return 2; }" in second_block
+
+    def test_dedup_without_line_numbers_and_jobs(self, tmp_path):
+        paths = [self._write(tmp_path, f"f{i}.c", f"int f{i};\n") for i in range(3)]
+        sequential = compress_files(paths, include_line_numbers=False, output_base=tmp_path, dedup=True)
+        parallel = compress_files(paths, include_line_numbers=False, output_base=tmp_path, jobs=2, dedup=True)
+        assert sequential == parallel
+        assert sequential.count("[same as f0.c:4-9]") == 2
+
+    def test_references_never_point_at_replaced_lines(self):
+        old = [f"#include \"generated/common_runtime_header_{n}.h\"" for n in range(4)]
+        new = [f"#include \"generated/service_specific_header_{n}.h\"" for n in range(4)]
+        dedup = BoilerplateDeduplicator()
+        a = list(dedup.rewrite("a", enumerate(old, 1)))
+        b = list(dedup.rewrite("b", enumerate(new + old, 1)))
+        c = list(dedup.rewrite("c", enumerate(new + old, 1)))
+        assert a == list(enumerate(old, 1))
+        assert b == [*enumerate(new, 1), (5, "[same as a:1-4]")]
+        assert c == [(1, "[same as b:1-4]"), (5, "[same as a:1-4]")]
+
+    def test_short_runs_are_kept(self, tmp_path):
+        body = "}\n}\n}\n}\n}\n"
+        first = tmp_path / "a.c"
+        second = tmp_path / "b.c"
+        first.write_text(body, encoding="utf-8")
+        second.write_text(body, encoding="utf-8")
+        result = compress_files([str(first), str(second)], output_base=tmp_path, dedup=True)
+        assert "same as" not in result
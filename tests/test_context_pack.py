@@ -0,0 +1,119 @@
+"""Tests for the usereq.context_pack module and `--token-budget`.
+
+Covers: CPK-001 through CPK-004.
+"""
+
+import json
+import subprocess
+
+import pytest
+
+import usereq.cli as cli_module
+from usereq.cli import main
+from usereq.context_pack import TokenPacker, rank_files
+from usereq.token_counter import get_token_counter
+
+
+def _git(path, *args):
+    """Run one git command in the test repository."""
+    subprocess.run(["git", *args], cwd=path, check=True, capture_output=True)
+
+
+@pytest.fixture
+def project(repo_temp_dir, monkeypatch):
+    """Committed three-file project with REQUIREMENTS.md naming `b.py`."""
+    monkeypatch.setattr(
+        cli_module,
+        "maybe_notify_newer_version",
+        lambda timeout_seconds=2.0: None,
+    )
+    src = repo_temp_dir / "src"
+    src.mkdir()
+    for name in ("a", "b", "c"):
+        body = "".join(
+            f'def {name}_{i}(value):\n    """! @brief Helper {i} of {name}."""\n    return value + {i}\n\n\n'
+            for i in range(6)
+        )
+        (src / f"{name}.py").write_text(body, encoding="utf-8")
+    docs = repo_temp_dir / "docs"
+    docs.mkdir()
+    (docs / "REQUIREMENTS.md").write_text("- The parser lives in `b.py`.\n", encoding="utf-8")
+    req_dir = repo_temp_dir / ".req"
+    req_dir.mkdir()
+    config = {
+        "guidelines-dir": "docs/",
+        "docs-dir": "docs/",
+        "tests-dir": "tests/",
+        "src-dir": ["src"],
+    }
+    (req_dir / "config.json").write_text(json.dumps(config), encoding="utf-8")
+    (repo_temp_dir / ".gitignore").write_text(".req/\n", encoding="utf-8")
+    _git(repo_temp_dir, "add", "-A")
+    _git(repo_temp_dir, "commit", "-m", "init")
+    monkeypatch.chdir(repo_temp_dir)
+    return repo_temp_dir
+
+
+class TestRankFiles:
+    """CPK-001: Dirty files first, then files named in REQUIREMENTS.md, then the rest."""
+
+    def test_priority_tiers(self, project):
+        src = project / "src"
+        (src / "c.py").write_text("def changed():\n    pass\n", encoding="utf-8")
+        files = [str(src / name) for name in ("a.py", "b.py", "c.py")]
+        requirements = (project / "docs" / "REQUIREMENTS.md").read_text(encoding="utf-8")
+        ranked = rank_files(files, project, requirements)
+        assert [path.rsplit("/", 1)[-1] for path in ranked] == ["c.py", "b.py", "a.py"]
+
+
+class TestTokenPacker:
+    """CPK-002: Packed output never exceeds the budget and degrades in order."""
+
+    def test_exact_accounting_and_degradation(self):
+        counter = get_token_counter()
+        full = "# big\n" + "word " * 200
+        packer = TokenPacker(120, "\n\n---\n\n", header="# Files Structure\n```\nx\n```")
+        assert packer.offer([("full", "# small\nshort text")]) == "full"
+        assert packer.offer([("full", full), ("signatures", "# big\n- fn `f()`"), ("tree", "")]) == "signatures"
+        assert packer.offer([("full", full), ("signatures", full), ("tree", "")]) == "tree"
+        output = "# Files Structure\n```\nx\n```\n\n" + "".join(packer.fragments()) + "\n"
+        assert counter.count_tokens(output) == packer.used <= 120
+        assert packer.levels == {"full": 1, "signatures": 1, "tree": 1}
+
+    def test_header_over_budget(self):
+        with pytest.raises(ValueError, match="smaller than the output header"):
+            TokenPacker(1, "\n\n", header="# Files Structure\n```\nmany words here\n```")
+
+
+class TestTokenBudgetCli:
+    """CPK-003: --references/--compress --token-budget fit the budget."""
+
+    @pytest.mark.parametrize("command", ["--references", "--compress"])
+    def test_output_fits_budget(self, project, capsys, command):
+        assert main([command, "--jobs", "1", "--no-cache"]) == 0
+        full = capsys.readouterr().out
+        counter = get_token_counter()
+        budget = counter.count_tokens(full) // 2
+        assert main([command, "--jobs", "1", "--no-cache", "--token-budget", str(budget)]) == 0
+        captured = capsys.readouterr()
+        assert counter.count_tokens(captured.out) <= budget
+        assert "Token budget:" in captured.err
+        assert "b_0" in captured.out
+
+    def test_generous_budget_keeps_full_sections(self, project, capsys):
+        assert main(["--compress", "--jobs", "1", "--token-budget", "100000"]) == 0
+        captured = capsys.readouterr()
+        assert captured.out.count("@@@ ") == 3
+        assert "Signatures only" not in captured.out
+
+
+class TestTokenBudgetOptions:
+    """CPK-004: --token-budget validation."""
+
+    def test_rejects_non_positive_budget(self, project, capsys):
+        assert main(["--references", "--token-budget", "0"]) == 1
+        assert "--token-budget must be a positive integer" in capsys.readouterr().err
+
+    def test_rejects_incremental(self, project, capsys):
+        assert main(["--references", "--incremental", "--token-budget", "10"]) == 1
+        assert "cannot be combined with --incremental" in capsys.readouterr().err
@@ -1,7 +1,7 @@
 """Tests for the --files-tokens, --files-references, --files-compress,
 --references, --compress, --enable-line-numbers, and --tokens CLI commands.
 
-Covers: CMD-001 through CMD-017.
+Covers: CMD-001 through CMD-017, CMD-030 through CMD-035.
 """
 
 import contextlib
@@ -10,7 +10,9 @@ import json
 import os
 import tempfile
 import shutil
+import subprocess
 import re
+import sys
 from typing import Dict, List
 
 import pytest
@@ -21,6 +23,7 @@ from usereq.cli import (
     EXCLUDED_DIRS,
     SUPPORTED_EXTENSIONS,
     _collect_source_files,
+    _project_relative_paths,
 )
 from pathlib import Path
 from usereq.doxygen_parser import parse_doxygen_comment
@@ -1051,6 +1054,37 @@ class TestCollectSourceFiles:
         assert len(files) == 2
 
 
+class TestSourceEnumeration:
+    """CMD-032: Pathspec-restricted enumeration keeps the former selection rules."""
+
+    def test_prefix_extension_and_name_rules(self, repo_temp_dir):
+        """Directory prefixes match whole components, suffixes ignore case, and non-ASCII names are kept."""
+        (repo_temp_dir / "src" / "a").mkdir(parents=True)
+        (repo_temp_dir / "srcx").mkdir()
+        (repo_temp_dir / "src" / "a" / "x.py").write_text("x = 1\n", encoding="utf-8")
+        (repo_temp_dir / "src" / "UP.PY").write_text("x = 1\n", encoding="utf-8")
+        (repo_temp_dir / "src" / "ü n.py").write_text("x = 1\n", encoding="utf-8")
+        (repo_temp_dir / "src" / ".py").write_text("x = 1\n", encoding="utf-8")
+        (repo_temp_dir / "srcx" / "y.py").write_text("y = 1\n", encoding="utf-8")
+        subprocess.run(["git", "add", "src/a"], cwd=repo_temp_dir, check=True)
+        base = os.path.realpath(repo_temp_dir)
+        files = _collect_source_files(["src"], repo_temp_dir)
+        assert files == sorted(os.path.join(base, "src", name) for name in ("UP.PY", "a/x.py", "ü n.py"))
+        assert _collect_source_files(["../elsewhere"], repo_temp_dir) == []
+
+    def test_symlinks_are_resolved(self, repo_temp_dir):
+        """Tracked and untracked symlinks resolve to their targets like `Path.resolve()`."""
+        src = repo_temp_dir / "src"
+        src.mkdir()
+        (src / "real.py").write_text("x = 1\n", encoding="utf-8")
+        (src / "tracked.py").symlink_to("real.py")
+        subprocess.run(["git", "add", "src"], cwd=repo_temp_dir, check=True)
+        (src / "untracked.py").symlink_to("real.py")
+        files = _collect_source_files(["src"], repo_temp_dir)
+        assert files == [str((src / "real.py").resolve())]
+        assert _project_relative_paths(files + ["/elsewhere/z.py"], repo_temp_dir) == ["src/real.py", None]
+
+
 class TestReferencesCommand:
     """CMD-008, CMD-009, CMD-014, CMD-015: --references tests."""
 
@@ -2094,3 +2128,351 @@ class TestExcludedDirs:
     def test_excluded_dirs_kept_only_when_not_gitignored(self):
         """EXCLUDED_DIRS should be empty for this repository."""
         assert EXCLUDED_DIRS == frozenset()
+
+
+class TestParallelJobs:
+    """CMD-030: --jobs worker pool output matches sequential execution."""
+
+    def _run(self, capsys, argv: List[str]) -> tuple[int, str, str]:
+        rc = main(argv)
+        captured = capsys.readouterr()
+        return rc, captured.out, captured.err
+
+    @pytest.mark.parametrize(
+        "command",
+        [
+            ["--files-references"],
+            ["--files-compress"],
+            ["--files-find", "FUNCTION|CLASS", ".*"],
+        ],
+        ids=["references", "compress", "find"],
+    )
+    def test_parallel_output_matches_sequential(self, capsys, monkeypatch, command):
+        monkeypatch.setattr(
+            cli_module,
+            "maybe_notify_newer_version",
+            lambda timeout_seconds=2.0: None,
+        )
+        files = [str(path) for path in FIXTURE_FILES] + ["/nonexistent/file.py"]
+        sequential = self._run(
+            capsys, ["--verbose", "--jobs", "1", *command, *files]
+        )
+        parallel = self._run(
+            capsys, ["--verbose", "--jobs", "4", *command, *files]
+        )
+        assert sequential[0] == 0
+        assert parallel == sequential
+        assert "SKIP  /nonexistent/file.py" in parallel[2]
+
+
+class TestStreamingOutput:
+    """CMD-031: Streamed output and --output FILE match buffered output."""
+
+    @pytest.fixture(autouse=True)
+    def _no_version_check(self, monkeypatch):
+        monkeypatch.setattr(
+            cli_module,
+            "maybe_notify_newer_version",
+            lambda timeout_seconds=2.0: None,
+        )
+
+    @pytest.mark.parametrize(
+        "command",
+        [
+            ["--files-references"],
+            ["--files-compress"],
+            ["--files-find", "FUNCTION|CLASS", ".*"],
+        ],
+        ids=["references", "compress", "find"],
+    )
+    def test_output_file_matches_stdout(self, capsys, tmp_path, command):
+        files = [str(path) for path in FIXTURE_FILES]
+        assert main(["--jobs", "1", *command, *files]) == 0
+        stdout = capsys.readouterr().out
+        target = tmp_path / "out.md"
+        assert main(["--jobs", "4", "--output", str(target), *command, *files]) == 0
+        assert capsys.readouterr().out == ""
+        assert target.read_text(encoding="utf-8") == stdout
+
+    def test_sections_stream_matches_joined_markdown(self):
+        from usereq.generate_markdown import generate_markdown, iter_markdown_sections
+
+        files = [str(path) for path in FIXTURE_FILES[:3]]
+        sections = iter_markdown_sections(files)
+        first = next(sections)
+        assert first.startswith("# ")
+        assert first + "".join(sections) == generate_markdown(files)
+
+    def test_failure_writes_no_output_file(self, capsys, tmp_path):
+        target = tmp_path / "out.md"
+        rc = main(["--output", str(target), "--files-compress", "/nonexistent/file.py"])
+        assert rc != 0
+        assert not target.exists()
+        capsys.readouterr()
+
+
+class TestJsonlFormat:
+    """CMD-033: --format jsonl emits one record per file and per construct."""
+
+    @pytest.fixture(autouse=True)
+    def _no_version_check(self, monkeypatch):
+        monkeypatch.setattr(
+            cli_module,
+            "maybe_notify_newer_version",
+            lambda timeout_seconds=2.0: None,
+        )
+
+    def _records(self, capsys, argv: List[str]) -> list[dict]:
+        assert main(argv) == 0
+        out = capsys.readouterr().out
+        assert out.endswith("\n") and not out.endswith("\n\n")
+        return [json.loads(line) for line in out.splitlines()]
+
+    def test_files_find_records_match_markdown(self, capsys):
+        files = [str(path) for path in FIXTURE_FILES]
+        records = self._records(capsys, ["--format", "jsonl", "--files-find", "FUNCTION|CLASS", ".*", *files])
+        assert main(["--files-find", "FUNCTION|CLASS", ".*", *files]) == 0
+        blocks = _extract_construct_blocks(capsys.readouterr().out)
+        constructs = [record for record in records if record["record"] == "construct"]
+        assert [(c["type_label"], c["name"], c["line_start"], c["line_end"]) for c in constructs] == [
+            (b["type_label"], b["name"], b["line_start"], b["line_end"]) for b in blocks
+        ]
+        assert {record["path"] for record in records if record["record"] == "file"} <= set(files)
+        assert all(c["code"] for c in constructs)
+
+    def test_files_references_records_follow_elements(self, capsys):
+        path = FIXTURES_DIR / "fixture_python.py"
+        records = self._records(capsys, ["--format", "jsonl", "--files-references", str(path)])
+        analyzer = SourceAnalyzer()
+        elements = analyzer.enrich(analyzer.analyze(str(path), "python"), "python", filepath=str(path))
+        expected = [e for e in elements if not e.element_type.name.startswith("COMMENT")]
+        head, constructs = records[0], records[1:]
+        assert head["record"] == "file" and head["language"] == "python" and head["lines"] > 0
+        assert head["doxygen_fields"]["brief"]
+        assert [(c["type_label"], c["line_start"], c["line_end"], c["signature"], c["parent_name"]) for c in constructs] == [
+            (e.type_label, e.line_start, e.line_end, e.signature, e.parent_name) for e in expected
+        ]
+        assert "code" not in constructs[0]
+
+    def test_files_compress_record_per_file(self, capsys):
+        files = [str(path) for path in FIXTURE_FILES[:3]]
+        records = self._records(capsys, ["--format", "jsonl", "--files-compress", *files])
+        assert main(["--files-compress", *files]) == 0
+        markdown = capsys.readouterr().out
+        assert len(records) == 3
+        for record in records:
+            assert record["record"] == "file"
+            assert f"> Lines: {record['line_start']}-{record['line_end']}\n```\n{record['code']}\n```" in markdown
+
+    def test_find_records_are_identical_with_and_without_cache(self, capsys, repo_temp_dir, monkeypatch):
+        src = repo_temp_dir / "src"
+        src.mkdir()
+        for name in ("fixture_java.java", "fixture_python.py", "fixture_typescript.ts"):
+            target = src / name
+            shutil.copy(FIXTURES_DIR / name, target)
+            st = os.stat(target)
+            os.utime(target, ns=(st.st_atime_ns, st.st_mtime_ns - 60_000_000_000))
+        (repo_temp_dir / ".req").mkdir()
+        (repo_temp_dir / ".req" / "config.json").write_text(
+            json.dumps({"guidelines-dir": "docs/", "docs-dir": "docs/", "tests-dir": "tests/", "src-dir": ["src"]}), encoding="utf-8"
+        )
+        monkeypatch.chdir(repo_temp_dir)
+        argv = ["--format", "jsonl", "--find", "CLASS|METHOD|FUNCTION|INTERFACE", ".*"]
+        outputs = []
+        for extra in (["--no-cache"], [], []):
+            assert main(argv + extra) == 0
+            outputs.append(capsys.readouterr().out)
+        assert outputs[0] == outputs[1] == outputs[2]
+        constructs = [json.loads(line) for line in outputs[0].splitlines() if '"record":"construct"' in line]
+        assert any("visibility" in record for record in constructs)
+        assert any("inherits" in record for record in constructs)
+
+    def test_jsonl_rejects_token_budget(self, capsys):
+        rc = main(["--format", "jsonl", "--token-budget", "100", "--files-compress", str(FIXTURE_FILES[0])])
+        captured = capsys.readouterr()
+        assert rc == 1
+        assert captured.out == ""
+        assert "--format jsonl cannot be combined with --token-budget" in captured.err
+
+
+class TestStartupFastPath:
+    """CMD-034: plain standalone commands bypass the argparse tree and heavy imports."""
+
+    @pytest.fixture(autouse=True)
+    def _no_version_check(self, monkeypatch):
+        monkeypatch.setattr(
+            cli_module,
+            "maybe_notify_newer_version",
+            lambda timeout_seconds=2.0: None,
+        )
+
+    @pytest.mark.parametrize(
+        "argv",
+        [
+            ["--files-tokens", "a.py", "b.py"],
+            ["--files-references", "a.py"],
+            ["--files-compress", "a.py"],
+            ["--files-find", "FUNCTION", ".*", "a.py"],
+        ],
+    )
+    def test_fast_path_matches_parser(self, argv):
+        """The fast-path namespace carries the same command value as the full parser."""
+        fast = cli_module._fast_path_args(argv)
+        parsed = cli_module.parse_args(argv)
+        dest = cli_module.FAST_PATH_COMMANDS[argv[0]]
+        assert vars(fast) == {dest: getattr(parsed, dest)}
+
+    @pytest.mark.parametrize(
+        "argv",
+        [
+            [],
+            ["--files-tokens"],
+            ["--files-compress", "a.py", "--enable-line-numbers"],
+            ["--files-references", "--jobs", "2", "a.py"],
+            ["--format", "jsonl", "--files-find", "FUNCTION", ".*", "a.py"],
+            ["--references", "--here"],
+        ],
+    )
+    def test_other_command_lines_use_the_parser(self, argv):
+        """Options other than a single fast-path command fall back to `parse_args()`."""
+        assert cli_module._fast_path_args(argv) is None
+
+    def test_fast_path_skips_parser_with_identical_output(self, capsys, monkeypatch):
+        """The fast path prints exactly what the parsed command prints, without building the parser."""
+        files = [str(path) for path in FIXTURE_FILES[:2]]
+        assert main(["--files-compress", *files, "--enable-line-numbers"]) == 0
+        capsys.readouterr()
+        assert main(["--files-compress", *files]) == 0
+        fast_output = capsys.readouterr().out
+
+        monkeypatch.setattr(cli_module, "_fast_path_args", lambda argv_list: None)
+        assert main(["--files-compress", *files]) == 0
+        assert capsys.readouterr().out == fast_output
+
+        def fail_build_parser():
+            raise AssertionError("build_parser must not run on the fast path")
+
+        monkeypatch.undo()
+        monkeypatch.setattr(cli_module, "maybe_notify_newer_version", lambda timeout_seconds=2.0: None)
+        monkeypatch.setattr(cli_module, "build_parser", fail_build_parser)
+        assert main(["--files-compress", *files]) == 0
+        assert capsys.readouterr().out == fast_output
+
+    def test_package_import_defers_heavy_modules(self):
+        """Importing `usereq.cli` loads neither the analyzers nor yaml/urllib.request."""
+        code = (
+            "import sys, usereq.cli, usereq\n"
+            "heavy = ['usereq.source_analyzer', 'usereq.compress', 'usereq.generate_markdown', 'yaml', 'urllib.request', 'email.utils']\n"
+            "print([name for name in heavy if name in sys.modules])\n"
+            "print(usereq.compress.__name__)\n"
+        )
+        env = dict(os.environ)
+        env["PYTHONPATH"] = os.pathsep.join(filter(None, (str(Path(cli_module.__file__).resolve().parents[1]), env.get("PYTHONPATH"))))
+        result = subprocess.run([sys.executable, "-c", code], capture_output=True, text=True, env=env, check=True)
+        assert result.stdout.splitlines() == ["[]", "usereq.compress"], result.stdout + result.stderr
+
+
+class TestBatchMode:
+    """CMD-035: --batch runs one project scan per project with per-project outputs."""
+
+    @pytest.fixture(autouse=True)
+    def _no_version_check(self, monkeypatch):
+        monkeypatch.setattr(
+            cli_module,
+            "maybe_notify_newer_version",
+            lambda timeout_seconds=2.0: None,
+        )
+
+    def _project(self, root: Path, name: str, fixtures: list, static_check: dict | None = None) -> Path:
+        project = root / name
+        src = project / "src"
+        src.mkdir(parents=True)
+        for fixture in fixtures:
+            shutil.copy(fixture, src / fixture.name)
+        (project / ".req").mkdir()
+        config = {"guidelines-dir": "docs/", "docs-dir": "docs/", "tests-dir": "tests/", "src-dir": ["src"]}
+        if static_check is not None:
+            config["static-check"] = static_check
+        (project / ".req" / "config.json").write_text(json.dumps(config), encoding="utf-8")
+        return project
+
+    def test_outputs_match_single_project_runs(self, capsys, monkeypatch, repo_temp_dir):
+        alpha = self._project(repo_temp_dir, "alpha", FIXTURE_FILES[:4])
+        beta = self._project(repo_temp_dir, "beta", FIXTURE_FILES[4:9])
+        rc = main(["--batch", str(alpha), str(beta), "--references", "--jobs", "3"])
+        err = capsys.readouterr().err
+        assert rc == 0
+        for project, count in ((alpha, 4), (beta, 5)):
+            monkeypatch.chdir(project)
+            assert main(["--references", "--jobs", "1"]) == 0
+            expected = capsys.readouterr().out
+            output = project / ".req" / "cache" / "references.md"
+            assert output.read_text(encoding="utf-8") == expected
+            assert re.search(rf"batch: {re.escape(str(project))} +{count} files +{count} ok +0 failed .*-> {re.escape(str(output))}", err)
+        assert "batch: 2 projects, 9 files, 0 with errors" in err
+
+    def test_failing_project_does_not_stop_batch(self, capsys, repo_temp_dir):
+        alpha = self._project(repo_temp_dir, "alpha", FIXTURE_FILES[:2])
+        missing = repo_temp_dir / "missing"
+        rc = main(["--batch", str(missing), str(alpha), "--references"])
+        err = capsys.readouterr().err
+        assert rc == 2
+        assert f"ERROR  Error: PROJECT_BASE '{missing}' does not exist" in err
+        assert (alpha / ".req" / "cache" / "references.md").read_text(encoding="utf-8").startswith("# Files Structure")
+
+    def test_shared_output_dir_names_projects(self, capsys, monkeypatch, repo_temp_dir):
+        first = self._project(repo_temp_dir / "a", "lib", FIXTURE_FILES[:2])
+        second = self._project(repo_temp_dir / "b", "lib", FIXTURE_FILES[2:3])
+        out_dir = repo_temp_dir / "out"
+        rc = main(["--batch", str(first), str(second), "--references", "--format", "jsonl", "--batch-output-dir", str(out_dir)])
+        capsys.readouterr()
+        assert rc == 0
+        assert sorted(path.name for path in out_dir.iterdir()) == ["lib-2.references.jsonl", "lib.references.jsonl"]
+        monkeypatch.chdir(second)
+        assert main(["--references", "--format", "jsonl"]) == 0
+        assert (out_dir / "lib-2.references.jsonl").read_text(encoding="utf-8") == capsys.readouterr().out
+
+    def test_suffixed_names_never_collide_with_project_names(self, capsys, repo_temp_dir):
+        projects = [
+            self._project(repo_temp_dir / parent, name, FIXTURE_FILES[index:index + 1])
+            for index, (parent, name) in enumerate((("x", "a"), ("y", "a"), ("z", "a-2")))
+        ]
+        out_dir = repo_temp_dir / "out"
+        rc = main(["--batch", *map(str, projects), "--references", "--batch-output-dir", str(out_dir)])
+        capsys.readouterr()
+        assert rc == 0
+        assert sorted(path.name for path in out_dir.iterdir()) == ["a-2-2.references.md", "a-2.references.md", "a.references.md"]
+        assert FIXTURE_FILES[2].name in (out_dir / "a-2-2.references.md").read_text(encoding="utf-8")
+
+    def test_static_check_writes_project_outputs(self, capsys, repo_temp_dir):
+        python_fixture = FIXTURES_DIR / "fixture_python.py"
+        passing = self._project(repo_temp_dir, "passing", [python_fixture], {"Python": [{"module": "Command", "cmd": "true"}]})
+        failing = self._project(repo_temp_dir, "failing", [python_fixture], {"Python": [{"module": "Command", "cmd": "false"}]})
+        rc = main(["--batch", str(passing), str(failing), "--static-check", "--no-cache"])
+        captured = capsys.readouterr()
+        assert rc == 1
+        assert captured.out == ""
+        assert (passing / ".req" / "cache" / "static-check.txt").read_text(encoding="utf-8") == ""
+        report = (failing / ".req" / "cache" / "static-check.txt").read_text(encoding="utf-8")
+        assert report.startswith(f"# Static-Check(Command[false]): {failing / 'src' / 'fixture_python.py'}\nResult: FAIL")
+        assert "exit=1" in captured.err and "batch: 2 projects, 0 with errors" in captured.err
+
+    @pytest.mark.parametrize(
+        "extra, message",
+        [
+            ([], "--batch requires --references or --static-check"),
+            (["--references", "--output", "x.md"], "--batch cannot be combined with --output"),
+            (["--references", "--incremental"], "--batch cannot be combined with --incremental"),
+            (["--static-check", "--format", "jsonl"], "--batch --static-check does not support --format jsonl"),
+        ],
+    )
+    def test_rejects_unsupported_combinations(self, capsys, repo_temp_dir, extra, message):
+        rc = main(["--batch", str(repo_temp_dir), *extra])
+        captured = capsys.readouterr()
+        assert rc == 1
+        assert captured.out == ""
+        assert message in captured.err
+
+    def test_batch_is_never_forwarded_to_server(self):
+        args = cli_module.parse_args(["--batch", "a", "b", "--references"])
+        assert not cli_module._is_server_forwardable(args)
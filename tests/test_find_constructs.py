@@ -3,6 +3,7 @@
 @details Tests construct extraction, tag filtering, pattern matching, and output formatting for the find_constructs module.
 """
 
+import re
 import sys
 from pathlib import Path
 
@@ -13,6 +14,7 @@ sys.path.insert(0, str(Path(__file__).resolve().parents[1] / "src"))
 
 from usereq.find_constructs import (
     LANGUAGE_TAGS,
+    ConstructMatcher,
     construct_matches,
     find_constructs_in_files,
     format_available_tags,
@@ -66,6 +68,44 @@ def test_construct_matches():
     assert not construct_matches(elem_no_name, {"COMMENT"}, ".*")
 
 
+def test_construct_matcher_fast_paths():
+    """! @brief Test literal fast paths agree with `re.search` semantics."""
+    assert ConstructMatcher({"FUNCTION"}, "foo").kind == "substring"
+    assert ConstructMatcher({"FUNCTION"}, "^foo").kind == "prefix"
+    assert ConstructMatcher({"FUNCTION"}, "foo$").kind == "suffix"
+    assert ConstructMatcher({"FUNCTION"}, "^foo$").kind == "equal"
+    assert ConstructMatcher({"FUNCTION"}, "^fo+$").kind == "regex"
+    cases = {
+        "foo": ["foo", "xfoox", "fo"],
+        "^foo": ["foobar", "xfoo"],
+        "foo$": ["barfoo", "foox", "foo\n"],
+        "^foo$": ["foo", "foo\n", "foox"],
+        "test_.*": ["test_foo", "foo"],
+    }
+    for pattern, names in cases.items():
+        matcher = ConstructMatcher({"FUNCTION"}, pattern)
+        for name in names:
+            assert matcher.match_name(name) == bool(re.search(pattern, name)), (pattern, name)
+        assert matcher.any_name(set(names)) == any(re.search(pattern, name) for name in names)
+    elem = SourceElement(
+        element_type=ElementType.FUNCTION,
+        line_start=1,
+        line_end=1,
+        extract="def foo(): pass",
+        name="foo",
+    )
+    assert ConstructMatcher({"FUNCTION"}, "^foo$").matches(elem)
+    assert not ConstructMatcher({"CLASS"}, "^foo$").matches(elem)
+
+
+def test_construct_matcher_rejects_invalid_pattern():
+    """! @brief Test invalid regex patterns raise before any file is analyzed."""
+    with pytest.raises(ValueError, match="Invalid regex pattern"):
+        ConstructMatcher({"FUNCTION"}, "[unclosed")
+    with pytest.raises(ValueError, match="Invalid regex pattern"):
+        find_constructs_in_files(["/nonexistent/file.py"], "FUNCTION", "(")
+
+
     def test_format_construct_with_line_numbers():
         """! @brief Test construct formatting with line numbers."""
     elem = SourceElement(
@@ -744,11 +744,11 @@ class TestFindConstructsComprehensive:
             find_constructs_in_files([fixture], "STRUCT", ".*")
 
     def test_invalid_regex_pattern(self, fixtures_dir):
-        """! @brief Test that invalid regex patterns are handled gracefully."""
+        """! @brief Test that invalid regex patterns are rejected before any file is analyzed."""
         fixture = str(self.get_fixture_path(fixtures_dir, "python"))
 
-        # Invalid regex should result in no matches
-        with pytest.raises(ValueError, match="No constructs found"):
+        # Invalid regex is reported up front instead of matching nothing
+        with pytest.raises(ValueError, match="Invalid regex pattern"):
             find_constructs_in_files([fixture], "CLASS", "[invalid(regex")
 
 
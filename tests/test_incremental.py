@@ -0,0 +1,129 @@
+"""Tests for the usereq.incremental module and `--references --incremental`.
+
+Covers: INC-001 through INC-003.
+"""
+
+import json
+import subprocess
+
+import pytest
+
+import usereq.cli as cli_module
+import usereq.generate_markdown as generate_markdown_module
+from usereq.cli import main
+from usereq.incremental import git_changed_paths, git_dirty_paths
+
+
+def _git(path, *args):
+    """Run one git command in the test repository."""
+    subprocess.run(["git", *args], cwd=path, check=True, capture_output=True)
+
+
+@pytest.fixture
+def project(repo_temp_dir, monkeypatch):
+    """Committed two-file project with a `.req/config.json`."""
+    monkeypatch.setattr(
+        cli_module,
+        "maybe_notify_newer_version",
+        lambda timeout_seconds=2.0: None,
+    )
+    src = repo_temp_dir / "src"
+    src.mkdir()
+    (src / "a.py").write_text("def alpha():\n    return 1\n", encoding="utf-8")
+    (src / "b.py").write_text("def beta():\n    return 2\n", encoding="utf-8")
+    req_dir = repo_temp_dir / ".req"
+    req_dir.mkdir()
+    config = {
+        "guidelines-dir": "docs/",
+        "docs-dir": "docs/",
+        "tests-dir": "tests/",
+        "src-dir": ["src"],
+    }
+    (req_dir / "config.json").write_text(json.dumps(config), encoding="utf-8")
+    _git(repo_temp_dir, "add", "-A")
+    _git(repo_temp_dir, "commit", "-m", "init")
+    monkeypatch.chdir(repo_temp_dir)
+    return repo_temp_dir
+
+
+@pytest.fixture
+def rendered(monkeypatch):
+    """Record the paths rendered by the markdown worker."""
+    calls = []
+    original = generate_markdown_module._render_file
+
+    def _tracking(fpath, *args, **kwargs):
+        calls.append(fpath.rsplit("/", 1)[-1])
+        return original(fpath, *args, **kwargs)
+
+    monkeypatch.setattr(generate_markdown_module, "_render_file", _tracking)
+    return calls
+
+
+def _references(capsys, *extra):
+    assert main(["--references", "--jobs", "1", *extra]) == 0
+    return capsys.readouterr().out
+
+
+class TestGitChangeDetection:
+    """INC-001: Changed paths come from git diff and git status."""
+
+    def test_reports_dirty_and_committed_changes(self, project):
+        head = subprocess.run(
+            ["git", "rev-parse", "HEAD"], cwd=project, check=True, capture_output=True, text=True
+        ).stdout.strip()
+        (project / "src" / "a.py").write_text("def alpha():\n    return 3\n", encoding="utf-8")
+        (project / "src" / "c.py").write_text("x = 1\n", encoding="utf-8")
+        dirty = git_dirty_paths(project)
+        assert str((project / "src" / "a.py").resolve()) in dirty
+        assert str((project / "src" / "c.py").resolve()) in dirty
+        _git(project, "commit", "-am", "change a")
+        changed = git_changed_paths(project, head)
+        assert changed == {str((project / "src" / "a.py").resolve())}
+        assert git_changed_paths(project, "0" * 40) is None
+
+
+class TestIncrementalReferences:
+    """INC-002: Incremental output matches full scans and re-renders only changed files."""
+
+    def test_unchanged_tree_renders_nothing(self, project, capsys, rendered):
+        full = _references(capsys, "--no-cache")
+        assert _references(capsys, "--incremental") == full
+        rendered.clear()
+        assert _references(capsys, "--incremental") == full
+        assert rendered == []
+
+    def test_dirty_and_committed_changes_are_rerendered(self, project, capsys, rendered):
+        _references(capsys, "--incremental")
+        (project / "src" / "b.py").write_text("def gamma():\n    return 2\n", encoding="utf-8")
+        rendered.clear()
+        output = _references(capsys, "--incremental")
+        assert rendered == ["b.py"]
+        assert output == _references(capsys, "--no-cache")
+        assert "gamma" in output
+
+        _git(project, "commit", "-am", "rename beta")
+        (project / "src" / "a.py").write_text("def delta():\n    return 1\n", encoding="utf-8")
+        _git(project, "commit", "-am", "rename alpha")
+        rendered.clear()
+        output = _references(capsys, "--incremental")
+        assert sorted(rendered) == ["a.py", "b.py"]
+        assert output == _references(capsys, "--no-cache")
+
+    def test_reverted_file_is_rerendered(self, project, capsys, rendered):
+        path = project / "src" / "a.py"
+        original = path.read_text(encoding="utf-8")
+        path.write_text("def temp():\n    pass\n", encoding="utf-8")
+        _references(capsys, "--incremental")
+        path.write_text(original, encoding="utf-8")
+        rendered.clear()
+        assert "alpha" in _references(capsys, "--incremental")
+        assert rendered == ["a.py"]
+
+
+class TestIncrementalOptions:
+    """INC-003: --incremental requires the analysis cache."""
+
+    def test_rejects_no_cache(self, project, capsys):
+        assert main(["--references", "--incremental", "--no-cache"]) == 1
+        assert "--incremental requires the analysis cache" in capsys.readouterr().err
@@ -0,0 +1,231 @@
+"""Tests for the usereq.line_lexer module.
+
+Covers: LEX-001 through LEX-006.
+"""
+
+from pathlib import Path
+
+import pytest
+
+from usereq import line_lexer
+from usereq.compress import EXT_LANG_MAP, _is_in_string, _remove_inline_comment, compress_file
+from usereq.line_lexer import BlockEndTracker, BraceIndex, LineLexer, get_line_lexer, iter_brace_marks
+from usereq.source_analyzer import ElementType, SourceAnalyzer, build_language_specs
+
+
+class TestLineLexerScan:
+    """LEX-001: String and comment classification."""
+
+    def test_comment_inside_string_is_ignored(self):
+        lexer = LineLexer(('"', "'"), "//")
+        line = 'char *s = "http://x"; // tail'
+        assert lexer.find_comment(line) == line.index("// tail")
+        assert lexer.in_string(line, line.index("//"))
+
+    def test_longest_delimiter_wins(self):
+        lexer = LineLexer(('"', '"""'), "#")
+        line = 'x = """a " # b""" # c'
+        assert lexer.find_comment(line) == line.index("# c")
+
+    def test_state_carries_across_lines(self):
+        lexer = LineLexer(('"""', '"'), "#")
+        state, _ = lexer.advance('x = """open # not', 0, 17)
+        assert state == '"""'
+        assert lexer.find_comment('still # not', state) is None
+        assert lexer.find_comment('done""" # yes', state) == 8
+
+
+class TestLineLexerEscapes:
+    """LEX-002: Analyzer and compressor escape rules."""
+
+    def test_backslash_escapes_single_delimiter(self):
+        line = r'x = "a \" b" # c'
+        assert LineLexer(('"',), "#").find_comment(line) == line.index("# c")
+        assert _remove_inline_comment(line, "#", ('"',)) == r'x = "a \" b" '
+
+    def test_compressor_does_not_escape_multi_delimiters(self):
+        line = r'x = """a\""" # c'
+        assert get_line_lexer(('"""',), "#", True).find_comment(line) is None
+        assert _remove_inline_comment(line, "#", ('"""',)) == r'x = """a\""" '
+        assert not _is_in_string(line, len(line) - 1, ('"""',))
+
+
+class TestLineLexerSharing:
+    """LEX-003: Lexers are built once per delimiter configuration."""
+
+    def test_lexer_is_cached(self):
+        spec = build_language_specs()["cpp"]
+        first = get_line_lexer(spec.string_delimiters, spec.single_comment)
+        assert get_line_lexer(spec.string_delimiters, spec.single_comment) is first
+
+    def test_long_line_scan(self):
+        line = "int t[] = {" + ", ".join(f'"s{i}"' for i in range(5000)) + "}; // end"
+        lexer = get_line_lexer(('"', "'"), "//")
+        assert lexer.find_comment(line) == line.index("// end")
+
+
+class TestBraceIndex:
+    """LEX-004: String- and comment-aware, uncapped brace matching."""
+
+    def _end(self, text, language, start=0):
+        lines = text.splitlines(keepends=True)
+        spec = build_language_specs()[language]
+        return BraceIndex.from_lines(lines, spec, language).block_end(start)
+
+    def test_ignores_braces_in_literals_and_comments(self):
+        text = (
+            "void f() {\n"
+            "    char c = '{';\n"
+            "    const char *s = \"}}\";\n"
+            "    /* { */ // {\n"
+            "}\n"
+            "int x;\n"
+        )
+        assert self._end(text, "cpp") == 5
+
+    def test_cpp_raw_string_spans_lines(self):
+        text = 'void f() {\n    auto s = R"x(\n}\n)x";\n}\n'
+        assert self._end(text, "cpp") == 5
+
+    def test_rust_lifetimes_are_code(self):
+        text = "fn f<'a>(x: &'a str) -> &'a str {\n    x\n}\n"
+        assert self._end(text, "rust") == 3
+
+    def test_declaration_without_body(self):
+        text = "int f(int a,\n      int b);\nvoid g() {\n}\n"
+        assert self._end(text, "c") == 1
+
+    def test_nested_blocks_and_no_line_cap(self):
+        body = "".join(f"    void m{i}() {{\n        x();\n    }}\n" for i in range(200))
+        text = "namespace n {\n" + body + "}\n"
+        lines = text.splitlines(keepends=True)
+        spec = build_language_specs()["cpp"]
+        index = BraceIndex.from_lines(lines, spec, "cpp")
+        assert index.block_end(0) == len(lines)
+        assert index.block_end(1) == 4
+        assert index.block_end(len(lines) - 4) == len(lines) - 1
+
+    def test_analyzer_uses_uncapped_index(self, tmp_path):
+        path = tmp_path / "big.c"
+        path.write_text("void f() {\n" + "    x();\n" * 400 + "}\n", encoding="utf-8")
+        elements = SourceAnalyzer().analyze(str(path), "c")
+        func = next(e for e in elements if e.line_start == 1 and e.element_type == ElementType.FUNCTION)
+        assert func.line_end == 402
+
+
+class TestBlockEndTracker:
+    """LEX-005: Incremental block ends equal the whole-file BraceIndex."""
+
+    def test_resolves_like_brace_index(self):
+        text = (
+            "namespace n {\n"
+            "int decl(int a,\n"
+            "         int b);\n"
+            "struct S {\n"
+            "    void m() {\n"
+            "        if (x) { y(); }\n"
+            "    }\n"
+            "};\n"
+            "void g()\n"
+            "{\n"
+            "}\n"
+            "}\n"
+            "void open() {\n"
+        )
+        lines = text.splitlines(keepends=True)
+        spec = build_language_specs()["cpp"]
+        index = BraceIndex.from_lines(lines, spec, "cpp")
+        tracker = BlockEndTracker()
+        ends = {}
+        for number, (_, depth, mark) in enumerate(iter_brace_marks(lines, spec, "cpp"), 1):
+            tracker.register(number)
+            ends.update(tracker.feed(depth, mark))
+        ends.update(tracker.finish())
+        assert ends == {number: index.block_end(number - 1) for number in range(1, len(lines) + 1)}
+
+
+FIXTURES = sorted((Path(__file__).parent / "fixtures").glob("fixture_*"))
+
+TRICKY_LINES = [
+    'auto s = R"x(a } " b)x"; int c = \'{\'; // }\n',
+    'let r = br##"}{"## ; let l: &\'a str = "\\"; /* { */ x(); }\n',
+    'msg = "naïve { ünïcode }" + \'😀{\' # }\n',
+    'x = "open string continued \\\n',
+    '    still open } " ; y = `tmpl { ${a} }`;\r\n',
+    'String t = """ { text\n',
+    '  block } """; f(a; b) { g(); }\n',
+    'c = \'\\u{1F600}\'; d = \'\\\'\'; e = \'ab\'; }\n',
+    '/* unterminated { block\n',
+    '   ends here */ int k = 1;\n',
+]
+
+
+def _run_with_native(monkeypatch, enabled, action):
+    monkeypatch.setattr(line_lexer, "NATIVE_SCAN", line_lexer.NATIVE_SCAN if enabled else None)
+    get_line_lexer.cache_clear()
+    try:
+        return action()
+    finally:
+        get_line_lexer.cache_clear()
+
+
+@pytest.mark.skipif(line_lexer.NATIVE_SCAN is None, reason="native scanning kernel not built")
+class TestNativeScanKernel:
+    """LEX-006: The optional native kernels produce the same output as the pure-Python kernels."""
+
+    def test_lexer_matches_python_on_fixtures(self):
+        specs = build_language_specs()
+        for path in FIXTURES:
+            spec = specs[EXT_LANG_MAP[path.suffix]]
+            lines = path.read_text(encoding="utf-8").splitlines() + [line.rstrip("\n") for line in TRICKY_LINES]
+            for escape_multi in (True, False):
+                native = line_lexer.NATIVE_SCAN.Lexer(
+                    tuple(sorted(spec.string_delimiters, key=len, reverse=True)), spec.single_comment, escape_multi,
+                )
+                python = LineLexer(tuple(spec.string_delimiters), spec.single_comment, escape_multi)
+                state = None
+                for line in lines:
+                    assert native.find_comment(line, state) == python.find_comment(line, state), (path.name, line)
+                    for pos in range(0, len(line) + 2, 3):
+                        assert native.in_string(line, pos, state) == python.in_string(line, pos, state), (path.name, line, pos)
+                    assert native.advance(line, 0, len(line), state) == python.advance(line, 0, len(line), state)
+                    state = python.advance(line, 0, len(line), state)[0]
+
+    def test_brace_marks_match_python_on_fixtures(self):
+        specs = build_language_specs()
+        for path in FIXTURES:
+            lines = path.read_text(encoding="utf-8").splitlines(keepends=True) + TRICKY_LINES
+            for language in sorted({EXT_LANG_MAP[path.suffix], "cpp", "rust", "java"}):
+                spec = specs[EXT_LANG_MAP[path.suffix]]
+                delimiters = sorted(set(spec.string_delimiters) | ({'"""'} if language in line_lexer.TEXT_BLOCK_LANGUAGES else set()),
+                                    key=len, reverse=True)
+                expected = list(line_lexer._iter_python_brace_marks(lines, spec, language, delimiters))
+                assert list(iter_brace_marks(lines, spec, language)) == expected, (path.name, language)
+
+    def test_analysis_and_compression_are_identical(self, monkeypatch):
+        def render():
+            outputs = []
+            for path in FIXTURES:
+                language = EXT_LANG_MAP[path.suffix]
+                analyzer = SourceAnalyzer()
+                elements = analyzer.enrich(analyzer.analyze(str(path), language), language, str(path))
+                outputs.append([(e.element_type, e.name, e.line_start, e.line_end, e.signature, e.parent_name) for e in elements])
+                outputs.append(compress_file(str(path), language))
+            return outputs
+
+        native = _run_with_native(monkeypatch, True, render)
+        python = _run_with_native(monkeypatch, False, render)
+        assert native == python
+
+    def test_non_str_delimiters_are_rejected(self):
+        for delimiters in (('"', None), ('"', 1)):
+            with pytest.raises(TypeError, match="string delimiters must be str"):
+                line_lexer.NATIVE_SCAN.Lexer(delimiters, "#", False)
+            with pytest.raises(TypeError, match="string delimiters must be str"):
+                line_lexer.NATIVE_SCAN.BraceScanner("/*", "//", delimiters, "*/")
+
+    def test_environment_opt_out(self, monkeypatch):
+        monkeypatch.setenv(line_lexer.NATIVE_SCAN_ENV, "0")
+        assert line_lexer._load_native_scan() is None
+        monkeypatch.delenv(line_lexer.NATIVE_SCAN_ENV)
+        assert line_lexer._load_native_scan() is line_lexer.NATIVE_SCAN
@@ -0,0 +1,105 @@
+"""Tests for the usereq.parallel module.
+
+Covers: PAR-001 through PAR-005.
+"""
+
+import os
+import threading
+import time
+
+from usereq.parallel import (
+    MAX_CHUNK_SIZE,
+    STATUS_OK,
+    STATUS_SKIP,
+    FileOutcome,
+    _chunk_size,
+    format_outcome_line,
+    iter_ordered,
+    iter_ordered_threads,
+    map_ordered,
+    resolve_jobs,
+)
+
+
+def _square(value: int) -> int:
+    """Picklable worker used by pool scheduling tests."""
+    return value * value
+
+
+class TestResolveJobs:
+    """PAR-001: Worker count normalization."""
+
+    def test_none_selects_core_count(self):
+        assert resolve_jobs(None) == max(1, os.cpu_count() or 1)
+
+    def test_non_positive_selects_core_count(self):
+        assert resolve_jobs(0) == resolve_jobs(None)
+
+    def test_explicit_value_is_kept(self):
+        assert resolve_jobs(3) == 3
+
+
+class TestOrderedMapping:
+    """PAR-002: Results keep input order in every scheduling mode."""
+
+    def test_sequential_order(self):
+        assert map_ordered(_square, range(10), jobs=1) == [i * i for i in range(10)]
+
+    def test_pool_order(self):
+        items = list(range(50))
+        assert list(iter_ordered(_square, items, jobs=4)) == [i * i for i in items]
+
+    def test_empty_input(self):
+        assert map_ordered(_square, [], jobs=4) == []
+
+
+class TestOutcomeFormatting:
+    """PAR-003: Verbose status lines keep the historical column layout."""
+
+    def test_ok_without_note(self):
+        assert format_outcome_line(FileOutcome(STATUS_OK, "a.py")) == "  OK    a.py"
+
+    def test_skip_with_note(self):
+        outcome = FileOutcome(STATUS_SKIP, "a.py", note="not found")
+        assert format_outcome_line(outcome) == "  SKIP  a.py (not found)"
+
+
+class TestBoundedScheduling:
+    """PAR-004: Pool scheduling keeps a bounded window of in-flight chunks."""
+
+    def test_chunk_size_is_capped(self):
+        assert _chunk_size(100000, 2) == MAX_CHUNK_SIZE
+        assert _chunk_size(10, 4) == 1
+
+    def test_large_input_keeps_order(self):
+        items = list(range(1000))
+        results = iter_ordered(_square, items, jobs=3)
+        assert next(results) == 0
+        assert list(results) == [i * i for i in items[1:]]
+
+
+class TestThreadScheduling:
+    """PAR-005: Thread scheduling overlaps workers and keeps input order."""
+
+    def test_results_keep_input_order(self):
+        items = list(range(40))
+
+        def _slow_square(value):
+            time.sleep(0.001 * (len(items) - value) / len(items))
+            return value * value
+
+        assert list(iter_ordered_threads(_slow_square, items, jobs=4)) == [i * i for i in items]
+
+    def test_workers_run_concurrently(self):
+        barrier = threading.Barrier(3, timeout=5)
+
+        def _wait(value):
+            barrier.wait()
+            return value
+
+        assert list(iter_ordered_threads(_wait, [1, 2, 3], jobs=3)) == [1, 2, 3]
+
+    def test_single_job_runs_in_caller_thread(self):
+        caller = threading.get_ident()
+        idents = list(iter_ordered_threads(lambda _: threading.get_ident(), [1, 2], jobs=1))
+        assert idents == [caller, caller]
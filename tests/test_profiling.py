@@ -0,0 +1,141 @@
+"""Tests for the usereq.profiling module and `--profile`.
+
+Covers: PRF-001 through PRF-004.
+"""
+
+import json
+import sys
+
+import pytest
+
+import usereq.cli as cli_module
+from usereq import profiling
+from usereq.cli import main
+from usereq.parallel import iter_ordered
+from usereq.static_check import _run_tool
+
+
+@pytest.fixture(autouse=True)
+def _no_release_check(monkeypatch):
+    """Disable the startup release check and leave profiling disabled afterwards."""
+    monkeypatch.setattr(
+        cli_module,
+        "maybe_notify_newer_version",
+        lambda timeout_seconds=2.0: None,
+    )
+    yield
+    profiling.stop()
+
+
+@pytest.fixture
+def sources(repo_temp_dir):
+    """Three small Python files."""
+    paths = []
+    for index in range(3):
+        path = repo_temp_dir / f"mod{index}.py"
+        path.write_text(
+            f'"""! @brief Module {index}."""\n\n\nclass Item{index}:\n    def run(self):\n        return {index}\n\n\ndef helper_{index}():\n    return 1\n',
+            encoding="utf-8",
+        )
+        paths.append(str(path))
+    return paths
+
+
+def _count_lines(path: str) -> int:
+    """Picklable worker recording one counter per call."""
+    profiling.count("test.calls")
+    with profiling.span("test.work"):
+        return len(path)
+
+
+class TestProfiler:
+    """PRF-001: spans, counters and file times accumulate, merge and report."""
+
+    def test_accumulate_merge_and_report(self):
+        """Merged snapshots add up and the report orders the slowest files first."""
+        profiler = profiling.Profiler()
+        profiler.add_span("analyze", 0.5)
+        profiler.add("read.bytes", 10)
+        profiler.add_file("a.py", 0.1)
+        other = profiling.Profiler()
+        other.add_span("analyze", 0.25, calls=2)
+        other.add("read.bytes", 5)
+        other.add_file("b.py", 0.3)
+        profiler.merge(other.snapshot())
+        report = profiler.report(top=1)
+        assert report["spans"] == [{"name": "analyze", "seconds": 0.75, "calls": 3}]
+        assert report["counters"] == {"read.bytes": 15}
+        assert report["slowest_files"] == [{"path": "b.py", "seconds": 0.3}]
+        table = profiler.format("table")
+        assert "analyze" in table and "read.bytes" in table and "b.py" in table
+        assert json.loads(profiler.format("json"))["counters"] == {"read.bytes": 15}
+        with pytest.raises(ValueError):
+            profiler.format("xml")
+
+    def test_span_records_on_exception(self):
+        """A span that raises is still recorded."""
+        profiler = profiling.start()
+        with pytest.raises(RuntimeError):
+            with profiling.span("boom"):
+                raise RuntimeError("x")
+        profiling.stop()
+        assert profiler.spans["boom"][1] == 1
+
+
+class TestDisabled:
+    """PRF-002: instrumentation is a no-op while profiling is disabled."""
+
+    def test_helpers_do_nothing(self):
+        """span() returns the shared no-op context and nothing is recorded."""
+        assert profiling.active() is None
+        assert profiling.span("a") is profiling.span("b")
+        profiling.count("x")
+        profiling.record_file("a.py", 1.0)
+        assert profiling.active() is None
+
+
+class TestWorkerMerge:
+    """PRF-003: pool workers and subprocess helpers report into the parent profile."""
+
+    def test_process_pool_profiles_are_merged(self, sources):
+        """Counters and per-file times from worker processes reach the parent."""
+        profiler = profiling.start()
+        results = list(iter_ordered(_count_lines, sources, jobs=2))
+        profiling.stop()
+        assert results == [len(path) for path in sources]
+        assert profiler.counters["test.calls"] == len(sources)
+        assert profiler.spans["test.work"][1] == len(sources)
+        assert set(profiler.files) == set(sources)
+
+    def test_static_check_subprocesses_are_counted(self):
+        """Each checker invocation increments `subprocesses.static_check`."""
+        profiler = profiling.start()
+        result = _run_tool([sys.executable, "-c", "pass"])
+        profiling.stop()
+        assert result.returncode == 0
+        assert profiler.counters["subprocesses.static_check"] == 1
+        assert profiler.spans["static_check.subprocess"][1] == 1
+
+
+class TestCliProfile:
+    """PRF-004: `--profile` reports on stderr without changing stdout."""
+
+    def test_table_report(self, sources, capsys):
+        """The table lists pipeline and enrich sub-step spans, counters and slowest files."""
+        assert main(["--files-references", *sources]) == 0
+        plain = capsys.readouterr()
+        assert main(["--files-references", *sources, "--profile"]) == 0
+        profiled = capsys.readouterr()
+        assert profiled.out == plain.out
+        for name in ("command", "read", "analyze", "enrich.hierarchy", "enrich.doxygen_fields", "format_markdown", "write_output",
+                     "analyze.regex_attempts", "elements.CLASS", "read.bytes", "slowest files"):
+            assert name in profiled.err, name
+        assert profiling.active() is None
+
+    def test_json_report_with_jobs(self, sources, capsys):
+        """The JSON report aggregates worker counters under `--jobs`."""
+        assert main(["--files-compress", *sources, "--jobs", "2", "--profile", "--profile-format", "json"]) == 0
+        report = json.loads(capsys.readouterr().err)
+        assert report["counters"]["read.files"] == len(sources)
+        assert {entry["name"] for entry in report["spans"]} >= {"command", "compress", "write_output"}
+        assert len(report["slowest_files"]) == len(sources)
@@ -0,0 +1,160 @@
+"""Tests for the usereq.server module, `--serve`, and command forwarding.
+
+Covers: SRV-001 through SRV-005.
+"""
+
+import io
+import os
+import threading
+import time
+
+import pytest
+
+import usereq.cli as cli_module
+from usereq import analysis_cache, server
+from usereq.cli import _collect_source_files, _main, load_package_version, main
+
+
+@pytest.fixture(autouse=True)
+def _no_release_check(monkeypatch):
+    """Disable the startup release check."""
+    monkeypatch.setattr(
+        cli_module,
+        "maybe_notify_newer_version",
+        lambda timeout_seconds=2.0: None,
+    )
+
+
+@pytest.fixture
+def project(repo_temp_dir, monkeypatch):
+    """Project directory with two Python sources, used as the working directory."""
+    src = repo_temp_dir / "src"
+    src.mkdir()
+    (src / "alpha.py").write_text('def alpha():\n    """Alpha."""\n    return 1\n', encoding="utf-8")
+    (src / "beta.py").write_text("class Beta:\n    def run(self):\n        return 2\n", encoding="utf-8")
+    monkeypatch.chdir(repo_temp_dir)
+    return repo_temp_dir
+
+
+@pytest.fixture
+def running_server(project):
+    """Run `--serve` for the project in a background thread until the test ends."""
+    thread = threading.Thread(target=main, args=(["--serve"],), daemon=True)
+    thread.start()
+    path = server.socket_path(project)
+    deadline = time.monotonic() + 10
+    while not server.is_running(path):
+        assert time.monotonic() < deadline, "server did not start"
+        time.sleep(0.02)
+    yield path
+    server.stop(str(project))
+    thread.join(10)
+    assert not thread.is_alive()
+
+
+def _forward(argv):
+    """Forward a command and capture its exit status, stdout, and stderr."""
+    out, err = io.StringIO(), io.StringIO()
+    status = server.forward(argv, os.getcwd(), load_package_version(), stdout=out, stderr=err)
+    return status, out.getvalue(), err.getvalue()
+
+
+def _local(argv, capsys):
+    """Run a command in-process without forwarding."""
+    status = _main(argv + ["--no-server"])
+    captured = capsys.readouterr()
+    return status, captured.out, captured.err
+
+
+class TestForwarding:
+    """SRV-001: forwarded commands produce the output and status of local runs."""
+
+    def test_output_and_status_match_local_run(self, running_server, capsys):
+        """Stdout, stderr, and exit codes are relayed unchanged, including failures."""
+        capsys.readouterr()
+        for argv in (["--files-compress", "src/alpha.py", "src/beta.py"], ["--files-find", "CLASS", "Missing", "src/beta.py"]):
+            assert _forward(argv) == _local(argv, capsys)
+        assert _forward(["--files-find", "CLASS", "Beta", "src/beta.py"])[0] == 0
+
+    def test_server_rejects_other_commands(self, running_server):
+        """Only forwardable commands run inside the server."""
+        status, out, err = _forward(["--git-check"])
+        assert (status, out) == (1, "")
+        assert "only runs" in err
+
+
+class TestFallback:
+    """SRV-002: without a compatible server the command runs locally."""
+
+    def test_other_version_and_directory(self, project, running_server):
+        """A server of another version refuses, and another directory has no server."""
+        assert server.forward(["--files-compress", "src/alpha.py"], os.getcwd(), "0.0.0-other") is None
+        other = project / "src"
+        assert server.forward(["--files-compress", "alpha.py"], str(other), load_package_version()) is None
+
+    def test_stale_socket_file(self, project, monkeypatch):
+        """A leftover non-socket file does not block local execution."""
+        stale = project / "stale.sock"
+        stale.write_text("", encoding="utf-8")
+        monkeypatch.setattr(server, "socket_path", lambda cwd: stale)
+        assert server.forward(["--files-compress", "src/alpha.py"], os.getcwd(), load_package_version()) is None
+        assert main(["--serve-stop"]) == 1
+
+
+class TestSourceFileMemo:
+    """SRV-003: the served file list is reused only while the tree signature is unchanged."""
+
+    def test_memo_tracks_additions_and_ignores(self, project, monkeypatch):
+        """Creating a file or editing `.gitignore` refreshes the memoized list."""
+        monkeypatch.setattr(cli_module, "_SOURCE_FILES_MEMO", {})
+        first = _collect_source_files(["src"], project)
+        assert [os.path.basename(path) for path in first] == ["alpha.py", "beta.py"]
+        assert _collect_source_files(["src"], project) == first
+        time.sleep(0.01)
+        (project / "src" / "gamma.py").write_text("x = 1\n", encoding="utf-8")
+        assert len(_collect_source_files(["src"], project)) == 3
+        (project / ".gitignore").write_text("src/gamma.py\n", encoding="utf-8")
+        assert _collect_source_files(["src"], project) == first
+
+
+class TestMemoryLayer:
+    """SRV-004: the in-process cache layer serves payloads and stat signatures without disk reads."""
+
+    def test_store_then_load_from_memory(self, project):
+        """A stored payload is returned as the same object after its disk entry is gone."""
+        cache = analysis_cache.AnalysisCache.for_project(project)
+        analysis_cache.enable_memory()
+        try:
+            payload = ["element"]
+            cache.store("ab" * 20, "analysis.python", payload)
+            for entry in cache.objects_dir.rglob("*.analysis.python"):
+                entry.unlink()
+            assert cache.load("ab" * 20, "analysis.python") is payload
+        finally:
+            analysis_cache.disable_memory()
+        assert cache.load("ab" * 20, "analysis.python") is None
+
+
+class TestPrivateSocketDirectory:
+    """SRV-005: sockets are used only inside a private directory owned by the current user."""
+
+    def test_shared_directory_is_not_trusted(self, project, running_server):
+        """A socket directory open to other users makes clients run locally."""
+        directory = running_server.parent
+        mode = os.stat(directory).st_mode & 0o777
+        os.chmod(directory, 0o755)
+        try:
+            assert server.forward(["--files-compress", "src/alpha.py"], os.getcwd(), load_package_version()) is None
+            assert server.stop(str(project)) is False
+        finally:
+            os.chmod(directory, mode)
+        assert server.forward(["--files-compress", "src/alpha.py"], os.getcwd(), load_package_version(), stdout=io.StringIO()) == 0
+
+    def test_serve_refuses_shared_directory(self, project):
+        """The server does not bind below a directory it cannot keep private."""
+        shared = project / "shared"
+        shared.mkdir()
+        os.chmod(shared, 0o777)
+        with pytest.raises(ValueError, match="not a private directory"):
+            server.serve(project, lambda argv: 0, load_package_version(), path=shared / "x.sock", idle_timeout=0.1)
+        assert not (shared / "x.sock").exists()
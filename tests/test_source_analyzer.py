@@ -1,21 +1,31 @@
 """Tests for the usereq.source_analyzer module.
 
-Covers: SRC-001 through SRC-014.
+Covers: SRC-001 through SRC-019.
 Ported and adapted from the original parser test suite.
 """
 
 import os
+import pickle
+import re
 import tempfile
+import tracemalloc
 from collections import Counter
 
 import pytest
 
 from usereq.source_analyzer import (
+    BRACE_LANGUAGES,
+    NO_DOXYGEN_FIELDS,
+    SPEC_REGISTRY,
+    ElementIndex,
     ElementType,
+    LanguageSpec,
+    LanguageSpecRegistry,
     SourceAnalyzer,
     SourceElement,
     build_language_specs,
     format_markdown,
+    get_language_spec,
 )
 
 
@@ -691,6 +701,245 @@ class TestBuildLanguageSpecs:
             assert spec.single_comment is not None
 
 
+class TestLanguageSpecRegistry:
+    """SRC-015: Lazy shared language specification registry."""
+
+    def test_lookup_builds_only_requested_language(self):
+        """A C++ lookup must not compile unrelated languages."""
+        registry = LanguageSpecRegistry()
+        assert "haskell" in registry
+        registry["cpp"]
+        registry["hpp"]
+        assert registry.built_languages() == ["cpp"]
+
+    def test_aliases_resolve_to_same_object(self):
+        """Aliases and canonical keys must return one shared spec."""
+        registry = LanguageSpecRegistry()
+        assert registry["py"] is registry["python"]
+        assert registry["cc"] is registry["cpp"]
+        assert "cobol" not in registry
+        with pytest.raises(KeyError):
+            registry["cobol"]
+
+    def test_keys_match_build_language_specs(self):
+        """Registry keys and patterns must match the eager builder."""
+        registry = LanguageSpecRegistry()
+        specs = build_language_specs()
+        assert list(registry) == list(specs)
+        assert [p.pattern for _, p in registry["rust"].patterns] == [
+            p.pattern for _, p in specs["rust"].patterns
+        ]
+
+    def test_registry_shared_across_analyzers(self):
+        """Analyzers must share compiled specs through SPEC_REGISTRY."""
+        assert SourceAnalyzer().specs is SourceAnalyzer().specs is SPEC_REGISTRY
+        assert get_language_spec(".PY") is SPEC_REGISTRY["python"]
+        assert get_language_spec("cobol") is None
+
+
+class TestFusedConstructMatcher:
+    """SRC-016: Single-pass fused construct pattern dispatch."""
+
+    @pytest.mark.parametrize("language", ALL_LANGUAGES)
+    def test_matches_sequential_scan(self, language):
+        """Fused dispatch must pick the same pattern and groups as the sequential loop."""
+        spec = build_language_specs()[language]
+        assert spec.fused_pattern() is not None
+        with open(fixture_path(language), encoding="utf-8", errors="replace") as handle:
+            for line in handle:
+                line = line.rstrip("\n")
+                expected = next(
+                    ((elem_type, match) for elem_type, pattern in spec.patterns
+                     if (match := pattern.match(line))),
+                    None,
+                )
+                actual = spec.match_construct(line)
+                if expected is None:
+                    assert actual is None
+                else:
+                    assert actual[0] == expected[0]
+                    assert actual[1].groups() == expected[1].groups()
+
+    def test_unfusable_patterns_fall_back(self):
+        """Backreferences disable fusion without changing results."""
+        spec = LanguageSpec(
+            name="Test",
+            patterns=[
+                (ElementType.CONSTANT, re.compile(r"^(\w+)=\1$")),
+                (ElementType.VARIABLE, re.compile(r"^(\w+)=")),
+            ],
+        )
+        assert spec.fused_pattern() is None
+        assert spec.match_construct("a=a")[0] == ElementType.CONSTANT
+        assert spec.match_construct("a=b")[0] == ElementType.VARIABLE
+        assert spec.match_construct("nothing") is None
+
+
+class TestElementIndex:
+    """SRC-017: Per-file interval index for hierarchy and doc-comment lookups."""
+
+    @staticmethod
+    def _elem(kind, start, end, name=None, extract="x"):
+        return SourceElement(element_type=kind, line_start=start, line_end=end,
+                             extract=extract, name=name)
+
+    def test_innermost_enclosing_container(self):
+        """Nested containers resolve to the latest-starting, then shortest, span."""
+        outer = self._elem(ElementType.NAMESPACE, 1, 50, "ns")
+        cls = self._elem(ElementType.CLASS, 5, 40, "Outer")
+        inner = self._elem(ElementType.STRUCT, 10, 20, "Inner")
+        same_start = self._elem(ElementType.STRUCT, 10, 30, "Wide")
+        method = self._elem(ElementType.METHOD, 12, 14, "m")
+        late = self._elem(ElementType.FUNCTION, 25, 26, "f")
+        stray = self._elem(ElementType.FUNCTION, 60, 61, "g")
+        index = ElementIndex([outer, cls, same_start, inner, method, late, stray])
+        assert index.enclosing_container(method) is inner
+        assert index.enclosing_container(late) is same_start
+        assert index.enclosing_container(stray) is None
+
+    def test_doc_comment_rules(self):
+        """Preceding, blocked, postfix, and Doxygen-only distant comments resolve like the linear scan."""
+        doc = self._elem(ElementType.COMMENT_SINGLE, 1, 1, extract="/// @brief F")
+        func = self._elem(ElementType.FUNCTION, 2, 5, "f")
+        blocked = self._elem(ElementType.COMMENT_SINGLE, 7, 7, extract="// note")
+        var = self._elem(ElementType.VARIABLE, 8, 8, "v")
+        target = self._elem(ElementType.FUNCTION, 9, 9, "g")
+        postfix = self._elem(ElementType.COMMENT_SINGLE, 10, 10, extract="//!< @brief G")
+        far_doc = self._elem(ElementType.COMMENT_MULTI, 20, 22, extract="/** @brief H */")
+        plain = self._elem(ElementType.COMMENT_SINGLE, 24, 24, extract="// plain")
+        far_target = self._elem(ElementType.FUNCTION, 30, 31, "h")
+        index = ElementIndex([doc, func, blocked, var, target, postfix, far_doc, plain, far_target])
+        assert index.doc_comment(func) is doc
+        assert index.doc_comment(var) is blocked
+        assert index.doc_comment(target) is postfix
+        assert index.doc_comment(far_target) is far_doc
+
+    def test_preceding_block_merges_contiguous_comments(self):
+        """Adjacent standalone comments merge top-down into one block."""
+        first = self._elem(ElementType.COMMENT_SINGLE, 3, 3, extract="# @brief A")
+        second = self._elem(ElementType.COMMENT_SINGLE, 4, 4, extract="# @param x X")
+        gap = self._elem(ElementType.COMMENT_SINGLE, 1, 1, extract="# header")
+        index = ElementIndex([gap, first, second])
+        assert index.preceding_block(second) == [first, second]
+
+    def test_enrich_matches_pairwise_scan_on_generated_header(self, tmp_path):
+        """Hierarchy and Doxygen fields of many sibling structs match a brute-force containment scan."""
+        lines = []
+        for i in range(200):
+            lines += [f"/// @brief S{i}", f"struct S{i} {{", f"  int f{i}(int x) {{ return x; }}", "};"]
+        path = tmp_path / "gen.hpp"
+        path.write_text("\n".join(lines) + "\n", encoding="utf-8")
+        analyzer = SourceAnalyzer()
+        elements = analyzer.enrich(analyzer.analyze(str(path), "cpp"), "cpp", filepath=str(path))
+        structs = [e for e in elements if e.element_type == ElementType.STRUCT]
+        assert len(structs) == 200
+        assert all(e.doxygen_fields.get("brief") == [e.name] for e in structs)
+        for elem in elements:
+            if elem.element_type in (ElementType.FUNCTION, ElementType.METHOD):
+                owners = [c for c in structs if c.line_start <= elem.line_start and c.line_end >= elem.line_end]
+                assert elem.parent_name == owners[-1].name
+
+
+class TestCompactElements:
+    """SRC-018: Slotted elements derive their text from the shared source lines."""
+
+    SOURCE = (
+        "/*\n * @brief Widget.\n * @details Long\n * block\n * comment.\n */\n"
+        "int widget(int a) {\n    return a;\n}\n"
+    )
+
+    @pytest.fixture
+    def elements(self, tmp_path):
+        path = tmp_path / "widget.c"
+        path.write_text(self.SOURCE, encoding="utf-8")
+        analyzer = SourceAnalyzer()
+        return analyzer.enrich(analyzer.analyze(str(path), "c"), "c", filepath=str(path))
+
+    def test_records_share_source_and_defaults(self, elements):
+        """Elements have no instance dict, reference one line list, and share empty defaults."""
+        assert all(not hasattr(elem, "__dict__") for elem in elements)
+        assert len({id(elem._lines) for elem in elements if elem._lines is not None}) == 1
+        comment = next(e for e in elements if e.element_type == ElementType.COMMENT_MULTI)
+        assert comment.doxygen_fields is NO_DOXYGEN_FIELDS or comment.doxygen_fields == {}
+        with pytest.raises(TypeError):
+            NO_DOXYGEN_FIELDS["brief"] = ["x"]
+
+    def test_derived_text_matches_materialized_fields(self, elements):
+        """Lazy extract, first line and full comment text follow the SRS-133 truncation rules."""
+        comment = next(e for e in elements if e.element_type == ElementType.COMMENT_MULTI)
+        assert comment.extract == "/*\n * @brief Widget.\n * @details Long\n * block\n    ..."
+        assert comment.extract_lines() == comment.extract.split("\n")
+        assert comment.first_line == "/*"
+        assert comment.comment_source == "\n".join(self.SOURCE.split("\n")[:6])
+        assert comment.search_text(re.compile(r"@details")) and not comment.search_text(re.compile(r"@file"))
+        func = next(e for e in elements if e.element_type == ElementType.FUNCTION)
+        assert func.extract == "int widget(int a) {\n    return a;\n}"
+
+    def test_pickle_round_trip_materializes_text(self, elements):
+        """Pickled elements compare equal and no longer reference the source lines."""
+        restored = pickle.loads(pickle.dumps(elements))
+        assert restored == elements
+        assert all(elem._lines is None for elem in restored)
+        assert restored[0].extract == elements[0].extract
+
+
+class TestStreamingAnalysis:
+    """SRC-019: Bounded-memory streaming analysis of brace-language files."""
+
+    @pytest.mark.parametrize("language", [lang for lang in ALL_LANGUAGES if lang in BRACE_LANGUAGES])
+    def test_stream_matches_analyze(self, language, analyzer):
+        """Streamed elements and markdown equal analyze() + enrich() output."""
+        path = fixture_path(language)
+        expected = analyzer.enrich(analyzer.analyze(path, language), language, filepath=path)
+        streamed, total_lines = analyzer.analyze_stream(path, language)
+        analyzer.enrich(streamed, language, filepath=path, annotate_bodies=False)
+        assert streamed == expected
+        spec = analyzer.specs[language]
+        with open(path, "r", encoding="utf-8", errors="replace") as f:
+            assert total_lines == sum(1 for _ in f)
+        assert (format_markdown(streamed, path, language, spec.name, total_lines)
+                == format_markdown(expected, path, language, spec.name, total_lines))
+
+    def test_elements_are_yielded_before_end_of_input(self, analyzer):
+        """Resolved elements leave the generator while later lines are still unread."""
+        consumed = []
+
+        def lines():
+            for i in range(1000):
+                consumed.append(i)
+                yield f"int f{i}(void) {{\n"
+                yield "    return 0;\n"
+                yield "}\n"
+
+        stream = analyzer.iter_stream(lines(), "c")
+        first = next(stream)
+        assert (first.line_start, first.line_end) == (1, 3)
+        assert len(consumed) < 5
+
+    def test_non_brace_language_is_rejected(self, analyzer):
+        """Indentation-delimited languages cannot be streamed."""
+        with pytest.raises(ValueError):
+            list(analyzer.iter_stream(iter(["def f():\n"]), "python"))
+
+    def test_memory_does_not_grow_with_file_size(self, tmp_path, analyzer):
+        """Peak allocation while streaming stays far below the file size."""
+        path = tmp_path / "table.cpp"
+        row = "    {" + ", ".join(["0x7f"] * 24) + "},\n"
+        with open(path, "w", encoding="utf-8") as f:
+            f.write("static const unsigned char kTable[][24] = {\n")
+            f.writelines(row for _ in range(40000))
+            f.write("};\n")
+        size = os.path.getsize(path)
+        tracemalloc.start()
+        try:
+            elements, total_lines = analyzer.analyze_stream(str(path), "cpp")
+            _, peak = tracemalloc.get_traced_memory()
+        finally:
+            tracemalloc.stop()
+        assert total_lines == 40002
+        assert peak < size // 10
+
+
 class TestFormatMarkdown:
     """SRC-010: format_markdown() tests."""
 
@@ -0,0 +1,95 @@
+"""Tests for the usereq.source_buffer module.
+
+Covers: BUF-001 through BUF-004.
+"""
+
+import subprocess
+
+import pytest
+
+import usereq.source_buffer as source_buffer_module
+from usereq.compress import compress_file, compress_source
+from usereq.source_analyzer import SourceAnalyzer
+from usereq.source_buffer import SourceBuffer
+
+PAYLOADS = [
+    b"def foo():\n    return 1\n",
+    b"no trailing newline\nsecond",
+    b"crlf\r\nline\r\nlone\rcr\n",
+    b"bad \xff\xfe utf8\n\x0bvertical tab\x0cform feed\n",
+    b"",
+]
+
+
+class TestReadlinesEquivalence:
+    """BUF-001: Lines and counts match text-mode file reading."""
+
+    @pytest.mark.parametrize("payload", PAYLOADS)
+    def test_lines_match_readlines(self, tmp_path, payload):
+        path = tmp_path / "sample.py"
+        path.write_bytes(payload)
+        with open(path, "r", encoding="utf-8", errors="replace") as handle:
+            expected = handle.readlines()
+        buffer = SourceBuffer.from_path(str(path))
+        assert buffer.lines == expected
+        assert buffer.line_count == len(expected)
+        with open(path, "r", encoding="utf-8", errors="replace") as handle:
+            assert buffer.text == handle.read()
+
+    def test_mmap_path_matches_read_path(self, tmp_path, monkeypatch):
+        path = tmp_path / "big.c"
+        path.write_bytes(b"int main(void) {\r\n  return 0;\r\n}\r\n" * 50)
+        small = SourceBuffer.from_path(str(path))
+        monkeypatch.setattr(source_buffer_module, "MMAP_THRESHOLD_BYTES", 1)
+        mapped = SourceBuffer.from_path(str(path))
+        assert mapped.lines == small.lines
+        assert mapped.digest == small.digest
+
+
+class TestLineIndex:
+    """BUF-002: Line offset index lookups."""
+
+    def test_offsets_and_line_lookup(self):
+        buffer = SourceBuffer("ab\ncde\n\nf")
+        assert buffer.line_offsets == [0, 3, 7, 8]
+        assert buffer.line_of_offset(0) == 1
+        assert buffer.line_of_offset(4) == 2
+        assert buffer.line_of_offset(8) == 4
+        assert buffer.slice_lines(2, 3) == ["cde\n", "\n"]
+
+
+class TestDigest:
+    """BUF-003: Digest equals the git blob object id of the raw bytes."""
+
+    def test_digest_matches_git(self, tmp_path):
+        path = tmp_path / "a.py"
+        path.write_bytes(b"x = 1\r\n")
+        expected = subprocess.run(
+            ["git", "hash-object", "--no-filters", str(path)],
+            check=True,
+            capture_output=True,
+            text=True,
+        ).stdout.strip()
+        assert SourceBuffer.from_path(str(path)).digest == expected
+
+
+class TestSharedConsumers:
+    """BUF-004: Analyzer and compressor results do not depend on buffer reuse."""
+
+    def test_analyze_and_enrich_with_buffer(self, fixtures_dir):
+        path = f"{fixtures_dir}/fixture_python.py"
+        analyzer = SourceAnalyzer()
+        expected = analyzer.enrich(analyzer.analyze(path, "python"), "python", filepath=path)
+        buffer = SourceBuffer.from_path(path)
+        actual = analyzer.enrich(
+            analyzer.analyze(path, "python", source=buffer),
+            "python",
+            filepath=path,
+            source=buffer,
+        )
+        assert actual == expected
+
+    def test_compress_with_buffer(self, fixtures_dir):
+        path = f"{fixtures_dir}/fixture_python.py"
+        buffer = SourceBuffer.from_path(path)
+        assert compress_source(buffer, "python") == compress_file(path, "python")
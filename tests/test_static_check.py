@@ -17,6 +17,8 @@
   - --enable-static-check config persistence (SRS-262)
   - Language name case-insensitivity (SRS-262)
   - fail_only mode suppressing output on pass for each checker class (SRS-247)
+  - concurrent and batched static-check scheduling (SRS-384)
+  - content-addressed static-check verdict cache (SRS-395)
 @author useReq
 @version 0.0.72
 """
@@ -38,11 +40,13 @@ from usereq.static_check import (
     StaticCheckBase,
     StaticCheckCommand,
     StaticCheckPylance,
+    StaticCheckResultCache,
     StaticCheckRuff,
     _resolve_files,
     dispatch_static_check_for_file,
     parse_enable_static_check,
     run_static_check,
+    run_static_check_plan,
 )
 from usereq.cli import ReqError
 
@@ -1910,5 +1914,227 @@ class TestEnableStaticCheckConfigPersistence(unittest.TestCase):
         )
 
 
+
+# ---------------------------------------------------------------------------
+# run_static_check_plan scheduling tests (SRS-384)
+# ---------------------------------------------------------------------------
+
+class TestStaticCheckPlanScheduling(unittest.TestCase):
+    """!
+    @brief Tests for concurrent and batched static-check scheduling (SRS-384).
+    @details Covers: plan-ordered output under concurrency, single-invocation batches
+      for passing groups, per-file recheck of failing groups, and non-batchable commands.
+    """
+
+    def setUp(self) -> None:
+        self.tmp = TEMP_BASE / "plan"
+        if self.tmp.exists():
+            shutil.rmtree(self.tmp)
+        self.files = [
+            str(_make_temp_file(self.tmp, f"mod{index}.py").resolve()) for index in range(6)
+        ]
+
+    def tearDown(self) -> None:
+        if self.tmp.exists():
+            shutil.rmtree(self.tmp)
+
+    @staticmethod
+    def _fake_run(failing: set[str], delay: bool = False):
+        """Build a subprocess.run replacement failing whenever a failing path is checked."""
+        import time
+
+        calls: list[list[str]] = []
+
+        def _run(cmd, **kwargs):
+            calls.append(list(cmd))
+            bad = [arg for arg in cmd if arg in failing]
+            if delay:
+                time.sleep(0.002 * (len(cmd) % 3))
+            if bad:
+                return MagicMock(returncode=1, stdout=f"error in {', '.join(bad)}\n", stderr="")
+            return MagicMock(returncode=0, stdout="", stderr="")
+
+        return _run, calls
+
+    def _run_plan(self, configs: list[dict], failing: set[str], **kwargs) -> tuple[int, str, list]:
+        fake, calls = self._fake_run(failing, delay=True)
+        plan = [(path, configs) for path in self.files]
+        out = StringIO()
+        with patch("subprocess.run", side_effect=fake):
+            with patch("sys.stdout", out):
+                rc = run_static_check_plan(plan, project_base=self.tmp, **kwargs)
+        return rc, out.getvalue(), calls
+
+    def test_concurrent_output_matches_sequential(self) -> None:
+        """Concurrent dispatch prints the same per-file blocks in plan order."""
+        configs = [{"module": "Ruff"}, {"module": "Pylance"}]
+        failing = {self.files[1], self.files[4]}
+        rc_seq, out_seq, calls_seq = self._run_plan(configs, failing, jobs=1)
+        rc_par, out_par, calls_par = self._run_plan(configs, failing, jobs=4)
+        self.assertEqual((rc_seq, out_seq), (1, out_par))
+        self.assertEqual(rc_par, 1)
+        self.assertEqual(len(calls_seq), 12)
+        self.assertEqual(len(calls_par), 12)
+        self.assertLess(out_seq.index(self.files[1]), out_seq.index(self.files[4]))
+        self.assertIn("# Static-Check(Ruff): " + self.files[1], out_seq)
+
+    def test_batch_passing_group_uses_one_invocation(self) -> None:
+        """A passing batch replaces every per-file invocation of its tool."""
+        rc, out, calls = self._run_plan([{"module": "Ruff"}], set(), jobs=4, batch=True)
+        self.assertEqual(rc, 0)
+        self.assertEqual(out, "")
+        self.assertEqual(len(calls), 1)
+        self.assertEqual(calls[0][:4], [sys.executable, "-m", "ruff", "check"])
+        self.assertEqual(calls[0][4:], self.files)
+
+    def test_batch_failing_group_is_demultiplexed_per_file(self) -> None:
+        """A failing batch is rechecked per file, reproducing the non-batched output."""
+        configs = [{"module": "Pylance"}]
+        failing = {self.files[2]}
+        rc_plain, out_plain, _ = self._run_plan(configs, failing, jobs=2)
+        rc_batch, out_batch, calls = self._run_plan(configs, failing, jobs=2, batch=True)
+        self.assertEqual((rc_plain, rc_batch), (1, 1))
+        self.assertEqual(out_batch, out_plain)
+        self.assertEqual(len(calls), 1 + len(self.files))
+        self.assertIn("Result: FAIL", out_batch)
+
+    def test_batch_skips_commands_without_multi_path_support(self) -> None:
+        """Only BATCH_COMMANDS entries are batched; other commands keep per-file runs."""
+        configs = [
+            {"module": "Command", "cmd": "cppcheck", "params": ["--error-exitcode=1"]},
+            {"module": "Command", "cmd": "node", "params": ["--check"]},
+        ]
+        with patch("shutil.which", return_value="/usr/bin/tool"):
+            rc, _, calls = self._run_plan(configs, set(), jobs=3, batch=True)
+        self.assertEqual(rc, 0)
+        cppcheck_calls = [call for call in calls if call[0] == "cppcheck"]
+        node_calls = [call for call in calls if call[0] == "node"]
+        self.assertEqual(cppcheck_calls, [["cppcheck", "--error-exitcode=1", *self.files]])
+        self.assertEqual(len(node_calls), len(self.files))
+
+    def test_cli_static_check_batch_flag(self) -> None:
+        """--files-static-check --static-check-batch batches configured Ruff checks."""
+        import json
+
+        from usereq import cli
+
+        (self.tmp / ".req").mkdir()
+        (self.tmp / ".req" / "config.json").write_text(
+            json.dumps({"src-dir": ["."], "static-check": {"Python": [{"module": "Ruff"}]}}),
+            encoding="utf-8",
+        )
+        fake, calls = self._fake_run(set())
+        with patch("subprocess.run", side_effect=fake):
+            with patch("builtins.print"):
+                rc = cli.main(
+                    ["--base", str(self.tmp), "--files-static-check", *self.files, "--static-check-batch", "--jobs", "2"]
+                )
+        self.assertEqual(rc, 0)
+        self.assertEqual(len(calls), 1)
+
+
+class TestStaticCheckResultCache(unittest.TestCase):
+    """!
+    @brief Tests for the content-addressed static-check verdict cache (SRS-395).
+    @details Covers: byte-identical replay without subprocesses, invalidation on file, params,
+      tool, and tool-config changes, batch pass recording, and the CLI `--no-cache` bypass.
+    """
+
+    def setUp(self) -> None:
+        from usereq.analysis_cache import AnalysisCache
+
+        self.tmp = TEMP_BASE / "result_cache"
+        if self.tmp.exists():
+            shutil.rmtree(self.tmp)
+        self.files = [
+            str(_make_temp_file(self.tmp, f"mod{index}.py", f"x = {index}\n").resolve()) for index in range(4)
+        ]
+        self.cache = AnalysisCache(self.tmp / ".req" / "cache")
+
+    def tearDown(self) -> None:
+        if self.tmp.exists():
+            shutil.rmtree(self.tmp)
+
+    def _run_plan(self, configs: list[dict], failing: set[str], **kwargs) -> tuple[int, str, list]:
+        fake, calls = TestStaticCheckPlanScheduling._fake_run(failing)
+        plan = [(path, configs) for path in self.files]
+        out = StringIO()
+        with patch("subprocess.run", side_effect=fake):
+            with patch("sys.stdout", out):
+                rc = run_static_check_plan(
+                    plan,
+                    project_base=self.tmp,
+                    result_cache=StaticCheckResultCache(self.cache, self.tmp),
+                    **kwargs,
+                )
+        return rc, out.getvalue(), calls
+
+    def test_replay_is_identical_without_subprocess(self) -> None:
+        """A warm run prints the cold run's FAIL blocks and exit code without running tools."""
+        configs = [{"module": "Ruff"}, {"module": "Pylance"}]
+        failing = {self.files[1]}
+        cold = self._run_plan(configs, failing, jobs=2)
+        warm = self._run_plan(configs, failing, jobs=2)
+        self.assertEqual(len(cold[2]), 8)
+        self.assertEqual(warm[2], [])
+        self.assertEqual(warm[:2], cold[:2])
+        self.assertIn("error in " + self.files[1], warm[1])
+
+    def test_changes_select_new_entries(self) -> None:
+        """Edited files, changed params, another tool version, and edited tool config miss the cache."""
+        self._run_plan([{"module": "Ruff"}], set(), jobs=1)
+        Path(self.files[0]).write_text("x = 100\n", encoding="utf-8")
+        _, _, calls = self._run_plan([{"module": "Ruff"}], set(), jobs=1)
+        self.assertEqual([call[4] for call in calls], [self.files[0]])
+        _, _, calls = self._run_plan([{"module": "Ruff", "params": ["--select", "E"]}], set(), jobs=1)
+        self.assertEqual(len(calls), len(self.files))
+        with patch("importlib.metadata.version", return_value="999.0"):
+            _, _, calls = self._run_plan([{"module": "Ruff"}], set(), jobs=1)
+        self.assertEqual(len(calls), len(self.files))
+        (self.tmp / "ruff.toml").write_text("line-length = 80\n", encoding="utf-8")
+        _, _, calls = self._run_plan([{"module": "Ruff"}], set(), jobs=1)
+        self.assertEqual(len(calls), len(self.files))
+
+    def test_batch_pass_is_recorded_per_file(self) -> None:
+        """A passing batch caches every file, so the next run spawns nothing."""
+        _, _, calls = self._run_plan([{"module": "Ruff"}], set(), jobs=2, batch=True)
+        self.assertEqual(len(calls), 1)
+        rc, out, calls = self._run_plan([{"module": "Ruff"}], set(), jobs=2, batch=True)
+        self.assertEqual((rc, out, calls), (0, "", []))
+
+    def test_missing_tool_is_not_cached(self) -> None:
+        """A tool that cannot start is retried on the next run."""
+        checker = StaticCheckRuff(
+            inputs=[self.files[0]], fail_only=True, sink=[], result_cache=StaticCheckResultCache(self.cache, self.tmp)
+        )
+        with patch("subprocess.run", side_effect=FileNotFoundError):
+            self.assertEqual(checker.run(), 1)
+        with patch("subprocess.run", return_value=MagicMock(returncode=0, stdout="", stderr="")) as mock_run:
+            self.assertEqual(checker.run(), 0)
+        mock_run.assert_called_once()
+
+    def test_cli_no_cache_bypasses_verdicts(self) -> None:
+        """--files-static-check reuses verdicts under .req/cache unless --no-cache is set."""
+        import json
+
+        from usereq import cli
+
+        subprocess.run(["git", "init", "-q", str(self.tmp)], check=True)
+        (self.tmp / ".req").mkdir()
+        (self.tmp / ".req" / "config.json").write_text(
+            json.dumps({"src-dir": ["."], "static-check": {"Python": [{"module": "Ruff"}]}}),
+            encoding="utf-8",
+        )
+        argv = ["--base", str(self.tmp), "--files-static-check", *self.files, "--jobs", "1"]
+        counts = []
+        for extra in ([], [], ["--no-cache"]):
+            fake, calls = TestStaticCheckPlanScheduling._fake_run(set())
+            with patch("subprocess.run", side_effect=fake):
+                with patch("builtins.print"):
+                    self.assertEqual(cli.main(argv + extra), 0)
+            counts.append(len(calls))
+        self.assertEqual(counts, [len(self.files), 0, len(self.files)])
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,138 @@
+"""Tests for the usereq.symbol_index module and index-backed construct queries.
+
+Covers: SYM-001 through SYM-004.
+"""
+
+import os
+
+import usereq.find_constructs as find_constructs_module
+import usereq.symbol_index as symbol_index_module
+from usereq.analysis_cache import AnalysisCache
+from usereq.find_constructs import find_constructs_in_files
+from usereq.symbol_index import SymbolIndex, literal_prefix
+
+
+def _age(path, seconds: int = 60) -> None:
+    """Move a file mtime into the past so its stat signature is not racy."""
+    st = os.stat(path)
+    os.utime(path, ns=(st.st_atime_ns, st.st_mtime_ns - seconds * 1_000_000_000))
+
+
+def _write(path, text: str) -> None:
+    """Write a source file with a non-racy mtime."""
+    path.write_text(text, encoding="utf-8")
+    _age(path)
+
+
+def _tracking(monkeypatch):
+    """Record the paths analyzed through the index worker."""
+    calls = []
+    original = symbol_index_module._index_file
+
+    def _wrapper(path, *args, **kwargs):
+        calls.append(os.path.basename(path))
+        return original(path, *args, **kwargs)
+
+    monkeypatch.setattr(symbol_index_module, "_index_file", _wrapper)
+    return calls
+
+
+class TestLiteralPrefix:
+    """SYM-001: Only anchored literal prefixes select the bisect path."""
+
+    def test_extracts_conservative_prefixes(self):
+        assert literal_prefix("^run_find$") == "run_find"
+        assert literal_prefix(r"^get\.value") == "get.value"
+        assert literal_prefix("^run_files?_") == "run_file"
+        assert literal_prefix("^ab{2}") == "a"
+        assert literal_prefix("^[a-z]") is None
+        assert literal_prefix("run") is None
+        assert literal_prefix("^x|main") is None
+        assert literal_prefix(r"^\w+") is None
+
+
+class TestSymbolIndexRefresh:
+    """SYM-002: Warm queries re-analyze only files whose stat signature changed."""
+
+    def test_reanalyzes_only_stale_files(self, repo_temp_dir, monkeypatch):
+        first = repo_temp_dir / "a.py"
+        second = repo_temp_dir / "b.py"
+        _write(first, "def alpha():\n    return 1\n")
+        _write(second, "def beta():\n    return 2\n")
+        cache = AnalysisCache(repo_temp_dir / "cache", fingerprint="f" * 40)
+        calls = _tracking(monkeypatch)
+        files = [str(first), str(second)]
+
+        index = SymbolIndex.for_cache(cache)
+        index.refresh(files)
+        index.save()
+        assert sorted(calls) == ["a.py", "b.py"]
+
+        calls.clear()
+        entries = SymbolIndex.for_cache(cache).refresh(files)
+        assert calls == []
+        assert [record.name for record in entries[str(first)].records] == ["alpha"]
+
+        _write(second, "def gamma():\n    return 3\n\n\ndef delta():\n    pass\n")
+        calls.clear()
+        entries = SymbolIndex.for_cache(cache).refresh(files)
+        assert calls == ["b.py"]
+        assert [record.name for record in entries[str(second)].records] == ["gamma", "delta"]
+
+    def test_missing_file_is_dropped(self, repo_temp_dir):
+        path = repo_temp_dir / "a.py"
+        _write(path, "def alpha():\n    return 1\n")
+        index = SymbolIndex.for_cache(AnalysisCache(repo_temp_dir / "cache", fingerprint="f" * 40))
+        index.refresh([str(path)])
+        path.unlink()
+        assert index.refresh([str(path)]) == {str(path): None}
+        assert index.files == {}
+        assert index.names == []
+
+
+class TestPrefixCandidates:
+    """SYM-003: Literal-prefix lookups bisect the sorted name table."""
+
+    def test_returns_only_prefixed_records(self, repo_temp_dir):
+        path = repo_temp_dir / "a.py"
+        _write(path, "def run_a():\n    pass\n\n\ndef other():\n    pass\n\n\ndef run_b():\n    pass\n")
+        index = SymbolIndex.for_cache(AnalysisCache(repo_temp_dir / "cache", fingerprint="f" * 40))
+        entry = index.refresh([str(path)])[str(path)]
+        candidates = index.prefix_candidates("run_")
+        assert [entry.records[position].name for position in candidates[str(path)]] == ["run_a", "run_b"]
+        assert index.prefix_candidates("zzz") == {}
+
+
+class TestIndexedFind:
+    """SYM-004: Index-backed queries render the same output as full scans."""
+
+    def test_output_matches_uncached_scan(self, repo_temp_dir, monkeypatch):
+        module = repo_temp_dir / "mod.py"
+        _write(
+            module,
+            '"""!\n@file mod.py\n@brief Module.\n"""\n\n\n'
+            "class Runner:\n"
+            '    """! @brief Runner class."""\n\n'
+            "    def run_fast(self):\n"
+            '        """! @brief Fast path.\n        @return None.\n        """\n'
+            "        return None\n\n\n"
+            "def run_slow():\n    return 1\n",
+        )
+        other = repo_temp_dir / "lib.c"
+        _write(other, "int run_c(void) {\n    return 0;\n}\n")
+        files = [str(module), str(other), str(repo_temp_dir / "missing.py")]
+        cache = AnalysisCache(repo_temp_dir / "cache", fingerprint="f" * 40)
+        for tag, pattern in (("FUNCTION", "^run_"), ("CLASS|FUNCTION", ".*"), ("FUNCTION", "slow$")):
+            expected = find_constructs_in_files(files, tag, pattern, True)
+            assert find_constructs_in_files(files, tag, pattern, True, cache=cache) == expected
+
+        analyzed = []
+        original = find_constructs_module.load_analysis
+        monkeypatch.setattr(
+            find_constructs_module,
+            "load_analysis",
+            lambda *args, **kwargs: analyzed.append(args[1]) or original(*args, **kwargs),
+        )
+        output = find_constructs_in_files(files, "FUNCTION", "^run_fast$", False, cache=cache)
+        assert "run_fast" in output and "Fast path." in output
+        assert analyzed == []
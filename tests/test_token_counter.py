@@ -1,17 +1,21 @@
 """Tests for the usereq.token_counter module.
 
-Covers: TOK-001 through TOK-006.
+Covers: TOK-001 through TOK-009.
 """
 
+import io
 import os
 import tempfile
 
 
+import usereq.token_counter as token_counter_module
+from usereq.analysis_cache import AnalysisCache
 from usereq.token_counter import (
     TokenCounter,
     count_file_metrics,
     count_files_metrics,
     format_pack_summary,
+    get_token_counter,
 )
 
 
@@ -148,3 +152,73 @@ class TestTokenCounterErrorHandling:
         # Normal strings should work
         result = counter.count_tokens("normal text")
         assert result > 0
+
+
+class TestBatchCounting:
+    """TOK-007: One counter per process and batch encoding."""
+
+    def test_counter_is_shared(self):
+        """get_token_counter must return one instance per encoding."""
+        assert get_token_counter() is get_token_counter("cl100k_base")
+
+    def test_batch_matches_single_counts(self):
+        """Batch counts must equal per-document counts in input order."""
+        counter = get_token_counter()
+        contents = ["alpha beta", "", "def foo():\n    return 42\n"]
+        assert counter.count_tokens_batch(contents) == [counter.count_tokens(c) for c in contents]
+
+    def test_files_are_encoded_in_one_batch(self, repo_temp_dir, monkeypatch):
+        """count_files_metrics must tokenize small files through one batch call."""
+        paths = []
+        for i in range(3):
+            path = repo_temp_dir / f"f{i}.md"
+            path.write_text(f"line {i}\n" * (i + 1), encoding="utf-8")
+            paths.append(str(path))
+        calls = []
+        counter = get_token_counter()
+        original = counter.count_tokens_batch
+        monkeypatch.setattr(counter, "count_tokens_batch", lambda contents: calls.append(len(contents)) or original(contents))
+        results = count_files_metrics(paths)
+        assert calls == [3]
+        assert [r["tokens"] for r in results] == [counter.count_tokens(open(p).read()) for p in paths]
+
+
+class TestStreamingCounting:
+    """TOK-008: Chunked counting equals whole-content counting."""
+
+    def test_stream_matches_whole_content(self):
+        """count_stream must add up to the whole-content count for any chunk size."""
+        counter = get_token_counter()
+        content = "".join(f"def f{i}(x):\n    return x  +  {i}\n\n  \n" for i in range(200))
+        expected = (counter.count_tokens(content), len(content))
+        for chunk in (1, 7, 64, 4096):
+            assert counter.count_stream(io.StringIO(content), chunk_chars=chunk) == expected
+
+    def test_large_files_stream(self, repo_temp_dir, monkeypatch):
+        """Files above the threshold must be counted without batch encoding."""
+        monkeypatch.setattr(token_counter_module, "STREAM_THRESHOLD_BYTES", 16)
+        path = repo_temp_dir / "big.md"
+        content = "word " * 50 + "\nnext line\n"
+        path.write_text(content, encoding="utf-8")
+        result = count_files_metrics([str(path)])[0]
+        assert result == {"file": str(path), "tokens": get_token_counter().count_tokens(content), "chars": len(content)}
+
+
+class TestCachedCounting:
+    """TOK-009: Counts are cached by content digest."""
+
+    def test_warm_run_skips_tokenization(self, repo_temp_dir, monkeypatch):
+        """Unchanged files must be answered from the cache."""
+        path = repo_temp_dir / "doc.md"
+        path.write_text("# Title\n\nSome text.\n", encoding="utf-8")
+        st = os.stat(path)
+        os.utime(path, ns=(st.st_atime_ns, st.st_mtime_ns - 60_000_000_000))
+        cache = AnalysisCache(repo_temp_dir / "cache", fingerprint="f" * 40)
+        cold = count_files_metrics([str(path)], cache=cache)
+        counter = get_token_counter()
+        monkeypatch.setattr(counter, "count_tokens_batch", lambda contents: (_ for _ in ()).throw(AssertionError("tokenized")))
+        assert count_files_metrics([str(path)], cache=cache) == cold
+        path.write_text("# Title\n\nOther text, longer.\n", encoding="utf-8")
+        monkeypatch.undo()
+        changed = count_files_metrics([str(path)], cache=cache)
+        assert changed[0]["chars"] == len("# Title\n\nOther text, longer.\n")
@@ -3,6 +3,10 @@
 import io
 import http.client
 import json
+import os
+import subprocess
+import sys
+import sysconfig
 import tempfile
 import urllib.error
 import unittest
@@ -71,7 +75,7 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                     return_value=idle_path,
                 ):
                     with patch(
-                        "usereq.cli.urllib.request.urlopen",
+                        "urllib.request.urlopen",
                         return_value=urlopen_cm,
                     ) as urlopen_mock:
                         with patch("sys.stdout"):
@@ -111,11 +115,11 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                             ),
                         ):
                             with patch(
-                                "usereq.cli.urllib.request.urlopen",
+                                "urllib.request.urlopen",
                                 return_value=urlopen_cm,
                             ):
                                 with patch("sys.stderr") as fake_stderr:
-                                    cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                                    cli.run_release_check(timeout_seconds=2.0)
 
         written = "".join(call.args[0] for call in fake_stderr.write.call_args_list)
         self.assertIn(cli.ANSI_BRIGHT_GREEN, written)
@@ -148,11 +152,11 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                             ),
                         ):
                             with patch(
-                                "usereq.cli.urllib.request.urlopen",
+                                "urllib.request.urlopen",
                                 side_effect=http_error,
                             ):
                                 with patch("sys.stderr") as fake_stderr:
-                                    cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                                    cli.run_release_check(timeout_seconds=2.0)
             payload = json.loads(idle_path.read_text(encoding="utf-8"))
 
         written = "".join(call.args[0] for call in fake_stderr.write.call_args_list)
@@ -185,11 +189,11 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                             ),
                         ):
                             with patch(
-                                "usereq.cli.urllib.request.urlopen",
+                                "urllib.request.urlopen",
                                 side_effect=network_error,
                             ):
                                 with patch("sys.stderr") as fake_stderr:
-                                    cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                                    cli.run_release_check(timeout_seconds=2.0)
             payload = json.loads(idle_path.read_text(encoding="utf-8"))
 
         written = "".join(call.args[0] for call in fake_stderr.write.call_args_list)
@@ -216,10 +220,10 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                         return_value=idle_path,
                     ):
                         with patch(
-                            "usereq.cli.urllib.request.urlopen",
+                            "urllib.request.urlopen",
                             return_value=urlopen_cm,
                         ) as urlopen_mock:
-                            cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                            cli.run_release_check(timeout_seconds=2.0)
 
         urlopen_call = urlopen_mock.call_args
         request_object = urlopen_call.args[0]
@@ -247,8 +251,8 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                         "usereq.cli.get_release_check_idle_file_path",
                         return_value=idle_path,
                     ):
-                        with patch("usereq.cli.urllib.request.urlopen") as urlopen_mock:
-                            cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                        with patch("urllib.request.urlopen") as urlopen_mock:
+                            cli.run_release_check(timeout_seconds=2.0)
 
         urlopen_mock.assert_not_called()
 
@@ -311,10 +315,10 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                         return_value=idle_path,
                     ):
                         with patch(
-                            "usereq.cli.urllib.request.urlopen",
+                            "urllib.request.urlopen",
                             return_value=urlopen_cm,
                         ) as urlopen_mock:
-                            cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                            cli.run_release_check(timeout_seconds=2.0)
 
         urlopen_mock.assert_called_once()
 
@@ -342,10 +346,10 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                             ),
                         ):
                             with patch(
-                                "usereq.cli.urllib.request.urlopen",
+                                "urllib.request.urlopen",
                                 return_value=urlopen_cm,
                             ):
-                                cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                                cli.run_release_check(timeout_seconds=2.0)
 
             payload = json.loads(idle_path.read_text(encoding="utf-8"))
 
@@ -389,11 +393,11 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                             ),
                         ):
                             with patch(
-                                "usereq.cli.urllib.request.urlopen",
+                                "urllib.request.urlopen",
                                 return_value=urlopen_cm,
                             ):
                                 with patch("sys.stderr") as fake_stderr:
-                                    cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                                    cli.run_release_check(timeout_seconds=2.0)
             payload = json.loads(idle_path.read_text(encoding="utf-8"))
 
         written = "".join(call.args[0] for call in fake_stderr.write.call_args_list)
@@ -433,10 +437,10 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                             ),
                         ):
                             with patch(
-                                "usereq.cli.urllib.request.urlopen",
+                                "urllib.request.urlopen",
                                 side_effect=http_error,
                             ):
-                                cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                                cli.run_release_check(timeout_seconds=2.0)
 
             payload = json.loads(idle_path.read_text(encoding="utf-8"))
 
@@ -476,10 +480,10 @@ class TestOnlineUpdateCheck(unittest.TestCase):
                             ),
                         ):
                             with patch(
-                                "usereq.cli.urllib.request.urlopen",
+                                "urllib.request.urlopen",
                                 side_effect=http_error,
                             ):
-                                cli.maybe_notify_newer_version(timeout_seconds=2.0)
+                                cli.run_release_check(timeout_seconds=2.0)
 
             payload = json.loads(idle_path.read_text(encoding="utf-8"))
 
@@ -561,3 +565,180 @@ class TestOnlineUpdateCheck(unittest.TestCase):
             ],
             check=False,
         )
+
+
+class TestBackgroundReleaseCheck(unittest.TestCase):
+    """Verifies that startup release checks never wait on the network without --ver."""
+
+    NOW = 1700000000
+
+    def _idle_state(self, idle_until: int, latest_version: str | None = None) -> dict:
+        state = {
+            "last_success_timestamp": self.NOW - 7200,
+            "last_success_human_readable_timestamp": "2023-11-14T20:13:20Z",
+            "idle_until_timestamp": idle_until,
+            "idle_until_human_readable_timestamp": cli.format_unix_timestamp_utc(idle_until),
+        }
+        if latest_version is not None:
+            state["latest_version"] = latest_version
+        return state
+
+    def _notify(self, idle_path: Path) -> tuple[MagicMock, MagicMock, str]:
+        with patch("usereq.cli.load_package_version", return_value="0.0.1"):
+            with patch("usereq.cli.time.time", return_value=self.NOW):
+                with patch("usereq.cli.get_release_check_idle_file_path", return_value=idle_path):
+                    with patch("urllib.request.urlopen") as urlopen_mock:
+                        with patch("usereq.cli.spawn_background_release_check") as spawn_mock:
+                            with patch("sys.stderr") as fake_stderr:
+                                cli.maybe_notify_newer_version(timeout_seconds=2.0)
+        written = "".join(call.args[0] for call in fake_stderr.write.call_args_list)
+        return urlopen_mock, spawn_mock, written
+
+    def test_due_check_is_spawned_and_idle_window_renewed(self) -> None:
+        """A due check must start the background worker instead of calling the API."""
+        with tempfile.TemporaryDirectory() as temp_dir:
+            idle_path = Path(temp_dir) / "idle.json"
+            idle_path.write_text(json.dumps(self._idle_state(self.NOW - 1, "0.0.1")), encoding="utf-8")
+            urlopen_mock, spawn_mock, _ = self._notify(idle_path)
+            payload = json.loads(idle_path.read_text(encoding="utf-8"))
+
+        urlopen_mock.assert_not_called()
+        spawn_mock.assert_called_once_with()
+        self.assertEqual(payload["idle_until_timestamp"], self.NOW + cli.RELEASE_CHECK_IDLE_DELAY_SECONDS)
+        self.assertEqual(payload["last_success_timestamp"], self.NOW - 7200)
+        self.assertEqual(payload["latest_version"], "0.0.1")
+
+    def test_renewed_window_starts_a_single_check(self) -> None:
+        """Invocations following a spawned check must not start another one."""
+        with tempfile.TemporaryDirectory() as temp_dir:
+            idle_path = Path(temp_dir) / "idle.json"
+            _, first_spawn, _ = self._notify(idle_path)
+            _, second_spawn, _ = self._notify(idle_path)
+
+        first_spawn.assert_called_once_with()
+        second_spawn.assert_not_called()
+
+    def test_cached_newer_version_is_reported_from_idle_state(self) -> None:
+        """The notice must come from the cached latest version, without network access."""
+        with tempfile.TemporaryDirectory() as temp_dir:
+            idle_path = Path(temp_dir) / "idle.json"
+            idle_path.write_text(json.dumps(self._idle_state(self.NOW + 3600, "9.9.9")), encoding="utf-8")
+            urlopen_mock, spawn_mock, written = self._notify(idle_path)
+
+        urlopen_mock.assert_not_called()
+        spawn_mock.assert_not_called()
+        self.assertIn(cli.ANSI_BRIGHT_GREEN, written)
+        self.assertIn("installed 0.0.1, latest 9.9.9.", written)
+
+    def test_cached_older_version_prints_nothing(self) -> None:
+        """A cached version not newer than the installed one must stay silent."""
+        with tempfile.TemporaryDirectory() as temp_dir:
+            idle_path = Path(temp_dir) / "idle.json"
+            idle_path.write_text(json.dumps(self._idle_state(self.NOW + 3600, "0.0.1")), encoding="utf-8")
+            _, _, written = self._notify(idle_path)
+
+        self.assertEqual(written, "")
+
+    def _successful_check(self, idle_path: Path, tag: str = "v9.9.9") -> None:
+        response_mock = MagicMock()
+        response_mock.read.return_value = json.dumps({"tag_name": tag}).encode("utf-8")
+        urlopen_cm = MagicMock()
+        urlopen_cm.__enter__.return_value = response_mock
+        urlopen_cm.__exit__.return_value = None
+        with patch("usereq.cli.load_package_version", return_value="0.0.1"):
+            with patch("usereq.cli.time.time", return_value=self.NOW):
+                with patch("usereq.cli.get_release_check_idle_file_path", return_value=idle_path):
+                    with patch("urllib.request.urlopen", return_value=urlopen_cm):
+                        with patch("sys.stderr"):
+                            cli.run_release_check(force=True)
+
+    def test_cached_notice_is_printed_once_per_check(self) -> None:
+        """A second invocation must stay silent until the next successful check."""
+        with tempfile.TemporaryDirectory() as temp_dir:
+            idle_path = Path(temp_dir) / "idle.json"
+            idle_path.write_text(json.dumps(self._idle_state(self.NOW + 3600, "9.9.9")), encoding="utf-8")
+            _, _, first = self._notify(idle_path)
+            _, _, second = self._notify(idle_path)
+            payload = json.loads(idle_path.read_text(encoding="utf-8"))
+            self._successful_check(idle_path)
+            _, _, third = self._notify(idle_path)
+
+        self.assertIn("latest 9.9.9.", first)
+        self.assertEqual(payload["notified_version"], "9.9.9")
+        self.assertEqual(payload["idle_until_timestamp"], self.NOW + 3600)
+        self.assertEqual(second, "")
+        self.assertIn("latest 9.9.9.", third)
+
+    def test_successful_check_caches_latest_version(self) -> None:
+        """The worker must store the fetched version for the next invocation."""
+        with tempfile.TemporaryDirectory() as temp_dir:
+            idle_path = Path(temp_dir) / "idle.json"
+            idle_path.write_text(json.dumps(self._idle_state(self.NOW + 3600)), encoding="utf-8")
+            self._successful_check(idle_path)
+            payload = json.loads(idle_path.read_text(encoding="utf-8"))
+            state = cli.read_release_check_idle_state(idle_path)
+
+        self.assertEqual(payload["latest_version"], "9.9.9")
+        self.assertEqual(state["latest_version"], "9.9.9")
+        self.assertEqual(payload["last_success_timestamp"], self.NOW)
+
+    def test_failed_check_keeps_cached_version(self) -> None:
+        """Failure idle-state rewrites must preserve the cached and the announced version."""
+        with tempfile.TemporaryDirectory() as temp_dir:
+            idle_path = Path(temp_dir) / "idle.json"
+            cli.write_failed_release_check_idle_state(
+                file_path=idle_path,
+                now_timestamp=self.NOW,
+                idle_state={**self._idle_state(self.NOW - 1, "9.9.9"), "notified_version": "9.9.9"},
+            )
+            payload = json.loads(idle_path.read_text(encoding="utf-8"))
+
+        self.assertEqual(payload["latest_version"], "9.9.9")
+        self.assertEqual(payload["notified_version"], "9.9.9")
+
+    def test_command_does_not_wait_on_network(self) -> None:
+        """Commands other than --ver must return without calling the release API."""
+        fixture = Path(__file__).resolve().parent / "fixtures" / "fixture_python.py"
+        with tempfile.TemporaryDirectory() as temp_dir:
+            idle_path = Path(temp_dir) / "idle.json"
+            with patch("usereq.cli.get_release_check_idle_file_path", return_value=idle_path):
+                with patch("urllib.request.urlopen", side_effect=AssertionError("network")) as urlopen_mock:
+                    with patch("usereq.cli.spawn_background_release_check") as spawn_mock:
+                        with patch("sys.stdout"):
+                            exit_code = cli.main(["--files-tokens", str(fixture)])
+
+        self.assertEqual(exit_code, 0)
+        urlopen_mock.assert_not_called()
+        spawn_mock.assert_called_once_with()
+
+    def test_background_worker_is_detached(self) -> None:
+        """The worker must run in its own session with no inherited standard streams."""
+        with patch("usereq.cli.subprocess.Popen") as popen_mock:
+            self.assertTrue(cli.spawn_background_release_check())
+
+        args, kwargs = popen_mock.call_args
+        self.assertEqual(args[0][1:], ["-c", cli.RELEASE_CHECK_WORKER_CODE, str(Path(cli.__file__).resolve().parent.parent)])
+        self.assertTrue(kwargs["start_new_session"])
+        for stream in ("stdin", "stdout", "stderr"):
+            self.assertIs(kwargs[stream], cli.subprocess.DEVNULL)
+        self.assertNotIn("env", kwargs)
+
+    def test_background_worker_keeps_standard_library_first(self) -> None:
+        """A package directory already on the default path must not be moved ahead of the standard library."""
+        setup = cli.RELEASE_CHECK_WORKER_CODE.split("from usereq")[0]
+        probe = setup + "import json\nprint(json.dumps(sys.path))\n"
+        site_dir = sysconfig.get_paths()["purelib"]
+        with tempfile.TemporaryDirectory() as temp_dir:
+            results = []
+            for root in (site_dir, temp_dir):
+                output = subprocess.run([sys.executable, "-c", probe, os.path.realpath(root)], capture_output=True, text=True, check=True).stdout
+                results.append([os.path.realpath(entry) for entry in json.loads(output)])
+
+        stdlib = os.path.realpath(sysconfig.get_paths()["stdlib"])
+        self.assertLess(results[0].index(stdlib), results[0].index(os.path.realpath(site_dir)))
+        self.assertEqual(results[1][0], os.path.realpath(temp_dir))
+
+    def test_background_worker_spawn_failure_is_silent(self) -> None:
+        """A failed spawn must not break the invoking command."""
+        with patch("usereq.cli.subprocess.Popen", side_effect=OSError("no fork")):
+            self.assertFalse(cli.spawn_background_release_check())
@@ -0,0 +1,130 @@
+"""Tests for the usereq.watch module and `--watch`.
+
+Covers: WAT-001 through WAT-004.
+"""
+
+import functools
+import sys
+import threading
+import time
+
+import pytest
+
+import usereq.cli as cli_module
+from usereq import watch
+from usereq.cli import main
+
+
+@pytest.fixture(autouse=True)
+def _no_release_check(monkeypatch):
+    """Disable the startup release check."""
+    monkeypatch.setattr(
+        cli_module,
+        "maybe_notify_newer_version",
+        lambda timeout_seconds=2.0: None,
+    )
+
+
+@pytest.fixture
+def project(repo_temp_dir, monkeypatch):
+    """Configured project with two Python sources, used as the working directory."""
+    src = repo_temp_dir / "src"
+    src.mkdir()
+    (src / "alpha.py").write_text("def alpha():\n    return 1\n", encoding="utf-8")
+    (src / "beta.py").write_text("class Beta:\n    pass\n", encoding="utf-8")
+    (repo_temp_dir / ".req").mkdir()
+    (repo_temp_dir / ".req" / "config.json").write_text(
+        '{"src-dir": ["src"], "docs-dir": "docs", "tests-dir": "tests", "guidelines-dir": "guidelines"}', encoding="utf-8"
+    )
+    monkeypatch.chdir(repo_temp_dir)
+    return repo_temp_dir
+
+
+class _ScriptedWatcher:
+    """Watcher replaying a fixed sequence of change sets."""
+
+    def __init__(self, batches):
+        self.batches = list(batches)
+
+    def wait(self, timeout):
+        return self.batches.pop(0) if self.batches else set()
+
+    def close(self):
+        pass
+
+
+class TestPollingWatcher:
+    """WAT-001: the polling fallback reports created, modified, and deleted files."""
+
+    def test_reports_changes_and_skips_git(self, repo_temp_dir):
+        """Stat snapshot differences are returned; `.git` content is never scanned."""
+        target = repo_temp_dir / "a.py"
+        target.write_text("x = 1\n", encoding="utf-8")
+        watcher = watch.PollingWatcher([str(repo_temp_dir)], interval=0.01)
+        assert watcher.wait(0.02) == set()
+        created = repo_temp_dir / "b.py"
+        created.write_text("y = 2\n", encoding="utf-8")
+        target.write_text("x = 10\n", encoding="utf-8")
+        (repo_temp_dir / ".git" / "scratch").write_text("ignored\n", encoding="utf-8")
+        assert watcher.wait(1.0) == {str(created), str(target)}
+        created.unlink()
+        assert watcher.wait(1.0) == {str(created)}
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="inotify is Linux only")
+class TestInotifyWatcher:
+    """WAT-002: the inotify watcher follows new directories."""
+
+    def test_new_directory_is_watched(self, repo_temp_dir):
+        """Files created inside a directory made after start-up are reported."""
+        watcher = watch.create_watcher([str(repo_temp_dir)])
+        try:
+            if not isinstance(watcher, watch.InotifyWatcher):
+                pytest.skip("inotify unavailable")
+            package = repo_temp_dir / "pkg"
+            package.mkdir()
+            assert str(package) in watch.collect_batch(watcher, debounce=0.05, timeout=2.0)
+            module = package / "mod.py"
+            module.write_text("z = 3\n", encoding="utf-8")
+            assert str(module) in watch.collect_batch(watcher, debounce=0.05, timeout=2.0)
+        finally:
+            watcher.close()
+
+
+class TestDebounce:
+    """WAT-003: bursts of changes are merged into one batch."""
+
+    def test_batches_merge_until_quiet(self):
+        """Changes arriving before the quiet period ends join the current batch."""
+        watcher = _ScriptedWatcher([{"a"}, {"b"}, set(), {"c"}])
+        batches = []
+        assert watch.watch_loop(watcher, batches.append, debounce=0.01) == 2
+        assert batches == [{"a", "b"}, {"c"}]
+
+
+class TestCliWatch:
+    """WAT-004: `--watch` keeps the references artifact equal to `--references` output."""
+
+    def test_artifact_tracks_edits(self, project, monkeypatch, capsys):
+        """The initial render and a re-render after an edit match a fresh `--references` run."""
+        monkeypatch.setattr(watch, "create_watcher", lambda roots: watch.PollingWatcher(roots, interval=0.02))
+        monkeypatch.setattr(watch, "watch_loop", functools.partial(watch.watch_loop, max_batches=1))
+        artifact = project / ".req" / "cache" / "references.md"
+        thread = threading.Thread(target=main, args=(["--watch", "--jobs", "1"],), daemon=True)
+        thread.start()
+        deadline = time.monotonic() + 10
+        while not artifact.exists():
+            assert time.monotonic() < deadline, "initial render missing"
+            time.sleep(0.02)
+        (project / "src" / "alpha.py").write_text("def alpha_renamed():\n    return 1\n", encoding="utf-8")
+        thread.join(10)
+        assert not thread.is_alive()
+        capsys.readouterr()
+        assert main(["--references", "--no-server", "--jobs", "1"]) == 0
+        assert artifact.read_text(encoding="utf-8") == capsys.readouterr().out
+        assert "alpha_renamed" in artifact.read_text(encoding="utf-8")
+
+    def test_requires_cache(self, project, capsys):
+        """`--no-cache` is rejected."""
+        assert main(["--watch", "--no-cache"]) == 1
+        assert "--watch requires the analysis cache" in capsys.readouterr().err